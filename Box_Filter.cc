@@ -0,0 +1,196 @@
+/*	Box_Filter
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#include	"Box_Filter.hh"
+
+#include	<QTransform>
+
+#include	<cmath>
+#include	<cstring>
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/*==============================================================================
+	Constants
+*/
+const char* const
+	Box_Filter::ID =
+		"UA::HiRISE::Box_Filter ($Revision: 1.1 $ $Date: 2026/10/17 00:00:00 $)";
+
+#ifndef MAX_BOX_FILTER_STEP
+#define MAX_BOX_FILTER_STEP			8.0
+#endif
+const double
+	Box_Filter::MAX_STEP			= MAX_BOX_FILTER_STEP;
+
+namespace
+{
+/*	Tolerance for bin boundaries that fall on a pixel center.
+
+	Accumulated floating point error must not move a boundary by a
+	whole pixel.
+*/
+const double
+	BOUNDARY_TOLERANCE				= 1.0e-9;
+
+inline int
+bin_boundary
+	(
+	double	location,
+	int		limit
+	)
+{
+double
+	boundary = std::ceil (location - BOUNDARY_TOLERANCE);
+if (boundary <= 0.0)
+	return 0;
+if (boundary >= limit)
+	return limit;
+return static_cast<int>(boundary);
+}
+}
+
+/*==============================================================================
+	Constructor
+*/
+Box_Filter::Box_Filter ()
+	:	First (0),
+		End (0),
+		Lines (0)
+{}
+
+/*==============================================================================
+	Mapping
+*/
+bool
+Box_Filter::applicable
+	(
+	const QTransform&	transform
+	)
+{
+return
+	transform.isAffine () &&
+	transform.m12 () == 0.0 &&
+	transform.m21 () == 0.0 &&
+	transform.m11 () >= 1.0 &&
+	transform.m22 () >= 1.0 &&
+	(transform.m11 () > 1.0 ||
+	 transform.m22 () > 1.0) &&
+	transform.m11 () <= MAX_STEP &&
+	transform.m22 () <= MAX_STEP;
+}
+
+
+void
+Box_Filter::span
+	(
+	double	origin,
+	double	step,
+	int		limit,
+	int*	first,
+	int*	end
+	)
+{
+*first = bin_boundary (origin, limit);
+*end   = bin_boundary (origin + step, limit);
+}
+
+
+void
+Box_Filter::samples
+	(
+	unsigned int	count,
+	double			origin,
+	double			step,
+	int				source_width
+	)
+{
+Bin_Ends.resize (count);
+First = End = bin_boundary (origin, source_width);
+for (unsigned int
+		index = 0;
+		index < count;
+		index++)
+	{
+	End = bin_boundary (origin + (step * (index + 1)), source_width);
+	Bin_Ends[index] = End - First;
+	}
+Row_Sums.resize (End - First);
+clear ();
+}
+
+/*==============================================================================
+	Filtering
+*/
+void
+Box_Filter::clear ()
+{
+if (! Row_Sums.isEmpty ())
+	std::memset (Row_Sums.data (), 0, Row_Sums.size () * sizeof (quint32));
+Lines = 0;
+}
+
+
+void
+Box_Filter::average
+	(
+	quint32*	values,
+	quint32		undefined
+	) const
+{
+const quint32
+	*sums = Row_Sums.constData ();
+quint64
+	sum,
+	area;
+int
+	sample = 0,
+	bin_end,
+	count = Bin_Ends.size ();
+for (int
+		index = 0;
+		index < count;
+		index++)
+	{
+	bin_end = Bin_Ends[index];
+	area = (quint64)(bin_end - sample) * Lines;
+	if (area == 0)
+		{
+		values[index] = undefined;
+		sample = bin_end;
+		continue;
+		}
+	for (sum = 0;
+		 sample < bin_end;
+		 sample++)
+		sum += sums[sample];
+	values[index] = static_cast<quint32>((sum + (area >> 1)) / area);
+	}
+}
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
@@ -0,0 +1,211 @@
+/*	Box_Filter
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#ifndef HiView_Box_Filter_hh
+#define HiView_Box_Filter_hh
+
+#include	"Data_Map_Kernels.hh"
+
+#include	<QVector>
+
+class QTransform;
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/**	A <i>Box_Filter</i> averages the source image data values under
+	each display pixel of a scaled down image.
+
+	Point sampling a scaled down image selects one source value for each
+	display pixel; the other source values that the display pixel
+	covers are ignored, which produces aliasing artifacts when the scale
+	is not a power of two. A Box_Filter instead renders each display
+	pixel as the average of all the source values in its area.
+
+	The filter is separable. For each display line the source lines
+	under the display line are {@link accumulate(const Source_Type*)
+	accumulated}, in sequence, into a line of sums by a SIMD kernel.
+	Each display sample is then the {@link average(quint32*, quint32)
+	average} of the sums for the source samples it covers. Only the
+	contiguous span of source samples covered by the display line is
+	accumulated.
+
+	The source sample bins are set when the horizontal {@link
+	samples(unsigned int, double, double, int) sample mapping} changes;
+	a Box_Filter is intended to be reused for all display lines with the
+	same horizontal mapping.
+
+	@version	$Revision: 1.1 $
+*/
+class Box_Filter
+{
+public:
+/*==============================================================================
+	Constants
+*/
+//!	Class identification name with source code version and date.
+static const char* const
+	ID;
+
+/**	Maximum source to display scaling for which box filtering is
+	{@link applicable(const QTransform&) applicable}.
+
+	Larger scaling factors are point sampled to bound the rendering
+	cost.
+*/
+static const double
+	MAX_STEP;
+
+/*==============================================================================
+	Constructor
+*/
+Box_Filter ();
+
+/*==============================================================================
+	Mapping
+*/
+/**	Test if box filtering is applicable to a display to source
+	transform.
+
+	The transform must be affine, unrotated and unflipped with a scaling
+	factor - the source step for each display pixel - of at least 1 in
+	both directions, greater than 1 in at least one direction, and no
+	greater than the {@link #MAX_STEP maximum step}.
+
+	@param	transform	The display to source transform.
+	@return	true if the transform can be box filtered; false otherwise.
+*/
+static bool applicable (const QTransform& transform);
+
+/**	Get the span of source locations covered by a display location.
+
+	The source locations are those with pixel centers within the display
+	pixel area.
+
+	@param	origin	The source coordinate of the leading edge of the
+		display pixel, where source pixel centers are at integer
+		coordinates.
+	@param	step	The source extent of the display pixel.
+	@param	limit	The number of source locations.
+	@param	first	A pointer to where the first source location will be
+		stored.
+	@param	end		A pointer to where the source location following
+		the last location will be stored. This will be no greater than the
+		first location if the span is empty.
+*/
+static void span (double origin, double step, int limit,
+	int* first, int* end);
+
+/**	Set the source sample bins for a display line.
+
+	@param	count	The number of display samples.
+	@param	origin	The source sample coordinate of the leading edge of
+		the first display sample, where source pixel centers are at
+		integer coordinates.
+	@param	step	The source extent of each display sample.
+	@param	source_width	The number of source samples.
+*/
+void samples (unsigned int count, double origin, double step,
+	int source_width);
+
+/**	Get the first source sample covered by the display line.
+
+	@return	The source sample number.
+*/
+inline int first () const
+	{return First;}
+
+/**	Get the number of contiguous source samples covered by the display
+	line.
+
+	@return	The number of source samples, starting with the {@link
+		first() first} source sample, that are accumulated for each
+		source line.
+*/
+inline int width () const
+	{return End - First;}
+
+/*==============================================================================
+	Filtering
+*/
+/**	Clear the accumulated source lines.
+*/
+void clear ();
+
+/**	Accumulate a source line.
+
+	@param	source	A pointer to the {@link first() first} source sample
+		value of the source line. There must be {@link width() width}
+		values.
+*/
+template<typename Source_Type>
+inline void accumulate (const Source_Type* source)
+	{
+	if (End > First)
+		{
+		accumulate_values (source, Row_Sums.data (),
+			static_cast<unsigned int>(End - First));
+		++Lines;
+		}
+	}
+
+/**	Get the number of accumulated source lines.
+
+	@return	The number of source lines accumulated since the filter was
+		last {@link clear() cleared}.
+*/
+inline unsigned int lines () const
+	{return Lines;}
+
+/**	Average the accumulated source lines into display sample values.
+
+	@param	values	A pointer to storage for the display sample values.
+	@param	undefined	The value for display samples that do not cover
+		any source data.
+*/
+void average (quint32* values, quint32 undefined) const;
+
+/*==============================================================================
+	Data
+*/
+private:
+
+//	Source sample bin ends, relative to First, for each display sample.
+QVector<int>
+	Bin_Ends;
+int
+	First,
+	End;
+
+QVector<quint32>
+	Row_Sums;
+unsigned int
+	Lines;
+};
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
+#endif
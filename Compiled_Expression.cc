@@ -0,0 +1,1272 @@
+/*	Compiled_Expression
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#include	"Compiled_Expression.hh"
+
+#include	<QVector>
+#include	<QList>
+
+#include	<cmath>
+#include	<limits>
+using std::numeric_limits;
+
+
+#if defined (DEBUG_SECTION)
+/*******************************************************************************
+	DEBUG_SECTION controls
+
+	DEBUG_SECTION report selection options.
+	Define any of the following options to obtain the desired debug reports:
+*/
+#define DEBUG_OFF			0
+#define DEBUG_ALL			-1
+#define DEBUG_COMPILE		(1 << 0)
+
+#define DEBUG_DEFAULT		DEBUG_ALL
+
+#if (DEBUG_SECTION+0) == 0
+#undef  DEBUG_SECTION
+#define DEBUG_SECTION DEBUG_OFF
+#else
+#include	<iostream>
+using std::clog;
+using std::endl;
+#endif
+
+#endif	//	DEBUG_SECTION
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/*==============================================================================
+	Constants
+*/
+const char* const
+	Compiled_Expression::ID =
+		"UA::HiRISE::Compiled_Expression ($Revision: 1.1 $ $Date: 2026/10/17 00:00:00 $)";
+
+/*==============================================================================
+	Expression nodes
+*/
+/*	An expression node evaluates its operation over vectors of values.
+
+	Boolean results are represented as 1.0 (true) and 0.0 (false); the
+	Boolean flag records that the node result is boolean so the result
+	type of the expression can be checked.
+*/
+class Compiled_Expression::Node
+{
+public:
+
+Node (bool boolean = false)
+	:	Boolean (boolean)
+{}
+
+virtual ~Node ()
+{}
+
+virtual void evaluate (const double* const* variables,
+	double* results, int count) const = 0;
+
+virtual bool is_constant () const
+	{return false;}
+
+bool
+	Boolean;
+};
+
+
+#ifndef DOXYGEN_PROCESSING
+namespace
+{
+typedef Compiled_Expression::Node	Node;
+
+//	JavaScript truthiness of a number.
+inline bool
+truth
+	(
+	double	value
+	)
+{return value != 0.0 && value == value;}
+
+
+class Constant_Node
+:	public Node
+{
+public:
+
+Constant_Node (double value, bool boolean = false)
+	:	Node (boolean),
+		Value (value)
+{}
+
+void evaluate
+	(
+	const double* const*,
+	double*		results,
+	int			count
+	) const
+{
+while (count--)
+	*results++ = Value;
+}
+
+bool is_constant () const
+	{return true;}
+
+double
+	Value;
+};
+
+
+class Variable_Node
+:	public Node
+{
+public:
+
+Variable_Node (int index)
+	:	Index (index)
+{}
+
+void evaluate
+	(
+	const double* const*	variables,
+	double*					results,
+	int						count
+	) const
+{
+const double
+	*values = variables[Index];
+while (count--)
+	*results++ = *values++;
+}
+
+int
+	Index;
+};
+
+
+enum Operator
+	{
+	NEGATE,
+	NOT,
+	ADD,
+	SUBTRACT,
+	MULTIPLY,
+	DIVIDE,
+	MODULUS,
+	LESS,
+	LESS_EQUAL,
+	GREATER,
+	GREATER_EQUAL,
+	EQUAL,
+	NOT_EQUAL,
+	AND,
+	OR,
+	ABS,
+	ACOS,
+	ASIN,
+	ATAN,
+	ATAN2,
+	CEIL,
+	COS,
+	EXP,
+	FLOOR,
+	LOG,
+	MAX,
+	MIN,
+	POW,
+	ROUND,
+	SIN,
+	SQRT,
+	TAN
+	};
+
+
+class Unary_Node
+:	public Node
+{
+public:
+
+Unary_Node (Operator operation, Node* operand)
+	:	Node (operation == NOT),
+		Operation (operation),
+		Operand (operand)
+{}
+
+~Unary_Node ()
+	{delete Operand;}
+
+void evaluate
+	(
+	const double* const*	variables,
+	double*					results,
+	int						count
+	) const
+{
+Operand->evaluate (variables, results, count);
+switch (Operation)
+	{
+	case NEGATE:
+		while (count--)
+			{
+			*results = -*results;
+			++results;
+			}
+		break;
+	case NOT:
+		while (count--)
+			{
+			*results = truth (*results) ? 0.0 : 1.0;
+			++results;
+			}
+		break;
+	case ABS:
+		while (count--)
+			{
+			*results = std::fabs (*results);
+			++results;
+			}
+		break;
+	case ACOS:
+		while (count--)
+			{
+			*results = std::acos (*results);
+			++results;
+			}
+		break;
+	case ASIN:
+		while (count--)
+			{
+			*results = std::asin (*results);
+			++results;
+			}
+		break;
+	case ATAN:
+		while (count--)
+			{
+			*results = std::atan (*results);
+			++results;
+			}
+		break;
+	case CEIL:
+		while (count--)
+			{
+			*results = std::ceil (*results);
+			++results;
+			}
+		break;
+	case COS:
+		while (count--)
+			{
+			*results = std::cos (*results);
+			++results;
+			}
+		break;
+	case EXP:
+		while (count--)
+			{
+			*results = std::exp (*results);
+			++results;
+			}
+		break;
+	case FLOOR:
+		while (count--)
+			{
+			*results = std::floor (*results);
+			++results;
+			}
+		break;
+	case LOG:
+		while (count--)
+			{
+			*results = std::log (*results);
+			++results;
+			}
+		break;
+	case ROUND:
+		//	JavaScript rounds halves up.
+		while (count--)
+			{
+			*results = std::floor (*results + 0.5);
+			++results;
+			}
+		break;
+	case SIN:
+		while (count--)
+			{
+			*results = std::sin (*results);
+			++results;
+			}
+		break;
+	case SQRT:
+		while (count--)
+			{
+			*results = std::sqrt (*results);
+			++results;
+			}
+		break;
+	case TAN:
+		while (count--)
+			{
+			*results = std::tan (*results);
+			++results;
+			}
+		break;
+	default:
+		break;
+	}
+}
+
+bool is_constant () const
+	{return Operand->is_constant ();}
+
+Operator
+	Operation;
+Node
+	*Operand;
+};
+
+
+class Binary_Node
+:	public Node
+{
+public:
+
+Binary_Node (Operator operation, Node* left, Node* right)
+	:	Node (operation >= LESS && operation <= NOT_EQUAL),
+		Operation (operation),
+		Left (left),
+		Right (right)
+{
+if (Operation == AND ||
+	Operation == OR)
+	Boolean = Left->Boolean;
+}
+
+~Binary_Node ()
+{
+delete Left;
+delete Right;
+}
+
+void evaluate
+	(
+	const double* const*	variables,
+	double*					results,
+	int						count
+	) const
+{
+Left->evaluate (variables, results, count);
+QVector<double>
+	right_values (count);
+Right->evaluate (variables, right_values.data (), count);
+const double
+	*right = right_values.constData ();
+double
+	value;
+switch (Operation)
+	{
+	case ADD:
+		while (count--)
+			*results++ += *right++;
+		break;
+	case SUBTRACT:
+		while (count--)
+			*results++ -= *right++;
+		break;
+	case MULTIPLY:
+		while (count--)
+			*results++ *= *right++;
+		break;
+	case DIVIDE:
+		while (count--)
+			*results++ /= *right++;
+		break;
+	case MODULUS:
+		while (count--)
+			{
+			*results = std::fmod (*results, *right++);
+			++results;
+			}
+		break;
+	case LESS:
+		while (count--)
+			{
+			*results = (*results < *right++) ? 1.0 : 0.0;
+			++results;
+			}
+		break;
+	case LESS_EQUAL:
+		while (count--)
+			{
+			*results = (*results <= *right++) ? 1.0 : 0.0;
+			++results;
+			}
+		break;
+	case GREATER:
+		while (count--)
+			{
+			*results = (*results > *right++) ? 1.0 : 0.0;
+			++results;
+			}
+		break;
+	case GREATER_EQUAL:
+		while (count--)
+			{
+			*results = (*results >= *right++) ? 1.0 : 0.0;
+			++results;
+			}
+		break;
+	case EQUAL:
+		while (count--)
+			{
+			*results = (*results == *right++) ? 1.0 : 0.0;
+			++results;
+			}
+		break;
+	case NOT_EQUAL:
+		while (count--)
+			{
+			*results = (*results != *right++) ? 1.0 : 0.0;
+			++results;
+			}
+		break;
+	case AND:
+		//	JavaScript yields the left operand if it is false.
+		while (count--)
+			{
+			if (truth (*results))
+				*results = *right;
+			++results;
+			++right;
+			}
+		break;
+	case OR:
+		//	JavaScript yields the left operand if it is true.
+		while (count--)
+			{
+			if (! truth (*results))
+				*results = *right;
+			++results;
+			++right;
+			}
+		break;
+	case ATAN2:
+		while (count--)
+			{
+			*results = std::atan2 (*results, *right++);
+			++results;
+			}
+		break;
+	case POW:
+		while (count--)
+			{
+			*results = std::pow (*results, *right++);
+			++results;
+			}
+		break;
+	case MAX:
+		//	JavaScript yields NaN if either value is NaN.
+		while (count--)
+			{
+			value = *right++;
+			if (*results != *results ||
+				value != value)
+				*results = numeric_limits<double>::quiet_NaN ();
+			else if (value > *results)
+				*results = value;
+			++results;
+			}
+		break;
+	case MIN:
+		while (count--)
+			{
+			value = *right++;
+			if (*results != *results ||
+				value != value)
+				*results = numeric_limits<double>::quiet_NaN ();
+			else if (value < *results)
+				*results = value;
+			++results;
+			}
+		break;
+	default:
+		break;
+	}
+}
+
+bool is_constant () const
+	{return Left->is_constant () && Right->is_constant ();}
+
+Operator
+	Operation;
+Node
+	*Left,
+	*Right;
+};
+
+
+class Conditional_Node
+:	public Node
+{
+public:
+
+Conditional_Node (Node* condition, Node* when_true, Node* when_false)
+	:	Node (when_true->Boolean),
+		Condition (condition),
+		When_True (when_true),
+		When_False (when_false)
+{}
+
+~Conditional_Node ()
+{
+delete Condition;
+delete When_True;
+delete When_False;
+}
+
+void evaluate
+	(
+	const double* const*	variables,
+	double*					results,
+	int						count
+	) const
+{
+QVector<double>
+	conditions (count),
+	false_values (count);
+Condition->evaluate (variables, conditions.data (), count);
+When_True->evaluate (variables, results, count);
+When_False->evaluate (variables, false_values.data (), count);
+const double
+	*condition = conditions.constData (),
+	*value = false_values.constData ();
+while (count--)
+	{
+	if (! truth (*condition++))
+		*results = *value;
+	++results;
+	++value;
+	}
+}
+
+bool is_constant () const
+{
+return
+	Condition->is_constant () &&
+	When_True->is_constant () &&
+	When_False->is_constant ();
+}
+
+Node
+	*Condition,
+	*When_True,
+	*When_False;
+};
+
+/*==============================================================================
+	Parser
+*/
+struct Function_Definition
+{
+const char
+	*Name;
+Operator
+	Operation;
+int
+	Arguments;	//	Negative for one or more.
+};
+
+const Function_Definition
+	FUNCTIONS[] =
+	{
+	{"abs",		ABS,	1},
+	{"acos",	ACOS,	1},
+	{"asin",	ASIN,	1},
+	{"atan",	ATAN,	1},
+	{"atan2",	ATAN2,	2},
+	{"ceil",	CEIL,	1},
+	{"cos",		COS,	1},
+	{"exp",		EXP,	1},
+	{"floor",	FLOOR,	1},
+	{"log",		LOG,	1},
+	{"max",		MAX,	-1},
+	{"min",		MIN,	-1},
+	{"pow",		POW,	2},
+	{"round",	ROUND,	1},
+	{"sin",		SIN,	1},
+	{"sqrt",	SQRT,	1},
+	{"tan",		TAN,	1},
+	{NULL,		ABS,	0}
+	};
+
+
+/*	Recursive descent parser.
+
+	Each parse method returns a new Node, or NULL with the Error set if
+	the expression can not be compiled. The precedence of the operators
+	is that of JavaScript.
+*/
+class Parser
+{
+public:
+
+Parser
+	(
+	const QString&							expression,
+	const QStringList&						variables,
+	const Compiled_Expression::Constants&	constants,
+	Compiled_Expression::Constants&			used_constants
+	)
+	:	Source (expression),
+		Position (0),
+		Variables (variables),
+		Constants_Table (constants),
+		Used_Constants (used_constants)
+{}
+
+Node* parse ()
+{
+Node
+	*node = conditional ();
+if (node)
+	{
+	skip_space ();
+	if (Position < Source.length ())
+		fail (QString ("unexpected \"%1\"").arg (Source.mid (Position)));
+	if (! Error.isEmpty ())
+		{
+		delete node;
+		node = NULL;
+		}
+	}
+return node;
+}
+
+QString
+	Error;
+
+private:
+
+void fail
+	(
+	const QString&	message
+	)
+{
+if (Error.isEmpty ())
+	Error = QString ("%1 at character %2").arg (message).arg (Position + 1);
+}
+
+void skip_space ()
+{
+while (Position < Source.length () &&
+		Source[Position].isSpace ())
+	++Position;
+}
+
+//	Match an operator token.
+bool match
+	(
+	const char*	token
+	)
+{
+skip_space ();
+int
+	length = (int)qstrlen (token);
+if (Source.midRef (Position, length) == QLatin1String (token))
+	{
+	//	Don't match the leading part of a longer operator.
+	QChar
+		next = (Position + length < Source.length ()) ?
+			Source[Position + length] : QChar ();
+	if (length == 1 &&
+		(token[0] == '<' || token[0] == '>' ||
+		 token[0] == '!' || token[0] == '=') &&
+		next == '=')
+		return false;
+	if (length == 1 &&
+		(token[0] == '&' || token[0] == '|') &&
+		next == token[0])
+		return false;
+	if (length == 1 &&
+		(token[0] == '+' || token[0] == '-') &&
+		next == token[0])
+		{
+		/*	Increment and decrement are not double signs in JavaScript;
+			leave them to the script engine.
+		*/
+		fail (QString ("unsupported \"%1%1\" operator").arg (token[0]));
+		return false;
+		}
+	if (length == 2 &&
+		(token[0] == '=' || token[0] == '!') &&
+		next == '=')
+		return false;
+	Position += length;
+	return true;
+	}
+return false;
+}
+
+//	Combine binary operands, folding constant results.
+Node* combine
+	(
+	Node*	node
+	)
+{
+if (node &&
+	node->is_constant ())
+	{
+	double
+		value;
+	node->evaluate (NULL, &value, 1);
+	Node
+		*constant = new Constant_Node (value, node->Boolean);
+	delete node;
+	node = constant;
+	}
+return node;
+}
+
+Node* conditional ()
+{
+Node
+	*node = logical_or (),
+	*when_true,
+	*when_false;
+if (node &&
+	match ("?"))
+	{
+	if (! (when_true = conditional ()))
+		{
+		delete node;
+		return NULL;
+		}
+	if (! match (":"))
+		{
+		fail ("missing \":\"");
+		delete node;
+		delete when_true;
+		return NULL;
+		}
+	if (! (when_false = conditional ()))
+		{
+		delete node;
+		delete when_true;
+		return NULL;
+		}
+	if (when_true->Boolean != when_false->Boolean)
+		{
+		fail ("mixed boolean and numeric conditional results");
+		delete node;
+		delete when_true;
+		delete when_false;
+		return NULL;
+		}
+	node = combine (new Conditional_Node (node, when_true, when_false));
+	}
+return node;
+}
+
+Node* binary
+	(
+	Node*		left,
+	Operator	operation,
+	Node*		right
+	)
+{
+if (! right)
+	{
+	delete left;
+	return NULL;
+	}
+if ((operation == AND || operation == OR) &&
+	left->Boolean != right->Boolean)
+	{
+	fail ("mixed boolean and numeric logical operands");
+	delete left;
+	delete right;
+	return NULL;
+	}
+return combine (new Binary_Node (operation, left, right));
+}
+
+Node* logical_or ()
+{
+Node
+	*node = logical_and ();
+while (node &&
+		match ("||"))
+	node = binary (node, OR, logical_and ());
+return node;
+}
+
+Node* logical_and ()
+{
+Node
+	*node = equality ();
+while (node &&
+		match ("&&"))
+	node = binary (node, AND, equality ());
+return node;
+}
+
+Node* equality ()
+{
+Node
+	*node = relational (),
+	*right;
+bool
+	strict;
+Operator
+	operation;
+while (node)
+	{
+	if ((strict = match ("===")) || match ("=="))
+		operation = EQUAL;
+	else
+	if ((strict = match ("!==")) || match ("!="))
+		operation = NOT_EQUAL;
+	else
+		break;
+	if (! (right = relational ()))
+		{
+		delete node;
+		return NULL;
+		}
+	if (strict &&
+		node->Boolean != right->Boolean)
+		{
+		//	Strict comparison of different types is constant.
+		fail ("strict comparison of boolean and numeric values");
+		delete node;
+		delete right;
+		return NULL;
+		}
+	node = binary (node, operation, right);
+	}
+return node;
+}
+
+Node* relational ()
+{
+Node
+	*node = additive ();
+while (node)
+	{
+	if (match ("<="))
+		node = binary (node, LESS_EQUAL, additive ());
+	else
+	if (match (">="))
+		node = binary (node, GREATER_EQUAL, additive ());
+	else
+	if (match ("<"))
+		node = binary (node, LESS, additive ());
+	else
+	if (match (">"))
+		node = binary (node, GREATER, additive ());
+	else
+		break;
+	}
+return node;
+}
+
+Node* additive ()
+{
+Node
+	*node = multiplicative ();
+while (node)
+	{
+	if (match ("+"))
+		node = binary (node, ADD, multiplicative ());
+	else
+	if (match ("-"))
+		node = binary (node, SUBTRACT, multiplicative ());
+	else
+		break;
+	}
+return node;
+}
+
+Node* multiplicative ()
+{
+Node
+	*node = unary ();
+while (node)
+	{
+	if (match ("*"))
+		node = binary (node, MULTIPLY, unary ());
+	else
+	if (match ("/"))
+		node = binary (node, DIVIDE, unary ());
+	else
+	if (match ("%"))
+		node = binary (node, MODULUS, unary ());
+	else
+		break;
+	}
+return node;
+}
+
+Node* unary ()
+{
+Node
+	*node;
+if (match ("-"))
+	{
+	if ((node = unary ()))
+		node = combine (new Unary_Node (NEGATE, node));
+	}
+else
+if (match ("+"))
+	{
+	//	Numeric conversion.
+	if ((node = unary ()))
+		node->Boolean = false;
+	}
+else
+if (match ("!"))
+	{
+	if ((node = unary ()))
+		node = combine (new Unary_Node (NOT, node));
+	}
+else
+	node = primary ();
+return node;
+}
+
+Node* primary ()
+{
+skip_space ();
+if (Position >= Source.length ())
+	{
+	fail ("incomplete expression");
+	return NULL;
+	}
+
+QChar
+	character = Source[Position];
+if (character.isDigit () ||
+	(character == '.' &&
+	 Position + 1 < Source.length () &&
+	 Source[Position + 1].isDigit ()))
+	return number ();
+
+if (character.isLetter () ||
+	character == '_' ||
+	character == '$')
+	return name ();
+
+if (match ("("))
+	{
+	Node
+		*node = conditional ();
+	if (node &&
+		! match (")"))
+		{
+		fail ("missing \")\"");
+		delete node;
+		node = NULL;
+		}
+	return node;
+	}
+
+fail (QString ("unexpected \"%1\"").arg (character));
+return NULL;
+}
+
+Node* number ()
+{
+int
+	start = Position;
+bool
+	OK;
+double
+	value;
+if (Source[Position] == '0' &&
+	Position + 1 < Source.length () &&
+	(Source[Position + 1] == 'x' || Source[Position + 1] == 'X'))
+	{
+	Position += 2;
+	while (Position < Source.length () &&
+			QString ("0123456789abcdefABCDEF").contains (Source[Position]))
+		++Position;
+	value = (double)Source.mid (start + 2, Position - start - 2)
+		.toULongLong (&OK, 16);
+	}
+else
+	{
+	while (Position < Source.length () &&
+			(Source[Position].isDigit () || Source[Position] == '.'))
+		++Position;
+	if (Position < Source.length () &&
+		(Source[Position] == 'e' || Source[Position] == 'E'))
+		{
+		++Position;
+		if (Position < Source.length () &&
+			(Source[Position] == '+' || Source[Position] == '-'))
+			++Position;
+		while (Position < Source.length () &&
+				Source[Position].isDigit ())
+			++Position;
+		}
+	value = Source.mid (start, Position - start).toDouble (&OK);
+	}
+if (! OK)
+	{
+	Position = start;
+	fail ("invalid number");
+	return NULL;
+	}
+return new Constant_Node (value);
+}
+
+Node* name ()
+{
+int
+	start = Position;
+while (Position < Source.length () &&
+		(Source[Position].isLetterOrNumber () ||
+		 Source[Position] == '_' ||
+		 Source[Position] == '$' ||
+		 Source[Position] == '.'))
+	++Position;
+QString
+	identifier (Source.mid (start, Position - start));
+
+int
+	index = Variables.indexOf (identifier);
+if (index >= 0)
+	return new Variable_Node (index);
+if (Constants_Table.contains (identifier))
+	{
+	double
+		value = Constants_Table.value (identifier);
+	Used_Constants.insert (identifier, value);
+	return new Constant_Node (value);
+	}
+if (identifier == "Math.PI")
+	return new Constant_Node (3.14159265358979323846);
+if (identifier == "Math.E")
+	return new Constant_Node (2.71828182845904523536);
+if (identifier == "true" ||
+	identifier == "false")
+	return new Constant_Node ((identifier == "true") ? 1.0 : 0.0, true);
+
+QString
+	function_name (identifier);
+if (function_name.startsWith ("Math."))
+	function_name.remove (0, 5);
+const Function_Definition
+	*function = FUNCTIONS;
+while (function->Name &&
+		function_name != function->Name)
+	++function;
+if (! function->Name ||
+	! match ("("))
+	{
+	Position = start;
+	fail (QString ("unknown name \"%1\"").arg (identifier));
+	return NULL;
+	}
+
+QList<Node*>
+	arguments;
+Node
+	*argument;
+if (! match (")"))
+	{
+	do
+		{
+		if (! (argument = conditional ()))
+			{
+			qDeleteAll (arguments);
+			return NULL;
+			}
+		arguments.append (argument);
+		}
+		while (match (","));
+	if (! match (")"))
+		{
+		fail ("missing \")\"");
+		qDeleteAll (arguments);
+		return NULL;
+		}
+	}
+if ((function->Arguments < 0 && arguments.isEmpty ()) ||
+	(function->Arguments > 0 && arguments.size () != function->Arguments))
+	{
+	Position = start;
+	fail (QString ("wrong number of arguments to \"%1\"").arg (identifier));
+	qDeleteAll (arguments);
+	return NULL;
+	}
+
+Node
+	*node = arguments.takeFirst ();
+node->Boolean = false;
+if (arguments.isEmpty ())
+	{
+	if (function->Arguments == 1)
+		node = combine (new Unary_Node (function->Operation, node));
+	}
+else
+	while (! arguments.isEmpty ())
+		{
+		argument = arguments.takeFirst ();
+		argument->Boolean = false;
+		node = combine
+			(new Binary_Node (function->Operation, node, argument));
+		}
+return node;
+}
+
+const QString
+	&Source;
+int
+	Position;
+const QStringList
+	&Variables;
+const Compiled_Expression::Constants
+	&Constants_Table;
+Compiled_Expression::Constants
+	&Used_Constants;
+};
+
+}
+#endif	//	DOXYGEN_PROCESSING
+
+/*==============================================================================
+	Constructors
+*/
+Compiled_Expression::Compiled_Expression ()
+	:	Root (NULL)
+{}
+
+
+Compiled_Expression::Compiled_Expression
+	(
+	const QString&		expression,
+	const QStringList&	variables,
+	const Constants&	constants
+	)
+	:	Root (NULL)
+{compile (expression, variables, constants);}
+
+
+Compiled_Expression::~Compiled_Expression ()
+{delete Root;}
+
+/*==============================================================================
+	Accessors
+*/
+bool
+Compiled_Expression::compile
+	(
+	const QString&		expression,
+	const QStringList&	variables,
+	const Constants&	constants
+	)
+{
+delete Root;
+Root = NULL;
+Expression = expression;
+Variables = variables;
+Used_Constants.clear ();
+Error.clear ();
+
+//	A trailing statement terminator is allowed.
+QString
+	source (expression.trimmed ());
+while (source.endsWith (';'))
+	{
+	source.chop (1);
+	source = source.trimmed ();
+	}
+if (source.isEmpty ())
+	Error = "empty expression";
+else
+	{
+	Parser
+		parser (source, Variables, constants, Used_Constants);
+	if ((Root = parser.parse ()) &&
+		Root->Boolean)
+		{
+		delete Root;
+		Root = NULL;
+		Error = "boolean expression result";
+		}
+	else
+		Error = parser.Error;
+	if (! Root)
+		Used_Constants.clear ();
+	}
+#if ((DEBUG_SECTION) & DEBUG_COMPILE)
+clog << "    Compiled_Expression::compile: "
+		<< expression.toStdString () << endl;
+if (Root)
+	clog << "    compiled" << endl;
+else
+	clog << "    not compiled - " << Error.toStdString () << endl;
+#endif
+return Root;
+}
+
+/*==============================================================================
+	Evaluation
+*/
+bool
+Compiled_Expression::evaluate
+	(
+	const double* const*	variable_values,
+	double*					results,
+	int						count
+	) const
+{
+if (! Root)
+	return false;
+if (count > 0)
+	Root->evaluate (variable_values, results, count);
+return true;
+}
+
+
+bool
+Compiled_Expression::evaluate
+	(
+	const double*	values,
+	double*			results,
+	int				count
+	) const
+{
+if (Variables.size () > 1)
+	return false;
+return evaluate (&values, results, count);
+}
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
@@ -0,0 +1,229 @@
+/*	Compiled_Expression
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#ifndef HiView_Compiled_Expression_hh
+#define HiView_Compiled_Expression_hh
+
+#include	<QString>
+#include	<QStringList>
+#include	<QHash>
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/**	A <i>Compiled_Expression</i> is an arithmetic expression compiled
+	for evaluation over vectors of variable values.
+
+	The expression syntax is the arithmetic subset of JavaScript that
+	is used for image data functions:
+
+	<ul>
+	<li>Numbers, including exponent notation.
+	<li>Named variables, whose values are provided at evaluation time,
+		and named constants, whose values are provided at compile time.
+	<li>The Math.PI and Math.E constants.
+	<li>The unary +, - and ! operators. Adjacent signs must be
+		separated, as in "- -x"; "--" and "++" are the JavaScript
+		decrement and increment operators, which are not supported.
+	<li>The binary *, /, %, +, - operators.
+	<li>The &lt;, &lt;=, &gt;, &gt;=, ==, !=, ===, !== comparison
+		operators.
+	<li>The &amp;&amp; and || logical operators.
+	<li>The ?: conditional operator.
+	<li>The abs, acos, asin, atan, atan2, ceil, cos, exp, floor, log,
+		max, min, pow, round, sin, sqrt and tan functions, with or
+		without the "Math." prefix.
+	</ul>
+
+	The expression is compiled into a tree of operation nodes. Each node
+	is evaluated over the entire vector of variable values before its
+	parent node uses the results, so the cost of interpreting the tree is
+	paid once per vector rather than once per value.
+
+	An expression that uses any other syntax, an undefined name, or that
+	produces a boolean rather than a numeric result, is not compiled; the
+	{@link error() error} description says why. The caller is expected
+	to fall back to a full script engine for such expressions.
+
+	@version	$Revision: 1.1 $
+*/
+class Compiled_Expression
+{
+public:
+/*==============================================================================
+	Constants
+*/
+//!	Class identification name with source code version and date.
+static const char* const
+	ID;
+
+/*==============================================================================
+	Types
+*/
+//!	Named constant values.
+typedef QHash<QString, double>	Constants;
+
+//	Expression node.
+class Node;
+
+/*==============================================================================
+	Constructors
+*/
+/**	Construct an empty Compiled_Expression.
+
+	The expression is not {@link is_valid() valid} until it is
+	{@link compile(const QString&, const QStringList&, const Constants&)
+	compiled}.
+*/
+Compiled_Expression ();
+
+/**	Construct a Compiled_Expression by compiling an expression.
+
+	@param	expression	The expression source text.
+	@param	variables	A QStringList of variable names.
+	@param	constants	Named constant values.
+	@see	compile(const QString&, const QStringList&, const Constants&)
+*/
+explicit Compiled_Expression (const QString& expression,
+	const QStringList& variables = QStringList (),
+	const Constants& constants = Constants ());
+
+~Compiled_Expression ();
+
+private:
+//	Not copyable.
+Compiled_Expression (const Compiled_Expression&);
+Compiled_Expression& operator= (const Compiled_Expression&);
+
+/*==============================================================================
+	Accessors
+*/
+public:
+
+/**	Compile an expression.
+
+	Any previously compiled expression is discarded.
+
+	@param	expression	The expression source text.
+	@param	variables	A QStringList of variable names. The position of
+		a name in the list is the position of the corresponding values
+		array in the {@link evaluate(const double* const*, double*, int)
+		const variables values} when evaluating the expression.
+	@param	constants	Named constant values. A variable name takes
+		precedence over a constant with the same name.
+	@return	true if the expression was compiled; false otherwise.
+*/
+bool compile (const QString& expression,
+	const QStringList& variables = QStringList (),
+	const Constants& constants = Constants ());
+
+/**	Test if the expression has been compiled.
+
+	@return	true if there is a compiled expression that can be evaluated;
+		false otherwise.
+*/
+inline bool is_valid () const
+	{return Root;}
+
+/**	Get the expression source text.
+
+	@return	The expression source text that was last compiled.
+*/
+inline QString expression () const
+	{return Expression;}
+
+/**	Get the variable names.
+
+	@return	The QStringList of variable names.
+*/
+inline QStringList variables () const
+	{return Variables;}
+
+/**	Get the named constants used by the expression.
+
+	@return	The Constants, with the values they had when the expression
+		was compiled, that the expression refers to.
+*/
+inline Constants constants () const
+	{return Used_Constants;}
+
+/**	Get a description of why the expression could not be compiled.
+
+	@return	The error description. This will be empty if the expression
+		is {@link is_valid() valid}.
+*/
+inline QString error () const
+	{return Error;}
+
+/*==============================================================================
+	Evaluation
+*/
+/**	Evaluate the expression over vectors of variable values.
+
+	@param	variable_values	An array of pointers to variable value
+		arrays, one for each of the {@link variables() variables} in
+		the same order. Each array must have count values.
+	@param	results	A pointer to storage for count expression results.
+	@param	count	The number of values in each variable values array.
+	@return	true if the expression was evaluated; false if the
+		expression is not {@link is_valid() valid}.
+*/
+bool evaluate (const double* const* variable_values,
+	double* results, int count) const;
+
+/**	Evaluate an expression of a single variable over a vector of values.
+
+	@param	values	A pointer to the variable values array.
+	@param	results	A pointer to storage for count expression results.
+	@param	count	The number of values.
+	@return	true if the expression was evaluated; false if the
+		expression is not {@link is_valid() valid} or it has more than
+		one variable.
+	@see	evaluate(const double* const*, double*, int) const
+*/
+bool evaluate (const double* values, double* results, int count) const;
+
+/*==============================================================================
+	Data
+*/
+private:
+
+QString
+	Expression;
+QStringList
+	Variables;
+Constants
+	Used_Constants;
+QString
+	Error;
+
+Node
+	*Root;
+};
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
+#endif
@@ -23,6 +23,8 @@ Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
 
 #include	"Count_Sequence.hh"
 
+#include	<cmath>
+
 
 #if defined (DEBUG_SECTION)
 /*	DEBUG_SECTION controls
@@ -63,7 +65,10 @@ Count_Sequence::Count_Sequence ()
 	:	QwtSeriesData (),
 		Max_Count (0),
 		Base (0.0),
-		Increment (1.0)
+		Increment (1.0),
+		Decimated_Min (0.0),
+		Decimated_Max (0.0),
+		Decimated_Columns (0)
 {
 #if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
 clog << ">>> Count_Sequence @ " << (void*)this << endl
@@ -84,7 +89,10 @@ Count_Sequence::Count_Sequence
 		Data (count_sequence.Data),
 		Max_Count (count_sequence.Max_Count),
 		Base (base),
-		Increment (increment)
+		Increment (increment),
+		Decimated_Min (0.0),
+		Decimated_Max (0.0),
+		Decimated_Columns (0)
 {}
 
 
@@ -97,7 +105,10 @@ Count_Sequence::Count_Sequence
 		Data (),
 		Max_Count (0),
 		Base (base),
-		Increment (increment)
+		Increment (increment),
+		Decimated_Min (0.0),
+		Decimated_Max (0.0),
+		Decimated_Columns (0)
 {data (data_values.data (), data_values.size ());}
 
 
@@ -111,7 +122,10 @@ Count_Sequence::Count_Sequence
 		Data (),
 		Max_Count (0),
 		Base (base),
-		Increment (increment)
+		Increment (increment),
+		Decimated_Min (0.0),
+		Decimated_Max (0.0),
+		Decimated_Columns (0)
 {data (data_values, size);}
 
 
@@ -203,6 +217,7 @@ Count_Sequence::data
 {
 Data.clear ();
 Max_Count = 0;
+Decimated_Columns = 0;
 if (size)
 	{
 	Data.reserve (size);
@@ -227,6 +242,7 @@ if (amount <= 0)
 	{
 	Data.clear ();
 	Max_Count = 0;
+	Decimated_Columns = 0;
 	}
 else
 if (Data.size () != amount)
@@ -278,6 +294,110 @@ return QRectF
 
 unsigned long long
 Count_Sequence::calculate_max_count ()
-{return (Max_Count = max_count_value (Data));}
+{
+Decimated_Columns = 0;
+return (Max_Count = max_count_value (Data));
+}
+
+
+const QVector<QPointF>&
+Count_Sequence::decimated
+	(
+	double	x_min,
+	double	x_max,
+	int		columns
+	) const
+{
+if (x_max < x_min)
+	qSwap (x_min, x_max);
+if (columns <= 0)
+	{
+	Decimated.clear ();
+	Decimated_Columns = 0;
+	return Decimated;
+	}
+if (Decimated_Columns == columns &&
+	Decimated_Min == x_min &&
+	Decimated_Max == x_max)
+	return Decimated;
+
+#if ((DEBUG_SECTION) & DEBUG_HELPERS)
+clog << ">>> Count_Sequence::decimated: "
+		<< x_min << " to " << x_max << ", " << columns << " columns" << endl;
+#endif
+Decimated.clear ();
+Decimated_Min = x_min;
+Decimated_Max = x_max;
+Decimated_Columns = columns;
+
+int
+	first = 0,
+	last = Data.size () - 1;
+if (last < 0 ||
+	Increment == 0.0)
+	return Decimated;
+
+//	Data content index range that covers the interval.
+double
+	first_index = (x_min - Base) / Increment,
+	last_index  = (x_max - Base) / Increment;
+if (last_index < first_index)
+	qSwap (first_index, last_index);
+if (first_index > first)
+	first = (int)qMin (std::floor (first_index), (double)last + 1);
+if (last_index < last)
+	last = (int)qMax (std::floor (last_index), (double)first - 1);
+int
+	amount = last - first + 1;
+if (amount <= 0)
+	return Decimated;
+
+if (amount <= (columns << 1))
+	{
+	//	No decimation needed.
+	Decimated.reserve (amount);
+	for (int
+			index = first;
+			index <= last;
+			index++)
+		Decimated.append (QPointF (x (index), Data.at (index)));
+	}
+else
+	{
+	Decimated.reserve (columns << 1);
+	int
+		end = first,
+		index,
+		min_index,
+		max_index;
+	for (int
+			column = 1;
+			column <= columns;
+			column++)
+		{
+		index = end;
+		end = first + (int)(((long long)amount * column) / columns);
+		min_index = max_index = index;
+		while (++index < end)
+			{
+			if (Data.at (index) < Data.at (min_index))
+				min_index = index;
+			else
+			if (Data.at (index) > Data.at (max_index))
+				max_index = index;
+			}
+		if (max_index < min_index)
+			qSwap (min_index, max_index);
+		Decimated.append (QPointF (x (min_index), Data.at (min_index)));
+		if (max_index != min_index)
+			Decimated.append (QPointF (x (max_index), Data.at (max_index)));
+		}
+	}
+#if ((DEBUG_SECTION) & DEBUG_HELPERS)
+clog << "<<< Count_Sequence::decimated: " << amount << " values to "
+		<< Decimated.size () << " samples" << endl;
+#endif
+return Decimated;
+}
 
 }	//	namespace UA::HiRISE
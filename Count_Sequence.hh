@@ -181,7 +181,7 @@ void size (int amount);
 	@see	x()
 */
 inline Count_Sequence& base (double base_value)
-	{Base = base_value; return *this;}
+	{Base = base_value; Decimated_Columns = 0; return *this;}
 
 /**	Gets the Count_Sequence base value.
 
@@ -201,7 +201,7 @@ inline double base () const
 	@see	x()
 */
 inline Count_Sequence& increment (double increment_amount)
-	{Increment = increment_amount; return *this;}
+	{Increment = increment_amount; Decimated_Columns = 0; return *this;}
 
 /**	Gets the Count_Sequence increment amount.
 
@@ -222,12 +222,41 @@ inline unsigned long long max_count () const
 /**	Recalculates the {@link max_count() maximum data content value}.
 
 	The {@link max_count() maximum data content value} is updated
-	and returned.
+	and returned. Any cached {@link decimated(double, double, int)
+	decimated samples} are discarded.
 
 	@return	The maximum data content value.
 */
 unsigned long long calculate_max_count ();
 
+/**	Gets a level of detail decimation of the data content.
+
+	The data content within an x value interval is reduced to no more
+	than two samples for each of a number of columns; typically the
+	columns are the pixels of a plot canvas across the interval. Each
+	column is represented by the samples of its minimum and maximum
+	data values, in data content order, so the extreme values that
+	determine the plotted shape of the data are preserved. When there
+	are no more than two data values per column every data value in
+	the interval is sampled.
+
+	The decimated samples are cached until the interval or number of
+	columns changes, or the data content, {@link base(double) base} or
+	{@link increment(double) increment} is changed. <b>N.B.</b>: If the
+	{@link data() data content} is modified externally the {@link
+	calculate_max_count() max count value} must be recalculated for the
+	decimated samples to be updated.
+
+	@param	x_min	One end of the x value interval.
+	@param	x_max	The other end of the x value interval.
+	@param	columns	The number of columns across the interval.
+	@return	A QVector of decimated samples, ordered by data content
+		index. This will be empty if there is no data content in the
+		interval or the number of columns is not positive.
+*/
+const QVector<QPointF>& decimated (double x_min, double x_max, int columns)
+	const;
+
 /*==============================================================================
 	QwtData virtual methods implementations
 */
@@ -299,6 +328,15 @@ double
 	Base,
 	Increment;
 
+//	Decimated samples cache.
+mutable QVector<QPointF>
+	Decimated;
+mutable double
+	Decimated_Min,
+	Decimated_Max;
+//	Zero when the cache is invalid.
+mutable int
+	Decimated_Columns;
 };
 
 }	//	namespace UA::HiRISE
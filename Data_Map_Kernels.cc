@@ -0,0 +1,709 @@
+/*	Data_Map_Kernels
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#include	"Data_Map_Kernels.hh"
+
+/*	SIMD kernel selection.
+
+	The SIMD kernels are only available for x86 hosts. The AVX2 kernels
+	are compiled with a function target attribute (GCC and Clang) so the
+	rest of the application need not be compiled for AVX2; they are only
+	used when the host CPU is found to support AVX2 at run time.
+*/
+#if ! defined (DATA_MAP_KERNELS_SCALAR) && \
+	(defined (__x86_64__) || defined (_M_X64) || \
+	 defined (__i386__)   || defined (_M_IX86))
+#define DATA_MAP_KERNELS_X86
+
+#include	<immintrin.h>
+#if defined (_MSC_VER)
+#include	<intrin.h>
+#define TARGET_SSE2
+#define TARGET_AVX2
+#else
+#define TARGET_SSE2		__attribute__ ((target ("sse2")))
+#define TARGET_AVX2		__attribute__ ((target ("avx2")))
+#endif
+#endif
+
+
+#if defined (DEBUG_SECTION)
+/*	DEBUG_SECTION controls
+
+	DEBUG_SECTION report selection options.
+	Define any of the following options to obtain the desired debug reports:
+*/
+#define DEBUG_OFF			0
+#define DEBUG_ALL			-1
+#define DEBUG_DISPATCH		(1 << 0)
+
+#define DEBUG_DEFAULT		DEBUG_ALL
+
+#if (DEBUG_SECTION +0) == 0
+#undef  DEBUG_SECTION
+#define DEBUG_SECTION DEBUG_OFF
+#endif
+
+#include	<iostream>
+using std::clog;
+using std::endl;
+#endif	//	DEBUG_SECTION
+
+
+namespace UA::HiRISE
+{
+namespace
+{
+/*==============================================================================
+	Scalar kernels
+*/
+template<typename Source_Type>
+void
+map_data_values_scalar
+	(
+	const Source_Type*	source,
+	quint8*				display_band,
+	unsigned int		count,
+	const quint8*		data_map,
+	unsigned int		data_map_size,
+	quint8				background
+	)
+{
+const Source_Type
+	*end_source = source + count;
+while (source < end_source)
+	{
+	*display_band++ = (static_cast<quint32>(*source) < data_map_size) ?
+		data_map[*source] : background;
+	++source;
+	}
+}
+
+
+void
+pack_display_pixels_scalar
+	(
+	QRgb*			display_data,
+	const quint8*	red,
+	const quint8*	green,
+	const quint8*	blue,
+	unsigned int	count
+	)
+{
+const QRgb
+	*end_data = display_data + count;
+while (display_data < end_data)
+	*display_data++ =
+		0xFF000000 |
+		(static_cast<QRgb>(*red++)   << 16) |
+		(static_cast<QRgb>(*green++) << 8) |
+		 static_cast<QRgb>(*blue++);
+}
+
+
+template<typename Source_Type>
+void
+accumulate_values_scalar
+	(
+	const Source_Type*	source,
+	quint32*			sums,
+	unsigned int		count
+	)
+{
+const Source_Type
+	*end_source = source + count;
+while (source < end_source)
+	*sums++ += *source++;
+}
+
+#ifdef DATA_MAP_KERNELS_X86
+/*==============================================================================
+	SSE2 kernels
+
+	SSE2 has no gather instruction so the data map lookup is done by the
+	scalar kernels at this level.
+*/
+TARGET_SSE2
+void
+pack_display_pixels_SSE2
+	(
+	QRgb*			display_data,
+	const quint8*	red,
+	const quint8*	green,
+	const quint8*	blue,
+	unsigned int	count
+	)
+{
+const __m128i
+	alpha = _mm_set1_epi8 (static_cast<char>(0xFF));
+__m128i
+	r, g, b,
+	bg, ra;
+unsigned int
+	index = 0;
+for (;
+	 (index + 16) <= count;
+	 index += 16)
+	{
+	r = _mm_loadu_si128 (reinterpret_cast<const __m128i*>(red   + index));
+	g = _mm_loadu_si128 (reinterpret_cast<const __m128i*>(green + index));
+	b = _mm_loadu_si128 (reinterpret_cast<const __m128i*>(blue  + index));
+
+	//	Little-endian QRgb memory order is B, G, R, A.
+	bg = _mm_unpacklo_epi8 (b, g);
+	ra = _mm_unpacklo_epi8 (r, alpha);
+	_mm_storeu_si128 (reinterpret_cast<__m128i*>(display_data + index),
+		_mm_unpacklo_epi16 (bg, ra));
+	_mm_storeu_si128 (reinterpret_cast<__m128i*>(display_data + index + 4),
+		_mm_unpackhi_epi16 (bg, ra));
+	bg = _mm_unpackhi_epi8 (b, g);
+	ra = _mm_unpackhi_epi8 (r, alpha);
+	_mm_storeu_si128 (reinterpret_cast<__m128i*>(display_data + index + 8),
+		_mm_unpacklo_epi16 (bg, ra));
+	_mm_storeu_si128 (reinterpret_cast<__m128i*>(display_data + index + 12),
+		_mm_unpackhi_epi16 (bg, ra));
+	}
+if (index < count)
+	pack_display_pixels_scalar (display_data + index,
+		red + index, green + index, blue + index, count - index);
+}
+
+
+TARGET_SSE2
+void
+accumulate_values_SSE2
+	(
+	const quint8*	source,
+	quint32*		sums,
+	unsigned int	count
+	)
+{
+const __m128i
+	zero = _mm_setzero_si128 ();
+__m128i
+	values,
+	words;
+__m128i
+	*sum;
+unsigned int
+	index = 0;
+for (;
+	 (index + 16) <= count;
+	 index += 16)
+	{
+	values = _mm_loadu_si128 (reinterpret_cast<const __m128i*>(source + index));
+	sum = reinterpret_cast<__m128i*>(sums + index);
+
+	words = _mm_unpacklo_epi8 (values, zero);
+	_mm_storeu_si128 (sum,     _mm_add_epi32 (_mm_loadu_si128 (sum),
+		_mm_unpacklo_epi16 (words, zero)));
+	_mm_storeu_si128 (sum + 1, _mm_add_epi32 (_mm_loadu_si128 (sum + 1),
+		_mm_unpackhi_epi16 (words, zero)));
+	words = _mm_unpackhi_epi8 (values, zero);
+	_mm_storeu_si128 (sum + 2, _mm_add_epi32 (_mm_loadu_si128 (sum + 2),
+		_mm_unpacklo_epi16 (words, zero)));
+	_mm_storeu_si128 (sum + 3, _mm_add_epi32 (_mm_loadu_si128 (sum + 3),
+		_mm_unpackhi_epi16 (words, zero)));
+	}
+if (index < count)
+	accumulate_values_scalar (source + index, sums + index, count - index);
+}
+
+
+TARGET_SSE2
+void
+accumulate_values_SSE2
+	(
+	const quint16*	source,
+	quint32*		sums,
+	unsigned int	count
+	)
+{
+const __m128i
+	zero = _mm_setzero_si128 ();
+__m128i
+	values;
+__m128i
+	*sum;
+unsigned int
+	index = 0;
+for (;
+	 (index + 8) <= count;
+	 index += 8)
+	{
+	values = _mm_loadu_si128 (reinterpret_cast<const __m128i*>(source + index));
+	sum = reinterpret_cast<__m128i*>(sums + index);
+	_mm_storeu_si128 (sum,     _mm_add_epi32 (_mm_loadu_si128 (sum),
+		_mm_unpacklo_epi16 (values, zero)));
+	_mm_storeu_si128 (sum + 1, _mm_add_epi32 (_mm_loadu_si128 (sum + 1),
+		_mm_unpackhi_epi16 (values, zero)));
+	}
+if (index < count)
+	accumulate_values_scalar (source + index, sums + index, count - index);
+}
+
+
+TARGET_SSE2
+void
+accumulate_values_SSE2
+	(
+	const quint32*	source,
+	quint32*		sums,
+	unsigned int	count
+	)
+{
+__m128i
+	*sum;
+unsigned int
+	index = 0;
+for (;
+	 (index + 4) <= count;
+	 index += 4)
+	{
+	sum = reinterpret_cast<__m128i*>(sums + index);
+	_mm_storeu_si128 (sum, _mm_add_epi32 (_mm_loadu_si128 (sum),
+		_mm_loadu_si128 (reinterpret_cast<const __m128i*>(source + index))));
+	}
+if (index < count)
+	accumulate_values_scalar (source + index, sums + index, count - index);
+}
+
+/*==============================================================================
+	AVX2 kernels
+*/
+/*	Map eight source values, widened to 32-bit lanes, to display values.
+
+	The data map entries are gathered as the 32-bit words containing the
+	indexed byte and then shifted into place. The gather is masked by
+	the valid entry condition so only words within the data map are read;
+	the data map size must be a multiple of four bytes to ensure that the
+	word containing the last valid entry is entirely within the map.
+*/
+TARGET_AVX2
+inline void
+map_8_values_AVX2
+	(
+	__m256i			values,
+	quint8*			display_band,
+	const quint8*	data_map,
+	__m256i			limit,
+	__m256i			background
+	)
+{
+const __m256i
+	sign_bit    = _mm256_set1_epi32 (static_cast<int>(0x80000000)),
+	word_mask   = _mm256_set1_epi32 (~3),
+	offset_mask = _mm256_set1_epi32 (3),
+	byte_mask   = _mm256_set1_epi32 (0xFF),
+	low_bytes   = _mm256_setr_epi8
+		(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		 0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1),
+	lane_words  = _mm256_setr_epi32 (0, 4, 0, 0, 0, 0, 0, 0);
+
+//	Unsigned values < limit.
+__m256i
+	valid = _mm256_cmpgt_epi32
+		(limit, _mm256_xor_si256 (values, sign_bit)),
+	words = _mm256_mask_i32gather_epi32
+		(_mm256_setzero_si256 (),
+		reinterpret_cast<const int*>(data_map),
+		_mm256_and_si256 (values, word_mask),
+		valid, 1),
+	mapped = _mm256_and_si256
+		(_mm256_srlv_epi32 (words,
+			_mm256_slli_epi32 (_mm256_and_si256 (values, offset_mask), 3)),
+		byte_mask);
+mapped = _mm256_blendv_epi8 (background, mapped, valid);
+
+//	Narrow the eight 32-bit lanes to eight contiguous bytes.
+mapped = _mm256_shuffle_epi8 (mapped, low_bytes);
+mapped = _mm256_permutevar8x32_epi32 (mapped, lane_words);
+_mm_storel_epi64 (reinterpret_cast<__m128i*>(display_band),
+	_mm256_castsi256_si128 (mapped));
+}
+
+
+TARGET_AVX2
+void
+map_data_values_AVX2
+	(
+	const quint8*	source,
+	quint8*			display_band,
+	unsigned int	count,
+	const quint8*	data_map,
+	unsigned int	data_map_size,
+	quint8			background
+	)
+{
+const __m256i
+	limit = _mm256_set1_epi32
+		(static_cast<int>(data_map_size ^ 0x80000000)),
+	fill  = _mm256_set1_epi32 (background);
+unsigned int
+	index = 0;
+if ((data_map_size & 3) == 0)
+	{
+	for (;
+		 (index + 8) <= count;
+		 index += 8)
+		map_8_values_AVX2 (_mm256_cvtepu8_epi32 (_mm_loadl_epi64
+				(reinterpret_cast<const __m128i*>(source + index))),
+			display_band + index, data_map, limit, fill);
+	}
+if (index < count)
+	map_data_values_scalar (source + index, display_band + index,
+		count - index, data_map, data_map_size, background);
+}
+
+
+TARGET_AVX2
+void
+map_data_values_AVX2
+	(
+	const quint16*	source,
+	quint8*			display_band,
+	unsigned int	count,
+	const quint8*	data_map,
+	unsigned int	data_map_size,
+	quint8			background
+	)
+{
+const __m256i
+	limit = _mm256_set1_epi32
+		(static_cast<int>(data_map_size ^ 0x80000000)),
+	fill  = _mm256_set1_epi32 (background);
+unsigned int
+	index = 0;
+if ((data_map_size & 3) == 0)
+	{
+	for (;
+		 (index + 8) <= count;
+		 index += 8)
+		map_8_values_AVX2 (_mm256_cvtepu16_epi32 (_mm_loadu_si128
+				(reinterpret_cast<const __m128i*>(source + index))),
+			display_band + index, data_map, limit, fill);
+	}
+if (index < count)
+	map_data_values_scalar (source + index, display_band + index,
+		count - index, data_map, data_map_size, background);
+}
+
+
+TARGET_AVX2
+void
+map_data_values_AVX2
+	(
+	const quint32*	source,
+	quint8*			display_band,
+	unsigned int	count,
+	const quint8*	data_map,
+	unsigned int	data_map_size,
+	quint8			background
+	)
+{
+const __m256i
+	limit = _mm256_set1_epi32
+		(static_cast<int>(data_map_size ^ 0x80000000)),
+	fill  = _mm256_set1_epi32 (background);
+unsigned int
+	index = 0;
+if ((data_map_size & 3) == 0)
+	{
+	for (;
+		 (index + 8) <= count;
+		 index += 8)
+		map_8_values_AVX2 (_mm256_loadu_si256
+				(reinterpret_cast<const __m256i*>(source + index)),
+			display_band + index, data_map, limit, fill);
+	}
+if (index < count)
+	map_data_values_scalar (source + index, display_band + index,
+		count - index, data_map, data_map_size, background);
+}
+
+
+TARGET_AVX2
+void
+pack_display_pixels_AVX2
+	(
+	QRgb*			display_data,
+	const quint8*	red,
+	const quint8*	green,
+	const quint8*	blue,
+	unsigned int	count
+	)
+{
+const __m256i
+	alpha = _mm256_set1_epi8 (static_cast<char>(0xFF));
+__m256i
+	r, g, b,
+	bg, ra,
+	pixels_0, pixels_1, pixels_2, pixels_3;
+unsigned int
+	index = 0;
+for (;
+	 (index + 32) <= count;
+	 index += 32)
+	{
+	r = _mm256_loadu_si256 (reinterpret_cast<const __m256i*>(red   + index));
+	g = _mm256_loadu_si256 (reinterpret_cast<const __m256i*>(green + index));
+	b = _mm256_loadu_si256 (reinterpret_cast<const __m256i*>(blue  + index));
+
+	/*	The unpack instructions operate within each 128-bit lane, so
+		each result holds four pixels from the low lane (pixels 0-15)
+		and four from the high lane (pixels 16-31).
+	*/
+	bg = _mm256_unpacklo_epi8 (b, g);
+	ra = _mm256_unpacklo_epi8 (r, alpha);
+	pixels_0 = _mm256_unpacklo_epi16 (bg, ra);	//	0-3, 16-19
+	pixels_1 = _mm256_unpackhi_epi16 (bg, ra);	//	4-7, 20-23
+	bg = _mm256_unpackhi_epi8 (b, g);
+	ra = _mm256_unpackhi_epi8 (r, alpha);
+	pixels_2 = _mm256_unpacklo_epi16 (bg, ra);	//	8-11, 24-27
+	pixels_3 = _mm256_unpackhi_epi16 (bg, ra);	//	12-15, 28-31
+
+	_mm256_storeu_si256 (reinterpret_cast<__m256i*>(display_data + index),
+		_mm256_permute2x128_si256 (pixels_0, pixels_1, 0x20));
+	_mm256_storeu_si256 (reinterpret_cast<__m256i*>(display_data + index + 8),
+		_mm256_permute2x128_si256 (pixels_2, pixels_3, 0x20));
+	_mm256_storeu_si256 (reinterpret_cast<__m256i*>(display_data + index + 16),
+		_mm256_permute2x128_si256 (pixels_0, pixels_1, 0x31));
+	_mm256_storeu_si256 (reinterpret_cast<__m256i*>(display_data + index + 24),
+		_mm256_permute2x128_si256 (pixels_2, pixels_3, 0x31));
+	}
+if (index < count)
+	pack_display_pixels_SSE2 (display_data + index,
+		red + index, green + index, blue + index, count - index);
+}
+
+/*==============================================================================
+	CPU capabilities
+*/
+SIMD_Level
+host_SIMD_level ()
+{
+SIMD_Level
+	level = SIMD_SCALAR;
+#if defined (_MSC_VER)
+int
+	registers[4];
+__cpuid (registers, 0);
+int
+	maximum_function = registers[0];
+__cpuid (registers, 1);
+if (registers[3] & (1 << 26))
+	level = SIMD_SSE2;
+//	OSXSAVE and AVX, with the OS saving the YMM registers.
+if ((registers[2] & (1 << 27)) &&
+	(registers[2] & (1 << 28)) &&
+	(_xgetbv (0) & 0x6) == 0x6 &&
+	maximum_function >= 7)
+	{
+	__cpuidex (registers, 7, 0);
+	if (registers[1] & (1 << 5))
+		level = SIMD_AVX2;
+	}
+#else
+__builtin_cpu_init ();
+if (__builtin_cpu_supports ("sse2"))
+	level = SIMD_SSE2;
+if (__builtin_cpu_supports ("avx2"))
+	level = SIMD_AVX2;
+#endif
+return level;
+}
+#endif	//	DATA_MAP_KERNELS_X86
+
+/*==============================================================================
+	Kernel dispatch
+*/
+struct Data_Map_Kernels
+{
+SIMD_Level
+	Level;
+
+void (*Map_8)  (const quint8*, quint8*,
+	unsigned int, const quint8*, unsigned int, quint8);
+void (*Map_16) (const quint16*, quint8*,
+	unsigned int, const quint8*, unsigned int, quint8);
+void (*Map_32) (const quint32*, quint8*,
+	unsigned int, const quint8*, unsigned int, quint8);
+void (*Pack)   (QRgb*, const quint8*, const quint8*, const quint8*,
+	unsigned int);
+void (*Accumulate_8)  (const quint8*,  quint32*, unsigned int);
+void (*Accumulate_16) (const quint16*, quint32*, unsigned int);
+void (*Accumulate_32) (const quint32*, quint32*, unsigned int);
+
+Data_Map_Kernels ()
+	:	Level  (SIMD_SCALAR),
+		Map_8  (map_data_values_scalar<quint8>),
+		Map_16 (map_data_values_scalar<quint16>),
+		Map_32 (map_data_values_scalar<quint32>),
+		Pack   (pack_display_pixels_scalar),
+		Accumulate_8  (accumulate_values_scalar<quint8>),
+		Accumulate_16 (accumulate_values_scalar<quint16>),
+		Accumulate_32 (accumulate_values_scalar<quint32>)
+{
+#ifdef DATA_MAP_KERNELS_X86
+Level = host_SIMD_level ();
+if (Level >= SIMD_SSE2)
+	{
+	Pack = pack_display_pixels_SSE2;
+	Accumulate_8  = accumulate_values_SSE2;
+	Accumulate_16 = accumulate_values_SSE2;
+	Accumulate_32 = accumulate_values_SSE2;
+	}
+if (Level >= SIMD_AVX2)
+	{
+	Map_8  = map_data_values_AVX2;
+	Map_16 = map_data_values_AVX2;
+	Map_32 = map_data_values_AVX2;
+	Pack   = pack_display_pixels_AVX2;
+	}
+#endif
+#if ((DEBUG_SECTION) & DEBUG_DISPATCH)
+clog << ">-< Data_Map_Kernels: " << SIMD_level_name (Level) << endl;
+#endif
+}
+};
+
+
+//	Thread safe, first use, initialization.
+inline const Data_Map_Kernels&
+kernels ()
+{
+static const Data_Map_Kernels
+	selected_kernels;
+return selected_kernels;
+}
+
+}	//	local namespace
+
+/*==============================================================================
+	Functions
+*/
+SIMD_Level
+data_map_kernels_level ()
+{return kernels ().Level;}
+
+
+const char*
+SIMD_level_name
+	(
+	SIMD_Level	level
+	)
+{
+switch (level)
+	{
+	case SIMD_AVX2:	return "AVX2";
+	case SIMD_SSE2:	return "SSE2";
+	default:		return "scalar";
+	}
+}
+
+
+void
+map_data_values
+	(
+	const quint8*	source,
+	quint8*			display_band,
+	unsigned int	count,
+	const quint8*	data_map,
+	unsigned int	data_map_size,
+	quint8			background
+	)
+{kernels ().Map_8
+	(source, display_band, count, data_map, data_map_size, background);}
+
+
+void
+map_data_values
+	(
+	const quint16*	source,
+	quint8*			display_band,
+	unsigned int	count,
+	const quint8*	data_map,
+	unsigned int	data_map_size,
+	quint8			background
+	)
+{kernels ().Map_16
+	(source, display_band, count, data_map, data_map_size, background);}
+
+
+void
+map_data_values
+	(
+	const quint32*	source,
+	quint8*			display_band,
+	unsigned int	count,
+	const quint8*	data_map,
+	unsigned int	data_map_size,
+	quint8			background
+	)
+{kernels ().Map_32
+	(source, display_band, count, data_map, data_map_size, background);}
+
+
+void
+pack_display_pixels
+	(
+	QRgb*			display_data,
+	const quint8*	red,
+	const quint8*	green,
+	const quint8*	blue,
+	unsigned int	count
+	)
+{kernels ().Pack (display_data, red, green, blue, count);}
+
+
+void
+accumulate_values
+	(
+	const quint8*	source,
+	quint32*		sums,
+	unsigned int	count
+	)
+{kernels ().Accumulate_8 (source, sums, count);}
+
+
+void
+accumulate_values
+	(
+	const quint16*	source,
+	quint32*		sums,
+	unsigned int	count
+	)
+{kernels ().Accumulate_16 (source, sums, count);}
+
+
+void
+accumulate_values
+	(
+	const quint32*	source,
+	quint32*		sums,
+	unsigned int	count
+	)
+{kernels ().Accumulate_32 (source, sums, count);}
+
+
+}	//	namespace UA::HiRISE
@@ -0,0 +1,134 @@
+/*	Data_Map_Kernels
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#ifndef HiView_Data_Map_Kernels_hh
+#define HiView_Data_Map_Kernels_hh
+
+#include	<QtGlobal>
+#include	<QRgb>
+
+
+namespace UA::HiRISE
+{
+/*==============================================================================
+	Data map kernels
+
+	The display mapping stage of image rendering maps each source image
+	pixel datum through the Data_Map LUT of its display band and then
+	merges the three mapped display band values into a QRgb display
+	image pixel. These functions do this work a line of pixels at a time
+	using the best instruction set available on the host CPU - AVX2 or
+	SSE2 - as determined at run time; a scalar implementation is always
+	available as the fallback.
+*/
+
+/**	The SIMD instruction set level used by the data map kernels.
+*/
+enum SIMD_Level
+	{
+	SIMD_SCALAR,
+	SIMD_SSE2,
+	SIMD_AVX2
+	};
+
+/**	Get the SIMD instruction set level used by the data map kernels.
+
+	The level is determined, from the host CPU capabilities, the first
+	time it is needed. If the DATA_MAP_KERNELS_SCALAR macro was defined
+	when the kernels were compiled the level is always SIMD_SCALAR.
+
+	@return	The SIMD_Level in use.
+*/
+SIMD_Level data_map_kernels_level ();
+
+/**	Get a brief description of a SIMD_Level.
+
+	@param	level	A SIMD_Level.
+	@return	A description string.
+*/
+const char* SIMD_level_name (SIMD_Level level);
+
+/**	Map a line of source data values through a data map.
+
+	Each source value less than the data map size is replaced with the
+	data map entry it indexes; any other source value - including the
+	Plastic_Image::UNDEFINED_PIXEL_VALUE - is replaced with the
+	background value.
+
+	@param	source	A pointer to the source data values.
+	@param	display_band	A pointer to the storage for the mapped
+		display band values.
+	@param	count	The number of values to map.
+	@param	data_map	A pointer to the data map LUT entries.
+	@param	data_map_size	The number of data map entries that may be
+		used.
+	@param	background	The display band value for unmapped data.
+*/
+void map_data_values (const quint8* source, quint8* display_band,
+	unsigned int count, const quint8* data_map, unsigned int data_map_size,
+	quint8 background);
+
+void map_data_values (const quint16* source, quint8* display_band,
+	unsigned int count, const quint8* data_map, unsigned int data_map_size,
+	quint8 background);
+
+void map_data_values (const quint32* source, quint8* display_band,
+	unsigned int count, const quint8* data_map, unsigned int data_map_size,
+	quint8 background);
+
+/**	Pack lines of display band values into display image pixels.
+
+	The red, green and blue display band values are interleaved into
+	opaque (0xFF alpha) QRgb values.
+
+	@param	display_data	A pointer to the QRgb display image pixels
+		to be set.
+	@param	red	A pointer to the red display band values.
+	@param	green	A pointer to the green display band values.
+	@param	blue	A pointer to the blue display band values.
+	@param	count	The number of display pixels to set.
+*/
+void pack_display_pixels (QRgb* display_data,
+	const quint8* red, const quint8* green, const quint8* blue,
+	unsigned int count);
+
+/**	Accumulate a line of source data values.
+
+	Each source value is added to the corresponding sum. This is the
+	vertical pass of the box filter used to render scaled down images.
+
+	@param	source	A pointer to the source data values.
+	@param	sums	A pointer to the sums to which the source values are
+		added.
+	@param	count	The number of values to accumulate.
+*/
+void accumulate_values (const quint8* source, quint32* sums,
+	unsigned int count);
+void accumulate_values (const quint16* source, quint32* sums,
+	unsigned int count);
+void accumulate_values (const quint32* source, quint32* sums,
+	unsigned int count);
+
+
+}	//	namespace UA::HiRISE
+#endif
@@ -0,0 +1,694 @@
+/*	Decoded_Data_Cache
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#include	"Decoded_Data_Cache.hh"
+
+#include	<QDir>
+#include	<QFile>
+#include	<QFileInfo>
+#include	<QCryptographicHash>
+#include	<QMutexLocker>
+#include	<QThreadPool>
+#include	<QRunnable>
+#include	<QVector>
+#include	<QPair>
+
+#include	<cstring>
+#include	<algorithm>
+
+
+#if defined (DEBUG_SECTION)
+/*******************************************************************************
+	DEBUG_SECTION controls
+
+	DEBUG_SECTION report selection options.
+	Define any of the following options to obtain the desired debug reports:
+*/
+#define DEBUG_OFF			0
+#define DEBUG_ALL			-1
+#define DEBUG_FETCH			(1 << 0)
+#define DEBUG_INSERT		(1 << 1)
+#define DEBUG_SPILL			(1 << 2)
+
+#define DEBUG_DEFAULT		DEBUG_ALL
+
+#if (DEBUG_SECTION+0) == 0
+#undef  DEBUG_SECTION
+#define DEBUG_SECTION DEBUG_OFF
+#else
+#include	<iostream>
+using std::clog;
+using std::endl;
+#endif
+
+#endif	//	DEBUG_SECTION
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/*==============================================================================
+	Constants
+*/
+const char* const
+	Decoded_Data_Cache::ID =
+		"UA::HiRISE::Decoded_Data_Cache ($Revision: 1.1 $ $Date: 2026/10/17 00:00:00 $)";
+
+#ifndef DEFAULT_DECODED_DATA_CACHE_SIZE
+#define DEFAULT_DECODED_DATA_CACHE_SIZE			256
+#endif
+const qint64
+	Decoded_Data_Cache::DEFAULT_MAX_SIZE =
+		(qint64)DEFAULT_DECODED_DATA_CACHE_SIZE << 20;
+
+#ifndef DEFAULT_DECODED_DATA_SPILL_SIZE
+#define DEFAULT_DECODED_DATA_SPILL_SIZE			4096
+#endif
+const qint64
+	Decoded_Data_Cache::DEFAULT_MAX_SPILL_SIZE =
+		(qint64)DEFAULT_DECODED_DATA_SPILL_SIZE << 20;
+
+const char* const
+	Decoded_Data_Cache::SPILL_FILE_EXTENSION	= ".decoded";
+
+/*==============================================================================
+	Spiller
+*/
+#ifndef	DOXYGEN_PROCESSING
+//	Writes the spill queue of a Decoded_Data_Cache on a pool thread.
+class Decoded_Data_Spiller
+:	public QRunnable
+{
+public:
+
+explicit Decoded_Data_Spiller (Decoded_Data_Cache* cache)
+	:	Cache (cache)
+{}
+
+void run ()
+{Cache->spill ();}
+
+private:
+
+Decoded_Data_Cache
+	*Cache;
+};
+#endif
+
+/*==============================================================================
+	Constructors
+*/
+Decoded_Data_Cache::Decoded_Data_Cache
+	(
+	qint64			max_size,
+	const QString&	spill_directory
+	)
+	:	Max_Size (qMax (max_size, (qint64)0)),
+		Size (0),
+		Spill_Use (0),
+		Max_Spill_Size (DEFAULT_MAX_SPILL_SIZE),
+		Spilled_Size (0),
+		Spilling (false)
+{
+if (! spill_directory.isEmpty ())
+	Decoded_Data_Cache::spill_directory (spill_directory);
+}
+
+
+Decoded_Data_Cache::~Decoded_Data_Cache ()
+{
+QMutexLocker
+	lock (&Lock);
+while (Spilling)
+	Spilling_Done.wait (&Lock);
+}
+
+/*==============================================================================
+	Accessors
+*/
+void
+Decoded_Data_Cache::max_size
+	(
+	qint64	size
+	)
+{
+if (size < 0)
+	size = 0;
+QMutexLocker
+	lock (&Lock);
+Max_Size = size;
+if (! Max_Size)
+	{
+	//	Disabled.
+	Blocks.clear ();
+	Block_Use.clear ();
+	Size = 0;
+	Spill_Queue.clear ();
+	}
+else
+	{
+	discard ();
+	start_spilling ();
+	}
+}
+
+
+qint64
+Decoded_Data_Cache::max_size () const
+{
+QMutexLocker
+	lock (&Lock);
+return Max_Size;
+}
+
+
+qint64
+Decoded_Data_Cache::size () const
+{
+QMutexLocker
+	lock (&Lock);
+return Size;
+}
+
+
+bool
+Decoded_Data_Cache::spill_directory
+	(
+	const QString&	pathname
+	)
+{
+QMutexLocker
+	lock (&Lock);
+//	Blocks queued for the current directory are dropped.
+Spill_Queue.clear ();
+while (Spilling)
+	Spilling_Done.wait (&Lock);
+Spill_Directory.clear ();
+Spill_Files.clear ();
+Spilled_Size = 0;
+if (pathname.isEmpty ())
+	return true;
+
+QDir
+	directory (pathname);
+if (! directory.exists () &&
+	! directory.mkpath ("."))
+	return false;
+QFileInfo
+	info (directory.absolutePath ());
+if (! info.isDir () ||
+	! info.isWritable ())
+	return false;
+
+Spill_Directory = info.absoluteFilePath ();
+//	Oldest files first; they are the least recently used.
+QFileInfoList
+	files (directory.entryInfoList
+		(QStringList (QString ("*") + SPILL_FILE_EXTENSION), QDir::Files,
+		QDir::Time | QDir::Reversed));
+Spill_File
+	spill_file;
+for (int
+		index = 0;
+		index < files.size ();
+		index++)
+	{
+	spill_file.Size = files[index].size ();
+	spill_file.Used = ++Spill_Use;
+	Spill_Files.insert (files[index].fileName (), spill_file);
+	Spilled_Size += spill_file.Size;
+	}
+#if ((DEBUG_SECTION) & DEBUG_SPILL)
+clog << ">-< Decoded_Data_Cache::spill_directory: "
+		<< Spill_Directory.toStdString () << endl
+	 << "    " << files.size () << " files, "
+	 	<< Spilled_Size << " bytes" << endl;
+#endif
+QStringList
+	removals (prune_spill_directory ());
+lock.unlock ();
+remove_files (removals);
+return true;
+}
+
+
+QString
+Decoded_Data_Cache::spill_directory () const
+{
+QMutexLocker
+	lock (&Lock);
+return Spill_Directory;
+}
+
+
+void
+Decoded_Data_Cache::max_spill_size
+	(
+	qint64	size
+	)
+{
+if (size < 0)
+	size = 0;
+QMutexLocker
+	lock (&Lock);
+Max_Spill_Size = size;
+QStringList
+	removals (prune_spill_directory ());
+lock.unlock ();
+remove_files (removals);
+}
+
+
+qint64
+Decoded_Data_Cache::max_spill_size () const
+{
+QMutexLocker
+	lock (&Lock);
+return Max_Spill_Size;
+}
+
+
+bool
+Decoded_Data_Cache::enabled () const
+{
+QMutexLocker
+	lock (&Lock);
+return Max_Size > 0;
+}
+
+/*==============================================================================
+	Cache
+*/
+QString
+Decoded_Data_Cache::key
+	(
+	const QString&	source_name,
+	unsigned int	resolution_level,
+	unsigned int	band,
+	const QRect&	region
+	)
+{
+return QString ("%1|%2|%3|%4,%5,%6x%7")
+	.arg (source_name)
+	.arg (resolution_level)
+	.arg (band)
+	.arg (region.x ())
+	.arg (region.y ())
+	.arg (region.width ())
+	.arg (region.height ());
+}
+
+
+bool
+Decoded_Data_Cache::fetch
+	(
+	const QString&	key,
+	void*			buffer,
+	qint64			size
+	)
+{
+if (! buffer ||
+	size <= 0)
+	return false;
+
+QMutexLocker
+	lock (&Lock);
+if (! Max_Size)
+	return false;
+
+QHash<QString, Cached_Block>::iterator
+	block = Blocks.find (key);
+if (block != Blocks.end ())
+	{
+	if (block->Data.size () != size)
+		{
+		#if ((DEBUG_SECTION) & DEBUG_FETCH)
+		clog << ">-< Decoded_Data_Cache::fetch: " << key.toStdString ()
+				<< endl
+			 << "    block size " << block->Data.size ()
+			 	<< " != " << size << " expected" << endl;
+		#endif
+		return false;
+		}
+	std::memcpy (buffer, block->Data.constData (), size);
+	//	Most recently used.
+	Block_Use.splice (Block_Use.begin (), Block_Use, block->Use);
+	#if ((DEBUG_SECTION) & DEBUG_FETCH)
+	clog << ">-< Decoded_Data_Cache::fetch: " << key.toStdString ()
+			<< " from memory" << endl;
+	#endif
+	return true;
+	}
+
+QByteArray
+	data;
+if (Spill_Queue.contains (key))
+	{
+	//	Discarded but not yet spilled; it is held in memory again.
+	data = Spill_Queue.take (key);
+	if (data.size () != size)
+		return false;
+	}
+else
+	{
+	QString
+		file_name (spill_file_name (key));
+	QHash<QString, Spill_File>::iterator
+		spill_file = Spill_Files.find (file_name);
+	if (spill_file == Spill_Files.end () ||
+		spill_file->Size != size)
+		return false;
+	//	The spill directory is pruned in order of use.
+	spill_file->Used = ++Spill_Use;
+
+	//	Read the spill file without holding the Lock.
+	QString
+		pathname (Spill_Directory + '/' + file_name);
+	lock.unlock ();
+	QFile
+		file (pathname);
+	if (file.open (QIODevice::ReadOnly))
+		{
+		data = file.readAll ();
+		file.close ();
+		}
+	lock.relock ();
+	if (data.size () != size)
+		{
+		//	The file was pruned or damaged.
+		if ((spill_file = Spill_Files.find (file_name)) != Spill_Files.end ())
+			{
+			Spilled_Size -= spill_file->Size;
+			Spill_Files.erase (spill_file);
+			}
+		return false;
+		}
+	#if ((DEBUG_SECTION) & DEBUG_FETCH)
+	clog << ">-< Decoded_Data_Cache::fetch: " << key.toStdString ()
+			<< " from " << pathname.toStdString () << endl;
+	#endif
+	}
+if (Max_Size &&
+	size <= Max_Size)
+	{
+	hold (key, data);
+	start_spilling ();
+	}
+lock.unlock ();
+std::memcpy (buffer, data.constData (), size);
+return true;
+}
+
+
+bool
+Decoded_Data_Cache::contains
+	(
+	const QString&	key
+	) const
+{
+QMutexLocker
+	lock (&Lock);
+return Max_Size &&
+	(Blocks.contains (key) ||
+	 Spill_Queue.contains (key) ||
+	 Spill_Files.contains (spill_file_name (key)));
+}
+
+
+void
+Decoded_Data_Cache::insert
+	(
+	const QString&	key,
+	const void*		data,
+	qint64			size
+	)
+{
+if (! data ||
+	size <= 0)
+	return;
+
+//	Copy the data before locking.
+QByteArray
+	block (static_cast<const char*>(data), size);
+QMutexLocker
+	lock (&Lock);
+if (! Max_Size)
+	return;
+#if ((DEBUG_SECTION) & DEBUG_INSERT)
+clog << ">-< Decoded_Data_Cache::insert: " << key.toStdString ()
+		<< ' ' << size << " bytes" << endl;
+#endif
+Spill_Queue.remove (key);
+if (size <= Max_Size)
+	hold (key, block);
+else
+if (! Spill_Directory.isEmpty () &&
+	size <= Max_Spill_Size &&
+	! Spill_Files.contains (spill_file_name (key)))
+	//	Too large to hold in memory; it goes directly to the spill.
+	Spill_Queue.insert (key, block);
+start_spilling ();
+}
+
+
+void
+Decoded_Data_Cache::clear ()
+{
+QMutexLocker
+	lock (&Lock);
+Blocks.clear ();
+Block_Use.clear ();
+Size = 0;
+}
+
+/*==============================================================================
+	Helpers
+*/
+void
+Decoded_Data_Cache::hold
+	(
+	const QString&		key,
+	const QByteArray&	data
+	)
+{
+QHash<QString, Cached_Block>::iterator
+	block = Blocks.find (key);
+if (block != Blocks.end ())
+	{
+	Size -= block->Data.size ();
+	Block_Use.erase (block->Use);
+	}
+Block_Use.push_front (key);
+Cached_Block
+	cached;
+cached.Data = data;
+cached.Use = Block_Use.begin ();
+Blocks.insert (key, cached);
+Size += data.size ();
+discard ();
+}
+
+
+void
+Decoded_Data_Cache::discard ()
+{
+while (Size > Max_Size &&
+		! Block_Use.empty ())
+	{
+	QString
+		key (Block_Use.back ());
+	Block_Use.pop_back ();
+	QByteArray
+		data (Blocks.take (key).Data);
+	Size -= data.size ();
+	//	Blocks already in the spill directory are not written again.
+	if (Max_Size &&
+		! Spill_Directory.isEmpty () &&
+		data.size () <= Max_Spill_Size &&
+		! Spill_Files.contains (spill_file_name (key)))
+		Spill_Queue.insert (key, data);
+	}
+}
+
+
+void
+Decoded_Data_Cache::start_spilling ()
+{
+if (! Spilling &&
+	! Spill_Queue.isEmpty ())
+	{
+	Spilling = true;
+	QThreadPool::globalInstance ()->start (new Decoded_Data_Spiller (this));
+	}
+}
+
+
+void
+Decoded_Data_Cache::spill ()
+{
+QMutexLocker
+	lock (&Lock);
+while (! Spill_Queue.isEmpty () &&
+		! Spill_Directory.isEmpty ())
+	{
+	QHash<QString, QByteArray>::iterator
+		entry = Spill_Queue.begin ();
+	QString
+		file_name (spill_file_name (entry.key ())),
+		directory (Spill_Directory);
+	QByteArray
+		data (entry.value ());
+	Spill_Queue.erase (entry);
+	lock.unlock ();
+
+	/*	Write to a temporary file that is then renamed so a partially
+		written spill file is never seen by fetch.
+	*/
+	QString
+		pathname (directory + '/' + file_name),
+		temporary (pathname + ".part");
+	QFile
+		file (temporary);
+	bool
+		written = false;
+	if (file.open (QIODevice::WriteOnly | QIODevice::Truncate))
+		{
+		written = (file.write (data) == data.size ());
+		file.close ();
+		if (written)
+			{
+			QFile::remove (pathname);
+			written = QFile::rename (temporary, pathname);
+			}
+		if (! written)
+			QFile::remove (temporary);
+		}
+
+	lock.relock ();
+	QStringList
+		removals;
+	if (written &&
+		directory == Spill_Directory)
+		{
+		QHash<QString, Spill_File>::iterator
+			spill_file = Spill_Files.find (file_name);
+		if (spill_file != Spill_Files.end ())
+			Spilled_Size -= spill_file->Size;
+		Spill_File
+			spilled;
+		spilled.Size = data.size ();
+		spilled.Used = ++Spill_Use;
+		Spill_Files.insert (file_name, spilled);
+		Spilled_Size += spilled.Size;
+		#if ((DEBUG_SECTION) & DEBUG_SPILL)
+		clog << ">-< Decoded_Data_Cache::spill: "
+				<< pathname.toStdString () << endl;
+		#endif
+		removals = prune_spill_directory ();
+		}
+	if (! removals.isEmpty ())
+		{
+		lock.unlock ();
+		remove_files (removals);
+		lock.relock ();
+		}
+	}
+Spilling = false;
+Spilling_Done.wakeAll ();
+}
+
+
+QStringList
+Decoded_Data_Cache::prune_spill_directory ()
+{
+QStringList
+	removals;
+if (Spill_Directory.isEmpty () ||
+	Spilled_Size <= Max_Spill_Size)
+	return removals;
+
+//	Least recently used files first.
+QVector<QPair<quint64, QString> >
+	files;
+files.reserve (Spill_Files.size ());
+for (QHash<QString, Spill_File>::const_iterator
+		spill_file = Spill_Files.constBegin ();
+		spill_file != Spill_Files.constEnd ();
+		++spill_file)
+	files.append (qMakePair (spill_file->Used, spill_file.key ()));
+std::sort (files.begin (), files.end ());
+
+/*	Prune to less than the limit so every new block does not result in
+	pruning.
+*/
+qint64
+	limit = Max_Spill_Size - (Max_Spill_Size >> 3);
+for (int
+		index = 0;
+		index < files.size () &&
+		Spilled_Size > limit;
+		index++)
+	{
+	Spilled_Size -= Spill_Files.take (files[index].second).Size;
+	removals.append (Spill_Directory + '/' + files[index].second);
+	}
+if (Spilled_Size < 0)
+	Spilled_Size = 0;
+#if ((DEBUG_SECTION) & DEBUG_SPILL)
+clog << ">-< Decoded_Data_Cache::prune_spill_directory: "
+		<< removals.size () << " files removed, "
+		<< Spilled_Size << " bytes remain" << endl;
+#endif
+return removals;
+}
+
+
+QString
+Decoded_Data_Cache::spill_file_name
+	(
+	const QString&	key
+	)
+{
+return QCryptographicHash::hash (key.toUtf8 (), QCryptographicHash::Sha1)
+		.toHex ()
+	+ SPILL_FILE_EXTENSION;
+}
+
+
+void
+Decoded_Data_Cache::remove_files
+	(
+	const QStringList&	pathnames
+	)
+{
+for (int
+		index = 0;
+		index < pathnames.size ();
+		index++)
+	QFile::remove (pathnames[index]);
+}
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
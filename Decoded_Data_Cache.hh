@@ -0,0 +1,312 @@
+/*	Decoded_Data_Cache
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#ifndef HiView_Decoded_Data_Cache_hh
+#define HiView_Decoded_Data_Cache_hh
+
+#include	<QHash>
+#include	<QByteArray>
+#include	<QString>
+#include	<QStringList>
+#include	<QRect>
+#include	<QMutex>
+#include	<QWaitCondition>
+
+#include	<list>
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/**	A <i>Decoded_Data_Cache</i> holds blocks of decoded source image
+	data so they need not be decoded again.
+
+	Each block is the pixel data of a single source image band at some
+	resolution level for some image region, identified by a {@link
+	key(const QString&, unsigned int, unsigned int, const QRect&) key}
+	string. Blocks are held in memory up to a {@link max_size() maximum
+	size}; when the limit is reached the least recently used blocks are
+	discarded. A maximum size of zero disables the cache entirely.
+
+	If a {@link spill_directory() spill directory} is set the blocks
+	discarded from memory are written to files in that directory. A
+	block no longer held in memory will be read back from its spill
+	file, so decoded data may survive the memory limit and be reused
+	across application sessions. Spill files are written on a thread of
+	the global thread pool, never while the cache is locked, so the
+	threads using the cache do not wait on disk writes. The spill
+	directory is pruned, least recently used files first, when its
+	contents exceed the {@link max_spill_size() maximum spill size}.
+
+	A Decoded_Data_Cache is thread safe.
+
+	@version	$Revision: 1.1 $
+*/
+class Decoded_Data_Cache
+{
+public:
+/*==============================================================================
+	Constants
+*/
+//!	Class identification name with source code version and date.
+static const char* const
+	ID;
+
+//!	Default maximum memory size, in bytes.
+static const qint64
+	DEFAULT_MAX_SIZE;
+
+//!	Default maximum spill directory size, in bytes.
+static const qint64
+	DEFAULT_MAX_SPILL_SIZE;
+
+//!	Spill file name extension.
+static const char* const
+	SPILL_FILE_EXTENSION;
+
+/*==============================================================================
+	Constructors
+*/
+/**	Construct a Decoded_Data_Cache.
+
+	@param	max_size	The maximum amount of data, in bytes, to be held
+		in memory. If zero the cache is disabled.
+	@param	spill_directory	The pathname to a directory where data
+		blocks are to be spilled. If empty no data will be spilled.
+*/
+explicit Decoded_Data_Cache (qint64 max_size = DEFAULT_MAX_SIZE,
+	const QString& spill_directory = QString ());
+
+/**	Destroy the Decoded_Data_Cache.
+
+	Any spill files still being written are completed first.
+*/
+~Decoded_Data_Cache ();
+
+private:
+//	Not copyable.
+Decoded_Data_Cache (const Decoded_Data_Cache&);
+Decoded_Data_Cache& operator= (const Decoded_Data_Cache&);
+
+/*==============================================================================
+	Accessors
+*/
+public:
+
+/**	Set the maximum amount of data to be held in memory.
+
+	If the amount of data currently in memory exceeds the new limit
+	least recently used blocks are discarded.
+
+	@param	size	The maximum amount of data, in bytes. If zero the
+		cache is disabled: the data held in memory is discarded without
+		being spilled, and the spill directory is not used.
+*/
+void max_size (qint64 size);
+
+/**	Get the maximum amount of data to be held in memory.
+
+	@return	The maximum amount of data, in bytes.
+*/
+qint64 max_size () const;
+
+/**	Get the amount of data held in memory.
+
+	@return	The amount of data, in bytes.
+*/
+qint64 size () const;
+
+/**	Set the spill directory.
+
+	The directory is created if it does not exist. Its existing spill
+	files are used in order of their modification times.
+
+	@param	pathname	The pathname to the spill directory. If empty
+		data blocks will not be spilled.
+	@return	true if the spill directory is usable; false otherwise, in
+		which case no spill directory is set.
+*/
+bool spill_directory (const QString& pathname);
+
+/**	Get the spill directory.
+
+	@return	The spill directory pathname. This will be empty if no
+		spill directory is set.
+*/
+QString spill_directory () const;
+
+/**	Set the maximum amount of data to be held in the spill directory.
+
+	@param	size	The maximum amount of data, in bytes.
+*/
+void max_spill_size (qint64 size);
+
+/**	Get the maximum amount of data to be held in the spill directory.
+
+	@return	The maximum amount of data, in bytes.
+*/
+qint64 max_spill_size () const;
+
+/**	Test if the cache is enabled.
+
+	@return	true if the {@link max_size() maximum size} is not zero;
+		false otherwise.
+*/
+bool enabled () const;
+
+/*==============================================================================
+	Cache
+*/
+/**	Get a data block key.
+
+	@param	source_name	A name that uniquely identifies the source image
+		content. This should change whenever the source content changes.
+	@param	resolution_level	The source resolution level of the data.
+	@param	band	The source image band of the data.
+	@param	region	The source image region, relative to the full
+		resolution image grid, that the data was rendered from.
+	@return	A key string.
+*/
+static QString key (const QString& source_name,
+	unsigned int resolution_level, unsigned int band, const QRect& region);
+
+/**	Fetch a data block.
+
+	If the block is not held in memory, but is in the spill directory,
+	it is read from its spill file and held in memory again.
+
+	@param	key	The block {@link key(const QString&, unsigned int,
+		unsigned int, const QRect&) key}.
+	@param	buffer	A pointer to storage that will receive the block data.
+	@param	size	The expected size of the block in bytes.
+	@return	true if the block was found with the expected size and its
+		data copied into the buffer; false otherwise, in which case the
+		buffer contents are unchanged.
+*/
+bool fetch (const QString& key, void* buffer, qint64 size);
+
+/**	Test if a data block is available.
+
+	@param	key	The block {@link key(const QString&, unsigned int,
+		unsigned int, const QRect&) key}.
+	@return	true if the block is held in memory or in the spill
+		directory; false otherwise.
+*/
+bool contains (const QString& key) const;
+
+/**	Insert a data block.
+
+	The block data is copied. Any block with the same key is replaced.
+
+	@param	key	The block {@link key(const QString&, unsigned int,
+		unsigned int, const QRect&) key}.
+	@param	data	A pointer to the block data.
+	@param	size	The size of the block data in bytes.
+*/
+void insert (const QString& key, const void* data, qint64 size);
+
+/**	Remove all data blocks held in memory.
+
+	The blocks are not spilled, and spilled blocks are not removed.
+*/
+void clear ();
+
+/*==============================================================================
+	Helpers
+*/
+private:
+
+//	The Lock is expected to be locked by the callers of these helpers.
+
+void hold (const QString& key, const QByteArray& data);
+void discard ();
+void start_spilling ();
+QStringList prune_spill_directory ();
+
+static QString spill_file_name (const QString& key);
+static void remove_files (const QStringList& pathnames);
+
+friend class Decoded_Data_Spiller;
+//	Write the queued spill blocks; run on a pool thread.
+void spill ();
+
+/*==============================================================================
+	Data
+*/
+private:
+
+struct Cached_Block
+	{
+	QByteArray
+		Data;
+	//	Position in the Block_Use list.
+	std::list<QString>::iterator
+		Use;
+	};
+
+QHash<QString, Cached_Block>
+	Blocks;
+//	Block keys, most recently used first.
+std::list<QString>
+	Block_Use;
+qint64
+	Max_Size,
+	Size;
+
+struct Spill_File
+	{
+	qint64
+		Size;
+	//	Spill_Use sequence number of the last use.
+	quint64
+		Used;
+	};
+
+QString
+	Spill_Directory;
+//	Spill files by file name.
+QHash<QString, Spill_File>
+	Spill_Files;
+quint64
+	Spill_Use;
+qint64
+	Max_Spill_Size,
+	Spilled_Size;
+
+//	Blocks discarded from memory waiting to be spilled, by key.
+QHash<QString, QByteArray>
+	Spill_Queue;
+bool
+	Spilling;
+QWaitCondition
+	Spilling_Done;
+
+mutable QMutex
+	Lock;
+};
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
+#endif
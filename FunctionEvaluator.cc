@@ -4,10 +4,13 @@
 #include <iostream>
 using namespace std;
 
+using UA::HiRISE::Compiled_Expression;
+
 static QString JS_FUNC_NAME = "value";
 static QString JS_FUNC_ARGS = "dn";
 
 FunctionEvaluator::FunctionEvaluator(QString input)
+    : expression(input)
 {
     // constructing a function to evaluate
     function = QString("function %1 (%2) { return (%3) }").arg(JS_FUNC_NAME, JS_FUNC_ARGS, input);
@@ -35,10 +38,79 @@ void FunctionEvaluator::error()
     max_at = -1;
 }
 
+void FunctionEvaluator::accumulate(int dn, unsigned long long count, double num)
+{
+    cnt += count;
+    sum += count * num;
+
+    if (num < min)
+    {
+        min = num;
+        min_at = dn;
+    }
+
+    if (num > max)
+    {
+        max = num;
+        max_at = dn;
+    }
+}
+
 void FunctionEvaluator::run()
 {
     qDebug() << function;
 
+    reset();
+
+    // The arithmetic subset of JavaScript is compiled and evaluated for
+    // all DN bins at once; anything else is run by the script engine.
+    if (!runCompiled())
+        runScript();
+
+    avg = sum / cnt;
+/*
+    cout << "*** Statistics ***" << endl;
+    cout << " cnt = " << cnt << endl; // like number of pixels in region
+    cout << " sum = " << sum << endl; // sum of pixel values
+    cout << " min = " << min << " at dn " << min_at << endl; // lowest value from user's function
+    cout << " max = " << max << " at dn " << max_at << endl; // highest value from user's function
+    cout << " avg = " << avg << endl; // average value from user's function
+    cout << endl;
+*/
+    emit runCompleted();
+}
+
+bool FunctionEvaluator::runCompiled()
+{
+    Compiled_Expression compiled(expression, QStringList() << JS_FUNC_ARGS, properties);
+
+    // Not compiled; the caller falls back to the script engine.
+    if (!compiled.is_valid())
+        return false;
+
+    // Only the DN bins with data are evaluated.
+    QVector<double> dns;
+    dns.reserve(data->size());
+    for (int dn = 0 ; dn < data->size() ; dn++)
+    {
+        if (data->at(dn) > 0)
+            dns.append(dn);
+    }
+
+    QVector<double> values(dns.size());
+    compiled.evaluate(dns.constData(), values.data(), dns.size());
+
+    for (int i = 0 ; i < dns.size() ; i++)
+    {
+        int dn = (int)dns[i];
+        accumulate(dn, data->at(dn), values[i]);
+    }
+
+    return true;
+}
+
+void FunctionEvaluator::runScript()
+{
     /* Passing an invalid QScriptValue as the this argument to QScriptValue::call()
      * indicates that the Global Object should be used as the this object;
      * in other words, that the function should be invoked as a global function.
@@ -47,8 +119,6 @@ void FunctionEvaluator::run()
 
     QScriptValue fun = engine.globalObject().property(JS_FUNC_NAME);
 
-    reset();
-
     for (int dn = 0 ; dn < data->size() ; dn++)
     {
         unsigned long long count = data->at(dn);
@@ -77,35 +147,8 @@ void FunctionEvaluator::run()
             break;
         }
 
-        double num = val.toNumber();
-
-        cnt += count;
-        sum += count * num;
-
-        if (num < min)
-        {
-            min = num;
-            min_at = dn;
-        }
-
-        if (num > max)
-        {
-            max = num;
-            max_at = dn;
-        }
+        accumulate(dn, count, val.toNumber());
     }
-
-    avg = sum / cnt;
-/*
-    cout << "*** Statistics ***" << endl;
-    cout << " cnt = " << cnt << endl; // like number of pixels in region
-    cout << " sum = " << sum << endl; // sum of pixel values
-    cout << " min = " << min << " at dn " << min_at << endl; // lowest value from user's function
-    cout << " max = " << max << " at dn " << max_at << endl; // highest value from user's function
-    cout << " avg = " << avg << endl; // average value from user's function
-    cout << endl;
-*/
-    emit runCompleted();
 }
 
 void FunctionEvaluator::setData(QVector<unsigned long long> *data)
@@ -116,4 +159,5 @@ void FunctionEvaluator::setData(QVector<unsigned long long> *data)
 void FunctionEvaluator::setProperty(const QString name, const double value)
 {
     engine.globalObject().setProperty(name, value);
+    properties.insert(name, value);
 }
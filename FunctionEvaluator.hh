@@ -7,6 +7,8 @@
 #include <QVector>
 #include <QtScript>
 
+#include "Compiled_Expression.hh"
+
 class FunctionEvaluator : public QThread
 {
     Q_OBJECT
@@ -36,6 +38,11 @@ private:
     void reset();
     void error();
 
+    bool runCompiled();
+    void runScript();
+    void accumulate(int dn, unsigned long long count, double num);
+
+    QString expression;
     QString function;
     long double cnt;
     long double sum;
@@ -48,6 +55,9 @@ private:
 
     QScriptEngine engine;
 
+    // Property values, used as constants by the compiled expression
+    UA::HiRISE::Compiled_Expression::Constants properties;
+
     QVector<unsigned long long> *data;
 };
 
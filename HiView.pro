@@ -294,7 +294,15 @@ HEADERS +=	\
 	Image_Renderer_Thread.hh \
 	Plastic_Image.hh \
 	Plastic_QImage.hh \
+	Image_Pyramid.hh \
+	Data_Map_Kernels.hh \
+	Box_Filter.hh \
+	Index_Table_Cache.hh \
+	Tile_Memory_Arena.hh \
+	Decoded_Data_Cache.hh \
 	JP2_Image.hh \
+	Mapped_Image.hh \
+	Planar_Image.hh \
 	Plastic_Image_Factory.hh \
 	Tiled_Image_Display.hh \
 	Image_Viewer.hh \
@@ -302,6 +310,7 @@ HEADERS +=	\
 	Navigator_Tool.hh \
 	Count_Sequence.hh \
 	Histogram_Plot.hh \
+	Histogram_Index.hh \
 	Stats.hh \
 	Statistics_Tool.hh \
 	Statistics_and_Bounds_Tool.hh \
@@ -317,6 +326,8 @@ HEADERS +=	\
 	Value_Tree_Model.hh \
 	Parameter_Tree_View.hh \
 	Metadata_Dialog.hh \
+	Metadata_Parser_Thread.hh \
+	Metadata_Search_Index.hh \
 	PDS_Metadata.hh \
 	Qstream.hh \
 	Save_Image_Dialog.hh \
@@ -331,6 +342,7 @@ HEADERS +=	\
 	Polar_Stereographic_Elliptical_Projection.hh \
 	SpeechHandler.hh \
    FunctionEvaluator.hh \
+	Compiled_Expression.hh \
 	Voice_Adapter.hh \
 	Distance_Line.hh
 
@@ -348,7 +360,15 @@ SOURCES +=	\
 	Image_Renderer_Thread.cc \
 	Plastic_Image.cc \
 	Plastic_QImage.cc \
+	Image_Pyramid.cc \
+	Data_Map_Kernels.cc \
+	Box_Filter.cc \
+	Index_Table_Cache.cc \
+	Tile_Memory_Arena.cc \
+	Decoded_Data_Cache.cc \
 	JP2_Image.cc \
+	Mapped_Image.cc \
+	Planar_Image.cc \
 	Plastic_Image_Factory.cc \
 	Tiled_Image_Display.cc \
 	Image_Viewer.cc \
@@ -356,6 +376,7 @@ SOURCES +=	\
 	Navigator_Tool.cc \
 	Count_Sequence.cc \
 	Histogram_Plot.cc \
+	Histogram_Index.cc \
 	Stats.cc \
 	Statistics_Tool.cc \
 	Statistics_and_Bounds_Tool.cc \
@@ -371,6 +392,8 @@ SOURCES +=	\
 	Value_Tree_Model.cc \
 	Parameter_Tree_View.cc \
 	Metadata_Dialog.cc \
+	Metadata_Parser_Thread.cc \
+	Metadata_Search_Index.cc \
 	PDS_Metadata.cc \
 	Qstream.cc \
 	Save_Image_Dialog.cc \
@@ -386,6 +409,7 @@ SOURCES +=	\
 	Polar_Stereographic_Elliptical_Projection.cc \
    SpeechHandler.cc \
    FunctionEvaluator.cc \
+	Compiled_Expression.cc \
 	Voice_Adapter.cc \
 	Distance_Line.cc
    
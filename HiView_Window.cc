@@ -2478,6 +2478,20 @@ clog << "<<< HiView_Window::tool_position" << endl;
 #endif
 }
 
+
+void
+HiView_Window::decoded_data_cache_size
+	(
+	int		size
+	)
+{
+#if ((DEBUG_SECTION) & DEBUG_SLOTS)
+clog << ">-< HiView_Window::decoded_data_cache_size: " << size << " MB" << endl;
+#endif
+JP2_Image::decoded_data_cache ().max_size ((qint64)size << 20);
+}
+
+
 /*------------------------------------------------------------------------------
 	Navigator
 */
@@ -2806,6 +2820,7 @@ if (Statistics)
 	}
 
 	if(refreshed) {
+		Image_Info->histograms_changed();
 		//send data to engine
 		if(!Selected_Image_Region.isEmpty()) {
 			Image_Info->update_region_stats();
@@ -3359,6 +3374,24 @@ connect (Preferences,
 			SIGNAL (rendering_increment_lines_changed (int)),
 		 Image_View,
 		 	SLOT (rendering_increment_lines (int)));
+Image_View->rendering_threads (Preferences->rendering_threads ());
+connect (Preferences,
+			SIGNAL (rendering_threads_changed (int)),
+		 Image_View,
+		 	SLOT (rendering_threads (int)));
+decoded_data_cache_size (Preferences->decoded_data_cache_size ());
+if (! Preferences->decoded_data_spill_directory ().isEmpty () &&
+	! JP2_Image::decoded_data_cache ().spill_directory
+		(Preferences->decoded_data_spill_directory ()))
+	QMessageBox::warning ((isVisible () ? this : NULL),
+		tr ("HiView Configuration"),
+		tr ("The Decoded_Data_Spill_Directory \"")
+		+ Preferences->decoded_data_spill_directory ()
+		+ tr ("\" can not be used.\n\n")
+		+ tr ("Decoded data will not be spilled."));
+connect (Preferences,
+			SIGNAL (decoded_data_cache_size_changed (int)),
+			SLOT (decoded_data_cache_size (int)));
 Image_View->background_color (Preferences->background_color ());
 connect (Preferences,
 			SIGNAL (background_color_changed (QRgb)),
@@ -4587,6 +4620,9 @@ Aggregate
 LOCKED_LOGGING ((
 clog << "    metadata @ " << (void*)metadata << endl));
 #endif
+if (Metadata)
+	//	Abandon any PDS metadata still arriving for the previous image.
+	Metadata->reset ();
 Image_Metadata_Dialog->parameters (metadata);
 
 //	Reset the Location_Mapper.
@@ -4641,6 +4677,10 @@ if (metadata &&
 				SIGNAL (fetched (idaeim::PVL::Aggregate*)),
 				SLOT (PDS_metadata (idaeim::PVL::Aggregate*)),
 				Qt::UniqueConnection);
+			connect (Metadata,
+				SIGNAL (fetched_parameter (idaeim::PVL::Parameter*)),
+				SLOT (PDS_metadata_parameter (idaeim::PVL::Parameter*)),
+				Qt::UniqueConnection);
 			}
 		#if ((DEBUG_SECTION) & (DEBUG_METADATA | DEBUG_LOAD_IMAGE))
 		clog << "      Metadata fetch " << URL.toString () << endl;
@@ -4666,23 +4706,29 @@ LOCKED_LOGGING ((
 clog << ">>> HiView_Window::PDS_metadata: metadata @ "
 		<< (void*)metadata << endl));
 #endif
-if (metadata)
+if (metadata &&
+	Image_Metadata_Dialog->parameters ())
 	{
-	//	Copy out the metadata from the PDS_Metadata fetcher.
 	#if ((DEBUG_SECTION) & DEBUG_METADATA_PARAMETERS)
 	clog << "    metadata -" << endl
 		 << *metadata;
 	#endif
-	metadata = new Aggregate (*metadata);
-	metadata->name (PDS_Metadata::PDS_METADATA_GROUP);
-	//	Add the metadata to the root metadata.
-	Image_Metadata_Dialog->parameters ()->add (metadata);
+	Aggregate
+		*group (PDS_metadata_group ());
+	if (! group)
+		{
+		//	Copy out the metadata from the PDS_Metadata fetcher.
+		metadata = new Aggregate (*metadata);
+		metadata->name (PDS_Metadata::PDS_METADATA_GROUP);
+		//	Add the metadata to the root metadata.
+		Image_Metadata_Dialog->add_parameter (metadata);
+		group = PDS_metadata_group ();
+		}
+	metadata = group;
 	#if ((DEBUG_SECTION) & DEBUG_METADATA)
 	clog << "    Image_Metadata_Dialog parameters -" << endl
 		 << *(Image_Metadata_Dialog->parameters ());
 	#endif
-	//	Refresh the Image_Metadata_Dialog view.
-	Image_Metadata_Dialog->parameters (Image_Metadata_Dialog->parameters ());
 	//	Refresh the Location_Mapper.
 	Location->parameters (metadata);
 	//	Refresh the Image_Info_Panel.
@@ -4718,6 +4764,56 @@ clog << "<<< HiView_Window::PDS_metadata" << endl));
 #endif
 }
 
+
+void
+HiView_Window::PDS_metadata_parameter
+	(
+	Parameter*	parameter
+	)
+{
+#if ((DEBUG_SECTION) & DEBUG_METADATA)
+LOCKED_LOGGING ((
+clog << ">-< HiView_Window::PDS_metadata_parameter: "
+		<< (parameter ? parameter->name () : string ("NULL")) << endl));
+#endif
+Aggregate
+	*metadata (Image_Metadata_Dialog ?
+		Image_Metadata_Dialog->parameters () : NULL);
+if (! parameter ||
+	! metadata)
+	return;
+
+Aggregate
+	*group (PDS_metadata_group ());
+if (! group)
+	{
+	Image_Metadata_Dialog->add_parameter
+		(new Aggregate (PDS_Metadata::PDS_METADATA_GROUP));
+	group = PDS_metadata_group ();
+	}
+//	The parameter remains owned by the PDS_Metadata fetcher.
+Image_Metadata_Dialog->add_parameter (parameter->clone (), group);
+}
+
+
+Aggregate*
+HiView_Window::PDS_metadata_group () const
+{
+Aggregate
+	*metadata (Image_Metadata_Dialog ?
+		Image_Metadata_Dialog->parameters () : NULL);
+if (metadata)
+	{
+	int
+		index = metadata->size ();
+	while (--index >= 0)
+		if ((*metadata)[index].is_Aggregate () &&
+			(*metadata)[index].name () == PDS_Metadata::PDS_METADATA_GROUP)
+			return static_cast<Aggregate*>(&(*metadata)[index]);
+	}
+return NULL;
+}
+
 /*==============================================================================
 	Image Save
 */
@@ -318,7 +318,9 @@ void continue_startup ();
 
 	If non-NULL metadata is obtained the parameters are added to the
 	{@metadata() basic metadata} with the {@link
-	#PDS_Metadata::PDS_METADATA_GROUP} name. Then the {@link
+	#PDS_Metadata::PDS_METADATA_GROUP} name, unless they have already
+	been {@link PDS_metadata_parameter(idaeim::PVL::Parameter*) added}
+	as they were fetched. Then the {@link
 	Plastic_Image::notify_metadata_monitors() registered metadata
 	monitors are notified} of the change to the metadata.
 
@@ -328,6 +330,19 @@ void continue_startup ();
 */
 void PDS_metadata (idaeim::PVL::Aggregate* metadata);
 
+/**	Receives each top level parameter as soon as it has been {@link
+	PDS_Metadata::fetched_parameter(idaeim::PVL::Parameter*) parsed}
+	from the PDS metadata source.
+
+	A copy of the parameter is added to the {@link
+	#PDS_Metadata::PDS_METADATA_GROUP} of the metadata dialog, which is
+	created if necessary. The dialog tree is updated incrementally so it
+	remains usable while the remainder of the metadata is arriving.
+
+	@param	parameter	A pointer to the parameter that was parsed.
+*/
+void PDS_metadata_parameter (idaeim::PVL::Parameter* parameter);
+
 void save_image_done (bool completed);
 
 /**	Receives the {@link Image_Viewer::rendering_status(int) rendering
@@ -393,6 +408,14 @@ void tool_position ();
 
 void toggle_distance_tool(bool enable);
 void line_color(const QColor & color);
+
+/**	Set the decoded data cache size.
+
+	@param	size	The maximum amount of decoded JP2 source data, in MB,
+		to be held in memory.
+	@see	JP2_Image::decoded_data_cache()
+*/
+void decoded_data_cache_size (int size);
 #ifdef __APPLE__
 void recognizer_toggled(bool enable);
 #endif
@@ -410,6 +433,7 @@ void load_image_start ();
 void load_image_failed (const QString& reason = QString ());
 
 void reset_metadata ();
+idaeim::PVL::Aggregate* PDS_metadata_group () const;
 
 void configure ();
 void save_configuration ();
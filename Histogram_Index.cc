@@ -0,0 +1,389 @@
+/*	Histogram_Index
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#include	"Histogram_Index.hh"
+
+
+#if defined (DEBUG_SECTION)
+/*******************************************************************************
+	DEBUG_SECTION controls
+
+	DEBUG_SECTION report selection options.
+	Define any of the following options to obtain the desired debug reports:
+*/
+#define DEBUG_OFF			0
+#define DEBUG_ALL			-1
+#define DEBUG_INDEX			(1 << 0)
+
+#define DEBUG_DEFAULT		DEBUG_ALL
+
+#if (DEBUG_SECTION+0) == 0
+#undef  DEBUG_SECTION
+#define DEBUG_SECTION DEBUG_OFF
+#else
+#include	<iostream>
+using std::clog;
+using std::endl;
+#endif
+
+#endif	//	DEBUG_SECTION
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/*==============================================================================
+	Constants
+*/
+const char* const
+	Histogram_Index::ID =
+		"UA::HiRISE::Histogram_Index ($Revision: 1.1 $ $Date: 2026/10/17 00:00:00 $)";
+
+
+#ifndef HISTOGRAM_INDEX_BLOCK_SIZE
+#define HISTOGRAM_INDEX_BLOCK_SIZE			256
+#endif
+const int
+	Histogram_Index::DEFAULT_BLOCK_SIZE		= HISTOGRAM_INDEX_BLOCK_SIZE;
+
+#ifndef HISTOGRAM_INDEX_MAX_SIZE
+#define HISTOGRAM_INDEX_MAX_SIZE			(64 * 1024 * 1024)
+#endif
+const int
+	Histogram_Index::DEFAULT_MAX_INDEX_SIZE	= HISTOGRAM_INDEX_MAX_SIZE;
+
+/*==============================================================================
+	Block
+*/
+Histogram_Index::Block::Block
+	(
+	const QVector<Histogram*>&	histograms
+	)
+{
+int
+	first,
+	last;
+for (int
+		band = 0;
+		band < 3;
+		band++)
+	{
+	Offset[band] = 0;
+	if (band >= histograms.size () ||
+		! histograms[band])
+		continue;
+
+	const Histogram
+		&histogram = *histograms[band];
+	first = 0;
+	last = histogram.size ();
+	while (first < last &&
+		 ! histogram[first])
+		++first;
+	while (last > first &&
+		 ! histogram[last - 1])
+		--last;
+	if (first < last)
+		{
+		Offset[band] = first;
+		Counts[band] = histogram.mid (first, last - first);
+		}
+	}
+}
+
+
+void
+Histogram_Index::Block::add_to
+	(
+	QVector<Histogram*>	histograms
+	) const
+{
+int
+	band,
+	other_band,
+	entries;
+for (band = 0;
+	 band < 3 &&
+	 band < histograms.size ();
+	 band++)
+	{
+	if (! histograms[band] ||
+		Counts[band].isEmpty ())
+		continue;
+	other_band = band;
+	while (other_band--)
+		if (histograms[band] == histograms[other_band])
+			break;
+	if (other_band >= 0)
+		//	Shared histogram.
+		continue;
+
+	entries = Offset[band] + Counts[band].size ();
+	if (histograms[band]->size () < entries)
+		histograms[band]->resize (entries);
+	quint64
+		*counts = histograms[band]->data () + Offset[band];
+	const quint64
+		*block_counts = Counts[band].constData ();
+	entries = Counts[band].size ();
+	while (entries--)
+		*counts++ += *block_counts++;
+	}
+}
+
+
+int
+Histogram_Index::Block::size () const
+{
+return (int)sizeof (Block) +
+	(int)sizeof (quint64) *
+		(Counts[0].size () + Counts[1].size () + Counts[2].size ());
+}
+
+/*==============================================================================
+	Constructors
+*/
+Histogram_Index::Histogram_Index
+	(
+	int		block_size
+	)
+	:	Block_Size ((block_size > 0) ? block_size : DEFAULT_BLOCK_SIZE),
+		Blocks (DEFAULT_MAX_INDEX_SIZE)
+{
+Band_Map[0] = 0;
+Band_Map[1] = 1;
+Band_Map[2] = 2;
+}
+
+/*==============================================================================
+	Accessors
+*/
+void
+Histogram_Index::max_index_size
+	(
+	int		size
+	)
+{Blocks.setMaxCost (size);}
+
+/*==============================================================================
+	Index
+*/
+bool
+Histogram_Index::reset
+	(
+	int					block_size,
+	const unsigned int*	band_map
+	)
+{
+if (block_size <= 0)
+	block_size = DEFAULT_BLOCK_SIZE;
+bool
+	changed = (block_size != Block_Size);
+for (unsigned int
+		band = 0;
+		band < 3;
+		band++)
+	{
+	if (Band_Map[band] != (band_map ? band_map[band] : band))
+		{
+		Band_Map[band] = (band_map ? band_map[band] : band);
+		changed = true;
+		}
+	}
+if (changed)
+	{
+	#if ((DEBUG_SECTION) & DEBUG_INDEX)
+	clog << "    Histogram_Index::reset: block size " << Block_Size
+			<< " -> " << block_size << ", band map "
+			<< Band_Map[0] << ", " << Band_Map[1] << ", " << Band_Map[2]
+			<< endl;
+	#endif
+	Block_Size = block_size;
+	clear ();
+	}
+return changed;
+}
+
+
+void
+Histogram_Index::clear ()
+{Blocks.clear ();}
+
+
+void
+Histogram_Index::invalidate
+	(
+	const QRect&	image_region
+	)
+{
+if (image_region.isEmpty () ||
+	Blocks.isEmpty ())
+	return;
+QList<quint64>
+	keys (Blocks.keys ());
+while (! keys.isEmpty ())
+	{
+	quint64
+		key = keys.takeLast ();
+	if (block_region (block_coordinate (key)).intersects (image_region))
+		Blocks.remove (key);
+	}
+#if ((DEBUG_SECTION) & DEBUG_INDEX)
+clog << "    Histogram_Index::invalidate: " << Blocks.count ()
+		<< " blocks remain" << endl;
+#endif
+}
+
+
+QRect
+Histogram_Index::blocks_region
+	(
+	const QRect&	image_region
+	) const
+{
+if (image_region.isEmpty () ||
+	image_region.left () < 0 ||
+	image_region.top () < 0)
+	return QRect ();
+
+int
+	left   = (image_region.left () + Block_Size - 1) / Block_Size,
+	top    = (image_region.top ()  + Block_Size - 1) / Block_Size,
+	right  = (image_region.left () + image_region.width ())  / Block_Size,
+	bottom = (image_region.top ()  + image_region.height ()) / Block_Size;
+if (right <= left ||
+	bottom <= top)
+	return QRect ();
+return QRect
+	(left * Block_Size, top * Block_Size,
+	(right - left) * Block_Size, (bottom - top) * Block_Size);
+}
+
+
+QList<QRect>
+Histogram_Index::edge_regions
+	(
+	const QRect&	image_region
+	) const
+{
+QList<QRect>
+	edges;
+QRect
+	blocks (blocks_region (image_region));
+if (blocks.isEmpty ())
+	{
+	if (! image_region.isEmpty ())
+		edges.append (image_region);
+	return edges;
+	}
+
+QRect
+	edge;
+//	Top.
+edge.setCoords (image_region.left (), image_region.top (),
+	image_region.right (), blocks.top () - 1);
+if (! edge.isEmpty ())
+	edges.append (edge);
+//	Bottom.
+edge.setCoords (image_region.left (), blocks.bottom () + 1,
+	image_region.right (), image_region.bottom ());
+if (! edge.isEmpty ())
+	edges.append (edge);
+//	Left.
+edge.setCoords (image_region.left (), blocks.top (),
+	blocks.left () - 1, blocks.bottom ());
+if (! edge.isEmpty ())
+	edges.append (edge);
+//	Right.
+edge.setCoords (blocks.right () + 1, blocks.top (),
+	image_region.right (), blocks.bottom ());
+if (! edge.isEmpty ())
+	edges.append (edge);
+return edges;
+}
+
+
+QRect
+Histogram_Index::block_region
+	(
+	const QPoint&	block
+	) const
+{
+return QRect
+	(block.x () * Block_Size, block.y () * Block_Size,
+	Block_Size, Block_Size);
+}
+
+
+bool
+Histogram_Index::add
+	(
+	QVector<Histogram*>	histograms,
+	const QPoint&		block
+	) const
+{
+Block
+	*block_histograms = Blocks.object (block_key (block));
+if (block_histograms)
+	{
+	block_histograms->add_to (histograms);
+	return true;
+	}
+return false;
+}
+
+
+bool
+Histogram_Index::insert
+	(
+	const QPoint&	block,
+	Block*			histograms
+	)
+{
+if (! histograms)
+	return false;
+return Blocks.insert (block_key (block), histograms, histograms->size ());
+}
+
+/*==============================================================================
+	Helpers
+*/
+quint64
+Histogram_Index::block_key
+	(
+	const QPoint&	block
+	)
+{return ((quint64)(quint32)block.x () << 32) | (quint32)block.y ();}
+
+
+QPoint
+Histogram_Index::block_coordinate
+	(
+	quint64	key
+	)
+{return QPoint ((int)(quint32)(key >> 32), (int)(quint32)key);}
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
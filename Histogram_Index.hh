@@ -0,0 +1,282 @@
+/*	Histogram_Index
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#ifndef HiView_Histogram_Index_hh
+#define HiView_Histogram_Index_hh
+
+#include	"Plastic_Image.hh"
+
+#include	<QCache>
+#include	<QRect>
+#include	<QPoint>
+#include	<QList>
+#include	<QVector>
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/**	A <i>Histogram_Index</i> caches source image data histograms for
+	square blocks of the source image.
+
+	The source image space is partitioned into a grid of blocks, each
+	{@link block_size() block size} pixels on a side, with the first
+	block at the image origin. The histograms of the three display bands
+	for a block are {@link insert(const QPoint&, Block*) inserted} into
+	the index once they have been counted. The histograms for an
+	arbitrary image region may then be assembled by {@link
+	add(QVector<Histogram*>, const QPoint&) adding} the indexed
+	histograms of the blocks that are entirely within the {@link
+	blocks_region(const QRect&) const blocks region} of the image region
+	and counting only the pixels of the {@link edge_regions(const QRect&)
+	const edge regions} that remain.
+
+	Block histograms are held in a cache limited by the {@link
+	max_index_size() maximum index size}; the least recently used block
+	histograms are discarded to make room for new ones. Only the range of
+	histogram entries from the first to the last non-zero count is held
+	for a block.
+
+	The indexed histograms are only valid for the band map and image
+	data they were counted from. The index is {@link reset(int, const
+	unsigned int*) reset} when the block size or band map changes, and
+	the blocks that intersect an image region whose data has changed may
+	be {@link invalidate(const QRect&) invalidated}.
+
+	<b>N.B.</b>: A Histogram_Index is not thread safe.
+
+	@version	$Revision: 1.1 $
+*/
+class Histogram_Index
+{
+public:
+/*==============================================================================
+	Types
+*/
+typedef Plastic_Image::Histogram	Histogram;
+
+/**	The histograms of the three display bands for an image block.
+*/
+class Block
+{
+public:
+/**	Construct a Block from a set of histograms.
+
+	@param	histograms	A QVector of three Histogram pointers. A NULL
+		Histogram pointer produces an empty Block histogram.
+*/
+explicit Block (const QVector<Histogram*>& histograms);
+
+/**	Add the Block histograms to a set of histograms.
+
+	Each histogram is enlarged as necessary to hold the Block histogram
+	entries. A histogram that is shared by more than one band is only
+	added to once.
+
+	@param	histograms	A QVector of three Histogram pointers. A NULL
+		Histogram pointer is ignored.
+*/
+void add_to (QVector<Histogram*> histograms) const;
+
+/**	Get the amount of storage used by the Block histograms.
+
+	@return	The number of bytes of histogram storage.
+*/
+int size () const;
+
+private:
+
+//	Index of the first histogram entry held for each band.
+int
+	Offset[3];
+//	Histogram entries from the first to the last non-zero count.
+Histogram
+	Counts[3];
+};
+
+/*==============================================================================
+	Constants
+*/
+//!	Class identification name with source code version and date.
+static const char* const
+	ID;
+
+//!	The default size of an index block side.
+static const int
+	DEFAULT_BLOCK_SIZE;
+
+//!	The default maximum amount of index storage in bytes.
+static const int
+	DEFAULT_MAX_INDEX_SIZE;
+
+/*==============================================================================
+	Constructors
+*/
+/**	Construct an empty Histogram_Index.
+
+	@param	block_size	The size of an index block side. A value less
+		than one is replaced with the DEFAULT_BLOCK_SIZE.
+*/
+explicit Histogram_Index (int block_size = DEFAULT_BLOCK_SIZE);
+
+/*==============================================================================
+	Accessors
+*/
+/**	Get the index block size.
+
+	@return	The size of an index block side.
+*/
+inline int block_size () const
+	{return Block_Size;}
+
+/**	Set the maximum amount of storage for indexed block histograms.
+
+	If the amount of indexed histogram storage is larger than the new
+	maximum the least recently used block histograms are discarded.
+
+	@param	size	The maximum number of bytes of storage.
+*/
+void max_index_size (int size);
+
+/**	Get the maximum amount of storage for indexed block histograms.
+
+	@return	The maximum number of bytes of storage.
+*/
+inline int max_index_size () const
+	{return Blocks.maxCost ();}
+
+/**	Get the number of indexed blocks.
+
+	@return	The number of blocks with indexed histograms.
+*/
+inline int blocks () const
+	{return Blocks.count ();}
+
+/*==============================================================================
+	Index
+*/
+/**	Reset the index for a block size and band map.
+
+	If either the block size or band map differ from those in effect
+	the index is {@link clear() cleared}.
+
+	@param	block_size	The size of an index block side. A value less
+		than one is replaced with the DEFAULT_BLOCK_SIZE.
+	@param	band_map	A pointer to an array of three source band
+		indices. If NULL a default band map with bands 0, 1, 2 is used.
+	@return	true if the index was cleared; false otherwise.
+*/
+bool reset (int block_size, const unsigned int* band_map);
+
+/**	Clear the index.
+
+	All indexed block histograms are discarded.
+*/
+void clear ();
+
+/**	Invalidate the blocks that intersect an image region.
+
+	@param	image_region	A QRect for the region of the image with
+		changed image data.
+*/
+void invalidate (const QRect& image_region);
+
+/**	Get the region covered by all the blocks entirely within an image
+	region.
+
+	@param	image_region	A QRect region of the image.
+	@return	A QRect aligned with the index block grid. This will be
+		empty if no block is entirely within the image region.
+*/
+QRect blocks_region (const QRect& image_region) const;
+
+/**	Get the regions of an image region outside of its {@link
+	blocks_region(const QRect&) const blocks region}.
+
+	The top and bottom edge regions span the full width of the image
+	region; the left and right edge regions span the height of the
+	blocks region.
+
+	@param	image_region	A QRect region of the image.
+	@return	A QList of up to four non-empty QRect edge regions. If the
+		image region has no blocks region the list will contain only the
+		image region.
+*/
+QList<QRect> edge_regions (const QRect& image_region) const;
+
+/**	Get the image region of a block.
+
+	@param	block	A QPoint block grid coordinate.
+	@return	A QRect for the image region of the block.
+*/
+QRect block_region (const QPoint& block) const;
+
+/**	Add the indexed histograms of a block to a set of histograms.
+
+	@param	histograms	A QVector of three Histogram pointers.
+	@param	block	A QPoint block grid coordinate.
+	@return	true if the block is indexed and its histograms were added;
+		false if the block is not indexed.
+	@see	Block::add_to(QVector<Histogram*>) const
+*/
+bool add (QVector<Histogram*> histograms, const QPoint& block) const;
+
+/**	Insert block histograms into the index.
+
+	@param	block	A QPoint block grid coordinate.
+	@param	histograms	A pointer to the Block histograms. Ownership of
+		the Block is transferred to the index; it may be deleted
+		immediately if it is larger than the {@link max_index_size()
+		maximum index size}.
+	@return	true if the Block was indexed; false otherwise.
+*/
+bool insert (const QPoint& block, Block* histograms);
+
+/*==============================================================================
+	Helpers
+*/
+private:
+
+static quint64 block_key (const QPoint& block);
+static QPoint block_coordinate (quint64 key);
+
+/*==============================================================================
+	Data
+*/
+private:
+
+int
+	Block_Size;
+
+unsigned int
+	Band_Map[3];
+
+QCache<quint64, Block>
+	Blocks;
+};
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
+#endif
@@ -27,6 +27,7 @@ Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
 
 #include <QString>
 #include <QPainter>
+#include <qmath.h>
 
 #include <qwt_plot.h>
 #include <qwt_series_data.h>
@@ -280,9 +281,7 @@ clog << ">>> Histogram_Plot @ " << (void*)this << "::draw" << endl
 	 << "    orientation = " << (attribute_is_set (HORIZONTAL_BARS) ?
 			"HORIZONTAL_BARS" : "VERTICAL_BARS") << endl;
 #endif
-int
-	bars = (int)Data->size ();
-if (! bars)
+if (! Data->size ())
 	{
 	#if ((DEBUG_SECTION) & DEBUG_DRAW)
 	clog << "    no bars" << endl
@@ -292,12 +291,45 @@ if (! bars)
 	}
 bool
 	horizontal = attribute_is_set (HORIZONTAL_BARS);
+
+/*	Level of detail.
+
+	Only the data content within the visible interval of the data
+	axis is used, decimated to the minimum and maximum values for each
+	pixel column of the canvas. The painting cost is thus proportional
+	to the canvas size rather than the number of data content values.
+*/
+const QwtScaleMap
+	&data_map = horizontal ? yMap : xMap;
+double
+	interval_min = qMin (data_map.s1 (), data_map.s2 ()),
+	interval_max = qMax (data_map.s1 (), data_map.s2 ());
+const QVector<QPointF>
+	&samples = Data->decimated (interval_min, interval_max,
+		qMax (1, qCeil (qAbs (data_map.p2 () - data_map.p1 ()))));
+int
+	bars = samples.size ();
+if (! bars)
+	{
+	#if ((DEBUG_SECTION) & DEBUG_DRAW)
+	clog << "    no bars in " << interval_min << " to " << interval_max << endl
+		 << "<<< Histogram_Plot::draw" << endl;
+	#endif
+	return;
+	}
+
+//	The trailing edge of the last bar.
 double
-	base = Data->base (),
-	increment = Data->increment ();
+	end = Data->x (Data->size ());
+if (Data->increment () < 0.0)
+	end = qMax (end, interval_min);
+else
+	end = qMin (end, interval_max);
 #if ((DEBUG_SECTION) & DEBUG_DRAW)
-clog << "         base = " << base << endl
-	 << "    increment = " << increment << endl;
+clog << "         base = " << Data->base () << endl
+	 << "    increment = " << Data->increment () << endl
+	 << "      samples = " << bars << endl
+	 << "          end = " << end << endl;
 #endif
 
 /*	Bar rectangle.
@@ -371,14 +403,14 @@ int
 if (horizontal)
 	{
 	bottom = xMap.transform (0.0);
-	last_edge = yMap.transform (base);
-	last_top = xMap.transform (Data->y (0));
+	last_edge = yMap.transform (samples.at (0).x ());
+	last_top = xMap.transform (samples.at (0).y ());
 	}
 else
 	{
 	bottom = yMap.transform (0.0);
-	last_edge = xMap.transform (base);
-	last_top = yMap.transform (Data->y (0));
+	last_edge = xMap.transform (samples.at (0).x ());
+	last_top = yMap.transform (samples.at (0).y ());
 	}
 last_length = qAbs (last_top - bottom);
 #if ((DEBUG_SECTION) & DEBUG_DRAW)
@@ -391,24 +423,35 @@ for (int bar = 0;
 		 bar++)
 	{
 	#if ((DEBUG_SECTION) & DEBUG_DRAW)
-	clog << "    bar " << bar << " -" << endl
-		 << "      value = " << Data->y (bar) << endl;
+	clog << "    bar " << bar << " -" << endl;
+	if (bar < bars)
+		clog << "      value = " << samples.at (bar).y () << endl;
 	#endif
 	if (horizontal)
 		{
-		next_edge = yMap.transform (base);
 		if (bar < bars)
-			next_top = xMap.transform (Data->y (bar));
+			{
+			next_edge = yMap.transform (samples.at (bar).x ());
+			next_top = xMap.transform (samples.at (bar).y ());
+			}
 		else
+			{
+			next_edge = yMap.transform (end);
 			next_top = last_top;
+			}
 		}
 	else
 		{
-		next_edge = xMap.transform (base);
 		if (bar < bars)
-			next_top = yMap.transform (Data->y (bar));
+			{
+			next_edge = xMap.transform (samples.at (bar).x ());
+			next_top = yMap.transform (samples.at (bar).y ());
+			}
 		else
+			{
+			next_edge = xMap.transform (end);
 			next_top = last_top;
+			}
 		}
 	#if ((DEBUG_SECTION) & DEBUG_DRAW)
 	clog << "      last = "
@@ -417,7 +460,6 @@ for (int bar = 0;
 			<< next_edge << " edge, " << next_top << " top" << endl;
 	#endif
 
-	base += increment;
 	if (last_top == next_top &&
 		bar < bars)
 		{
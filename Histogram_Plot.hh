@@ -254,6 +254,10 @@ virtual QRectF boundingRect () const;
 /**	Paints the histogram bars on a canvas region using horizontal
 	and vertical scaling maps.
 
+	Only the data content within the visible interval of the data axis
+	is painted, using the {@link Count_Sequence::decimated(double,
+	double, int) decimated samples} for the pixel size of the interval.
+
 	@param	painter	The QPainter to use for painting the histogram
 		bars.
 	@param	x_scale_map	A QwtScaleMap to use for mapping horizontal (x)
@@ -38,6 +38,7 @@ Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
 #include	<QtCore/qmath.h>
 #include	<QSettings>
 #include	<QScriptEngine>
+#include	<QScriptValueIterator>
 #include	<QStringList>
 
 using std::string;
@@ -138,7 +139,12 @@ Image_Info_Panel::Image_Info_Panel
 		Image_Data (tr (IMAGE_DATA_LABEL)),
 		Projector (NULL),
 		Statistics (NULL),
-		Exception_List (QList<int>())
+		Exception_List (QList<int>()),
+		Script_Compiled (false),
+		Average_Valid (false),
+		Average_Result (0),
+		Average_Lower_Limit (-1),
+		Average_Upper_Limit (-1)
 		
 		
 {
@@ -174,6 +180,7 @@ layout->setSizeConstraint (QLayout::SetFixedSize);
 
 layout->addWidget (image_data_panel ());
 layout->addWidget (Script_Panel = create_script_engine ());
+script_modified ();
 //Only show Script_Panel if there is a script, and the user wants the panel open.
 Script_Panel->setVisible(Show_Script && (Script != ""));
 
@@ -1009,6 +1016,11 @@ return representation;
 void Image_Info_Panel::update_statistics(Stats *stats) {
 	Statistics = stats;
 	Use_Avg_Rgb = Use_Avg_Rgb;
+	Average_Valid = false;
+}
+
+void Image_Info_Panel::histograms_changed() {
+	Average_Valid = false;
 }
 
 void Image_Info_Panel::update_region_stats() {
@@ -1022,11 +1034,25 @@ void Image_Info_Panel::update_region_stats() {
 void Image_Info_Panel::add_exception(int exception) {
 	if(Exception_List.indexOf(exception) == -1) {
 		Exception_List.push_back(exception);
+		exceptions_modified();
 	}
 }
 
 void Image_Info_Panel::clear_exceptions() {
 	Exception_List.clear();
+	exceptions_modified();
+}
+
+//	Exceptions are held in a bit array indexed by DN.
+void Image_Info_Panel::exceptions_modified() {
+	int size = 0;
+	for(int i = 0; i < Exception_List.size(); ++i)
+		size = qMax(size, Exception_List.at(i) + 1);
+	Exceptions.fill(false, size);
+	for(int i = 0; i < Exception_List.size(); ++i)
+		if(Exception_List.at(i) >= 0)
+			Exceptions.setBit(Exception_List.at(i));
+	Average_Valid = false;
 }
  
 
@@ -1140,60 +1166,152 @@ void Image_Info_Panel::set_property_f(const char * name, double data){
 
 void Image_Info_Panel::evaluate_script() {
 	if((Evaluate_R || Evaluate_G || Evaluate_B) && Use_Avg_Rgb && Statistics != NULL) {
-		QVector<Plastic_Image::Histogram*> &histograms = Statistics->histograms();
-		int lower_limit = Statistics->lower_limit();
-		int upper_limit = histograms[0]->size () - Statistics->upper_limit() - 1;
-		int count = 0;
-		qsreal result = 0;
-		
-		for(int i = lower_limit; i <= upper_limit; ++i) {
-			QScriptValue val;
-			bool skip = false;
-			int sum = 0;
-			for(int j = 0; j < Exception_List.size(); ++j) {
-				if(i == Exception_List.at(i)) {
-					skip = true;
-					break;
-				}
-			}
-			if(!skip) {
-				if(Evaluate_R) {
-					Global_Object.setProperty("red", i);
-					sum = histograms[0]->at(i);
-				}
-				if(Evaluate_G) {
-					if(histograms[1] != NULL) {
-						Global_Object.setProperty("green", i);
-						sum += histograms[1]->at(i);
-					}
-					else {
-						Global_Object.setProperty("green", 0);
-					}
-				}
-				if(Evaluate_B) {
-					if(histograms[2] != NULL) {
-						Global_Object.setProperty("blue", i);
-						sum += histograms[2]->at(i);
-					}
-					else {
-						Global_Object.setProperty("blue", 0);
-					}
-				}
-				
-				val = Engine->evaluate(Script);
-				if(!val.isNumber()) {
-					return;
-				}
-				count += sum;
-				result += val.toNumber() * sum;
+		qsreal result;
+		if(evaluate_average_script(result))
+			Script_Output->setNum(result);
+	}
+	else {
+		Script_Output->setText(Engine->evaluate(Script_Program).toString());
+	}
+}
+
+//	The script is to be recompiled.
+void Image_Info_Panel::script_modified() {
+	Script_Program = QScriptProgram(Script);
+	Script_Compiled = false;
+	Average_Valid = false;
+}
+
+//	The numeric script engine properties are the script constants.
+Compiled_Expression::Constants Image_Info_Panel::script_constants() const {
+	Compiled_Expression::Constants constants;
+	QScriptValueIterator property(Global_Object);
+	while(property.hasNext()) {
+		property.next();
+		if(property.value().isNumber())
+			constants.insert(property.name(), property.value().toNumber());
+	}
+	return constants;
+}
+
+/*	Compile the script for average pixel value evaluation.
+
+	The script is recompiled when any of the constants it uses has a
+	different value in the script engine.
+*/
+bool Image_Info_Panel::compile_average_script() {
+	QStringList variables;
+	variables << "red" << "green" << "blue";
+	if(!Script_Compiled) {
+		Compiled_Script.compile(Script, variables, script_constants());
+		Script_Compiled = true;
+		Average_Valid = false;
+	}
+	else if(Compiled_Script.is_valid()) {
+		Compiled_Expression::Constants constants(Compiled_Script.constants());
+		Compiled_Expression::Constants::const_iterator end = constants.constEnd();
+		for(Compiled_Expression::Constants::const_iterator i = constants.constBegin(); i != end; ++i) {
+			QScriptValue value = Global_Object.property(i.key());
+			double number = value.toNumber();
+			if(!value.isNumber() ||
+				!(number == i.value() || (number != number && i.value() != i.value()))) {
+				Compiled_Script.compile(Script, variables, script_constants());
+				Average_Valid = false;
+				break;
 			}
 		}
-		result /= count;
-		Script_Output->setNum(result);
+	}
+	return Compiled_Script.is_valid();
+}
+
+/*	Evaluate the script as the histogram weighted average over the DNs
+	within the statistics limits.
+
+	The bins with no data, or whose DN is an exception, are skipped. The
+	compiled script is evaluated for all the remaining bins at once and
+	its result is cached.
+*/
+bool Image_Info_Panel::evaluate_average_script(qsreal &result) {
+	QVector<Plastic_Image::Histogram*> &histograms = Statistics->histograms();
+	if(histograms.isEmpty() || histograms[0] == NULL)
+		return false;
+	int lower_limit = Statistics->lower_limit();
+	int upper_limit = histograms[0]->size () - Statistics->upper_limit() - 1;
+
+	bool compiled = compile_average_script();
+	if(compiled && Average_Valid &&
+		lower_limit == Average_Lower_Limit &&
+		upper_limit == Average_Upper_Limit) {
+		result = Average_Result;
+		return true;
+	}
+
+	//	Collect the DNs to be evaluated and their pixel counts.
+	QVector<double> dns, counts;
+	for(int i = qMax(lower_limit, 0); i <= upper_limit; ++i) {
+		if(i < Exceptions.size() && Exceptions.testBit(i))
+			continue;
+		quint64 sum = 0;
+		if(Evaluate_R)
+			sum = histograms[0]->at(i);
+		if(Evaluate_G && histograms.size() > 1 && histograms[1] != NULL)
+			sum += histograms[1]->at(i);
+		if(Evaluate_B && histograms.size() > 2 && histograms[2] != NULL)
+			sum += histograms[2]->at(i);
+		if(sum) {
+			dns.append(i);
+			counts.append(sum);
+		}
+	}
+
+	QVector<double> values(dns.size());
+	const char *names[3] = {"red", "green", "blue"};
+	bool evaluated[3] = {Evaluate_R, Evaluate_G, Evaluate_B};
+	if(compiled) {
+		QVector<double> band_values[3];
+		const double *variable_values[3];
+		for(int band = 0; band < 3; ++band) {
+			if(!evaluated[band])
+				band_values[band].fill(Global_Object.property(names[band]).toNumber(), dns.size());
+			else if(band == 0 || (histograms.size() > band && histograms[band] != NULL))
+				band_values[band] = dns;
+			else
+				band_values[band].fill(0.0, dns.size());
+			variable_values[band] = band_values[band].constData();
+		}
+		Compiled_Script.evaluate(variable_values, values.data(), dns.size());
 	}
 	else {
-		Script_Output->setText(Engine->evaluate(Script).toString());
+		for(int k = 0; k < dns.size(); ++k) {
+			for(int band = 0; band < 3; ++band) {
+				if(!evaluated[band])
+					continue;
+				if(band == 0 || (histograms.size() > band && histograms[band] != NULL))
+					Global_Object.setProperty(names[band], static_cast<int>(dns[k]));
+				else
+					Global_Object.setProperty(names[band], 0);
+			}
+			QScriptValue val = Engine->evaluate(Script_Program);
+			if(!val.isNumber())
+				return false;
+			values[k] = val.toNumber();
+		}
 	}
+
+	qsreal count = 0;
+	result = 0;
+	for(int k = 0; k < dns.size(); ++k) {
+		count += counts[k];
+		result += values[k] * counts[k];
+	}
+	result /= count;
+
+	//	Only the compiled script result can be known to be unchanged.
+	Average_Valid = compiled;
+	Average_Result = result;
+	Average_Lower_Limit = lower_limit;
+	Average_Upper_Limit = upper_limit;
+	return true;
 }
  
 void Image_Info_Panel::set_metadata(idaeim::PVL::Aggregate *metadata) {
@@ -1201,7 +1319,7 @@ void Image_Info_Panel::set_metadata(idaeim::PVL::Aggregate *metadata) {
 	unset_properties();
 	//clear properties list
 	Properties_List.clear();
-	Exception_List.clear();
+	clear_exceptions();
 	//get new properties
 	if(metadata != NULL) {
 		get_properties(*metadata);
@@ -1244,6 +1362,7 @@ void Image_Info_Panel::set_metadata(idaeim::PVL::Aggregate *metadata) {
 	}
 	emit variables_updated(Properties_List);
 	preparse_script(Script);
+	script_modified();
 	Script_Value->setText(Script);
 	evaluate_script();
 }
@@ -1439,6 +1558,7 @@ void Image_Info_Panel::script_changed(const QString& script) {
 	else {
 		Script = script;
 		preparse_script(Script);
+		script_modified();
 		Script_Value->setText(Script);
 		check_names();
 		evaluate_script();
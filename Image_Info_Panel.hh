@@ -27,9 +27,12 @@ Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
 #include	"Plastic_Image.hh"
 #include	"PVL.hh"
 #include    "Stats.hh"
+#include	"Compiled_Expression.hh"
 #include	<QFrame>
 #include	<QScriptEngine>
+#include	<QScriptProgram>
 #include	<QStringList>
+#include	<QBitArray>
 
 //	Forward references.
 class QWidget;
@@ -112,6 +115,11 @@ void clear_exceptions();
 void evaluate_script();
 void update_region_stats();
 void update_statistics(Stats *stats);
+/**	Notify the panel that the statistics histograms have been refreshed.
+
+	The cached average pixel value script result is discarded.
+*/
+void histograms_changed();
 QList<bool> *parse_variable_names(QList<QString> *list);
 void check_names();
 
@@ -176,6 +184,12 @@ void unset_properties();
 
 void initialize_script_values();
 
+void script_modified();
+void exceptions_modified();
+Compiled_Expression::Constants script_constants() const;
+bool compile_average_script();
+bool evaluate_average_script(qsreal &result);
+
 /*==============================================================================
 	Data
 */
@@ -255,6 +269,30 @@ int
 	
 QList<int>
 	Exception_List;
+
+/*	Average pixel value script evaluation.
+
+	The script is compiled once, when it or the metadata changes, and
+	evaluated over all the histogram bins as a batch. Scripts outside of
+	the Compiled_Expression syntax are run from a precompiled
+	QScriptProgram. The result is cached until the histograms, limits,
+	exceptions, script or the script constants change.
+*/
+Compiled_Expression
+	Compiled_Script;
+QScriptProgram
+	Script_Program;
+bool
+	Script_Compiled;
+QBitArray
+	Exceptions;
+bool
+	Average_Valid;
+qsreal
+	Average_Result;
+int
+	Average_Lower_Limit,
+	Average_Upper_Limit;
 };
 
 }	//	namespace HiRISE
@@ -0,0 +1,253 @@
+/*	Image_Pyramid
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#include	"Image_Pyramid.hh"
+
+#include	<QMutexLocker>
+
+
+#if defined (DEBUG_SECTION)
+/*******************************************************************************
+	DEBUG_SECTION controls
+
+	DEBUG_SECTION report selection options.
+	Define any of the following options to obtain the desired debug reports:
+*/
+#define DEBUG_OFF			0
+#define DEBUG_ALL			-1
+#define DEBUG_LEVELS		(1 << 0)
+
+#define DEBUG_DEFAULT		DEBUG_ALL
+
+#if (DEBUG_SECTION+0) == 0
+#undef  DEBUG_SECTION
+#define DEBUG_SECTION DEBUG_OFF
+#else
+#include	<iostream>
+using std::clog;
+using std::endl;
+#endif
+
+#endif	//	DEBUG_SECTION
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/*==============================================================================
+	Constants
+*/
+const char* const
+	Image_Pyramid::ID =
+		"UA::HiRISE::Image_Pyramid ($Revision: 1.1 $ $Date: 2026/10/17 00:00:00 $)";
+
+/*==============================================================================
+	Constructors
+*/
+Image_Pyramid::Image_Pyramid
+	(
+	const QImage&	image
+	)
+	:	Produced_Levels (0)
+{
+if (! image.isNull () &&
+	image.width () > 0 &&
+	image.height () > 0)
+	{
+	unsigned int
+		levels = 1;
+	int
+		width  = image.width (),
+		height = image.height ();
+	while (width > 1 ||
+		   height > 1)
+		{
+		width  = (width  + 1) >> 1;
+		height = (height + 1) >> 1;
+		++levels;
+		}
+	Levels.resize (levels);
+	Levels[0] = image;
+	Produced_Levels = 1;
+	}
+}
+
+/*==============================================================================
+	Accessors
+*/
+unsigned int
+Image_Pyramid::nearest_resolution_level
+	(
+	double	scale
+	) const
+{
+unsigned int
+	resolution_level = 1;
+if (Levels.isEmpty ())
+	resolution_level = 0;
+else
+if (scale > 0.0 &&
+	scale <= 0.5)
+	{
+	unsigned int
+		resolution_levels = Levels.size (),
+		scale_level = static_cast<unsigned int>(1.0 / scale);
+	//	The most significant bit number of the scale_level.
+	while ((scale_level >>= 1) &&
+			++resolution_level < resolution_levels) ;
+	}
+return resolution_level;
+}
+
+
+const QImage*
+Image_Pyramid::level
+	(
+	unsigned int	resolution_level
+	)
+{
+if (Levels.isEmpty ())
+	return NULL;
+if (resolution_level == 0)
+	resolution_level = 1;
+else
+if (resolution_level > static_cast<unsigned int>(Levels.size ()))
+	resolution_level = Levels.size ();
+
+QMutexLocker
+	lock (&Lock);
+while (Produced_Levels < resolution_level)
+	{
+	#if ((DEBUG_SECTION) & DEBUG_LEVELS)
+	clog << ">-< Image_Pyramid::level: producing level "
+			<< (Produced_Levels + 1) << endl;
+	#endif
+	Levels[Produced_Levels] = reduce (Levels[Produced_Levels - 1]);
+	++Produced_Levels;
+	}
+return &Levels[resolution_level - 1];
+}
+
+
+qint64
+Image_Pyramid::reduced_size () const
+{
+QMutexLocker
+	lock (&Lock);
+qint64
+	size = 0;
+for (unsigned int
+		index = 1;
+		index < Produced_Levels;
+		index++)
+	size += (qint64)Levels[index].bytesPerLine () * Levels[index].height ();
+return size;
+}
+
+/*==============================================================================
+	Helpers
+*/
+QImage
+Image_Pyramid::reduce
+	(
+	const QImage&	image
+	)
+{
+const QImage
+	source ((image.format () == QImage::Format_RGB32 ||
+			 image.format () == QImage::Format_ARGB32) ?
+		image : image.convertToFormat (QImage::Format_RGB32));
+int
+	source_width  = source.width (),
+	source_height = source.height (),
+	width  = (source_width  + 1) >> 1,
+	height = (source_height + 1) >> 1,
+	line,
+	sample,
+	last_sample;
+QImage
+	reduced (width, height, QImage::Format_RGB32);
+
+/*	The red and blue components of four pixels are summed in parallel
+	in the two 16-bit halves of a 32-bit value; the sum of four 8-bit
+	components can not overflow 16 bits. The green components are summed
+	separately. The reduced pixels are opaque; alpha is not averaged.
+*/
+const QRgb
+	*line_0,
+	*line_1;
+QRgb
+	*reduced_line,
+	pixel;
+quint32
+	red_blue,
+	green;
+for (line = 0;
+	 line < height;
+	 line++)
+	{
+	line_0 = reinterpret_cast<const QRgb*>
+		(source.constScanLine (line << 1));
+	line_1 = ((line << 1) + 1 < source_height) ?
+		reinterpret_cast<const QRgb*>
+			(source.constScanLine ((line << 1) + 1)) :
+		line_0;
+	reduced_line = reinterpret_cast<QRgb*>(reduced.scanLine (line));
+	for (sample = 0;
+		 sample < width;
+		 sample++)
+		{
+		last_sample = (sample << 1) + 1;
+		if (last_sample >= source_width)
+			last_sample = source_width - 1;
+
+		pixel = line_0[sample << 1];
+		red_blue = pixel & 0x00FF00FF;
+		green = (pixel >> 8) & 0x000000FF;
+		pixel = line_0[last_sample];
+		red_blue += pixel & 0x00FF00FF;
+		green += (pixel >> 8) & 0x000000FF;
+		pixel = line_1[sample << 1];
+		red_blue += pixel & 0x00FF00FF;
+		green += (pixel >> 8) & 0x000000FF;
+		pixel = line_1[last_sample];
+		red_blue += pixel & 0x00FF00FF;
+		green += (pixel >> 8) & 0x000000FF;
+
+		reduced_line[sample] = 0xFF000000 |
+			(((red_blue + 0x00020002) >> 2) & 0x00FF00FF) |
+			(((green + 2) >> 2) << 8);
+		}
+	}
+#if ((DEBUG_SECTION) & DEBUG_LEVELS)
+clog << ">-< Image_Pyramid::reduce: "
+		<< source_width << 'x' << source_height << " -> "
+		<< width << 'x' << height << endl;
+#endif
+return reduced;
+}
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
@@ -0,0 +1,155 @@
+/*	Image_Pyramid
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#ifndef HiView_Image_Pyramid_hh
+#define HiView_Image_Pyramid_hh
+
+#include	<QImage>
+#include	<QVector>
+#include	<QMutex>
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/**	An <i>Image_Pyramid</i> provides reduced resolution levels of a
+	QImage.
+
+	Resolution level 1 is the full resolution image. Each successive
+	resolution level is half the width and height - rounded up - of the
+	previous level, with each pixel the box filtered average of the 2x2
+	pixels of the previous level. The last resolution level is a single
+	pixel.
+
+	The resolution levels are computed lazily: A {@link level(unsigned
+	int) level} is not produced until it is first requested, and then
+	only from the closest level already produced. Reduced resolution
+	levels are 32-bit RGB images regardless of the format of the full
+	resolution image.
+
+	An Image_Pyramid is thread safe. Once a level has been produced it
+	is never changed, so a level image pointer obtained by one thread
+	remains valid, and may be used without locking, for the life of the
+	Image_Pyramid.
+
+	@version	$Revision: 1.1 $
+*/
+class Image_Pyramid
+{
+public:
+/*==============================================================================
+	Constants
+*/
+//!	Class identification name with source code version and date.
+static const char* const
+	ID;
+
+/*==============================================================================
+	Constructors
+*/
+/**	Construct an Image_Pyramid for a QImage.
+
+	No reduced resolution levels are produced.
+
+	@param	image	The full resolution QImage. The image data is
+		implicitly shared, not copied.
+*/
+explicit Image_Pyramid (const QImage& image);
+
+private:
+//	Not copyable.
+Image_Pyramid (const Image_Pyramid&);
+Image_Pyramid& operator= (const Image_Pyramid&);
+
+/*==============================================================================
+	Accessors
+*/
+public:
+
+/**	Get the number of resolution levels.
+
+	@return	The number of resolution levels, including the full
+		resolution image. This will be zero if the image is empty.
+*/
+inline unsigned int resolution_levels () const
+	{return Levels.size ();}
+
+/**	Get the resolution level for an image scale.
+
+	@param	scale	A positive image scaling factor.
+	@return	The resolution level at or above the level that produces the
+		image scale. This will be 1 for any scale greater than 0.5.
+	@see	JP2_Image::nearest_resolution_level(double)
+*/
+unsigned int nearest_resolution_level (double scale) const;
+
+/**	Get a resolution level image.
+
+	If the resolution level has not yet been produced it, and any
+	intervening levels, are produced now.
+
+	@param	resolution_level	The resolution level. A value of zero is
+		taken to be 1; a value greater than the number of {@link
+		resolution_levels() resolution levels} is taken to be the last
+		level.
+	@return	A pointer to the resolution level QImage. This will be NULL
+		if the image is empty.
+*/
+const QImage* level (unsigned int resolution_level);
+
+/**	Get the number of bytes of reduced resolution image data.
+
+	@return	The number of bytes of image data in the reduced resolution
+		levels that have been produced.
+*/
+qint64 reduced_size () const;
+
+/*==============================================================================
+	Helpers
+*/
+/**	Produce a box filtered half size image.
+
+	@param	image	A QImage to be reduced.
+	@return	A 32-bit RGB QImage.
+*/
+static QImage reduce (const QImage& image);
+
+/*==============================================================================
+	Data
+*/
+private:
+
+QVector<QImage>
+	Levels;
+unsigned int
+	Produced_Levels;
+
+mutable QMutex
+	Lock;
+};
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
+#endif
@@ -131,12 +131,6 @@ const bool
 	Image_Renderer::CANCELABLE				= true;
 
 /*==============================================================================
-	Class data
-*/
-QMutex
-	Image_Renderer::Rendering_Lock;
-
-/*------------------------------------------------------------------------------
 	Defaults
 */
 #ifndef DEFAULT_MIN_SOURCE_IMAGE_AREA
@@ -196,19 +190,15 @@ Image_Renderer_Rendering_Monitor
 bool
 notification
 	(
-	#if ((DEBUG_SECTION) & (DEBUG_RENDER | \
-					DEBUG_NOTIFY | \
-					DEBUG_NOTIFY_VISIBLE | \
-					DEBUG_LOCATION))
 	Plastic_Image&								image,
-	#else
-	Plastic_Image&,
-	#endif
 	Plastic_Image::Rendering_Monitor::Status	status,
 	const QString&								message,
 	const QRect&								tile_region
 	)
 {
+//	The active tile with the image being rendered.
+Image_Tile
+	*image_tile = Owner ? Owner->rendering_tile (&image) : NULL;
 #if ((DEBUG_SECTION) & (DEBUG_RENDER | \
 				DEBUG_NOTIFY | \
 				DEBUG_NOTIFY_VISIBLE | \
@@ -218,40 +208,44 @@ void*
 QString
 	pathname (object_pathname (Owner));
 #if ((DEBUG_SECTION) & DEBUG_NOTIFY_VISIBLE)
-if (Owner->Active_Tile->is_high_priority ())
+if (image_tile &&
+	image_tile->is_high_priority ())
 #endif
+{
 clog << "++> Image_Renderer::Image_Renderer_Rendering_Monitor::notification "
 		<< thread_ID << endl
 	 << "    status " << status << " \"" << message << '"' << endl
 	 << "    Owner Image_Renderer @ " << (void*)Owner << ' ' << pathname << endl
 	 << "    image @ " << (void*)&image << " - " << image.source_name () << endl
-	 << "    tile_region = " << tile_region << endl
-	 << "    Active_Tile " << *(Owner->Active_Tile) << endl;
+	 << "    tile_region = " << tile_region << endl;
+if (image_tile)
+	clog << "    active tile " << *image_tile << endl;
+}
 #endif
-if (Owner)
+if (image_tile)
 	{
 	//	>>> SIGNAL <<<
 	Owner->send_status_notice (message);
 
-	if (! Owner->Active_Tile->Tile_Region.isEmpty () &&	//	Visible in display?
+	if (! image_tile->Tile_Region.isEmpty () &&	//	Visible in display?
 		(status & Plastic_Image::Rendering_Monitor::RENDERED_DATA_MASK))
 		{
 		//	>>> SIGNAL <<<
 		Owner->send_rendered
-			(Owner->Active_Tile->Tile_Coordinate, tile_region);
+			(image_tile->Tile_Coordinate, tile_region);
 		#if ((DEBUG_SECTION) & (DEBUG_RENDER | \
 						DEBUG_NOTIFY | \
 						DEBUG_NOTIFY_VISIBLE | \
 						DEBUG_LOCATION))
 		clog << "      notification sent rendered signal" << endl;
 		#if ((DEBUG_SECTION) & DEBUG_NOTIFY_VISIBLE)
-		if (Owner->Active_Tile->is_high_priority ())
+		if (image_tile->is_high_priority ())
 			{
 		#endif
 			#if ((DEBUG_SECTION) & DEBUG_PROMPT)
 			char
 				input[4];
-			clog << "vis. tile " << Owner->Active_Tile->Tile_Coordinate
+			clog << "vis. tile " << image_tile->Tile_Coordinate
 				<< " region " << tile_region << " > ";
 			cin.getline (input, 2);
 			if (input[0] == 'q')
@@ -352,9 +346,11 @@ QString
 bool
 	locked = Queue_Lock.tryLock ();
 LOCK_LOG;
-if (Active_Tile)
-	clog << "    Image_Renderer::Active_Tile -" << endl
-		 << "    " << *Active_Tile << endl;
+if (! Active_Tiles.isEmpty ())
+	{
+	clog << "    Image_Renderer::Active_Tiles -" << endl;
+	print_queue (Active_Tiles);
+	}
 clog << "    Image_Renderer::Render_Queue" << endl
 	 << "    in " << pathname << endl;
 print_queue (Render_Queue);
@@ -447,8 +443,6 @@ Image_Renderer::Image_Renderer
 	Source_Image (new Plastic_QImage ()),
 	Max_Source_Image_Area (Default_Max_Source_Image_Area),
 	Reference_Image (Source_Image->clone (QSize (0, 0))),
-	Active_Tile (NULL),
-	Cancel (false),
 	Image_Rendering_Monitor (new Image_Renderer_Rendering_Monitor (this))
 {
 setObjectName ("Image_Renderer");
@@ -678,9 +672,11 @@ else
 LOCK_LOG;
 clog << "    Image_Renderer::queue " << thread_ID << endl
 	 << "    in " << pathname << endl;
-if (Active_Tile)
-	clog << "    Active_Tile -" << endl
-		 << "    " << *Active_Tile << endl;
+if (! Active_Tiles.isEmpty ())
+	{
+	clog << "    Active_Tiles -" << endl;
+	print_queue (Active_Tiles);
+	}
 clog << "    Render_Queue -" << endl;
 print_queue (Render_Queue);
 clog << "    Image_Renderer::queue " << thread_ID
@@ -722,8 +718,15 @@ QMutexLocker
 	queue_lock (&Queue_Lock);
 int
 	priority_status = 0;
-if (Active_Tile)
-	priority_status = Active_Tile->status ();
+if (! Active_Tiles.isEmpty ())
+	{
+	for (int
+			index = 0;
+			index < Active_Tiles.size ();
+		  ++index)
+		priority_status = qMax (priority_status,
+			Active_Tiles[index]->status ());
+	}
 else
 if (! Render_Queue.isEmpty ())
 	priority_status = Render_Queue.first ()->status ();
@@ -742,11 +745,9 @@ QMutexLocker
 bool
 	rendering;
 if (image)
-	rendering =
-		Active_Tile &&
-		Active_Tile->Image == image;
+	rendering = find_tile (image, Active_Tiles) >= 0;
 else
-	rendering = Active_Tile != NULL;
+	rendering = ! Active_Tiles.isEmpty ();
 return rendering;
 }
 
@@ -791,9 +792,11 @@ QString
 LOCK_LOG;
 clog << "    Image_Renderer::cancel " << thread_ID << endl
 	 << "    in " << pathname << endl;
-if (Active_Tile)
-	clog << "    Active_Tile -" << endl
-		 << "    " << *Active_Tile << endl;
+if (! Active_Tiles.isEmpty ())
+	{
+	clog << "    Active_Tiles -" << endl;
+	print_queue (Active_Tiles);
+	}
 clog << "    Render_Queue -" << endl;
 print_queue (Render_Queue);
 UNLOCK_LOG;
@@ -801,8 +804,7 @@ UNLOCK_LOG;
 bool
 	canceled = true;
 
-if (Active_Tile &&
-	Active_Tile->Image == image)
+if (find_tile (image, Active_Tiles) >= 0)
 	{
 	//	Cancel rendering of the active tile.
 	#if ((DEBUG_SECTION) & (DEBUG_SLOTS | DEBUG_QUEUE))
@@ -810,7 +812,7 @@ if (Active_Tile &&
 	clog << "    Image_Renderer::cancel " << thread_ID
 			<< ": abort" << endl));
 	#endif
-	canceled = abort (cancel_options);
+	canceled = abort (cancel_options, image);
 	}
 
 int
@@ -836,9 +838,11 @@ while (index--)
 #if ((DEBUG_SECTION) & DEBUG_QUEUE)
 LOCK_LOG;
 clog << "    Image_Renderer::cancel " << thread_ID << endl;
-if (Active_Tile)
-	clog << "    Active_Tile -" << endl
-		 << "    " << *Active_Tile << endl;
+if (! Active_Tiles.isEmpty ())
+	{
+	clog << "    Active_Tiles -" << endl;
+	print_queue (Active_Tiles);
+	}
 clog << "    Render_Queue after canceling image @ "
 		<< (void*)image << " -" << endl;
 print_queue (Render_Queue);
@@ -966,9 +970,11 @@ LOCK_LOG;
 clog << ">>> Image_Renderer::add_tile " << thread_ID
 		<< ": " << *image_tile << endl
 	 << "    in " << pathname << endl;
-if (Active_Tile)
-	clog << "    Active_Tile -" << endl
-		 << "    " << *Active_Tile << endl;
+if (! Active_Tiles.isEmpty ())
+	{
+	clog << "    Active_Tiles -" << endl;
+	print_queue (Active_Tiles);
+	}
 clog << "    Render_Queue -" << endl;
 print_queue (Render_Queue);
 UNLOCK_LOG;
@@ -991,19 +997,19 @@ if (index >= 0)
 	delete Delete_Queue.takeAt (index);
 	}
 
-//	Safety check for the image in the Active_Tile.
-if (Active_Tile &&
-	Active_Tile->Image == image_tile->Image)
+//	Safety check for the image in the Active_Tiles.
+index = find_tile (image_tile->Image, Active_Tiles);
+if (index >= 0)
 	{
 	#if ((DEBUG_SECTION) & DEBUG_QUEUE)
 	LOCKED_LOGGING ((
-	clog << "    add tile with image of Active_Tile -" << endl
-		 << "    " << *Active_Tile << endl));
+	clog << "    add tile with image of active tile -" << endl
+		 << "    " << *Active_Tiles[index] << endl));
 	#endif
 	image_tile->Delete_Image_When_Done
-		|= Active_Tile->Delete_Image_When_Done;
+		|= Active_Tiles[index]->Delete_Image_When_Done;
 	//	Image will be in the Render_Queue.
-	Active_Tile->Delete_Image_When_Done = false;
+	Active_Tiles[index]->Delete_Image_When_Done = false;
 	}
 
 if (Render_Queue.isEmpty () ||
@@ -1058,6 +1064,8 @@ else
 	#endif
 	Render_Queue.insert (index, image_tile);
 	}
+//	Release a rendering loop waiting for a tile to render.
+Queue_Event.set ();
 
 if (runnable ())
 	{
@@ -1072,9 +1080,11 @@ if (runnable ())
 	}
 #if ((DEBUG_SECTION) & DEBUG_QUEUE)
 LOCK_LOG;
-if (Active_Tile)
-	clog << "    Active_Tile -" << endl
-		 << "    " << *Active_Tile << endl;
+if (! Active_Tiles.isEmpty ())
+	{
+	clog << "    Active_Tiles -" << endl;
+	print_queue (Active_Tiles);
+	}
 clog << "    Render_Queue -" << endl;
 print_queue (Render_Queue);
 clog << "    in " << pathname << endl
@@ -1101,15 +1111,17 @@ LOCK_LOG;
 clog << ">>> Image_Renderer::clear " << thread_ID
 		<< ": " << cancel_options << " - " << description << endl
 	 << "    in " << pathname << endl;
-if (Active_Tile)
-	clog << "    Active_Tile -" << endl
-		 << "    " << *Active_Tile << endl;
+if (! Active_Tiles.isEmpty ())
+	{
+	clog << "    Active_Tiles -" << endl;
+	print_queue (Active_Tiles);
+	}
 clog << "    Render_Queue -" << endl;
 print_queue (Render_Queue);
 UNLOCK_LOG;
 #endif
 bool
-	//	Cancel rendering of the active tile.
+	//	Cancel rendering of the active tiles.
 	done = abort (cancel_options);
 
 int
@@ -1139,9 +1151,11 @@ while (index--)
 LOCK_LOG;
 clog << "    Image_Renderer::clear " << thread_ID << endl
 	 << "    in " << pathname << endl;
-if (Active_Tile)
-	clog << "    Active_Tile -" << endl
-		 << "    " << *Active_Tile << endl;
+if (! Active_Tiles.isEmpty ())
+	{
+	clog << "    Active_Tiles -" << endl;
+	print_queue (Active_Tiles);
+	}
 clog << "    cleared Render_Queue -" << endl;
 print_queue (Render_Queue);
 UNLOCK_LOG;
@@ -1150,6 +1164,9 @@ UNLOCK_LOG;
 //	Clear the Delete_Queue.
 delete_tiles ();
 
+//	Release a rendering loop waiting for the queue to change.
+Queue_Event.set ();
+
 if (! done &&
 	(cancel_options & WAIT_UNTIL_DONE))
 	{
@@ -1176,7 +1193,8 @@ return done;
 bool
 Image_Renderer::abort
 	(
-	int		cancel_options
+	int				cancel_options,
+	Plastic_Image*	image
 	)
 {
 //	>>> CAUTION: The Queue_Lock is expected to be locked.
@@ -1189,58 +1207,89 @@ QString
 LOCKED_LOGGING ((
 clog << ">>> Image_Renderer::abort " << thread_ID
 		<< ": " << cancel_options << " - " << description << endl
+	 << "    image " << (void*)image << endl
 	 << "    in " << pathname << endl));
 #endif
 bool
 	done = true;
-if (Active_Tile)
+Tile_Queue
+	targets;
+for (int
+		index = 0;
+		index < Active_Tiles.size ();
+	  ++index)
+	if (! image ||
+		Active_Tiles[index]->Image == image)
+		targets.append (Active_Tiles[index]);
+
+if (! targets.isEmpty ())
 	{
 	#if ((DEBUG_SECTION) & DEBUG_QUEUE)
-	LOCKED_LOGGING ((
+	LOCK_LOG;
 	clog << "    Image_Renderer::abort " << thread_ID
-			<< ": cancel rendering for " << *Active_Tile << endl
-		 << "    in " << pathname << endl));
+			<< ": cancel rendering for -" << endl;
+	print_queue (targets);
+	UNLOCK_LOG;
 	#endif
-	//	Raise the canceled flag for rendered tile disposition.
-	Cancel = true;
-	//	Notify the image rendering machinery to cancel operations.
-	Active_Tile->Image->cancel_update ();
+	//	Mark the tiles canceled for rendered tile disposition.
+	Rendering_Lock.lock ();
+	for (int
+			index = 0;
+			index < targets.size ();
+		  ++index)
+		if (! Canceled_Tiles.contains (targets[index]))
+			Canceled_Tiles.append (targets[index]);
+	Rendering_Lock.unlock ();
 
-	if (cancel_options & DELETE_WHEN_DONE)
-		//	Mark the tile image for deletion when the tile is destroyed.
-		Active_Tile->Delete_Image_When_Done = true;
+	for (int
+			index = 0;
+			index < targets.size ();
+		  ++index)
+		{
+		//	Notify the image rendering machinery to cancel operations.
+		targets[index]->Image->cancel_update ();
+
+		if (cancel_options & DELETE_WHEN_DONE)
+			//	Mark the tile image for deletion when the tile is destroyed.
+			targets[index]->Delete_Image_When_Done = true;
+		}
 
 	if (cancel_options & WAIT_UNTIL_DONE)
 		{
-		//	Wait for any rendering to complete.
+		//	Wait for any rendering of the tiles to complete.
 		#if ((DEBUG_SECTION) & DEBUG_QUEUE)
 		LOCKED_LOGGING ((
 		clog << "    Image_Renderer::abort " << thread_ID
-				<< ": try lock Rendering_Lock" << endl
+				<< ": wait for rendering to complete" << endl
 			 << "    in " << pathname << endl
-			 << "    wait up to " << Wait_Seconds << " seconds" << endl));
+			 << "    wait up to " << Wait_Seconds
+				<< " seconds for each completion" << endl));
 		#endif
-		if (Rendering_Lock.tryLock (Wait_Seconds * 1000))
+		Rendering_Lock.lock ();
+		while (done)
 			{
-			#if ((DEBUG_SECTION) & DEBUG_QUEUE)
-			LOCKED_LOGGING ((
-			clog << "    Image_Renderer::abort " << thread_ID
-					<< ": unlock Rendering_Lock" << endl
-				 << "    in " << pathname << endl));
-			#endif
-			Rendering_Lock.unlock ();
-			}
-		else
-			{
-			#if ((DEBUG_SECTION) & DEBUG_QUEUE)
-			LOCKED_LOGGING ((
-			clog << "!!! Image_Renderer::abort " << thread_ID
-					<< ": failed to obtain Rendering_Lock after "
-					<< Wait_Seconds << " seconds!" << endl
-				 << "    in " << pathname << endl));
-			#endif
-			done = false;
+			int
+				index = targets.size ();
+			while (index--)
+				if (Rendering_Tiles.contains (targets[index]))
+					break;
+			if (index < 0)
+				break;
+
+			Rendering_Event.reset ();
+			if (! Rendering_Event.wait (&Rendering_Lock, Wait_Seconds * 1000))
+				{
+				#if ((DEBUG_SECTION) & DEBUG_QUEUE)
+				LOCKED_LOGGING ((
+				clog << "!!! Image_Renderer::abort " << thread_ID
+						<< ": rendering did not complete after "
+						<< Wait_Seconds << " seconds!" << endl
+					 << "    in " << pathname << endl));
+				#endif
+				done = false;
+				}
 			}
+		Rendering_Lock.unlock ();
 		}
 	else
 		{
@@ -1299,18 +1348,18 @@ if (index >= 0)
 	deleted = true;
 	}
 
-if (Active_Tile &&
-	Active_Tile->Image == image)
+index = find_tile (image, Active_Tiles);
+if (index >= 0)
 	{
 	#if ((DEBUG_SECTION) & (DEBUG_DELETE_TILES | DEBUG_QUEUE))
 	LOCKED_LOGGING ((
 	clog << "    Image_Renderer::delete_image " << thread_ID
-			<< ": Active_Tile -" << endl
-		 << "    " << *Active_Tile << endl));
+			<< ": Active_Tiles[" << index << "] -" << endl
+		 << "    " << *Active_Tiles[index] << endl));
 	#endif
 	//	Delete when done if not in the Render_Queue.
-	Active_Tile->Delete_Image_When_Done = ! deleted;
-	//	The Active_Tile is put on the Delete_Queue when rendering is done.
+	Active_Tiles[index]->Delete_Image_When_Done = ! deleted;
+	//	The active tile is put on the Delete_Queue when rendering is done.
 	deleted = true;
 	}
 if (! deleted)
@@ -1611,29 +1660,21 @@ return (Runnable && ! Finish);
 void
 Image_Renderer::render ()
 {
-#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_OVERVIEW | DEBUG_QUEUE | DEBUG_STATUS))
+#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_OVERVIEW | DEBUG_QUEUE))
 void*
 	thread_ID = (void*)QThread::currentThreadId ();
 QString
-	pathname (object_pathname (this)),
-	name;
+	pathname (object_pathname (this));
 #endif
 #if ((DEBUG_SECTION) & DEBUG_RENDER)
 LOCKED_LOGGING ((
 clog << ">>> Image_Renderer::render " << thread_ID << endl
 	 << "    in " << pathname << endl));
 #endif
-#if ((DEBUG_SECTION) & DEBUG_TILE_MARKINGS)
-QString
-	label;
-#endif
 int
-	tile_status;
-bool
-	#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_TILE_MARKINGS))
-	complete,
-	#endif
-	canceled;
+	index;
+Image_Tile
+	*image_tile;
 
 while (true)
 	{
@@ -1657,16 +1698,37 @@ while (true)
 	#endif
 	Queue_Lock.lock ();
 
-	if (Render_Queue.isEmpty ())
+	index = next_tile ();
+	if (index < 0 ||
+		Active_Tiles.size () >= rendering_threads ())
 		{
-		#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_OVERVIEW))
-		LOCKED_LOGGING ((
-		clog << "    Image_Renderer::render " << thread_ID
-				<< ": empty Render_Queue" << endl
-			 << "    suspend_rendering" << endl
-			 << "    in " << pathname << endl));
-		#endif
-		suspend_rendering ();
+		if (Render_Queue.isEmpty () &&
+			Active_Tiles.isEmpty ())
+			{
+			#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_OVERVIEW))
+			LOCKED_LOGGING ((
+			clog << "    Image_Renderer::render " << thread_ID
+					<< ": empty Render_Queue" << endl
+				 << "    suspend_rendering" << endl
+				 << "    in " << pathname << endl));
+			#endif
+			suspend_rendering ();
+			}
+		else
+			{
+			/*	Wait for an active tile to be disposed of or another
+				tile to be queued.
+			*/
+			#if ((DEBUG_SECTION) & DEBUG_RENDER)
+			LOCKED_LOGGING ((
+			clog << "    Image_Renderer::render " << thread_ID
+					<< ": wait for Queue_Event" << endl
+				 << "    " << Active_Tiles.size () << " active tiles" << endl
+				 << "    in " << pathname << endl));
+			#endif
+			Queue_Event.reset ();
+			Queue_Event.wait (&Queue_Lock);
+			}
 		#if ((DEBUG_SECTION) & DEBUG_RENDER)
 		LOCKED_LOGGING ((
 		clog << "    Image_Renderer::render " << thread_ID
@@ -1680,233 +1742,303 @@ while (true)
 	LOCK_LOG;
 	clog << "--> Image_Renderer::render " << thread_ID << endl
 		 << "    in " << pathname << endl;
-	if (Active_Tile)
-		clog << "    Active_Tile -" << endl
-			 << "    " << *Active_Tile << endl;
+	if (! Active_Tiles.isEmpty ())
+		{
+		clog << "    Active_Tiles -" << endl;
+		print_queue (Active_Tiles);
+		}
 	clog << "    Render_Queue -" << endl;
 	print_queue (Render_Queue);
 	UNLOCK_LOG;
 	#endif
 
-	/*	Acquire the Active_Tile from the front of the Render_Queue.
+	/*	Acquire an active tile from the Render_Queue.
 
-		A non-NULL Active_Tile is used as a flag that an image tile has
-		been acquired for rendering. When rendering of the Active_Tile
-		is complete it will be deleted and the Active_Tile reset to NULL.
+		An image tile in the Active_Tiles list has been acquired for
+		rendering. When rendering of the active tile is complete it will
+		be removed from the list and deleted.
 	*/
-	Active_Tile = Render_Queue.takeAt (0);
-	tile_status = Active_Tile->status ();
-	canceled = Cancel;
-	#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_TILE_MARKINGS))
-	complete = false;
-	#endif
+	image_tile = Render_Queue.takeAt (index);
+	Active_Tiles.append (image_tile);
+	Rendering_Lock.lock ();
+	Rendering_Tiles.append (image_tile);
+	Rendering_Lock.unlock ();
 	#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_QUEUE | DEBUG_OVERVIEW))
 	LOCKED_LOGGING ((
 	clog << "    Image_Renderer::render " << thread_ID
-			<< ": Active_Tile " << *Active_Tile << endl
-		 << "    " << *(Active_Tile->Image) << endl
-		 << "    canceled = " << boolalpha << canceled << endl
+			<< ": dispatch Render_Queue[" << index << "] " << *image_tile << endl
+		 << "    " << *(image_tile->Image) << endl
 		 << "    in " << pathname << endl));
 	#endif
-	#if ((DEBUG_SECTION) & DEBUG_TILE_MARKINGS)
-	//	Tile markings.
-	label = QString (" ante render @ %1: gc %2, %3; so %4, %5; s %6")
-		.arg ((ulong)(Active_Tile->Image), 0, 16)
-		.arg (Active_Tile->Tile_Coordinate.rx ())
-		.arg (Active_Tile->Tile_Coordinate.ry ())
-		.arg (Active_Tile->Image->source_origin ().x ())
-		.arg (Active_Tile->Image->source_origin ().y ())
-		.arg (Active_Tile->Image->source_scaling ().width ());
-	mark_image (Active_Tile->Image, label,
-		TILE_MARKINGS_ANTE_Y,
-		TILE_MARKINGS_COLOR);
-	mark_image (Active_Tile->Image, label,
-		Active_Tile->Image->height () - TILE_MARKINGS_ANTE_Y - 12,
-		TILE_MARKINGS_COLOR);
-	#endif
 
-	//	Rendering begins .......................................................
+	//	Release the Queue_Lock during rendering.
 	#if ((DEBUG_SECTION) & DEBUG_RENDER)
 	LOCKED_LOGGING ((
 	clog << "    Image_Renderer::render " << thread_ID
-			<< ": lock Rendering_Lock" << endl
+			<< ": unlock Queue_Lock" << endl
 		 << "    in " << pathname << endl));
 	#endif
-	Rendering_Lock.lock ();
+	Queue_Lock.unlock ();
 
-	//	Register the Image_Rendering_Monitor with the tile's image.
-	Active_Tile->Image->add_rendering_monitor (Image_Rendering_Monitor);
+	dispatch_tile (image_tile);
+	}
+#if ((DEBUG_SECTION) & DEBUG_RENDER)
+LOCKED_LOGGING ((
+clog << "    in " << pathname << endl
+	 << "<<< Image_Renderer::render " << thread_ID << endl));
+#endif
+}
 
-	/*	Release the Queue_Lock during rendering.
 
-		>>> WARNING <<< The Queue_Lock must be released AFTER the
-		Rendering_Lock is acquired to avoid a race condition in abort.
-	*/
-	#if ((DEBUG_SECTION) & DEBUG_RENDER)
+void
+Image_Renderer::dispatch_tile
+	(
+	Image_Tile*	image_tile
+	)
+{render_tile (image_tile);}
+
+
+void
+Image_Renderer::render_tile
+	(
+	Image_Tile*	image_tile
+	)
+{
+#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_OVERVIEW | DEBUG_QUEUE | DEBUG_STATUS))
+void*
+	thread_ID = (void*)QThread::currentThreadId ();
+QString
+	pathname (object_pathname (this));
+#endif
+#if ((DEBUG_SECTION) & DEBUG_RENDER)
+LOCKED_LOGGING ((
+clog << ">>> Image_Renderer::render_tile " << thread_ID
+		<< ": " << *image_tile << endl
+	 << "    in " << pathname << endl));
+#endif
+#if ((DEBUG_SECTION) & DEBUG_TILE_MARKINGS)
+QString
+	label;
+#endif
+int
+	tile_status = image_tile->status ();
+#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_TILE_MARKINGS | DEBUG_OVERVIEW))
+bool
+	complete = false;
+#endif
+Rendering_Lock.lock ();
+bool
+	canceled = Canceled_Tiles.contains (image_tile),
+	failed = false;
+Rendering_Lock.unlock ();
+#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_QUEUE | DEBUG_OVERVIEW))
+LOCKED_LOGGING ((
+clog << "    Image_Renderer::render_tile " << thread_ID
+		<< ": active tile " << *image_tile << endl
+	 << "    " << *(image_tile->Image) << endl
+	 << "    canceled = " << boolalpha << canceled << endl
+	 << "    in " << pathname << endl));
+#endif
+#if ((DEBUG_SECTION) & DEBUG_TILE_MARKINGS)
+//	Tile markings.
+label = QString (" ante render @ %1: gc %2, %3; so %4, %5; s %6")
+	.arg ((ulong)(image_tile->Image), 0, 16)
+	.arg (image_tile->Tile_Coordinate.rx ())
+	.arg (image_tile->Tile_Coordinate.ry ())
+	.arg (image_tile->Image->source_origin ().x ())
+	.arg (image_tile->Image->source_origin ().y ())
+	.arg (image_tile->Image->source_scaling ().width ());
+mark_image (image_tile->Image, label,
+	TILE_MARKINGS_ANTE_Y,
+	TILE_MARKINGS_COLOR);
+mark_image (image_tile->Image, label,
+	image_tile->Image->height () - TILE_MARKINGS_ANTE_Y - 12,
+	TILE_MARKINGS_COLOR);
+#endif
+
+//	Rendering begins ...........................................................
+
+//	Register the Image_Rendering_Monitor with the tile's image.
+image_tile->Image->add_rendering_monitor (Image_Rendering_Monitor);
+
+if (! canceled)
+	{
+	#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_SIGNALS | DEBUG_STATUS))
 	LOCKED_LOGGING ((
-	clog << "    Image_Renderer::render " << thread_ID
-			<< ": unlock Queue_Lock" << endl
+	clog << "^^^ Image_Renderer::render_tile " << thread_ID
+			<< ": emit status " <<tile_status << " - "
+			<< status_description (tile_status) << endl
 		 << "    in " << pathname << endl));
 	#endif
-	Queue_Lock.unlock ();
-
-	if (! canceled)
-		{
-		#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_SIGNALS | DEBUG_STATUS))
-		LOCKED_LOGGING ((
-		clog << "^^^ Image_Renderer::render " << thread_ID
-				<< ": emit status " <<tile_status << " - "
-				<< status_description (tile_status) << endl
-			 << "    in " << pathname << endl));
-		#endif
-		//	>>> SIGNAL <<<
-		emit status (tile_status);
+	//	>>> SIGNAL <<<
+	emit status (tile_status);
 
-		//	Render the tile.
-		#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_OVERVIEW))
-		LOCKED_LOGGING ((
-		clog << "==> Image_Renderer::render " << thread_ID
-				<< ": rendering -" << endl
-			 << "    update " << *Active_Tile << endl
-			 << "      " << *(Active_Tile->Image) << endl
-			 << "    in " << pathname << endl));
+	//	Render the tile.
+	#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_OVERVIEW))
+	LOCKED_LOGGING ((
+	clog << "==> Image_Renderer::render_tile " << thread_ID
+			<< ": rendering -" << endl
+		 << "    update " << *image_tile << endl
+		 << "      " << *(image_tile->Image) << endl
+		 << "    in " << pathname << endl));
+	#endif
+	try {
+		#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_TILE_MARKINGS | DEBUG_OVERVIEW))
+		complete =
 		#endif
-		try {
-			#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_TILE_MARKINGS))
-			complete =
-			#endif
-			Active_Tile->Image->update ();
-			}
-		catch (Plastic_Image::Render_Exception& except)
-			{
-			#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_SIGNALS))
-			LOCKED_LOGGING ((
-			clog << "^^^ Image_Renderer::render " << thread_ID
-					<< ": emit error -" << endl
-				 << except.message () << endl
-				 << "    in " << pathname << endl));
-			#endif
-			//	>>> SIGNAL<<<
-			emit error (QString::fromStdString (except.message ()));
-			reset (DO_NOT_WAIT);
-			canceled = true;
-			}
-		#if ((DEBUG_SECTION) & DEBUG_RENDER)
+		image_tile->Image->update ();
+		}
+	catch (Plastic_Image::Render_Exception& except)
+		{
+		#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_SIGNALS))
 		LOCKED_LOGGING ((
-		clog << "<== Image_Renderer::render " << thread_ID
-				<< ": rendering complete "
-				<< boolalpha << complete << endl
-			 << "    for " << *Active_Tile << endl
+		clog << "^^^ Image_Renderer::render_tile " << thread_ID
+				<< ": emit error -" << endl
+			 << except.message () << endl
 			 << "    in " << pathname << endl));
 		#endif
-		#if ((DEBUG_SECTION) & DEBUG_TILE_MARKINGS)
-		//	Tile markings.
-		label.replace (0, 5, " post");
-		mark_image (Active_Tile->Image, label,
-			TILE_MARKINGS_POST_Y,
-			TILE_MARKINGS_COLOR);
-		mark_image (Active_Tile->Image, label,
-			Active_Tile->Image->height () - TILE_MARKINGS_POST_Y - 12,
-			TILE_MARKINGS_COLOR);
-		#endif
+		//	>>> SIGNAL<<<
+		emit error (QString::fromStdString (except.message ()));
+		failed =
+		canceled = true;
 		}
+	#if ((DEBUG_SECTION) & DEBUG_RENDER)
+	LOCKED_LOGGING ((
+	clog << "<== Image_Renderer::render_tile " << thread_ID
+			<< ": rendering complete "
+			<< boolalpha << complete << endl
+		 << "    for " << *image_tile << endl
+		 << "    in " << pathname << endl));
+	#endif
+	#if ((DEBUG_SECTION) & DEBUG_TILE_MARKINGS)
+	//	Tile markings.
+	label.replace (0, 5, " post");
+	mark_image (image_tile->Image, label,
+		TILE_MARKINGS_POST_Y,
+		TILE_MARKINGS_COLOR);
+	mark_image (image_tile->Image, label,
+		image_tile->Image->height () - TILE_MARKINGS_POST_Y - 12,
+		TILE_MARKINGS_COLOR);
+	#endif
+	}
 
-	//	Remove the Image_Rendering_Monitor from the image.
-	Active_Tile->Image->remove_rendering_monitor (Image_Rendering_Monitor);
+//	Remove the Image_Rendering_Monitor from the image.
+image_tile->Image->remove_rendering_monitor (Image_Rendering_Monitor);
 
-	Rendering_Lock.unlock ();
-	//	Rendering done .........................................................
+//	Release anyone waiting in abort for the rendering to complete.
+Rendering_Lock.lock ();
+Rendering_Tiles.removeAll (image_tile);
+Rendering_Event.set ();
+Rendering_Lock.unlock ();
 
-	/*	Reacquire the Queue_Lock.
+/*	Reset the renderer after a rendering failure.
 
-		>>> WARNING << The Queue_Lock must be acquired AFTER the
-		Rendering_Lock is released to avoid a deadlock condition in
-		abort.
+	This is done only after the tile has been removed from the rendering
+	tiles and its completion signaled; an abort waiting on the tile would
+	otherwise be held until its wait timed out.
+*/
+if (failed)
+	reset (DO_NOT_WAIT);
+//	Rendering done .............................................................
 
-		N.B.: The Active_Tile may continue to be used under the
-		presumption that it will only be deleted, once acquired, here.
-	*/
-	#if ((DEBUG_SECTION) & DEBUG_RENDER)
-	LOCKED_LOGGING ((
-	clog << "    Image_Renderer::render " << thread_ID
-			<< ": relock Queue_Lock" << endl
-		 << "    in " << pathname << endl));
-	#endif
-	Queue_Lock.lock ();
+/*	Acquire the Queue_Lock.
+
+	N.B.: The active tile may continue to be used under the presumption
+	that it will only be deleted, once acquired, here.
+*/
+#if ((DEBUG_SECTION) & DEBUG_RENDER)
+LOCKED_LOGGING ((
+clog << "    Image_Renderer::render_tile " << thread_ID
+		<< ": lock Queue_Lock" << endl
+	 << "    in " << pathname << endl));
+#endif
+Queue_Lock.lock ();
 
-	//	Tile disposition:
+//	Tile disposition:
 
-	//	The Cancel flag may have been set while the Queue_Lock was unlocked.
-	canceled |= Cancel;
-	#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_OVERVIEW))
+//	The tile may have been aborted while it was being rendered.
+Rendering_Lock.lock ();
+if (Canceled_Tiles.removeAll (image_tile))
+	canceled = true;
+Rendering_Lock.unlock ();
+#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_OVERVIEW))
+LOCKED_LOGGING ((
+clog << "<-- Image_Renderer::render_tile " << thread_ID
+		<< ": rendering "
+		<< (canceled ? "canceled " : "")
+		<< (complete ? "complete" : "incomplete") << " -" << endl
+	 << "    " << *(image_tile->Image) << endl
+	 << "    in " << pathname << endl));
+#endif
+#if ((DEBUG_SECTION) & DEBUG_TILE_MARKINGS)
+if (canceled ||
+	! complete)
+	{
+	//	Tile markings.
+	label = QString (" ")
+		+= QString (canceled ? "CANCELED " : "")
+		+= QString (complete ? "COMPLETE " : "INCOMPLETE ")
+		+= QString ("- ")
+		+= Plastic_Image::mapping_type_names
+			(image_tile->Image->needs_update ());
+	mark_image (image_tile->Image, label,
+		TILE_MARKINGS_CANCELED_Y,
+		TILE_MARKINGS_CANCELED_COLOR, Qt::transparent);
+	mark_image (image_tile->Image, label,
+		image_tile->Image->height () - TILE_MARKINGS_CANCELED_Y - 12,
+		TILE_MARKINGS_CANCELED_COLOR, Qt::transparent);
+	}
+#endif
+if (canceled)
+	{
+	//	Clear any lingering rendering cancellation status.
+	image_tile->Image->cancel_update (false);
+
+	tile_status |= RENDERING_CANCELED;
+	#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_SIGNALS | DEBUG_STATUS))
 	LOCKED_LOGGING ((
-	clog << "<-- Image_Renderer::render " << thread_ID
-			<< ": rendering "
-			<< (canceled ? "canceled " : "")
-			<< (complete ? "complete" : "incomplete") << " -" << endl
-		 << "    " << *(Active_Tile->Image) << endl
+	clog << "^^^ Image_Renderer::render_tile " << thread_ID
+			<< ": emit status " << tile_status << " - "
+			<< status_description (tile_status) << endl
 		 << "    in " << pathname << endl));
 	#endif
-	#if ((DEBUG_SECTION) & DEBUG_TILE_MARKINGS)
-	if (canceled ||
-		! complete)
-		{
-		//	Tile markings.
-		label = QString (" ")
-			+= QString (canceled ? "CANCELED " : "")
-			+= QString (complete ? "COMPLETE " : "INCOMPLETE ")
-			+= QString ("- ")
-			+= Plastic_Image::mapping_type_names
-				(Active_Tile->Image->needs_update ());
-		mark_image (Active_Tile->Image, label,
-			TILE_MARKINGS_CANCELED_Y,
-			TILE_MARKINGS_CANCELED_COLOR, Qt::transparent);
-		mark_image (Active_Tile->Image, label,
-			Active_Tile->Image->height () - TILE_MARKINGS_CANCELED_Y - 12,
-			TILE_MARKINGS_CANCELED_COLOR, Qt::transparent);
-		}
-	#endif
-	if (canceled)
-		{
-		//	Clear any lingering rendering cancellation status.
-		Active_Tile->Image->cancel_update (false);
-		Cancel = false;
-
-		tile_status |= RENDERING_CANCELED;
-		#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_SIGNALS | DEBUG_STATUS))
-		LOCKED_LOGGING ((
-		clog << "^^^ Image_Renderer::render " << thread_ID
-				<< ": emit status " << tile_status << " - "
-				<< status_description (tile_status) << endl
-			 << "    in " << pathname << endl));
-		#endif
-		//	>>> SIGNAL <<<
-		emit status (tile_status);
-		}
-	else
+	//	>>> SIGNAL <<<
+	emit status (tile_status);
+	}
+else
+	{
+	if (tile_status == RENDERING_HIGH_PRIORITY ||
+		! image_tile->Cancelable)
 		{
-		if (tile_status == RENDERING_HIGH_PRIORITY ||
-			! Active_Tile->Cancelable)
+		if (Immediate_Mode)
 			{
-			if (Immediate_Mode)
-				{
-				#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_SIGNALS))
-				LOCKED_LOGGING ((
-				clog << "^^^ Image_Renderer::render " << thread_ID
-						<< ": emit rendered " << *Active_Tile << endl
-					 << "    in " << pathname << endl));
-				#endif
-				//	>>> SIGNAL <<<
-				emit rendered (Active_Tile->Tile_Coordinate);
-				}
-			else
-			if (Render_Queue.isEmpty () ||
-				//	Check the next Render_Queue entry.
-				Render_Queue.at (0)->is_low_priority ())
+			#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_SIGNALS))
+			LOCKED_LOGGING ((
+			clog << "^^^ Image_Renderer::render_tile " << thread_ID
+					<< ": emit rendered " << *image_tile << endl
+				 << "    in " << pathname << endl));
+			#endif
+			//	>>> SIGNAL <<<
+			emit rendered (image_tile->Tile_Coordinate);
+			}
+		else
+		if (Render_Queue.isEmpty () ||
+			//	Check the next Render_Queue entry.
+			Render_Queue.at (0)->is_low_priority ())
+			{
+			//	Check the other active tiles.
+			int
+				index = Active_Tiles.size ();
+			while (index--)
+				if (Active_Tiles[index] != image_tile &&
+					(! Active_Tiles[index]->is_low_priority () ||
+					 ! Active_Tiles[index]->Cancelable))
+					break;
+			if (index < 0)
 				{
 				#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_SIGNALS))
 				LOCKED_LOGGING ((
-				clog << "^^^ Image_Renderer::render " << thread_ID
+				clog << "^^^ Image_Renderer::render_tile " << thread_ID
 						<< ": emit rendered all central tiles (0,0)" << endl
 					 << "    in " << pathname << endl));
 				#endif
@@ -1915,31 +2047,113 @@ while (true)
 				}
 			}
 		}
+	}
 
-	//	Dispose of the Active_Tile.
-	#if ((DEBUG_SECTION) & DEBUG_RENDER)
-	LOCKED_LOGGING ((
-	clog << "    Image_Renderer::render " << thread_ID
-			<< ": queue for deletion Active_Tile " << *Active_Tile << endl
-		 << "    in " << pathname << endl));
-	#endif
-	delete_tile (Active_Tile);
-	Active_Tile = NULL;
+//	Dispose of the active tile.
+#if ((DEBUG_SECTION) & DEBUG_RENDER)
+LOCKED_LOGGING ((
+clog << "    Image_Renderer::render_tile " << thread_ID
+		<< ": queue for deletion active tile " << *image_tile << endl
+	 << "    in " << pathname << endl));
+#endif
+Active_Tiles.removeAll (image_tile);
+delete_tile (image_tile);
 
-	//	Release the Queue_Lock.
-	#if ((DEBUG_SECTION) & DEBUG_RENDER)
-	LOCKED_LOGGING ((
-	clog << "    Image_Renderer::render " << thread_ID
-			<< ": unlock Queue_Lock" << endl
-		 << "    in " << pathname << endl));
-	#endif
-	Queue_Lock.unlock ();
+//	Release a rendering loop waiting for an active tile to be disposed of.
+Queue_Event.set ();
+
+//	Release the Queue_Lock.
+#if ((DEBUG_SECTION) & DEBUG_RENDER)
+LOCKED_LOGGING ((
+clog << "    Image_Renderer::render_tile " << thread_ID
+		<< ": unlock Queue_Lock" << endl
+	 << "    in " << pathname << endl));
+#endif
+Queue_Lock.unlock ();
+#if ((DEBUG_SECTION) & DEBUG_RENDER)
+LOCKED_LOGGING ((
+clog << "    in " << pathname << endl
+	 << "<<< Image_Renderer::render_tile " << thread_ID << endl));
+#endif
+}
+
+
+int
+Image_Renderer::next_tile () const
+{
+//	>>> CAUTION: The Queue_Lock is expected to be locked.
+for (int
+		index = 0;
+		index < Render_Queue.size ();
+	  ++index)
+	if (find_tile (Render_Queue[index]->Image, Active_Tiles) < 0)
+		return index;
+return -1;
+}
+
+
+Image_Tile*
+Image_Renderer::rendering_tile
+	(
+	const Plastic_Image*	image
+	) const
+{
+QMutexLocker
+	rendering_lock (&Rendering_Lock);
+for (int
+		index = 0;
+		index < Rendering_Tiles.size ();
+	  ++index)
+	if (Rendering_Tiles[index]->Image == image)
+		return Rendering_Tiles[index];
+return NULL;
+}
+
+
+int
+Image_Renderer::rendering_threads () const
+{return 1;}
+
+
+bool
+Image_Renderer::wait_until_idle ()
+{
+#if ((DEBUG_SECTION) & DEBUG_RENDER)
+void*
+	thread_ID = (void*)QThread::currentThreadId ();
+QString
+	pathname (object_pathname (this));
+LOCKED_LOGGING ((
+clog << ">>> Image_Renderer::wait_until_idle " << thread_ID << endl
+	 << "    in " << pathname << endl));
+#endif
+bool
+	idle = true;
+Queue_Lock.lock ();
+while (! Active_Tiles.isEmpty ())
+	{
+	Queue_Event.reset ();
+	if (! Queue_Event.wait (&Queue_Lock, Wait_Seconds * 1000))
+		{
+		#if ((DEBUG_SECTION) & DEBUG_RENDER)
+		LOCKED_LOGGING ((
+		clog << "!!! Image_Renderer::wait_until_idle " << thread_ID
+				<< ": active tiles remain after "
+				<< Wait_Seconds << " seconds!" << endl
+			 << "    in " << pathname << endl));
+		#endif
+		idle = false;
+		break;
+		}
 	}
+Queue_Lock.unlock ();
 #if ((DEBUG_SECTION) & DEBUG_RENDER)
 LOCKED_LOGGING ((
 clog << "    in " << pathname << endl
-	 << "<<< Image_Renderer::render " << thread_ID << endl));
+	 << "<<< Image_Renderer::wait_until_idle " << thread_ID
+		<< ": " << boolalpha << idle << endl));
 #endif
+return idle;
 }
 
 
@@ -2020,30 +2234,25 @@ Suspended = true;
 if (wait &&
 	! done)
 	{
-	bool
-		queue_locked = Queue_Lock.tryLock ();
-
 	//	Wait for any rendering to complete.
 	#if ((DEBUG_SECTION) & DEBUG_RENDER)
 	LOCKED_LOGGING ((
 	clog << "    Image_Renderer::suspend_rendering " << thread_ID
-			<< ": try lock Rendering_Lock" << endl
+			<< ": wait for rendering tiles" << endl
 		 << "    in " << pathname << endl
-		 << "    wait up to " << Wait_Seconds << " seconds" << endl));
+		 << "    wait up to " << Wait_Seconds
+			<< " seconds for each completion" << endl));
 	#endif
-	if ((done = Rendering_Lock.tryLock (Wait_Seconds * 1000)))
+	done = true;
+	Rendering_Lock.lock ();
+	while (! Rendering_Tiles.isEmpty ())
 		{
-		#if ((DEBUG_SECTION) & DEBUG_RENDER)
-		LOCKED_LOGGING ((
-		clog << "    Image_Renderer::suspend_rendering " << thread_ID
-				<< ": unlock Rendering_Lock" << endl
-			 << "    in " << pathname << endl));
-		#endif
-		Rendering_Lock.unlock ();
+		Rendering_Event.reset ();
+		if (! (done = Rendering_Event.wait
+				(&Rendering_Lock, Wait_Seconds * 1000)))
+			break;
 		}
-
-	if (queue_locked)
-		Queue_Lock.unlock ();
+	Rendering_Lock.unlock ();
 	}
 
 if (ready_locked)
@@ -2339,6 +2548,19 @@ clog << "    Image_Renderer::load_image " << thread_ID
 #endif
 Queue_Lock.lock ();
 
+//	Wait for any active tiles of the previous source to be disposed of.
+while (! Active_Tiles.isEmpty ())
+	{
+	#if ((DEBUG_SECTION) & DEBUG_LOAD_IMAGE)
+	LOCKED_LOGGING ((
+	clog << "    Image_Renderer::load_image " << thread_ID
+			<< ": wait for " << Active_Tiles.size () << " active tiles" << endl
+		 << "    in " << pathname << endl));
+	#endif
+	Queue_Event.reset ();
+	Queue_Event.wait (&Queue_Lock);
+	}
+
 bool
 	loaded = false;
 /*
@@ -2373,14 +2595,6 @@ if (! Source_Name.isEmpty ())
 			<< ": Source_Name \"" << Source_Name << '"' << endl
 		 << "    in " << pathname << endl));
 	#endif
-	#if ((DEBUG_SECTION) & DEBUG_LOAD_IMAGE)
-	LOCKED_LOGGING ((
-	clog << "    Image_Renderer::load_image " << thread_ID
-	 		<< ": lock Rendering_Lock" << endl
-		 << "    in " << pathname << endl));
-	#endif
-	Rendering_Lock.lock ();
-
 	//	Load the source image from the named source.
 	#if ((DEBUG_SECTION) & DEBUG_LOAD_IMAGE)
 	LOCKED_LOGGING ((
@@ -2389,14 +2603,6 @@ if (! Source_Name.isEmpty ())
 		 << "    in " << pathname << endl));
 	#endif
 	source_image = load_image (Source_Name);
-
-	#if ((DEBUG_SECTION) & DEBUG_LOAD_IMAGE)
-	LOCKED_LOGGING ((
-	clog << "    Image_Renderer::load_image " << thread_ID
-	 		<< ": unlock Rendering_Lock" << endl
-		 << "    in " << pathname << endl));
-	#endif
-	Rendering_Lock.unlock ();
 	}
 
 //	Clear the source image load request.
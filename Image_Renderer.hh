@@ -26,6 +26,7 @@ Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
 
 #include	"Plastic_Image.hh"
 #include	"Image_Tile.hh"
+#include	"Synchronized_Event.hh"
 
 //	PIRL++
 #include	"Reference_Counted_Pointer.hh"
@@ -102,6 +103,17 @@ class Image_Renderer_Rendering_Monitor;
 	queue is cleared of all other images. An image may also be flagged
 	for deletion when its encapsulating tile is destroyed.
 
+	Each image tile taken from the front of the queue for rendering
+	becomes an active tile until its rendering has been completed and
+	the tile disposed of. The rendering loop of an Image_Renderer
+	renders each active tile itself, one at a time. A subclass may
+	{@link dispatch_tile(Image_Tile*) dispatch} active tiles to be
+	rendered concurrently, in which case there may be as many active
+	tiles as there are {@link rendering_threads() rendering threads}.
+	A queued tile is not acquired while another tile with the same image
+	is active, so no image is ever rendered by more than one thread at a
+	time.
+
 	@author		Bradford Castalia, UA/HiROC
 	@version	$Revision: 1.35 $
 */
@@ -333,8 +345,9 @@ protected:
 	@link image(const QString&) Source_Name} has been posted nothing
 	is done. If a non-NULL Image_Source is found it is used as-is.
 	If a non-empty Source_Name is found it is used to {@link
-	load_image(const QString&) load an image}. <b>N.B.</b>: The
-	Rendering_Lock is held while the image is being loaded.
+	load_image(const QString&) load an image}. <b>N.B.</b>: Before
+	either source is used the method waits until there are no active
+	tiles.
 
 	The {@link #LOADING_IMAGE} {@link status(int) status signal} is
 	emitted <b>before</b> image loading begins.
@@ -413,7 +426,7 @@ JP2_Image* load_JP2_image (const QString& source_name);
 
 /**	Clone an image.
 
-	<b>N.B.</b>: The Rendering_Lock is held while the image is being
+	<b>N.B.</b>: There are no active tiles while the image is being
 	cloned.
 
 	If an exception is thrown from the source image's clone method
@@ -463,7 +476,7 @@ public:
 	before the tile is deleted.
 
 	<b>N.B.</b>: An image can be queued for rendering even if it is
-	currently being rendered (is associated with the Active_Tile).
+	currently being rendered (is associated with an active tile).
 
 	<b>N.B.</b>: Queuing an image will cause rendering to be {@link
 	start_rendering() started} if the renering loop is {@link runnable()
@@ -508,11 +521,11 @@ inline void queue (Plastic_Image* image,
 
 /**	Get the tile image rendering status.
 
-	@return	The {@link Image_Tile::status() priority status} of the
-		Active_Tile is returned. If there is no Active_Tile the status of
-		the first tile in the rendering queue (which is high-to-low
-		priority ordered) is returned. If the queue is empty zero is
-		returned.
+	@return	The highest {@link Image_Tile::status() priority status} of
+		the active tiles is returned. If there is no active tile the
+		status of the first tile in the rendering queue (which is
+		high-to-low priority ordered) is returned. If the queue is empty
+		zero is returned.
 	@see	status(int)
 */
 int rendering_status () const;
@@ -537,12 +550,12 @@ bool is_queued (Plastic_Image* image = NULL) const;
 	If the image is NULL the test is if any image is being rendered.
 
 	@param	image	A pointer to the Plastic_Image to be compared with
-		the image associated with the Active_Tile. If NULL, only the test
-		for an Active_Tile is made.
+		the images associated with the active tiles. If NULL, only the
+		test for any active tile is made.
 	@return	true if an image is being rendered and, if the image
 		specified is non-NULL, the specified image is being rendered; 
-		false if there is no Active_Tile or, if a non-NULL image was
-		specified, the Active_Tile is not the specified image.
+		false if there is no active tile or, if a non-NULL image was
+		specified, no active tile has the specified image.
 */
 bool is_rendering (Plastic_Image* image = NULL) const;
 
@@ -576,11 +589,11 @@ bool immediate_mode () const;
 /**	Cancel processing of an image.
 
 	The Render_Queue is searched for the Image_Tile containing the
-	image. If no match is found nothing is done. If the entry found is
-	for the first, active, image tile processing of the image is
-	aborted; in this case the method will not return until processing of
-	the image has stopped. Otherwise the matching entry is simply
-	removed from the Render_Queue.
+	image. If no match is found nothing is done. If the image is that of
+	an active tile processing of the image is {@link abort(int,
+	Plastic_Image*) aborted}; in this case the method will not return
+	until processing of the image has stopped. Otherwise the matching
+	entry is simply removed from the Render_Queue.
 
 	<b>N.B.</b>: Even queued entries marked as non-cancelable will be
 	canceled by this method.
@@ -605,7 +618,7 @@ bool immediate_mode () const;
 		not found in the queue; false if the image was found to be the
 		currently rendering image and it did not abort.
 	@see	cancel(int)
-	@see	abort(bool)
+	@see	abort(int, Plastic_Image*)
 */
 bool cancel
 	(Plastic_Image* image, int cancel_options = WAIT_UNTIL_DONE);
@@ -632,11 +645,11 @@ bool reset (int cancel_options = WAIT_UNTIL_DONE);
 	If the image is found in a tile on the Rendering_Queue the tile is
 	marked for {@link #DELETE_WHEN_DONE} and moved to the Delete_Queue
 	for {@link delete_tiles() eventual deletion}. If the image is
-	associated with the Active_Tile it is marked for {@link
+	associated with an active tile it is marked for {@link
 	#DELETE_WHEN_DONE} and left to complete rendering after which it will
-	be deleted. <b>N.B.</b>: The Active_Tile being rendered is not {@link
-	abort(int) aborted}; {@link cancel(Plastic_Image*, int) cancel}
-	image rendering to abort the Active_Tile.
+	be deleted. <b>N.B.</b>: The active tile being rendered is not {@link
+	abort(int, Plastic_Image*) aborted}; {@link cancel(Plastic_Image*,
+	int) cancel} image rendering to abort the active tile.
 
 	If the image is not found in a tile on the Rendering_Queue it is
 	wrapped in an image tile set for DELETE_WHEN_DONE and placed on the
@@ -644,7 +657,7 @@ bool reset (int cancel_options = WAIT_UNTIL_DONE);
 
 	@param	image	A pointer to the Plastic_Image object to be deleted.
 	@return	true if the image was found on the Rendering_Queue or
-		associated with the Active_Tile; false otherwise. In any case the
+		associated with an active tile; false otherwise. In any case the
 		image is either queued for deletion at the next opportunity or
 		marked for deletion when its rendering is completed.
 */
@@ -672,10 +685,9 @@ protected:
 /*
 	N.B.: Most of the queue management methods assume that the Queue_Lock
 	as been acquired so the Render or Delete Queue can be safely
-	manipulated. The exception is entry zero of the Render_Queue which
-	holds the tile currently being rendered if the Active_Tile is
-	non-NULL; The Active_Tile entry is the responsibility of the render
-	method.
+	manipulated. The Active_Tiles, which have been taken from the
+	Render_Queue, are the responsibility of the render method and the
+	render_tile method that disposes of them.
 */
 
 /**	Search a Tile_Queue for the Image_Tile containing a specific image.
@@ -719,7 +731,7 @@ static int find_tile (Plastic_Image* image, const Tile_Queue& queue);
 	As a safety check, the tile image is found in the Delete_Queue that
 	tile has its {@link Image_Tile::Delete_Image_When_Done} flag cleared,
 	it is removed from the queue and deleted. Also, if the image is
-	associated with the Active_Tile its Delete_Image_When_Done flag is
+	associated with an active tile its Delete_Image_When_Done flag is
 	cleared.
 
 	@param	image_tile	The Image tile to be added to the Render_Queue.
@@ -731,7 +743,7 @@ void add_tile (Image_Tile* image_tile);
 	<b>>>> WARNING <<<</b> The Queue_Lock is expected to be locked before
 	this method is entered.
 
-	An active rendering is {@link abort(int) aborted}.
+	All active rendering is {@link abort(int, Plastic_Image*) aborted}.
 
 	All Render_Queue tile entries that are marked as Cancelable are moved
 	to the Delete_Queue. If {@link #FORCE_CANCEL} is set in the cancel
@@ -757,7 +769,7 @@ void add_tile (Image_Tile* image_tile);
 	@return	true if the thread finished all rendering; false otherwise.
 	@see	cancel(int)
 	@see	reset(int)
-	@see	abort(int)
+	@see	abort(int, Plastic_Image*)
 */
 bool clear (int cancel_options = WAIT_UNTIL_DONE);
 
@@ -766,9 +778,10 @@ bool clear (int cancel_options = WAIT_UNTIL_DONE);
 	<b>>>> WARNING <<<</b> The Queue_Lock is expected to be locked before
 	this method is entered.
 
-	If there is no Active_Tile nothing is done.
+	If there is no active tile, or no active tile with the specified
+	image, nothing is done.
 
-	The Cancel flag is raised and the image of the Active_Tile is
+	Each aborted active tile is marked as canceled and its image is
 	notified to {@link Plastic_Image::cancel_update() cancel rendering}.
 	Note that when rendering is being done asynchronously (by an
 	Image_Renderer_Thread implementation of this class) cancellation does
@@ -780,17 +793,16 @@ bool clear (int cancel_options = WAIT_UNTIL_DONE);
 	of the current rendering increment.
 
 	If the {@link #DELETE_WHEN_DONE} flag is set in the cancel options
-	the Active_Tile is marked to delete its image when the tile is
-	destroyed.
-
-	If the {@link #WAIT_UNTIL_DONE} flag is set in the cancel options the
-	Rendering_Lock is acquired - which waits for the canceled rendering
-	of the current tile image to complete - before the Rendering_Lock is
-	released again. However, the attempt to acquire the lock will timeout
-	after 20 seconds, in which case the method will return false. If the
-	cancel options has the {@link #DO_NOT_WAIT} value then waiting for
-	rendering to complete will not be done and the method returns false
-	immediately.
+	each aborted active tile is marked to delete its image when the tile
+	is destroyed.
+
+	If the {@link #WAIT_UNTIL_DONE} flag is set in the cancel options
+	the method waits for the canceled rendering of the aborted tile
+	images to complete. However, waiting for a tile rendering to
+	complete will timeout after {@link #Wait_Seconds} seconds, in which
+	case the method will return false. If the cancel options has the
+	{@link #DO_NOT_WAIT} value then waiting for rendering to complete
+	will not be done and the method returns false immediately.
 
 	<b>WARNING</b>: The image of the active tile must not be immediately
 	deleted by the caller if the return value is false; any tile image
@@ -805,14 +817,16 @@ bool clear (int cancel_options = WAIT_UNTIL_DONE);
 		when the tile is deleted from the queue. The {@link #WAIT_UNTIL_DONE}
 		flag will block the method from returning until the cancellation
 		is complete. Cancellation is complete if the Render_Queue is empty or
-		rendering of the active tile, if there is one, has been completed.
-	@return	true if their was no Active_Tile being rendered or
+		rendering of the aborted active tiles, if any, has been completed.
+	@param	image	A pointer to the Plastic_Image of the active tile to
+		be aborted. If NULL all active tiles are aborted.
+	@return	true if there was no aborted active tile being rendered or
 		WAIT_UNTIL_DONE was set in the cancel options and rendering
 		completed within the allowed wait time; false if there is an
-		Active_Tile with rendering still be in progress when the method
-		returns.
+		aborted active tile with rendering still be in progress when the
+		method returns.
 */
-bool abort (int cancel_options = WAIT_UNTIL_DONE);
+bool abort (int cancel_options = WAIT_UNTIL_DONE, Plastic_Image* image = NULL);
 
 /**	Queue an image tile for deletion.
 
@@ -831,7 +845,7 @@ bool abort (int cancel_options = WAIT_UNTIL_DONE);
 	specified tile flag will be reset before it is deleted.
 
 	>>> CAUTION <<< The image tile queued for deletion must be removed
-	from the Render_Queue. Never queue the Active_Tile for deletion; it
+	from the Render_Queue. Never queue an active tile for deletion; it
 	is the responsibility of the rendering loop.
 
 	@param image_tile	A pointer to the Image_Tile to be deleted.
@@ -966,6 +980,18 @@ bool runnable () const;
 */
 virtual bool finish (int cancel_options = WAIT_UNTIL_DONE);
 
+/**	Get the number of threads available for rendering image tiles.
+
+	This is the maximum number of active tiles that the rendering loop
+	will have {@link dispatch_tile(Image_Tile*) dispatched} for rendering
+	at any time.
+
+	@return	Always 1 for the synchronous Image_Renderer; a subclass that
+		renders tiles concurrently will return the size of its rendering
+		pool.
+*/
+virtual int rendering_threads () const;
+
 //------------------------------------------------------------------------------
 protected:
 
@@ -982,21 +1008,94 @@ protected:
 	QImage&) source image} has been registered it is {@link load_image()
 	loaded}.
 
-	If the Render_Queue is empty {@link suspend_rendering(bool) rendering
-	is suspended} and the loop is restarted.
+	If the Render_Queue is empty and there are no active tiles {@link
+	suspend_rendering(bool) rendering is suspended} and the loop is
+	restarted.
 
-	If an image tile is in the Render_Queue its image {@link status(int)
-	rendering status is signaled} and the image is rendered. If the
-	rendering is not {@link cancel(int) canceled} and the tile is a
-	{@link Image_Tile::is_high_priority() high priority} or {@link
-	queue(Plastic_Image*, const QPoint&, bool) queued as not cancelable}
-	then the {@link rendered(const QPoint&) rendered signal} will be
-	emitted. However, if {@link immediate_mode(bool) immediate mode} as
-	not been enabled then the signal will only be emitted when all high
-	priority tiles in the queue have completed rendering.
+	The first image tile in the Render_Queue whose image is not that of
+	an active tile is taken from the queue, becomes an active tile, and
+	is {@link dispatch_tile(Image_Tile*) dispatched} for rendering. If
+	there is no such tile, or the number of active tiles has reached
+	the number of {@link rendering_threads() rendering threads}, the
+	loop waits until an active tile has been disposed of or another
+	tile is queued before it is restarted.
 */
 void render ();
 
+/**	Dispatch an active tile for rendering.
+
+	<b>N.B.</b>: The Queue_Lock is not locked when this method is used.
+
+	The image tile is {@link render_tile(Image_Tile*) rendered}
+	synchronously. A subclass may override this method to hand the
+	active tile to another thread to be rendered.
+
+	@param	image_tile	A pointer to the active Image_Tile to be
+		rendered.
+*/
+virtual void dispatch_tile (Image_Tile* image_tile);
+
+/**	Render an active tile and dispose of it.
+
+	<b>N.B.</b>: The Queue_Lock must not be locked when this method is
+	used. The method may be used in any thread, and for different active
+	tiles concurrently.
+
+	Unless the tile was {@link abort(int, Plastic_Image*) aborted}
+	before rendering started its image {@link status(int) rendering
+	status is signaled} and the image is rendered. If the rendering is
+	not canceled and the tile is a {@link Image_Tile::is_high_priority()
+	high priority} or {@link queue(Plastic_Image*, const QPoint&, bool)
+	queued as not cancelable} then the {@link rendered(const QPoint&)
+	rendered signal} will be emitted. However, if {@link
+	immediate_mode(bool) immediate mode} as not been enabled then the
+	signal will only be emitted when all high priority tiles, both
+	queued and active, have completed rendering.
+
+	Finally the tile is removed from the active tiles and {@link
+	delete_tile(Image_Tile*) queued for deletion}.
+
+	@param	image_tile	A pointer to the active Image_Tile to be
+		rendered.
+*/
+void render_tile (Image_Tile* image_tile);
+
+/**	Wait until there are no active tiles.
+
+	<b>N.B.</b>: The Queue_Lock must not be locked when this method is
+	used.
+
+	@return	true if there are no active tiles; false if waiting for an
+		active tile to be disposed of timed out after {@link
+		#Wait_Seconds} seconds.
+*/
+bool wait_until_idle ();
+
+
+private:
+
+/**	Find the next Render_Queue tile to be acquired for rendering.
+
+	<b>>>> WARNING <<<</b> The Queue_Lock is expected to be locked before
+	this method is entered.
+
+	@return	The index of the first Render_Queue entry whose image is not
+		that of an active tile, or -1 if there is no such entry.
+*/
+int next_tile () const;
+
+/**	Find the active tile of an image being rendered.
+
+	<b>N.B.</b>: The Rendering_Lock is locked during this method.
+
+	@param	image	A pointer to the Plastic_Image being rendered.
+	@return	A pointer to the active Image_Tile with the image being
+		rendered, or NULL if the image is not being rendered.
+*/
+Image_Tile* rendering_tile (const Plastic_Image* image) const;
+
+protected:
+
 /**	Run the rendering loop.
 */
 virtual void run_rendering ();
@@ -1122,8 +1221,8 @@ void image_loaded (bool successful);
 /**	Signal tile image rendering progress.
 
 	This signal is emitted from the {@link
-	Plastic_Image::Rendering_Monitor} when the Active_Tile does not
-	have an empty Tile_Region - i.e. some portion of the tile image
+	Plastic_Image::Rendering_Monitor} when the active tile being
+	rendered does not have an empty Tile_Region - i.e. some portion of the tile image
 	appears in the display - and the {@link
 	Plastic_Image::Rendering_Monitor::notification(Plastic_Image&,
 	Status, const QString&, const QRect&) rendering notification} {@link
@@ -1131,16 +1230,17 @@ void image_loaded (bool successful);
 	rendering bit set. Note that non-rendering status nofications do not
 	result in this signal being emitted from the Rendering_Monitor.
 
-	This signal is emitted from the main {@link render() render}
-	loop <b>after</b> a tile has completed rendering without being
-	canceled, if the tile has high priority status (i.e. it is visible in
-	the display viewport) or is marked as not cancelable. When {@link
-	immediate_mode(bool) immediate mode} is in effect the signal includes
-	the tile's display tile grid coordinate. Otherwise the signal is only
-	emitted when the next tile in the queue has low priority status or
-	the rendering queue is empty, and then the signal always has a null
-	tile coordinate. The signal emitted from the render loop always has
-	an empty tile region.
+	This signal is emitted from the {@link render_tile(Image_Tile*)
+	tile rendering} <b>after</b> a tile has completed rendering without
+	being canceled, if the tile has high priority status (i.e. it is
+	visible in the display viewport) or is marked as not cancelable.
+	When {@link immediate_mode(bool) immediate mode} is in effect the
+	signal includes the tile's display tile grid coordinate. Otherwise
+	the signal is only emitted when the next tile in the queue has low
+	priority status or the rendering queue is empty, and no other high
+	priority tile is active; then the signal always has a null tile
+	coordinate. The signal emitted after tile rendering always has an
+	empty tile region.
 
 	@param	tile_coordinate	A QPoint specifying the display tile grid
 		coordinate of the tile being rendered. May be null (have zero
@@ -1185,22 +1285,26 @@ void status_notice (const QString& message);
 	is emitted immediately <b>before</b> waiting for the ready event
 	latch to clear.
 
-	This signal is emitted from the main {@link render() render} loop
-	with the Active_Tile priority status (either {@link
+	This signal is emitted from the {@link render_tile(Image_Tile*)
+	tile rendering} with the active tile priority status (either {@link
 	#RENDERING_LOW_PRIORITY} or {@link #RENDERING_HIGH_PRIORITY})
-	immediately <b>before</b> the Active_Tile Image is updated (i.e.
+	immediately <b>before</b> the active tile Image is updated (i.e.
 	rendered if any updates are pending}.
 
-	This signal is emitted from the main {@link render() render} loop
-	with the Active_Tile priority status (either {@link
+	This signal is emitted from the {@link render_tile(Image_Tile*)
+	tile rendering} with the active tile priority status (either {@link
 	#RENDERING_LOW_PRIORITY} or {@link #RENDERING_HIGH_PRIORITY}) and
 	the {@link #RENDERING_CANCELED} qualifier bit set if rendering was
 	canceled for any reason. The signal is emitted <b>after</b> any
 	rendering in progress was canceled. Note that only rendering of
-	the Active_Tile may have been canceled rather than all queued
+	an active tile may have been canceled rather than all queued
 	rendering; check if any image {@link is_queued(Plastic_Image*)
 	is queued} to make the distinction.
 
+	<b>N.B.</b>: When active tiles are rendered concurrently the
+	#NOT_RENDERING value is only signaled after all active tiles have
+	been disposed of.
+
 	@param	An Image_Tile status value.
 	@see status_description(int)
 */
@@ -1211,9 +1315,9 @@ void status (int condition);
 	This signal is emitted when rendering did not complete during the
 	wait interval when the rendering queue was {@link clear(int) cleared}.
 
-	This signal is emitted from the main {@link render() render} loop
-	to forward a {@link Plastic_Image::Render_Exception} caught from
-	the rendering of the Active_Tile Image. The signal is emitted
+	This signal is emitted from the {@link render_tile(Image_Tile*)
+	tile rendering} to forward a {@link Plastic_Image::Render_Exception}
+	caught from the rendering of an active tile Image. The signal is emitted
 	immediately <b>before</b> the rendering queue is {@link reset(int)
 	reset}.
 
@@ -1239,8 +1343,8 @@ public slots:
 
 /*	Cancel rendering and {@link clear(int) clear} the queue.
 
-	Any rendering in progress is {@link abort(int) aborted} and the
-	rendering queue is {@link clear(int) cleared}.
+	Any rendering in progress is {@link abort(int, Plastic_Image*)
+	aborted} and the rendering queue is {@link clear(int) cleared}.
 
 	@param	cancel_options	One or more cancel options bit flags. The
 		{@link #DELETE_WHEN_DONE} flag marks the tile image to be deleted
@@ -1320,36 +1424,53 @@ Tile_Queue
 Tile_Queue
 	Delete_Queue;
 
-/**	The active tile has been acquired for rendering.
+/**	The active tiles that have been acquired for rendering.
 
-	The active tile is always acquired from the first Render_Queue entry
-	and will only be non-NULL when the renderer is running and has acquired
-	an active tile.
-
-	The Active_Tile is guarded by the Queue_Lock.
+	An active tile is taken from the Render_Queue by the rendering loop
+	and remains active until its rendering has been disposed of.
 */
-Image_Tile
-	*Active_Tile;
+Tile_Queue
+	Active_Tiles;
 
-//!	The current rendering operation has been canceled.
-bool
-	Cancel;
+/**	The Render_Queue or Active_Tiles have changed.
+
+	The event is set, with the Queue_Lock locked, when a tile is added
+	to the Render_Queue, when the queue is cleared, and when an active
+	tile is disposed of.
+*/
+Synchronized_Event
+	Queue_Event;
 
 
 //	Rendering_Lock access control ----------------------------------------------
-/*	Render only one image at a time.
+/*	Rendering state of the active tiles.
+
+	The Rendering_Lock is only held briefly, and never while a tile
+	image is being rendered, so it may be acquired from a rendering
+	monitor notification. When both locks are needed the Queue_Lock
+	must be acquired before the Rendering_Lock.
 
-	Because it is likely that there will be more than one Image_Renderer
-	in use by an application, the source image being rendered may be
-	shared amongst them, and image rendering may be done asynchronously
-	in a multi-threaded context, it is important to ensure that image
-	rendering is done synchrously, one at a time, across all
-	Image_Renderer objects. Therefor the rendering lock is a class data
-	member rather than an object data member.
+	N.B.: Image rendering is not serialized across Image_Renderer
+	objects. A Plastic_Image implementation that shares
+	a source amongst its clones which can not be used concurrently -
+	e.g. a JP2_Image JP2_Reader - is responsible for guarding the use of
+	its source.
 */
-static QMutex
+mutable QMutex
 	Rendering_Lock;
 
+//!	The active tiles with image rendering in progress.
+Tile_Queue
+	Rendering_Tiles;
+
+//!	The active tiles that have been aborted.
+Tile_Queue
+	Canceled_Tiles;
+
+//!	Set when an active tile is removed from the Rendering_Tiles.
+Synchronized_Event
+	Rendering_Event;
+
 friend class Image_Renderer_Rendering_Monitor;
 Image_Renderer_Rendering_Monitor
 	*Image_Rendering_Monitor;
@@ -23,6 +23,9 @@ Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
 
 #include	"Image_Renderer_Thread.hh"
 
+#include	<QThreadPool>
+#include	<QRunnable>
+
 
 #if defined (DEBUG_SECTION)
 /*******************************************************************************
@@ -67,6 +70,51 @@ const char* const
 	Image_Renderer_Thread::ID =
 		"UA::HiRISE::Image_Renderer_Thread ($Revision: 1.17 $ $Date: 2012/03/09 02:13:58 $)";
 
+#ifndef MAXIMUM_RENDERING_THREADS
+#define MAXIMUM_RENDERING_THREADS			64
+#endif
+const int
+	Image_Renderer_Thread::MAXIMUM_RENDERING_THREADS
+		= MAXIMUM_RENDERING_THREADS;
+
+/*==============================================================================
+	Defaults
+*/
+#ifndef DEFAULT_RENDERING_THREADS
+#define DEFAULT_RENDERING_THREADS			0
+#endif
+int
+	Image_Renderer_Thread::Default_Rendering_Threads
+		= DEFAULT_RENDERING_THREADS;
+
+/*==============================================================================
+	Tile_Rendering
+*/
+class Image_Renderer_Thread::Tile_Rendering
+:	public QRunnable
+{
+public:
+
+Tile_Rendering
+	(
+	Image_Renderer_Thread*	renderer,
+	Image_Tile*				image_tile
+	)
+	:	Renderer (renderer),
+		Tile (image_tile)
+{setAutoDelete (true);}
+
+void run ()
+{Renderer->render_tile (Tile);}
+
+private:
+
+Image_Renderer_Thread
+	*Renderer;
+Image_Tile
+	*Tile;
+};
+
 /*==============================================================================
 	Constructors
 */
@@ -75,9 +123,11 @@ Image_Renderer_Thread::Image_Renderer_Thread
 	QObject	*parent
 	)
 	:	Image_Renderer (parent),
-		QThread (parent)
+		QThread (parent),
+		Rendering_Pool (new QThreadPool)
 {
 Image_Renderer::setObjectName ("Image_Renderer_Thread");
+Rendering_Pool->setMaxThreadCount (rendering_threads ());
 #if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
 LOCKED_LOGGING ((
 clog << ">>> Image_Renderer_Thread @ " << (void*)this
@@ -104,12 +154,44 @@ clog << ">>> ~Image_Renderer_Thread @ " << (void*)this << endl));
 */
 if (! Finish)
 	finish (WAIT_UNTIL_DONE | FORCE_CANCEL);
+//	Any tiles still being rendered must be done before the pool is gone.
+Rendering_Pool->waitForDone ();
+delete Rendering_Pool;
 #if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
 LOCKED_LOGGING ((
 clog << "<<< ~Image_Renderer_Thread @ " << (void*)this << endl));
 #endif
 }
 
+/*==============================================================================
+	Accessors
+*/
+void
+Image_Renderer_Thread::default_rendering_threads
+	(
+	int		threads
+	)
+{
+if (threads < 0)
+	threads = 0;
+if (threads > MAXIMUM_RENDERING_THREADS)
+	threads = MAXIMUM_RENDERING_THREADS;
+Default_Rendering_Threads = threads;
+}
+
+
+int
+Image_Renderer_Thread::rendering_threads () const
+{
+int
+	threads = Default_Rendering_Threads;
+if (threads <= 0)
+	threads = QThread::idealThreadCount ();
+if (threads > MAXIMUM_RENDERING_THREADS)
+	threads = MAXIMUM_RENDERING_THREADS;
+return (threads < 1) ? 1 : threads;
+}
+
 /*==============================================================================
 	Run the rendering thread
 */
@@ -142,6 +224,25 @@ Image_Renderer_Thread::run_rendering ()
 {}
 
 
+void
+Image_Renderer_Thread::dispatch_tile
+	(
+	Image_Tile*	image_tile
+	)
+{
+#if ((DEBUG_SECTION) & DEBUG_RENDER)
+LOCKED_LOGGING ((
+clog << ">-< Image_Renderer_Thread::dispatch_tile "
+		<< (void*)QThread::currentThreadId () << ": " << *image_tile << endl));
+#endif
+int
+	threads = rendering_threads ();
+if (Rendering_Pool->maxThreadCount () != threads)
+	Rendering_Pool->setMaxThreadCount (threads);
+Rendering_Pool->start (new Tile_Rendering (this, image_tile));
+}
+
+
 bool
 Image_Renderer_Thread::is_ready ()
 {
@@ -156,6 +257,11 @@ clog << ">>> Image_Renderer_Thread::is_ready " << thread_ID << endl
 	 << ">>> Image_Renderer_Thread::is_ready "
 		<< ": lock Ready_Lock" << endl));
 #endif
+if (suspended ())
+	/*	Tiles dispatched to the rendering pool may still be rendering.
+		Rendering is not done until they have been disposed of.
+	*/
+	wait_until_idle ();
 Ready_Lock.lock ();
 if (Suspended)
 	{
@@ -310,6 +416,9 @@ if (isRunning ())
 		wait (Wait_Seconds * 1000);
 		}
 	}
+if (cancel_options & WAIT_UNTIL_DONE)
+	//	Wait for the rendering pool to dispose of any dispatched tiles.
+	Rendering_Pool->waitForDone (Wait_Seconds * 1000);
 bool
 	finished = isFinished ();
 #if ((DEBUG_SECTION) & (DEBUG_CONSTRUCTORS | DEBUG_RENDER))
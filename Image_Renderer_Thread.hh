@@ -29,6 +29,9 @@ Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
 
 #include	<QThread>
 
+//	Forward reference.
+class QThreadPool;
+
 
 namespace UA
 {
@@ -39,6 +42,19 @@ class JP2_Image;
 
 
 /**	An <i>Image_Renderer_Thread</i> provides asychronous image rendering.
+
+	The rendering loop runs in its own thread. Each active tile that
+	the loop {@link dispatch_tile(Image_Tile*) dispatches} is rendered
+	by a thread from a rendering pool, so the images of several tiles
+	may be rendered concurrently. The number of threads in the pool is
+	the {@link default_rendering_threads(int) default rendering threads}
+	value.
+
+	<b>N.B.</b>: The tile images of a JP2_Image share its JP2_Reader,
+	which decodes source data for one tile at a time. Only the mapping
+	of decoded source data to the display is concurrent for the tiles
+	of the same JP2 image; the tiles of images with different readers
+	are decoded concurrently.
 */
 class Image_Renderer_Thread
 :	public Image_Renderer,
@@ -52,6 +68,10 @@ public:
 static const char* const
 	ID;
 
+//!	Maximum number of rendering pool threads.
+static const int
+	MAXIMUM_RENDERING_THREADS;
+
 /*==============================================================================
 	Constructors
 */
@@ -61,6 +81,41 @@ explicit Image_Renderer_Thread (QObject *parent = NULL);
 
 virtual ~Image_Renderer_Thread ();
 
+/*==============================================================================
+	Accessors
+*/
+/**	Set the default number of rendering pool threads.
+
+	<b>N.B.</b>: The rendering pool of every Image_Renderer_Thread is
+	resized to the new value before it next dispatches a tile.
+
+	@param	threads	The number of threads to be used to render tiles.
+		If zero the ideal number of threads for the host system - the
+		number of processor cores - will be used. The value is limited
+		to the #MAXIMUM_RENDERING_THREADS; negative values are treated
+		as zero.
+	@see	rendering_threads()
+*/
+static void default_rendering_threads (int threads);
+
+/**	Get the default number of rendering pool threads.
+
+	@return	The default number of rendering pool threads. This will be
+		zero if the ideal number of threads for the host system is to
+		be used.
+	@see	default_rendering_threads(int)
+*/
+inline static int default_rendering_threads ()
+	{return Default_Rendering_Threads;}
+
+/**	Get the number of threads available for rendering image tiles.
+
+	@return	The {@link default_rendering_threads() default rendering
+		threads} value, or the ideal number of threads for the host
+		system if the default is zero. The value is never less than 1.
+*/
+virtual int rendering_threads () const;
+
 /*==============================================================================
 	Run
 */
@@ -73,6 +128,10 @@ virtual ~Image_Renderer_Thread ();
 	delete queue are {@link delete_tiles() deleted}.
 
 	If the rendering thread is not running, nothing more is done.
+	Otherwise, if the cancel options have the {@link #WAIT_UNTIL_DONE}
+	flag set, the rendering pool is also given up to {@link
+	#Wait_Seconds} seconds to complete the rendering of any tiles that
+	had been dispatched.
 
 	If the rendering loop is {@link suspended() suspended} it is
 	{@link start_rendering() started} again so the thread can proceed to
@@ -165,12 +224,24 @@ virtual void run ();
 */
 virtual void run_rendering ();
 
+/**	Dispatch an active tile for rendering.
+
+	The tile is {@link render_tile(Image_Tile*) rendered} by a thread
+	of the rendering pool. The pool is resized to the number of {@link
+	rendering_threads() rendering threads} first if that has changed.
+
+	@param	image_tile	A pointer to the active Image_Tile to be
+		rendered.
+*/
+virtual void dispatch_tile (Image_Tile* image_tile);
+
 /**	Test if the rendering loop is ready to continue.
 
 	<b>N.B.</b>: The Ready_Lock is locked during this method.
 
 	This method is called in each cycle of the rendering loop. If the
 	rendering loop has been {@link suspend_rendering(bool) suspended} the
+	thread first waits for any active tiles to be disposed of, then the
 	{@link status(int) status} signal is emitted with the {@link
 	#Image_Tile::FINISHED} condition, and the thread will wait (block
 	execution) until the ready condition event has been set before
@@ -188,9 +259,21 @@ virtual bool is_ready ();
 */
 private:
 
+//!	Default number of rendering pool threads; zero for the ideal number.
+static int
+	Default_Rendering_Threads;
+
 //!	The thread's ready to run condition.
 Synchronized_Event
 	Ready_Event;
+
+//!	The threads that render dispatched tiles.
+QThreadPool
+	*Rendering_Pool;
+
+//	The QRunnable that renders a dispatched tile.
+class Tile_Rendering;
+friend class Tile_Rendering;
 };
 
 
@@ -1026,6 +1026,14 @@ Image_Viewer::rendering_increment_lines
 {Image_Display->rendering_increment_lines (rendering_increment);}
 
 
+void
+Image_Viewer::rendering_threads
+	(
+	int		threads
+	)
+{Image_Display->rendering_threads (threads);}
+
+
 void
 Image_Viewer::background_color
 	(
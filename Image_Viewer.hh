@@ -703,6 +703,9 @@ namespace UA
             inline static int rendering_increment_lines ()
             {return Tiled_Image_Display::rendering_increment_lines ();}
             
+            inline static int rendering_threads ()
+            {return Tiled_Image_Display::rendering_threads ();}
+            
             inline static QRgb background_color ()
             {return Tiled_Image_Display::background_color ();}
             
@@ -1095,6 +1098,14 @@ namespace UA
              */
             void rendering_increment_lines (int rendering_increment);
             
+            /**	Set the number of threads used to render image tiles.
+             
+             @param	threads	The number of image tiles that may be rendered
+             concurrently. If zero the number of processor cores is used.
+             @see	rendering_threads()
+             */
+            void rendering_threads (int threads);
+            
             void background_color (QRgb color);
             
             /**	Set the size, in display space, of an image rendering tile.
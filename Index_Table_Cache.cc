@@ -0,0 +1,238 @@
+/*	Index_Table_Cache
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#include	"Index_Table_Cache.hh"
+
+#include	<QList>
+#include	<QWeakPointer>
+#include	<QMutex>
+#include	<QMutexLocker>
+
+
+#if defined (DEBUG_SECTION)
+/*******************************************************************************
+	DEBUG_SECTION controls
+
+	DEBUG_SECTION report selection options.
+	Define any of the following options to obtain the desired debug reports:
+*/
+#define DEBUG_OFF			0
+#define DEBUG_ALL			-1
+#define DEBUG_TABLES		(1 << 0)
+
+#define DEBUG_DEFAULT		DEBUG_ALL
+
+#if (DEBUG_SECTION+0) == 0
+#undef  DEBUG_SECTION
+#define DEBUG_SECTION DEBUG_OFF
+#else
+#include	<iostream>
+using std::clog;
+using std::endl;
+#endif
+
+#endif	//	DEBUG_SECTION
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/*==============================================================================
+	Constants
+*/
+const char* const
+	Index_Table_Cache::ID =
+		"UA::HiRISE::Index_Table_Cache ($Revision: 1.1 $ $Date: 2026/10/17 00:00:00 $)";
+
+#ifndef DEFAULT_INDEX_TABLE_CACHE_TABLES
+#define DEFAULT_INDEX_TABLE_CACHE_TABLES	64
+#endif
+const int
+	Index_Table_Cache::DEFAULT_MAX_TABLES	= DEFAULT_INDEX_TABLE_CACHE_TABLES;
+
+namespace
+{
+struct Index_Table_Entry
+{
+double
+	Step,
+	Phase;
+int
+	Count;
+QWeakPointer<const Index_Table_Cache::Index_Table>
+	Table;
+};
+
+struct Index_Tables
+{
+//	All tables that may be in use.
+QList<Index_Table_Entry>
+	Entries;
+//	Tables retained while not in use, most recently used first.
+QList<Index_Table_Cache::Shared_Index_Table>
+	Retained;
+int
+	Max_Tables;
+QMutex
+	Lock;
+
+Index_Tables ()
+	:	Max_Tables (Index_Table_Cache::DEFAULT_MAX_TABLES)
+{}
+
+void
+retain
+	(
+	const Index_Table_Cache::Shared_Index_Table&	table
+	)
+{
+Retained.removeOne (table);
+if (Max_Tables > 0)
+	Retained.prepend (table);
+while (Retained.size () > Max_Tables)
+	Retained.removeLast ();
+}
+};
+
+Index_Tables&
+tables ()
+{
+static Index_Tables
+	index_tables;
+return index_tables;
+}
+}
+
+/*==============================================================================
+	Index tables
+*/
+Index_Table_Cache::Shared_Index_Table
+Index_Table_Cache::index_table
+	(
+	double	step,
+	double	phase,
+	int		count
+	)
+{
+if (count < 0)
+	count = 0;
+Index_Tables
+	&cache = tables ();
+QMutexLocker
+	lock (&cache.Lock);
+
+Shared_Index_Table
+	table;
+for (int
+		index = 0;
+		index < cache.Entries.size ();
+		)
+	{
+	Index_Table_Entry
+		&entry = cache.Entries[index];
+	if (entry.Table.isNull ())
+		{
+		//	No longer in use.
+		cache.Entries.removeAt (index);
+		continue;
+		}
+	if (entry.Step  == step &&
+		entry.Phase == phase &&
+		entry.Count == count &&
+		! (table = entry.Table.toStrongRef ()).isNull ())
+		break;
+	++index;
+	}
+
+if (table.isNull ())
+	{
+	Index_Table
+		*indices = new Index_Table (count);
+	for (int
+			index = 0;
+			index < count;
+			index++)
+		(*indices)[index] = qRound (phase + (step * index));
+	table = Shared_Index_Table (indices);
+
+	Index_Table_Entry
+		entry;
+	entry.Step  = step;
+	entry.Phase = phase;
+	entry.Count = count;
+	entry.Table = table;
+	cache.Entries.append (entry);
+	#if ((DEBUG_SECTION) & DEBUG_TABLES)
+	clog << ">-< Index_Table_Cache::index_table: new table "
+			<< step << " step, " << phase << " phase, " << count
+			<< " count; " << cache.Entries.size () << " tables" << endl;
+	#endif
+	}
+cache.retain (table);
+return table;
+}
+
+
+void
+Index_Table_Cache::max_tables
+	(
+	int		tables_max
+	)
+{
+if (tables_max < 0)
+	tables_max = 0;
+Index_Tables
+	&cache = tables ();
+QMutexLocker
+	lock (&cache.Lock);
+cache.Max_Tables = tables_max;
+while (cache.Retained.size () > cache.Max_Tables)
+	cache.Retained.removeLast ();
+}
+
+
+int
+Index_Table_Cache::max_tables ()
+{
+Index_Tables
+	&cache = tables ();
+QMutexLocker
+	lock (&cache.Lock);
+return cache.Max_Tables;
+}
+
+
+void
+Index_Table_Cache::clear ()
+{
+Index_Tables
+	&cache = tables ();
+QMutexLocker
+	lock (&cache.Lock);
+cache.Retained.clear ();
+}
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
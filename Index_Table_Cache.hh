@@ -0,0 +1,123 @@
+/*	Index_Table_Cache
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#ifndef HiView_Index_Table_Cache_hh
+#define HiView_Index_Table_Cache_hh
+
+#include	<QVector>
+#include	<QSharedPointer>
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/**	The <i>Index_Table_Cache</i> provides shared tables of source image
+	index locations for scaled image rendering.
+
+	When a display image is rendered with an axis-aligned scaling of the
+	source image the source sample location of each display sample is
+	the same on every display line, and the source line location of each
+	display line is the same for every display sample. These locations
+	are the whole part of the scaled location origin plus an index
+	offset that depends only on the scaling factor, the sub-pixel phase
+	of the origin and the number of locations. An index table holds
+	these offsets.
+
+	A tiled display renders many tiles with the same scaling, phase and
+	size; the index tables are shared, with reference counting, by all
+	the renderings that use them so the location mapping is done once
+	rather than for every tile and band. A limited number of the most
+	recently used tables are retained while not in use.
+
+	The Index_Table_Cache is thread safe.
+
+	@version	$Revision: 1.1 $
+*/
+class Index_Table_Cache
+{
+public:
+/*==============================================================================
+	Constants
+*/
+//!	Class identification name with source code version and date.
+static const char* const
+	ID;
+
+//!	Default maximum number of retained index tables.
+static const int
+	DEFAULT_MAX_TABLES;
+
+/*==============================================================================
+	Types
+*/
+//!	Index offsets from the whole part of the location origin.
+typedef QVector<int>						Index_Table;
+typedef QSharedPointer<const Index_Table>	Shared_Index_Table;
+
+/*==============================================================================
+	Index tables
+*/
+/**	Get an index table.
+
+	The entry for each location index is the rounded offset of the
+	scaled location, phase + (step * index), from the origin.
+
+	@param	step	The source location step for each display location.
+	@param	phase	The sub-pixel phase of the source location origin;
+		i.e. the origin less its whole part.
+	@param	count	The number of locations.
+	@return	A shared pointer to the index table. This will be a table
+		retained from a previous use with the same arguments if possible.
+*/
+static Shared_Index_Table index_table (double step, double phase,
+	int count);
+
+/**	Set the maximum number of index tables retained while not in use.
+
+	@param	tables	The maximum number of retained tables. If zero no
+		tables are retained, though tables in use are still shared.
+*/
+static void max_tables (int tables);
+
+/**	Get the maximum number of index tables retained while not in use.
+
+	@return	The maximum number of retained tables.
+*/
+static int max_tables ();
+
+/**	Release all retained index tables.
+
+	Tables in use remain valid until they are no longer referenced.
+*/
+static void clear ();
+
+private:
+//	Not instantiable.
+Index_Table_Cache ();
+};
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
+#endif
@@ -24,6 +24,9 @@ Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
 #include	"JP2_Image.hh"
 
 #include	"HiView_Utilities.hh"
+#include	"Data_Map_Kernels.hh"
+#include	"Decoded_Data_Cache.hh"
+#include	"Box_Filter.hh"
 
 //	UA::HiRISE::JP2_Reader.
 #include	"JP2.hh"
@@ -40,6 +43,9 @@ using UA::HiRISE::JP2_Exception;
 using idaeim::PVL::Aggregate;
 
 #include	<QMutexLocker>
+#include	<QHash>
+#include	<QFileInfo>
+#include	<QDateTime>
 
 #include	<string>
 using std::string;
@@ -138,6 +144,79 @@ Plastic_Image::Name_String
 #define JP2_RENDERING_INCREMENT_LINES	400
 #endif
 
+/*==============================================================================
+	Class data
+*/
+namespace
+{
+//	A JP2_Reader lock and the number of JP2_Images using it.
+struct Reader_Lock_Entry
+	{
+	QMutex
+		Lock;
+	int
+		Users;
+
+	Reader_Lock_Entry ()
+		:	Users (0)
+		{}
+	};
+
+//	Locks by JP2_Reader.
+QHash<const JP2_Reader*, Reader_Lock_Entry*>
+	Reader_Locks;
+QMutex
+	Reader_Locks_Lock;
+
+/*	Holds a JP2_Reader lock for rendering.
+
+	When unlocked, explicitly or on destruction - including when an
+	exception is thrown - any Rendering_Monitor registered with the
+	reader is deregistered before the lock is released.
+*/
+class Reader_Render_Lock
+{
+public:
+
+Reader_Render_Lock
+	(
+	QMutex*		lock,
+	JP2_Reader*	reader
+	)
+	:	Lock (lock),
+		Reader (reader),
+		Locked (true)
+{Lock->lock ();}
+
+~Reader_Render_Lock ()
+{unlock ();}
+
+void
+unlock ()
+{
+if (Locked)
+	{
+	Locked = false;
+	Reader->rendering_monitor (NULL);
+	Lock->unlock ();
+	}
+}
+
+private:
+
+QMutex
+	*Lock;
+JP2_Reader
+	*Reader;
+bool
+	Locked;
+};
+}
+
+#ifndef DECODED_DATA_CACHE_SIZE
+#define DECODED_DATA_CACHE_SIZE		Decoded_Data_Cache::DEFAULT_MAX_SIZE
+#endif
+
 
 #ifndef	DOXYGEN_PROCESSING
 /*==============================================================================
@@ -849,6 +928,7 @@ JP2_Image::JP2_Image
 			: size),
 		band_map, transforms, data_maps),
 	Source (JP2_reader),
+	Reader_Lock (NULL),
 	Source_Rendering_Monitor (NULL),
 	Data_Buffer_Size (0)
 {
@@ -889,6 +969,7 @@ JP2_Image::JP2_Image
 				*= (1.0 / JP2_reader.resolution_level ())),
 		band_map, transforms, data_maps),
 	Source (JP2_reader.clone ()),
+	Reader_Lock (NULL),
 	Source_Rendering_Monitor (NULL),
 	Data_Buffer_Size (0)
 {
@@ -923,6 +1004,7 @@ JP2_Image::JP2_Image
 		(shared_mappings & DATA_MAPS)  ?
 			const_cast<const Data_Map**>(image.source_data_maps ()) : NULL),
 	Source (image.Source),	//	Share the JP2_Reader.
+	Reader_Lock (NULL),
 	Source_Rendering_Monitor (NULL),
 	Data_Buffer_Size (0)
 {
@@ -985,6 +1067,7 @@ JP2_Image::JP2_Image
 	:
 	Plastic_Image (size),
 	Source (NULL),
+	Reader_Lock (NULL),
 	Source_Rendering_Monitor (NULL),
 	Data_Buffer_Size (0)
 {
@@ -1039,6 +1122,10 @@ Display_Data_Buffers[2] = NULL;
 //	Initialize the base class object.
 Plastic_Image::initialize ();
 
+//	Share the lock of the Source with all other users of the Source.
+if (! Reader_Lock)
+	Reader_Lock = acquire_reader_lock (Source);
+
 if (! Source)
 	{
 	close ();
@@ -1219,6 +1306,9 @@ if (Source_Data_Buffers)
 
 if (Source_Rendering_Monitor)
 	delete Source_Rendering_Monitor;
+
+if (Reader_Lock)
+	release_reader_lock (Source);
 #if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
 clog << "<<< ~JP2_Image" << endl;
 #endif
@@ -1618,6 +1708,9 @@ unsigned int
 	source_data_width = (Display_Data_Buffers[band]->Rendered_Size).width (),
 	line_samples = source_data_region.width (),
 	max_value = histogram->size ();
+//	Count directly in the histogram data; avoids a detach check by datum.
+quint64
+	*counts = histogram->data ();
 Pixel_Data_Type
 	*data =
 		reinterpret_cast<Pixel_Data_Type*>(Display_Data_Buffers[band]->Buffer)
@@ -1638,7 +1731,7 @@ while (data < end_data)
 		{
 		if ((value = *(datum++)) < max_value)
 			{
-			(*histogram)[value]++;
+			counts[value]++;
 			#if ((DEBUG_SECTION) & DEBUG_PRINT_HISTOGRAMS)
 			clog << ' ' << setw (pixel_value_digits) << ((int)value & mask);
 			#endif
@@ -1891,6 +1984,18 @@ if (bands > 3)
 LOCKED_LOGGING ((
 clog << "    mapping_differences = " << mapping_differences () << endl));
 #endif
+//	Only one JP2_Image may render with the shared Source at a time.
+Reader_Render_Lock
+	reader_lock (Reader_Lock, Source);
+if (update_canceled ())
+	{
+	//	Canceled while waiting for the Source.
+	#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_OVERVIEW | DEBUG_LOCATION))
+	LOCKED_LOGGING ((
+	clog << "<<< JP2_Image::render_source: canceled" << endl));
+	#endif
+	return false;
+	}
 if (Rendering->Mapping_Differences & TRANSFORMS)
 	{
 	//	Geometric differences between the different bands.
@@ -1951,18 +2056,7 @@ if (Rendering->Mapping_Differences & TRANSFORMS)
 				notifications being sent after each increment to the
 				registered Rendering_Monitor.
 			*/
-			try {actual = Source->render ();}
-			catch (JP2_Exception&)
-				{
-				//	Deregister the JP2_Reader::Rendering_Monitor.
-				Source->rendering_monitor (NULL);
-				throw;
-				}
-			catch (...)
-				{
-				Source->rendering_monitor (NULL);
-				throw;
-				}
+			actual = Source->render ();
 
 			#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_OVERVIEW))
 			LOCKED_LOGGING ((
@@ -1979,7 +2073,7 @@ if (Rendering->Mapping_Differences & TRANSFORMS)
 		}
 
 	//	Deregister the JP2_Reader::Rendering_Monitor.
-	Source->rendering_monitor (NULL);
+	reader_lock.unlock ();
 	}
 else
 	{
@@ -1991,6 +2085,25 @@ else
 		//	Reset the display image to background.
 		fill (Rendering->Background_Color);
 
+		//	Resolution and region determines rendered region.
+		expected = Source->rendered_region ();
+
+		if (fetch_decoded_data (expected))
+			{
+			//	The Source is not needed; the decoded data was cached.
+			int
+				increment = Source->effective_rendering_increment_lines ();
+			reader_lock.unlock ();
+			source_data_rendered (true);
+			rendered = map_source (increment);
+			#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_OVERVIEW | DEBUG_LOCATION))
+			LOCKED_LOGGING ((
+			clog << "<<< JP2_Image::render_source: cached data "
+					<< boolalpha << rendered << endl));
+			#endif
+			return rendered;
+			}
+
 		/*	Register the JP2_Reader::Rendering_Monitor.
 
 			The Rendering_Monitor will receive incremental rendering
@@ -2024,9 +2137,6 @@ else
 			 	<< *Rendering_Display_Data_Buffers[2] << endl));
 		#endif
 
-		//	Resolution and region determines rendered region.
-		expected = Source->rendered_region ();
-
 		/*	Render the source.
 
 			The JPEG2000 codestream is fetched and decompressed into
@@ -2034,20 +2144,13 @@ else
 			to be done incrementally with notifications being sent after
 			each increment to the registered Rendering_Monitor.
 		*/
-		try {actual = Source->render ();}
-		catch (JP2_Exception&)
-			{
-			//	Deregister the JP2_Reader::Rendering_Monitor.
-			Source->rendering_monitor (NULL);
-			throw;
-			}
-		catch (...)
-			{
-			Source->rendering_monitor (NULL);
-			throw;
-			}
-		Source->rendering_monitor (NULL);
+		actual = Source->render ();
+
+		//	Deregister the JP2_Reader::Rendering_Monitor.
+		reader_lock.unlock ();
 		source_data_rendered (rendered = (actual == expected));
+		if (rendered)
+			cache_decoded_data (expected);
 		#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_OVERVIEW | DEBUG_LOCATION))
 		LOCKED_LOGGING ((
 		clog << "      rendered region " << expected << ' '
@@ -2056,8 +2159,14 @@ else
 		#endif
 		}
 	else
-	if (Rendering->Needs_Update)
-		rendered = map_source ();
+		{
+		//	The Source is not needed to remap the rendered source data.
+		int
+			increment = Source->effective_rendering_increment_lines ();
+		reader_lock.unlock ();
+		if (Rendering->Needs_Update)
+			rendered = map_source (increment);
+		}
 	}
 #if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_OVERVIEW | DEBUG_LOCATION))
 LOCKED_LOGGING ((
@@ -2068,7 +2177,10 @@ return rendered;
 
 
 bool
-JP2_Image::map_source ()
+JP2_Image::map_source
+	(
+	int		increment
+	)
 {
 #if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_LOCATION))
 LOCKED_LOGGING ((
@@ -2081,9 +2193,8 @@ Rendering_Monitor::Status
 	status = Rendering_Monitor::REMAPPING_DATA;
 int
 	data_precision = source_precision_bytes (),
-	display_height = height (),
-	increment = Source->effective_rendering_increment_lines ();
-if (increment == 0)
+	display_height = height ();
+if (increment <= 0)
 	increment = display_height;
 #if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_LOCATION))
 LOCKED_LOGGING ((
@@ -2136,6 +2247,133 @@ return mapped;
 }
 
 
+Decoded_Data_Cache&
+JP2_Image::decoded_data_cache ()
+{
+static Decoded_Data_Cache
+	cache (DECODED_DATA_CACHE_SIZE);
+return cache;
+}
+
+
+QString
+JP2_Image::decoded_data_key
+	(
+	int					band,
+	const PIRL::Cube&	region
+	)
+{
+if (Cache_Source_Name.isEmpty ())
+	{
+	if (source_name ().isEmpty ())
+		return QString ();
+	Cache_Source_Name = source_name ();
+	QFileInfo
+		file (Cache_Source_Name);
+	if (file.isFile ())
+		//	Cached data from a replaced file must not be used.
+		Cache_Source_Name = file.canonicalFilePath () + '@'
+			+ QString::number (file.lastModified ().toMSecsSinceEpoch ());
+	}
+return Decoded_Data_Cache::key (Cache_Source_Name,
+	Rendering_Display_Data_Buffers[band]->Rendered_Resolution,
+	Rendering->Band_Map[band],
+	QRect (region.X, region.Y, region.Width, region.Height));
+}
+
+
+bool
+JP2_Image::fetch_decoded_data
+	(
+	const PIRL::Cube&	region
+	)
+{
+Decoded_Data_Cache&
+	cache (decoded_data_cache ());
+if (! cache.enabled ())
+	return false;
+
+int
+	band;
+QString
+	keys[3];
+for (band = 0;
+	 band < 3;
+	 band++)
+	{
+	if ((keys[band] = decoded_data_key (band, region)).isEmpty () ||
+		! cache.contains (keys[band]))
+		return false;
+	}
+
+qint64
+	amount = (qint64)
+		(Rendering_Display_Data_Buffers[0]->Rendered_Size).width ()
+		* (Rendering_Display_Data_Buffers[0]->Rendered_Size).height ()
+		* source_precision_bytes ();
+if (amount <= 0 ||
+	(unsigned long long)amount > Data_Buffer_Size)
+	return false;
+
+for (band = 0;
+	 band < 3;
+	 band++)
+	{
+	//	Display bands may share a source data buffer.
+	if (band &&
+		Rendering_Display_Data_Buffers[band]->Buffer ==
+		Rendering_Display_Data_Buffers[band - 1]->Buffer)
+		continue;
+	if (! cache.fetch (keys[band],
+			Rendering_Display_Data_Buffers[band]->Buffer, amount))
+		return false;
+	}
+#if ((DEBUG_SECTION) & (DEBUG_RENDER | DEBUG_DATA_BUFFERS))
+LOCKED_LOGGING ((
+clog << ">-< JP2_Image::fetch_decoded_data: " << region << endl));
+#endif
+return true;
+}
+
+
+void
+JP2_Image::cache_decoded_data
+	(
+	const PIRL::Cube&	region
+	)
+{
+Decoded_Data_Cache&
+	cache (decoded_data_cache ());
+if (! cache.enabled ())
+	return;
+
+qint64
+	amount = (qint64)
+		(Rendering_Display_Data_Buffers[0]->Rendered_Size).width ()
+		* (Rendering_Display_Data_Buffers[0]->Rendered_Size).height ()
+		* source_precision_bytes ();
+if (amount <= 0 ||
+	(unsigned long long)amount > Data_Buffer_Size)
+	return;
+
+QString
+	key;
+for (int
+		band = 0;
+		band < 3;
+		band++)
+	{
+	if (band &&
+		Rendering_Display_Data_Buffers[band]->Buffer ==
+		Rendering_Display_Data_Buffers[band - 1]->Buffer)
+		continue;
+	if ((key = decoded_data_key (band, region)).isEmpty ())
+		return;
+	cache.insert (key, Rendering_Display_Data_Buffers[band]->Buffer, amount);
+	}
+}
+
+
 template<typename Pixel_Data_Type>
 bool
 JP2_Image::map_source_data_to_display_data
@@ -2151,11 +2389,7 @@ LOCKED_LOGGING ((
 clog << ">>> JP2_Image::map_source_data_to_display_data: " << region << endl
 	 << "    " << *this << endl));
 #endif
-Pixel_Datum
-	datum;
 QRgb
-	pixel_value,
-	*display_data,
 	*image_display_data =
 		image_data () + (region.top () * width ()) + region.left ();
 int
@@ -2171,11 +2405,14 @@ if (source_sample == 0 &&
 int
 	display_line = region.top () - 1,
 	display_sample,
+	display_samples = source_sample,
 	display_line_end   = region.top ()  + source_line,
 	display_sample_end = region.left () + source_sample;
 double
 	line,
-	sample;
+	sample,
+	line_sample,
+	step;
 #if ((DEBUG_SECTION) & (DEBUG_RENDER | \
 				DEBUG_PIXEL_MAPPING | \
 				DEBUG_PIXEL_DATA | \
@@ -2195,9 +2432,22 @@ clog << "      display image size = " << size () << endl
 	 	<< "-bit source_data -" << endl
 	 << "         background_color #"
 		<< setw (sizeof (QRgb)) << setfill ('0') << hex
-		<< Rendering->Background_Color << setfill (' ') << dec << endl;
+		<< Rendering->Background_Color << setfill (' ') << dec << endl
+	 << "            SIMD kernels = "
+	 	<< SIMD_level_name (data_map_kernels_level ()) << endl;
 	UNLOCK_LOG;
 #endif
+if (display_samples <= 0)
+	{
+	#if ((DEBUG_SECTION) & (DEBUG_RENDER | \
+					DEBUG_PIXEL_MAPPING | \
+					DEBUG_PIXEL_DATA | \
+					DEBUG_LOCATION))
+	LOCKED_LOGGING ((
+	clog << "<<< JP2_Image::map_source_data_to_display_data: true" << endl));
+	#endif
+	return true;
+	}
 
 //	Pre-map the band-map sensitive values.
 QTransform
@@ -2206,11 +2456,12 @@ Pixel_Data_Type
 	*source_data[3];
 unsigned int
 	source_data_width[3],
-	source_data_height[3];
+	source_data_height[3],
+	data_map_size[3];
 Data_Map
 	*data_maps[3];
-QRgb
-	background_value[3];
+quint8
+	background_datum[3];
 int
 	band = -1;
 while (++band < 3)
@@ -2233,10 +2484,11 @@ while (++band < 3)
 
 	//	Source-to-Display data LUT.
 	data_maps[band] = Rendering->Data_Maps[band];
+	data_map_size[band] = static_cast<unsigned int>(data_maps[band]->size ());
 
 	//	Background (no image) value.
-	background_value[band] =
-		Rendering->Background_Color & (0xFF << (16 - (band << 3)));
+	background_datum[band] = static_cast<quint8>
+		(Rendering->Background_Color >> (16 - (band << 3)));
 
 	#if ((DEBUG_SECTION) & (DEBUG_RENDER | \
 					DEBUG_PIXEL_MAPPING | \
@@ -2269,134 +2521,219 @@ while (++band < 3)
 	#endif
 	}
 
+/*	Line mapping buffers.
+
+	Each display line is mapped band by band. When the source data for
+	the entire display line is contiguous in the source data buffer -
+	the usual case of an identity differential transform - the source
+	data line is mapped directly through the band's Data_Map by the
+	data map kernel for the source data type. Otherwise the source data
+	at the sample locations found by stepping the differential transform
+	along the display line is first gathered into a line of values, with
+	locations outside the source data marked as undefined. The three
+	lines of display band values are then packed into the display line.
+
+	A band scaled down by the differential transform - the residual
+	scaling between source resolution levels - is box filtered: the
+	source data lines covered by each display line are accumulated and
+	the sums averaged over the source samples covered by each display
+	sample. The horizontal source sample bins are set once for the
+	region.
+*/
+Pixel_Datum
+	*source_values = new Pixel_Datum[display_samples];
+Box_Filter
+	*box_filters[3] = {NULL, NULL, NULL};
+int
+	filter_line,
+	filter_line_end;
+for (band = 0;
+	 band < 3;
+	 band++)
+	{
+	if (! box_filter_rendering () ||
+		! transforms[band] ||
+		! Box_Filter::applicable (*transforms[band]))
+		continue;
+	//	Source pixel centers are half a pixel from the rounded down locations.
+	box_filters[band] = new Box_Filter;
+	box_filters[band]->samples (display_samples,
+		(transforms[band]->m11 () * region.left ())
+			+ transforms[band]->dx () - 0.5,
+		transforms[band]->m11 (), source_data_width[band]);
+	}
+quint8
+	*band_values[3];
+band_values[0] = new quint8[display_samples * 3];
+band_values[1] = band_values[0] + display_samples;
+band_values[2] = band_values[1] + display_samples;
+const Pixel_Data_Type
+	*source_line_data;
+
 while (++display_line < display_line_end)
 	{
-	display_data = image_display_data;
-	display_sample = region.left () - 1;
-	while (++display_sample < display_sample_end)
+	#if ((DEBUG_SECTION) & DEBUG_PIXEL_MAPPING)
+	#if ((DEBUG_SECTION) & DEBUG_ONE_LINE)
+	if (! display_line)
+	#endif
+		clog << "    line " << display_line << " -" << endl;
+	#endif
+	band = -1;
+	while (++band < 3)
 		{
-		pixel_value = 0xFF000000;
-		band = -1;
-		#if ((DEBUG_SECTION) & DEBUG_PIXEL_MAPPING)
-		if (! display_sample)
+		if (! transforms[band])
 			{
-			#if ((DEBUG_SECTION) & DEBUG_ONE_LINE)
-			if (! display_line)
-			#endif
-				clog << "    line " << display_line << " -" << endl;
-			}
-		#endif
-		while (++band < 3)
-			{
-			if (transforms[band])
-				{
-				transforms[band]->map
-					(display_sample, display_line,
-					        &sample,        &line);
-				//	Round down to integer coordinates.
-				source_sample = round_down (sample);
-				source_line   = round_down (line);
-				}
-			else
-				{
-				source_sample = display_sample;
-				source_line   = display_line;
-				}
-			#if ((DEBUG_SECTION) & DEBUG_PIXEL_MAPPING)
-			#if ((DEBUG_SECTION) & DEBUG_ONE_LINE)
-			if (! display_line)
-			#endif
-				clog << "      " << band << "->" << Rendering->Band_Map[band]
-					 << ": display "
-					 << setw (3) << display_sample << "x, "
-					 << setw (3) << display_line << "y <- source "
-					 << setw (3) << source_sample << "x, "
-					 << setw (3) << source_line << "y ";
-			#endif
-			if (source_sample < 0 ||
-				source_sample >= (int)source_data_width[band] ||
-				source_line   < 0 ||
-				source_line   >= (int)source_data_height[band])
+			source_line = display_line;
+			if (source_line < (int)source_data_height[band] &&
+				display_sample_end <= (int)source_data_width[band])
 				{
+				//	Contiguous source data.
+				source_line_data = source_data[band]
+					+ (source_line * source_data_width[band])
+					+ region.left ();
 				#if ((DEBUG_SECTION) & DEBUG_PIXEL_MAPPING)
 				#if ((DEBUG_SECTION) & DEBUG_ONE_LINE)
 				if (! display_line)
 				#endif
-					clog << "= BG " << endl;
+					clog << "      " << band << "->"
+							<< Rendering->Band_Map[band]
+							<< ": display line " << display_line
+							<< " <- source data @ "
+							<< (void*)source_line_data << endl;
 				#endif
-				pixel_value |= background_value[band];
+				map_data_values (source_line_data, band_values[band],
+					display_samples,
+					data_maps[band]->constData (), data_map_size[band],
+					background_datum[band]);
+				continue;
+				}
+			for (display_sample = region.left ();
+				 display_sample < display_sample_end;
+				 display_sample++)
+				source_values[display_sample - region.left ()] =
+					(display_sample < (int)source_data_width[band] &&
+					 source_line    < (int)source_data_height[band]) ?
+					*(source_data[band]
+						+ (source_line * source_data_width[band])
+						+ display_sample) :
+					UNDEFINED_PIXEL_VALUE;
+			}
+		else
+		if (transforms[band]->isAffine () &&
+			transforms[band]->m12 () == 0.0)
+			{
+			/*	The source line is constant along the display line.
+
+				The display line terms of the differential transform are
+				only evaluated once for the line. Each source sample
+				location is computed from its display sample, in the same
+				order of operations as QTransform::map, rather than
+				accumulated across the line; accumulated rounding error
+				would select different source samples on wide lines.
+			*/
+			transforms[band]->map
+				(region.left (), display_line,
+				 &sample,        &line);
+			if (box_filters[band])
+				{
+				Box_Filter::span (line - 0.5, transforms[band]->m22 (),
+					source_data_height[band], &filter_line, &filter_line_end);
+				box_filters[band]->clear ();
+				for (;
+					 filter_line < filter_line_end;
+					 filter_line++)
+					box_filters[band]->accumulate (source_data[band]
+						+ (filter_line * source_data_width[band])
+						+ box_filters[band]->first ());
+				box_filters[band]->average (source_values,
+					UNDEFINED_PIXEL_VALUE);
 				}
 			else
 				{
-				/*
-					Use the source pixel datum obtained from the
-					source_data buffer at the line,sample offset as an
-					index into the Data_Maps LUT which provides an 8-bit
-					image pixel band datum that is shifted into the band
-					location of the QRgb (unsigned int) full pixel value
-					being assembled.
-				*/
-				datum =
-					*(source_data[band]
-					+ (source_line * source_data_width[band])
-					+ source_sample);
-				if (datum > (unsigned int)(data_maps[band]->size ()))
-					{
-					#if ((DEBUG_SECTION) & DEBUG_PIXEL_MAPPING)
-					clog
-						<< "= BG" << endl
-						<< "Invalid source data mapping while rendering" << endl
-						<< "at line " << source_line
-							<< ", sample " << source_sample
-							<< ", band " << band
-							<< " with datum " << datum
-							<< " of data map size " << data_maps[band]->size ();
-					#endif
-					pixel_value |= background_value[band];
-					}
+				step = transforms[band]->m11 ();
+				line_sample = transforms[band]->m21 () * display_line;
+				source_line = round_down (line);
+				if (source_line < 0 ||
+					source_line >= (int)source_data_height[band])
+					source_line_data = NULL;
 				else
+					source_line_data = source_data[band]
+						+ (source_line * source_data_width[band]);
+				for (display_sample = 0;
+					 display_sample < display_samples;
+					 display_sample++)
 					{
-					#if ((DEBUG_SECTION) & DEBUG_PIXEL_MAPPING)
-					#if ((DEBUG_SECTION) & DEBUG_ONE_LINE)
-					if (! display_line)
-						{
-					#endif
-						clog
-							<< "@ " << setfill (' ') << setw (sizeof (void*) << 1)
-							<< (void*)(source_data[band]
-							   + (source_line * source_data_width[band])
-							   + source_sample)
-							<< hex << setfill ('0')
-							<< setw (sizeof (Pixel_Data_Type) << 1)
-							<< datum << " -> " << setw (2)
-							<< static_cast<Pixel_Datum>(data_maps[band]->at (datum))
-							<< dec << setfill (' ') << endl;
-					#if ((DEBUG_SECTION) & DEBUG_ONE_LINE)
-						}
-					#endif
-					#endif
-					//	Merge the mapped pixel datum into the image pixel value.
-					pixel_value |= static_cast<QRgb>(
-						data_maps[band]->at (datum) << (16 - (band << 3)));
+					sample = step * (region.left () + display_sample)
+						+ line_sample + transforms[band]->dx ();
+					//	Round down to integer coordinates.
+					source_sample = round_down (sample);
+					source_values[display_sample] =
+						(source_line_data &&
+						 source_sample >= 0 &&
+						 source_sample < (int)source_data_width[band]) ?
+						source_line_data[source_sample] :
+						UNDEFINED_PIXEL_VALUE;
 					}
 				}
 			}
+		else
+			{
+			for (display_sample = region.left ();
+				 display_sample < display_sample_end;
+				 display_sample++)
+				{
+				transforms[band]->map
+					(display_sample, display_line,
+					        &sample,        &line);
+				//	Round down to integer coordinates.
+				source_sample = round_down (sample);
+				source_line   = round_down (line);
+				source_values[display_sample - region.left ()] =
+					(source_sample >= 0 &&
+					 source_sample < (int)source_data_width[band] &&
+					 source_line   >= 0 &&
+					 source_line   < (int)source_data_height[band]) ?
+					*(source_data[band]
+						+ (source_line * source_data_width[band])
+						+ source_sample) :
+					UNDEFINED_PIXEL_VALUE;
+				}
+			}
 		#if ((DEBUG_SECTION) & DEBUG_PIXEL_MAPPING)
 		#if ((DEBUG_SECTION) & DEBUG_ONE_LINE)
 		if (! display_line)
 		#endif
-			clog << "        display pixel @ "
-					<< setfill (' ') << setw (sizeof (display_data) << 1)
-					<< (void*)display_data
-					<< " = " << hex << setw (8) << pixel_value
-					<< dec << endl;
+			{
+			clog << "      " << band << "->" << Rendering->Band_Map[band]
+					<< ": display line " << display_line
+					<< " <- source values -" << endl
+				 << "       " << hex << setfill ('0');
+			for (display_sample = 0;
+				 display_sample < display_samples;
+				 display_sample++)
+				clog << ' ' << setw (sizeof (Pixel_Data_Type) << 1)
+						<< source_values[display_sample];
+			clog << dec << setfill (' ') << endl;
+			}
 		#endif
-		*display_data++ = pixel_value;
+		map_data_values (source_values, band_values[band],
+			display_samples,
+			data_maps[band]->constData (), data_map_size[band],
+			background_datum[band]);
 		}
 
+	pack_display_pixels (image_display_data,
+		band_values[0], band_values[1], band_values[2], display_samples);
+
 	//	Move to the beginning of the next line of the region.
 	image_display_data += width ();
 	}
+delete[] band_values[0];
+delete[] source_values;
+for (band = 0;
+	 band < 3;
+	 band++)
+	delete box_filters[band];
 #if ((DEBUG_SECTION) & (DEBUG_RENDER | \
 				DEBUG_PIXEL_MAPPING | \
 				DEBUG_PIXEL_DATA | \
@@ -2592,6 +2929,46 @@ JP2_Image::is_JP2_file
 {return JP2_Utilities::is_JP2_file (pathname.toStdString (), 0, 0);}
 
 
+QMutex*
+JP2_Image::acquire_reader_lock
+	(
+	const JP2_Reader*	reader
+	)
+{
+if (! reader)
+	return NULL;
+QMutexLocker
+	lock (&Reader_Locks_Lock);
+Reader_Lock_Entry
+	*&entry = Reader_Locks[reader];
+if (! entry)
+	entry = new Reader_Lock_Entry;
+++entry->Users;
+return &entry->Lock;
+}
+
+
+void
+JP2_Image::release_reader_lock
+	(
+	const JP2_Reader*	reader
+	)
+{
+if (! reader)
+	return;
+QMutexLocker
+	lock (&Reader_Locks_Lock);
+QHash<const JP2_Reader*, Reader_Lock_Entry*>::iterator
+	entry = Reader_Locks.find (reader);
+if (entry != Reader_Locks.end () &&
+	--(*entry)->Users == 0)
+	{
+	delete *entry;
+	Reader_Locks.erase (entry);
+	}
+}
+
+
 unsigned int
 JP2_Image::nearest_resolution_level
 	(
@@ -44,6 +44,7 @@ namespace UA::HiRISE
 class JP2_Reader;
 class JP2_Image_Rendering_Monitor;
 class Source_Data;
+class Decoded_Data_Cache;
 
 
 class JP2_Image
@@ -366,6 +367,24 @@ static bool is_JP2_file (const QString& pathname);
 */
 unsigned int nearest_resolution_level (double scale) const;
 
+/**	Get the decoded source data cache.
+
+	Source image band data decoded by the JP2_Reader is held in the cache
+	for each rendering of all image bands with the same geometry. The
+	data is keyed by the source name - with the file modification time
+	for a local file - resolution level, source band and rendered region.
+	When a rendering needs source data that is in the cache the data is
+	copied into the source data buffers without using the JP2_Reader.
+
+	The cache is shared by all JP2_Images. It may be {@link
+	Decoded_Data_Cache::max_size(qint64) resized} or given a {@link
+	Decoded_Data_Cache::spill_directory(const QString&) spill directory}
+	at any time.
+
+	@return	A reference to the Decoded_Data_Cache.
+*/
+static Decoded_Data_Cache& decoded_data_cache ();
+
 
 protected:
 
@@ -605,12 +624,42 @@ bool render_source ();
 /**	Map the source data to the display data.
 
 	<b>N.B.</b>: The source data is not rendered. The current contents
-	of the Source Data buffers are used.
+	of the Source Data buffers are used. The Source JP2_Reader is not
+	used, so the Reader_Lock need not be held.
 
+	@param	increment	The number of display image lines to be mapped
+		between rendering monitor notifications. If zero the entire
+		display image is mapped at once.
 	@return	true if the entire display was mapped from the source data;
 		false if the mapping was canceled before completion.
 */
-bool map_source ();
+bool map_source (int increment);
+
+/**	Copy cached decoded source data into the source data buffers.
+
+	@param	region	The Cube specifying the region of the source image,
+		relative to the full resolution grid, that is to be rendered.
+	@return	true if the data for all display bands was found in the
+		{@link decoded_data_cache() decoded data cache} and copied into
+		the source data buffers; false otherwise.
+*/
+bool fetch_decoded_data (const PIRL::Cube& region);
+
+/**	Hold the source data buffers in the decoded data cache.
+
+	@param	region	The Cube specifying the region of the source image,
+		relative to the full resolution grid, that was rendered.
+*/
+void cache_decoded_data (const PIRL::Cube& region);
+
+/**	Get the decoded data cache key for a display band.
+
+	@param	band	The display band.
+	@param	region	The Cube specifying the rendered source image region.
+	@return	The cache key. This will be empty if the source can not be
+		identified.
+*/
+QString decoded_data_key (int band, const PIRL::Cube& region);
 
 
 private:
@@ -679,6 +728,30 @@ template<typename Pixel_Data_Type> bool map_source_data_to_display_data
 template<typename Pixel_Data_Type> void source_data_histogram
 	(Histogram* histogram, const QRect& source_region, int band) const;
 
+/**	Acquire the lock for a JP2_Reader.
+
+	Each JP2_Reader has one lock that is shared by every JP2_Image that
+	uses the reader. The lock is created when it is first acquired for
+	the reader.
+
+	@param	reader	A pointer to a JP2_Reader. If NULL nothing is done.
+	@return	A pointer to the QMutex for the reader. This will be NULL if
+		the reader is NULL.
+	@see	release_reader_lock(const JP2_Reader*)
+*/
+static QMutex* acquire_reader_lock (const JP2_Reader* reader);
+
+/**	Release the lock for a JP2_Reader.
+
+	The lock is deleted when it has been released by every JP2_Image
+	that acquired it.
+
+	@param	reader	A pointer to a JP2_Reader. If NULL, or no lock has
+		been acquired for the reader, nothing is done.
+	@see	acquire_reader_lock(const JP2_Reader*)
+*/
+static void release_reader_lock (const JP2_Reader* reader);
+
 /*==============================================================================
 	Data
 */
@@ -687,6 +760,26 @@ private:
 Shared_JP2_Reader
 	Source;
 
+/*	JP2_Reader access control.
+
+	The JP2_Reader is shared by all clones of a JP2_Image, and its
+	rendering configuration is changed for each rendering, so only one
+	JP2_Image at a time may use a JP2_Reader to render source data. The
+	lock belongs to the JP2_Reader: JP2_Images with different readers
+	render their source data independently. The mapping of already
+	rendered source data to display data does not use the JP2_Reader
+	and is not serialized.
+*/
+QMutex
+	*Reader_Lock;
+
+/*	Identifies the source content in Decoded_Data_Cache keys.
+
+	Set from the source name when decoded_data_key makes the first key.
+*/
+QString
+	Cache_Source_Name;
+
 //	The asynchronous JP2_Reader::Rendering_Monitor event notifier.
 friend class JP2_Image_Rendering_Monitor;
 JP2_Image_Rendering_Monitor
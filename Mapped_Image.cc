@@ -0,0 +1,792 @@
+/*	Mapped_Image
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#include	"Mapped_Image.hh"
+
+#include	"PDS_Metadata.hh"
+#include	"Qstream.hh"
+
+#include	"PVL.hh"
+using idaeim::PVL::Aggregate;
+using idaeim::PVL::Parameter;
+using idaeim::PVL::Value;
+using idaeim::PVL::Array;
+using idaeim::PVL::Parser;
+
+#include	<QFileInfo>
+#include	<QDir>
+#include	<QMutexLocker>
+
+#include	<string>
+using std::string;
+#include	<sstream>
+using std::ostringstream;
+#include	<iomanip>
+using std::endl;
+#include	<stdexcept>
+using std::invalid_argument;
+using std::runtime_error;
+
+
+#if defined (DEBUG_SECTION)
+/*	DEBUG_SECTION controls
+
+	DEBUG_SECTION report selection options.
+	Define any of the following options to obtain the desired debug reports:
+*/
+#define DEBUG_OFF			0
+#define DEBUG_ALL			-1
+#define DEBUG_CONSTRUCTORS	(1 << 0)
+#define DEBUG_LABEL			(1 << 1)
+#define DEBUG_METADATA		(1 << 2)
+#define DEBUG_PIXEL_DATA	(1 << 6)
+
+#define DEBUG_DEFAULT		(DEBUG_ALL & ~DEBUG_PIXEL_DATA)
+
+#if (DEBUG_SECTION +0) == 0
+#undef  DEBUG_SECTION
+#define DEBUG_SECTION DEBUG_OFF
+#endif
+
+#include	<iostream>
+using std::clog;
+#endif	//	DEBUG_SECTION
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/*==============================================================================
+	Constants
+*/
+const char* const
+	Mapped_Image::ID =
+		"UA::HiRISE::Mapped_Image ($Revision: 1.1 $ $Date: 2026/10/17 00:00:00 $)";
+
+//	Label signatures.
+#ifndef MAPPED_IMAGE_LABEL_SIGNATURE_SIZE
+#define MAPPED_IMAGE_LABEL_SIGNATURE_SIZE	64
+#endif
+
+namespace
+{
+const char* const
+	PDS_LABEL_SIGNATURES[] =
+		{
+		"PDS_VERSION_ID",
+		"ODL_VERSION_ID",
+		NULL
+		},
+	ISIS_LABEL_SIGNATURE
+		= "Object = IsisCube";
+
+/*==============================================================================
+	Label helpers
+*/
+Parameter*
+label_parameter
+	(
+	const Aggregate&	parameters,
+	const char*			pathname,
+	PDS_Metadata::Parameter_Class_Selection
+						parameter_class = PDS_Metadata::ASSIGNMENT_PARAMETER
+	)
+{return PDS_Metadata::find_parameter (parameters, pathname,
+	false, 0, parameter_class);}
+
+
+qint64
+label_integer
+	(
+	const Aggregate&	parameters,
+	const char*			pathname,
+	qint64				default_value = -1
+	)
+{
+Parameter
+	*parameter (label_parameter (parameters, pathname));
+if (! parameter)
+	{
+	if (default_value >= 0)
+		return default_value;
+	ostringstream
+		message;
+	message
+		<< Mapped_Image::ID << endl
+		<< "The label does not have the required "
+			<< pathname << " parameter.";
+	throw invalid_argument (message.str ());
+	}
+return static_cast<qint64>(PDS_Metadata::numeric_value (*parameter));
+}
+
+
+QString
+label_string
+	(
+	const Aggregate&	parameters,
+	const char*			pathname,
+	const QString&		default_value = QString ()
+	)
+{
+Parameter
+	*parameter (label_parameter (parameters, pathname));
+if (! parameter)
+	return default_value;
+return PDS_Metadata::QString_value (*parameter).toUpper ();
+}
+
+
+/*	Find the data file named by a detached label.
+
+	A data file name in a PDS label is often not the same case as the
+	name of the file in the filesystem, so the name is also tried in
+	lowercase and uppercase.
+*/
+QString
+data_file_pathname
+	(
+	const QString&	label_pathname,
+	const QString&	data_file_name
+	)
+{
+QDir
+	directory (QFileInfo (label_pathname).absoluteDir ());
+QString
+	names[3] =
+		{
+		data_file_name,
+		data_file_name.toLower (),
+		data_file_name.toUpper ()
+		};
+for (int
+		index = 0;
+		index < 3;
+		index++)
+	if (directory.exists (names[index]))
+		return directory.filePath (names[index]);
+ostringstream
+	message;
+message
+	<< Mapped_Image::ID << endl
+	<< "The image data file " << data_file_name.toStdString ()
+		<< " named by the label could not be found.";
+throw invalid_argument (message.str ());
+}
+
+}	//	local namespace
+
+/*==============================================================================
+	Source_File
+*/
+Mapped_Image::Source_File::Source_File ()
+	:	Label (NULL),
+		Offset (0),
+		Bands (0),
+		Sample_Bytes (0),
+		MSB (false),
+		Line_Prefix_Bytes (0),
+		Line_Bytes (0),
+		Band_Bytes (0),
+		Mapped_Data (NULL),
+		Data (NULL)
+{}
+
+
+Mapped_Image::Source_File::~Source_File ()
+{
+if (Mapped_Data)
+	File.unmap (Mapped_Data);
+File.close ();
+delete Label;
+}
+
+
+Mapped_Image::Source_File*
+Mapped_Image::Source_File::open
+	(
+	const QString&	pathname
+	)
+{
+#if ((DEBUG_SECTION) & DEBUG_LABEL)
+clog << ">>> Mapped_Image::Source_File::open: "
+		<< pathname.toStdString () << endl;
+#endif
+QFile
+	label_file (pathname);
+if (! label_file.open (QIODevice::ReadOnly))
+	{
+	ostringstream
+		message;
+	message
+		<< Mapped_Image::ID << endl
+		<< "Unable to open the image file " << pathname.toStdString ();
+	throw runtime_error (message.str ());
+	}
+
+Source_File
+	*source = new Source_File;
+try
+	{
+	{
+	Qistream
+		qistream (&label_file);
+	Parser
+		parser (qistream);
+	source->Label = new Aggregate (parser, Parser::CONTAINER_NAME);
+	}
+	label_file.close ();
+	#if ((DEBUG_SECTION) & DEBUG_LABEL)
+	clog << "    label -" << endl
+		 << *source->Label;
+	#endif
+
+	if (label_parameter (*source->Label, "IsisCube",
+			PDS_Metadata::AGGREGATE_PARAMETER))
+		source->ISIS_layout (pathname);
+	else
+		source->PDS_layout (pathname);
+	source->map ();
+	}
+catch (idaeim::Exception& except)
+	{
+	delete source;
+	ostringstream
+		message;
+	message
+		<< Mapped_Image::ID << endl
+		<< "Unable to use the label of " << pathname.toStdString () << endl
+		<< except.message ();
+	throw invalid_argument (message.str ());
+	}
+catch (...)
+	{
+	delete source;
+	throw;
+	}
+#if ((DEBUG_SECTION) & DEBUG_LABEL)
+clog << "<<< Mapped_Image::Source_File::open: "
+		<< source->Size.width () << "w, " << source->Size.height () << "h, "
+		<< source->Bands << "b, " << (source->Sample_Bytes << 3) << " bits "
+		<< (source->MSB ? "MSB" : "LSB") << " @ " << source->Offset << endl;
+#endif
+return source;
+}
+
+
+void
+Mapped_Image::Source_File::PDS_layout
+	(
+	const QString&	pathname
+	)
+{
+ostringstream
+	message;
+message << Mapped_Image::ID << endl;
+
+//	The image data location.
+string
+	pointer_name (1, PDS_Metadata::RECORD_POINTER_PARAMETER_MARKER);
+pointer_name += PDS_Metadata::IMAGE_DATA_BLOCK_NAME;
+Parameter
+	*pointer (label_parameter (*Label, pointer_name.c_str ()));
+if (! pointer)
+	{
+	message << "The label does not have an " << pointer_name << " pointer.";
+	throw invalid_argument (message.str ());
+	}
+
+QString
+	data_file;
+const Value
+	*location = &pointer->value ();
+if (location->is_Array ())
+	{
+	//	(data file name, record number)
+	const Array
+		&values = static_cast<const Array&>(*location);
+	if (values.size () < 1 ||
+		! values[0].is_String ())
+		{
+		message << "The " << pointer_name << " pointer does not name a file.";
+		throw invalid_argument (message.str ());
+		}
+	data_file = QString::fromStdString (static_cast<string>(values[0]));
+	location = (values.size () > 1) ? &values[1] : NULL;
+	}
+else
+if (location->is_String ())
+	{
+	data_file = QString::fromStdString (static_cast<string>(*location));
+	location = NULL;
+	}
+
+if (location)
+	{
+	if (! location->is_Numeric ())
+		{
+		message << "The " << pointer_name
+				<< " pointer does not have a numeric location.";
+		throw invalid_argument (message.str ());
+		}
+	Offset = static_cast<qint64>(static_cast<double>(*location)) - 1;
+	if (QString::fromStdString (location->units ()).toUpper () !=
+			PDS_Metadata::BYTES_UNITS)
+		Offset *= label_integer (*Label,
+			PDS_Metadata::RECORD_BYTES_PARAMETER_NAME);
+	}
+File.setFileName (data_file.isEmpty () ?
+	pathname : data_file_pathname (pathname, data_file));
+
+//	The image description.
+Parameter
+	*image (label_parameter (*Label, PDS_Metadata::IMAGE_DATA_BLOCK_NAME,
+		PDS_Metadata::AGGREGATE_PARAMETER));
+if (! image)
+	{
+	message << "The label does not have an "
+			<< PDS_Metadata::IMAGE_DATA_BLOCK_NAME << " object.";
+	throw invalid_argument (message.str ());
+	}
+const Aggregate
+	&description = static_cast<const Aggregate&>(*image);
+
+Size.setWidth  (label_integer (description, "LINE_SAMPLES"));
+Size.setHeight (label_integer (description, "LINES"));
+Bands = label_integer (description, "BANDS", 1);
+
+if (Bands > 1 &&
+	label_string (description, "BAND_STORAGE_TYPE", "BAND_SEQUENTIAL")
+		!= "BAND_SEQUENTIAL")
+	{
+	message << "Only band sequential image data can be mapped.";
+	throw invalid_argument (message.str ());
+	}
+
+qint64
+	bits = label_integer (description, "SAMPLE_BITS");
+QString
+	sample_type (label_string (description, "SAMPLE_TYPE"));
+if ((bits != 8 && bits != 16) ||
+	! sample_type.endsWith ("UNSIGNED_INTEGER"))
+	{
+	message << "Only 8-bit or 16-bit unsigned integer image data"
+			<< " can be mapped; the image data is "
+			<< bits << "-bit " << sample_type.toStdString () << '.';
+	throw invalid_argument (message.str ());
+	}
+Sample_Bytes = bits >> 3;
+MSB = ! (sample_type.startsWith ("LSB_") ||
+		 sample_type.startsWith ("PC_") ||
+		 sample_type.startsWith ("VAX_"));
+
+Line_Prefix_Bytes = label_integer (description, "LINE_PREFIX_BYTES", 0);
+Line_Bytes = Line_Prefix_Bytes
+	+ (qint64)Size.width () * Sample_Bytes
+	+ label_integer (description, "LINE_SUFFIX_BYTES", 0);
+Band_Bytes = Line_Bytes * Size.height ();
+}
+
+
+void
+Mapped_Image::Source_File::ISIS_layout
+	(
+	const QString&	pathname
+	)
+{
+ostringstream
+	message;
+message << Mapped_Image::ID << endl;
+
+Parameter
+	*core (label_parameter (*Label, "IsisCube/Core",
+		PDS_Metadata::AGGREGATE_PARAMETER));
+if (! core)
+	{
+	message << "The label does not have an IsisCube Core object.";
+	throw invalid_argument (message.str ());
+	}
+const Aggregate
+	&description = static_cast<const Aggregate&>(*core);
+
+Parameter
+	*pointer (label_parameter (description, "^Core"));
+File.setFileName (pointer ?
+	data_file_pathname (pathname, PDS_Metadata::QString_value (*pointer)) :
+	pathname);
+Offset = label_integer (description, "StartByte", 1) - 1;
+
+if (label_string (description, "Format", "TILE") != "BANDSEQUENTIAL")
+	{
+	message << "Only band sequential cube data can be mapped.";
+	throw invalid_argument (message.str ());
+	}
+
+Size.setWidth  (label_integer (description, "Dimensions/Samples"));
+Size.setHeight (label_integer (description, "Dimensions/Lines"));
+Bands = label_integer (description, "Dimensions/Bands", 1);
+
+QString
+	pixel_type (label_string (description, "Pixels/Type"));
+if (pixel_type == "UNSIGNEDBYTE")
+	Sample_Bytes = 1;
+else
+if (pixel_type == "UNSIGNEDWORD")
+	Sample_Bytes = 2;
+else
+	{
+	message << "Only UnsignedByte or UnsignedWord cube data can be mapped;"
+			<< " the cube data is " << pixel_type.toStdString () << '.';
+	throw invalid_argument (message.str ());
+	}
+MSB = label_string (description, "Pixels/ByteOrder", "LSB") == "MSB";
+
+Line_Prefix_Bytes = 0;
+Line_Bytes = (qint64)Size.width () * Sample_Bytes;
+Band_Bytes = Line_Bytes * Size.height ();
+}
+
+
+void
+Mapped_Image::Source_File::map ()
+{
+ostringstream
+	message;
+message << Mapped_Image::ID << endl;
+
+if (Size.isEmpty () ||
+	! Bands ||
+	Offset < 0)
+	{
+	message << "The label describes an empty image: "
+			<< Size.width () << "w, " << Size.height () << "h, "
+			<< Bands << "b @ " << Offset;
+	throw invalid_argument (message.str ());
+	}
+if (! File.open (QIODevice::ReadOnly))
+	{
+	message << "Unable to open the image data file "
+			<< File.fileName ().toStdString ();
+	throw runtime_error (message.str ());
+	}
+
+qint64
+	data_size = Band_Bytes * Bands;
+if (File.size () < Offset + data_size)
+	{
+	message << "The image data file " << File.fileName ().toStdString ()
+			<< " is " << File.size () << " bytes but the label requires "
+			<< (Offset + data_size) << " bytes.";
+	throw invalid_argument (message.str ());
+	}
+if (! (Mapped_Data = File.map (Offset, data_size)))
+	{
+	message << "Unable to map the image data file "
+			<< File.fileName ().toStdString () << endl
+			<< File.errorString ().toStdString ();
+	throw runtime_error (message.str ());
+	}
+Data = Mapped_Data + Line_Prefix_Bytes;
+}
+
+/*==============================================================================
+	Constructors
+*/
+Mapped_Image::Mapped_Image
+	(
+	Source_File*		source,
+	const QSize&		size,
+	const unsigned int*	band_map,
+	const QTransform**	transforms,
+	const Data_Map**	data_maps
+	)
+	:
+	Plastic_Image (! size.isEmpty () ? size
+		: (source ? source->size () : size),
+		band_map, transforms, data_maps),
+	Source (source)
+{
+#if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
+clog << ">>> Mapped_Image @ " << (void*)this
+		<< ": From Source_File @ " << (void*)source << endl;
+#endif
+initialize ();
+#if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
+clog << "<<< Mapped_Image" << endl;
+#endif
+}
+
+
+Mapped_Image::Mapped_Image
+	(
+	const Mapped_Image&	image,
+	const QSize&		size,
+	Mapping_Type		shared_mappings
+	)
+	:
+	Plastic_Image (size.isValid () ? size : image.size (),
+		(shared_mappings & BAND_MAP)   ?
+			image.source_band_map () : NULL,
+		(shared_mappings & TRANSFORMS) ?
+			const_cast<const QTransform**>(image.source_transforms ()) : NULL,
+		(shared_mappings & DATA_MAPS)  ?
+			const_cast<const Data_Map**>(image.source_data_maps ()) : NULL),
+	Source (image.Source)
+{
+#if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
+clog << ">>> Mapped_Image @ " << (void*)this
+		<< ": Copy @ " << (void*)(&image) << endl
+	 << "    shared Source_File @ " << (void*)Source.data () << endl;
+#endif
+Auto_Update = image.Auto_Update;
+bool
+	do_update = auto_update (false);
+
+initialize ();
+
+source_name (image.source_name ());
+
+if (! (shared_mappings & BAND_MAP))
+	source_band_map (image.source_band_map ());
+if (! (shared_mappings & TRANSFORMS))
+	source_transforms
+		(const_cast<const QTransform**>(image.source_transforms ()));
+if (! (shared_mappings & DATA_MAPS))
+	source_data_maps
+		(const_cast<const Data_Map**>(image.source_data_maps ()));
+
+background_color (image.background_color ());
+
+if ((Auto_Update = do_update))
+	update ();
+else
+	fill (background_color ());
+#if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
+clog << "<<< Mapped_Image" << endl;
+#endif
+}
+
+
+Mapped_Image::~Mapped_Image ()
+{
+#if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
+clog << ">-< ~Mapped_Image @ " << (void*)this << endl;
+#endif
+}
+
+/*==============================================================================
+	Accessors
+*/
+Mapped_Image*
+Mapped_Image::clone
+	(
+	const QSize&	size,
+	Mapping_Type	shared_mappings
+	) const
+{return new Mapped_Image (*this, size, shared_mappings);}
+
+
+idaeim::PVL::Aggregate*
+Mapped_Image::metadata ()
+{
+QMutexLocker
+	object_lock (&Object_Lock);
+#if ((DEBUG_SECTION) & DEBUG_METADATA)
+clog << ">>> Mapped_Image::metadata" << endl;
+#endif
+bool
+	initialize = ! Metadata;
+Aggregate
+	*metadata = Plastic_Image::metadata ();
+if (initialize &&
+	metadata &&
+	Source &&
+	Source->label ())
+	{
+	//	Copy the source file label into the root metadata.
+	Aggregate
+		*label (new Aggregate (*Source->label ()));
+	label->name (PDS_Metadata::PDS_METADATA_GROUP);
+	metadata->add (label);
+	#if ((DEBUG_SECTION) & DEBUG_METADATA)
+	clog << "    basic metadata appended with the source label" << endl;
+	#endif
+	}
+#if ((DEBUG_SECTION) & DEBUG_METADATA)
+clog << "<<< Mapped_Image::metadata" << endl;
+#endif
+return metadata;
+}
+
+
+const void*
+Mapped_Image::source () const
+{return Source.data ();}
+
+
+QSize
+Mapped_Image::source_size () const
+{return Source ? Source->size () : QSize (0, 0);}
+
+
+unsigned int
+Mapped_Image::source_bands () const
+{return Source ? Source->bands () : 0;}
+
+
+unsigned int
+Mapped_Image::source_precision_bits () const
+{return Source ? Source->precision_bits () : 0;}
+
+
+Plastic_Image::Pixel_Datum
+Mapped_Image::source_pixel_value
+	(
+	unsigned int	x,
+	unsigned int	y,
+	unsigned int	band
+	)
+	const
+{
+Pixel_Datum
+	value;
+if (Source &&
+	x < static_cast<unsigned int>(Source->size ().width ()) &&
+	y < static_cast<unsigned int>(Source->size ().height ()) &&
+	band < Source->bands ())
+	value = Source->sample
+		(Source->line_data (y, band) + x * Source->sample_bytes ());
+else
+	value = UNDEFINED_PIXEL_VALUE;
+#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
+clog << ">-< Mapped_Image::source_pixel_value: "
+		<< x << "x, " << y << "y, " << band << "b = " << value << endl;
+#endif
+return value;
+}
+
+
+void
+Mapped_Image::source_line_values
+	(
+	Pixel_Datum*	values,
+	const int*		samples,
+	unsigned int	count,
+	int				line,
+	unsigned int	band
+	)
+	const
+{
+#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
+clog << ">-< Mapped_Image::source_line_values: "
+		<< count << " samples, " << line << "y, " << band << 'b' << endl;
+#endif
+unsigned int
+	index,
+	sample;
+if (! Source ||
+	line < 0 ||
+	line >= Source->size ().height () ||
+	band >= Source->bands ())
+	{
+	for (index = 0;
+		 index < count;
+		 index++)
+		values[index] = UNDEFINED_PIXEL_VALUE;
+	return;
+	}
+
+const unsigned int
+	source_width = static_cast<unsigned int>(Source->size ().width ());
+const uchar
+	*source_data = Source->line_data (line, band);
+if (Source->sample_bytes () == 1)
+	{
+	for (index = 0;
+		 index < count;
+		 index++)
+		{
+		sample = static_cast<unsigned int>(samples[index]);
+		values[index] = (sample < source_width) ?
+			source_data[sample] : UNDEFINED_PIXEL_VALUE;
+		}
+	}
+else
+if (Source->MSB_samples ())
+	{
+	for (index = 0;
+		 index < count;
+		 index++)
+		{
+		sample = static_cast<unsigned int>(samples[index]);
+		values[index] = (sample < source_width) ?
+			qFromBigEndian<quint16> (source_data + (sample << 1)) :
+			UNDEFINED_PIXEL_VALUE;
+		}
+	}
+else
+	{
+	for (index = 0;
+		 index < count;
+		 index++)
+		{
+		sample = static_cast<unsigned int>(samples[index]);
+		values[index] = (sample < source_width) ?
+			qFromLittleEndian<quint16> (source_data + (sample << 1)) :
+			UNDEFINED_PIXEL_VALUE;
+		}
+	}
+}
+
+/*==============================================================================
+	Utilities
+*/
+bool
+Mapped_Image::is_mapped_image_file
+	(
+	const QString&	pathname
+	)
+{
+QFile
+	file (pathname);
+if (! file.open (QIODevice::ReadOnly))
+	return false;
+QString
+	signature (QString::fromLatin1
+		(file.read (MAPPED_IMAGE_LABEL_SIGNATURE_SIZE)).simplified ());
+file.close ();
+
+for (int
+		index = 0;
+		PDS_LABEL_SIGNATURES[index];
+		index++)
+	if (signature.startsWith (PDS_LABEL_SIGNATURES[index],
+			Qt::CaseInsensitive))
+		return true;
+return signature.startsWith (ISIS_LABEL_SIGNATURE, Qt::CaseInsensitive);
+}
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
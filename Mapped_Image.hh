@@ -0,0 +1,345 @@
+/*	Mapped_Image
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#ifndef HiView_Mapped_Image_hh
+#define HiView_Mapped_Image_hh
+
+#include	"Plastic_Image.hh"
+
+#include	<QString>
+#include	<QSize>
+#include	<QFile>
+#include	<QSharedPointer>
+#include	<QtEndian>
+
+//	Forward references.
+namespace idaeim
+{
+namespace PVL
+{
+class Aggregate;
+}
+}
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/**	A <i>Mapped_Image</i> is a Plastic_Image with a source image that is
+	the uncompressed pixel data of a labeled image file mapped into
+	memory.
+
+	The source image file is described by a PVL label. Both PDS labels,
+	with an IMAGE object located by an ^IMAGE pointer, and ISIS cube
+	labels, with an IsisCube Core object, are recognized. The label may
+	be attached to the front of the image data file or be a detached
+	label file that names the image data file. The image data must be
+	band sequential, unsigned 8-bit or 16-bit samples in either byte
+	order. PDS line prefix and suffix bytes are skipped.
+
+	The image data is not read into memory. Instead the region of the
+	file containing the image data is mapped into the process address
+	space and pixel values are obtained directly from the mapped file
+	data; the operating system pages in only the parts of the file that
+	are rendered. The mapped file is shared by all clones of a
+	Mapped_Image and is unmapped when the last of them is destroyed.
+
+	@version	$Revision: 1.1 $
+*/
+class Mapped_Image
+:	public Plastic_Image
+{
+public:
+/*==============================================================================
+	Constants
+*/
+//!	Class identification name with source code version and date.
+static const char* const
+	ID;
+
+/*==============================================================================
+	Types
+*/
+/**	A <i>Source_File</i> is an image data file mapped into memory.
+*/
+class Source_File
+{
+public:
+/**	Open a labeled image file and map its image data into memory.
+
+	@param	pathname	The pathname to the image label file.
+	@return	A pointer to a Source_File. Ownership is transferred to the
+		caller.
+	@throws	std::invalid_argument	If the file label can not be parsed
+		or does not describe image data that can be mapped.
+	@throws	std::runtime_error	If the image data file can not be opened
+		or mapped.
+*/
+static Source_File* open (const QString& pathname);
+
+~Source_File ();
+
+/**	Get the image label parameters.
+
+	@return	A pointer to the label parameters Aggregate.
+*/
+inline const idaeim::PVL::Aggregate* label () const
+	{return Label;}
+
+/**	Get the pathname of the image data file.
+
+	@return	The image data file pathname. This will be the label file
+		pathname if the label is attached.
+*/
+inline QString data_pathname () const
+	{return File.fileName ();}
+
+//!	Image size in pixels.
+inline QSize size () const
+	{return Size;}
+
+//!	Number of image bands.
+inline unsigned int bands () const
+	{return Bands;}
+
+//!	Bits per pixel sample; 8 or 16.
+inline unsigned int precision_bits () const
+	{return Sample_Bytes << 3;}
+
+/**	Get a pointer to the first pixel sample of an image line.
+
+	@param	line	The image line number.
+	@param	band	The image band number.
+	@return	A pointer to the mapped sample data. The line and band
+		must be within the image bounds.
+*/
+inline const uchar* line_data (unsigned int line, unsigned int band) const
+	{return Data + band * Band_Bytes + line * Line_Bytes;}
+
+/**	Get a pixel sample value.
+
+	@param	data	A pointer to the mapped sample data.
+	@return	The pixel sample value in host byte order.
+*/
+inline Pixel_Datum sample (const uchar* data) const
+	{return (Sample_Bytes == 1) ? *data :
+		(MSB ? qFromBigEndian<quint16> (data) :
+			qFromLittleEndian<quint16> (data));}
+
+/**	Get the sample size.
+
+	@return	The number of bytes per pixel sample.
+*/
+inline unsigned int sample_bytes () const
+	{return Sample_Bytes;}
+
+//!	Test if multi-byte samples are in most significant byte first order.
+inline bool MSB_samples () const
+	{return MSB;}
+
+private:
+
+Source_File ();
+
+//	Not copyable.
+Source_File (const Source_File&);
+Source_File& operator= (const Source_File&);
+
+void PDS_layout (const QString& pathname);
+void ISIS_layout (const QString& pathname);
+void map ();
+
+QFile
+	File;
+idaeim::PVL::Aggregate
+	*Label;
+
+qint64
+	Offset;
+QSize
+	Size;
+unsigned int
+	Bands,
+	Sample_Bytes;
+bool
+	MSB;
+qint64
+	Line_Prefix_Bytes,
+	Line_Bytes,
+	Band_Bytes;
+
+uchar
+	*Mapped_Data;
+const uchar
+	*Data;
+};
+
+typedef QSharedPointer<Source_File>	Shared_Source_File;
+
+/*==============================================================================
+	Constructors
+*/
+/**	Construct a Mapped_Image on a Source_File.
+
+	<b>N.B.</b>: Ownership of the Source_File is transferred to the
+	Mapped_Image; i.e. the Source_File must have been constructed on the
+	heap.
+
+	@param	source	A pointer to a Source_File that will provide the
+		source image for this Plastic_Image.
+	@param	size	The size of the new Mapped_Image. If the size is not
+		valid the size of the source image will be used.
+	@param	band_map	A pointer to unsigned int array of three values
+		that will be used as the shared band map for this
+		Plastic_Image. If NULL band map sharing is not enabled and a
+		default band map will be provided.
+	@param	transforms	An array of QTransform pointers, one for each
+		band of the image, that will be used as the shared geometric
+		transforms for this Plastic_Image. If NULL geometric transforms
+		sharing is not enabled and default identity transforms will be
+		provided.
+	@param	data_maps	An array of data map arrays, one for each band
+		of the image, that will be used as the shared data maps for this
+		Plastic_Image. If NULL data map sharing is not enabled and
+		default identity data maps will be provided.
+*/
+explicit Mapped_Image (Source_File* source,
+	const QSize&		size = QSize (),
+	const unsigned int*	band_map = NULL,
+	const QTransform**	transforms = NULL,
+	const Data_Map**	data_maps = NULL);
+
+/**	Copy a Mapped_Image.
+
+	The mapped {@link source() source} file is shared, not copied. The
+	image {@link source_transforms() geometric transforms}, {@link
+	source_band_map() band map} and {@link source_data_maps() data maps}
+	are copied unless the corresponding shared mappings flag inidicates
+	they are to be shared with the image being copied. The {@link
+	background_color() background color} is also copied.
+
+	@param	image	The Mapped_Image to be copied.
+	@param	size	The size of the new Mapped_Image. If the size is not
+		valid the size of the Mapped_Image being copied (not its source
+		image) will be used.
+	@param	shared_mappings	A Mapping_Type that specifies any combination
+		of {@link #BAND_MAP}, {@link #TRANSFORMS} or {@link #DATA_MAPS} -
+		or {@link #NO_MAPPINGS} - data mappings that are to be shared with
+		the Mapped_Image being copied.
+*/
+explicit Mapped_Image (const Mapped_Image& image,
+	const QSize&	size = QSize (),
+	Mapping_Type	shared_mappings = NO_MAPPINGS);
+
+virtual ~Mapped_Image ();
+
+/*==============================================================================
+	Accessors
+*/
+/**	Clone this Mapped_Image.
+
+	@param	size	The size of the new Mapped_Image. If the size is not
+		valid the size of this Mapped_Image (not its source image) will
+		be used.
+	@param	shared_mappings	A Mapping_Type that specifies any combination
+		of {@link #BAND_MAP}, {@link #TRANSFORMS} or {@link #DATA_MAPS} -
+		or {@link #NO_MAPPINGS} - data mappings that are to be shared with
+		this Mapped_Image.
+	@return	A pointer to a Mapped_Image.
+	@see	Mapped_Image(const Mapped_Image&, const QSize&, Mapping_Type)
+*/
+virtual Mapped_Image* clone (const QSize& size = QSize (),
+	Mapping_Type shared_mappings = NO_MAPPINGS) const;
+
+/**	Get the image metadata.
+
+	The base {@link Plastic_Image::metadata() image metadata} is
+	appended with a copy of the source file label parameters in a group
+	having the PDS_Metadata::PDS_METADATA_GROUP name.
+
+	@return	A pointer to the metadata parameters.
+*/
+virtual idaeim::PVL::Aggregate* metadata ();
+
+/**	Get the image source.
+
+	@return	A pointer to the Source_File.
+*/
+virtual const void* source () const;
+
+virtual QSize source_size () const;
+
+virtual unsigned int source_bands () const;
+
+virtual unsigned int source_precision_bits () const;
+
+virtual Pixel_Datum source_pixel_value
+	(unsigned int x, unsigned int y, unsigned int band) const;
+
+/**	Get source image pixel data values from a single source image line.
+
+	The pixel values are obtained directly from the mapped source file
+	line data.
+
+	@param	values	A pointer to a Pixel_Datum array that will receive
+		the source data values.
+	@param	samples	A pointer to an array of count source image sample
+		locations.
+	@param	count	The number of sample locations.
+	@param	line	The source image line location.
+	@param	band	The source image band.
+	@see	Plastic_Image::source_line_values(Pixel_Datum*, const int*,
+		unsigned int, int, unsigned int)
+*/
+virtual void source_line_values (Pixel_Datum* values,
+	const int* samples, unsigned int count, int line, unsigned int band) const;
+
+/*==============================================================================
+	Utilities
+*/
+/**	Test if a file is a labeled image file that may be mapped.
+
+	Only the beginning of the file is examined for a PDS or ISIS label
+	signature; the label itself is not parsed.
+
+	@param	pathname	The pathname to a file.
+	@return	true if the file appears to have a PDS or ISIS label; false
+		otherwise.
+*/
+static bool is_mapped_image_file (const QString& pathname);
+
+/*==============================================================================
+	Data
+*/
+protected:
+
+Shared_Source_File
+	Source;
+
+};	//	Class Mapped_Image
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
+#endif
@@ -24,7 +24,9 @@ Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
 #include	"Metadata_Dialog.hh"
 
 #include	"Parameter_Tree_View.hh"
+#include	"Parameter_Tree_Model.hh"
 #include	"PDS_Metadata.hh"
+#include	"Metadata_Search_Index.hh"
 
 #include	"PVL.hh"
 using idaeim::PVL::Parameter;
@@ -41,6 +43,11 @@ using idaeim::PVL::Lister;
 #include	<QGridLayout>
 #include	<QMargins>
 #include	<QVBoxLayout>
+#include	<QHBoxLayout>
+#include	<QLineEdit>
+#include	<QComboBox>
+#include	<QTimer>
+#include	<QRegExp>
 #include	<QLabel>
 #include	<QAction>
 #include	<QModelIndex>
@@ -76,6 +83,7 @@ using		std::string;
 #define	DEBUG_CONSTRUCTORS		(1 << 0)
 #define DEBUG_SELECTION			(1 << 1)
 #define DEBUG_SAVE				(1 << 2)
+#define DEBUG_SEARCH			(1 << 3)
 
 #if (DEBUG_SECTION+0) == 0
 #undef	DEBUG_SECTION
@@ -120,6 +128,21 @@ const int
 	Metadata_Dialog::DEFAULT_WIDTH	= METADATA_DIALOG_DEFAULT_WIDTH,
 	Metadata_Dialog::DEFAULT_HEIGHT	= METADATA_DIALOG_DEFAULT_HEIGHT;
 
+/*	Delay, in milliseconds, after a parameter is added before the
+	search index is rebuilt.
+*/
+#ifndef METADATA_DIALOG_INDEX_DELAY
+#define METADATA_DIALOG_INDEX_DELAY		250
+#endif
+
+/*	Minimum search text length for the parameters found to be revealed
+	as the text is typed. Shorter searches match too much; the
+	parameters found are revealed one at a time with Return.
+*/
+#ifndef METADATA_DIALOG_MIN_REVEAL_LENGTH
+#define METADATA_DIALOG_MIN_REVEAL_LENGTH	3
+#endif
+
 /*==============================================================================
 	Application configuration parameters
 */
@@ -189,6 +212,52 @@ layout->addWidget (create_menus ());
 
 layout->addWidget (new Drawn_Line (Heading_Line_Weight));
 
+//	Search bar:
+#if (DEBUG_SECTION & DEBUG_CONSTRUCTORS)
+clog << "    Search bar layout" << endl;
+#endif
+QHBoxLayout*
+	search_layout = new QHBoxLayout;
+Search_Field = new QLineEdit;
+Search_Field->setPlaceholderText (tr ("Search names, pathnames and values"));
+Search_Field->setToolTip
+	(tr ("Press Return to step through the parameters found"));
+search_layout->addWidget (Search_Field, 10);
+Search_Mode = new QComboBox;
+Search_Mode->addItem (tr ("Contains"),
+	Metadata_Search_Index::SUBSTRING_SEARCH);
+Search_Mode->addItem (tr ("Starts with"),
+	Metadata_Search_Index::PREFIX_SEARCH);
+Search_Mode->addItem (tr ("Regular expression"),
+	Metadata_Search_Index::REGEX_SEARCH);
+search_layout->addWidget (Search_Mode);
+Search_Status = new QLabel;
+search_layout->addWidget (Search_Status);
+layout->addLayout (search_layout);
+
+connect (Search_Field,
+	SIGNAL (textChanged (const QString&)),
+	SLOT (search ()));
+connect (Search_Field,
+	SIGNAL (returnPressed ()),
+	SLOT (next_search_hit ()));
+connect (Search_Mode,
+	SIGNAL (currentIndexChanged (int)),
+	SLOT (search ()));
+Search_Hit = -1;
+
+//	Search index.
+Search_Index = new Metadata_Search_Index (this);
+connect (Search_Index,
+	SIGNAL (built ()),
+	SLOT (search ()));
+Index_Timer = new QTimer (this);
+Index_Timer->setSingleShot (true);
+Index_Timer->setInterval (METADATA_DIALOG_INDEX_DELAY);
+connect (Index_Timer,
+	SIGNAL (timeout ()),
+	SLOT (rebuild_search_index ()));
+
 //	Tree_View:
 
 //	The columns should start out with equal widths.
@@ -269,6 +338,16 @@ connect (action,
 	SIGNAL (triggered ()),
 	SLOT (close ()));
 addAction (action);
+
+//	Find action.
+action = new QAction (tr ("Find"), this);
+action->setShortcut (tr ("Ctrl+F"));
+connect (action,
+	SIGNAL (triggered ()),
+	Search_Field, SLOT (setFocus ()));
+addAction (action);
+
+rebuild_search_index ();
 #if (DEBUG_SECTION & DEBUG_CONSTRUCTORS)
 clog << "<<< Metadata_Dialog" << endl;
 #endif
@@ -322,12 +401,19 @@ Metadata_Dialog::parameters
 	Aggregate*	params
 	)
 {
+//	The index must not be reading the old parameters when they are replaced.
+Index_Timer->stop ();
+Search_Index->cancel ();
+Search_Hits.clear ();
+Search_Hit = -1;
+
 Tree_View->parameters (params);
 //	Reconnect to the selectionChanged signal if the selectionModel changed.
 connect (Tree_View->selectionModel (),
 	SIGNAL (selectionChanged (const QItemSelection&, const QItemSelection&)),
 	SLOT (selection_changed (const QItemSelection&, const QItemSelection&)),
 	Qt::UniqueConnection);
+rebuild_search_index ();
 }
 
 
@@ -336,6 +422,22 @@ Metadata_Dialog::parameters () const
 {return Tree_View->parameters ();}
 
 
+void
+Metadata_Dialog::add_parameter
+	(
+	Parameter*	parameter,
+	Aggregate*	aggregate
+	)
+{
+//	The index must not be reading the parameters while they are changed.
+Search_Index->cancel ();
+static_cast<Parameter_Tree_Model*>(Tree_View->model ())
+	->add (parameter, aggregate);
+//	Parameters tend to arrive in bursts; rebuild after the last one.
+Index_Timer->start ();
+}
+
+
 bool
 Metadata_Dialog::root_visible () const
 {return Tree_View->root_visible ();}
@@ -423,6 +525,74 @@ clog << "<<< Metadata_Dialog::selection_changed" << endl;
 }
 
 
+void
+Metadata_Dialog::search ()
+{
+QString
+	text (Search_Field->text ());
+#if (DEBUG_SECTION & DEBUG_SEARCH)
+clog << ">>> Metadata_Dialog::search: " << text << endl;
+#endif
+Search_Hits.clear ();
+Search_Hit = -1;
+if (text.isEmpty ())
+	Search_Status->clear ();
+else
+if (! Search_Index->ready ())
+	{
+	if (parameters ())
+		Search_Status->setText (tr ("Indexing..."));
+	else
+		Search_Status->clear ();
+	}
+else
+	{
+	Metadata_Search_Index::Search_Mode
+		mode = static_cast<Metadata_Search_Index::Search_Mode>
+			(Search_Mode->itemData (Search_Mode->currentIndex ()).toInt ());
+	Search_Hits = Search_Index->search (text, mode);
+	if (Search_Hits.isEmpty () &&
+		mode == Metadata_Search_Index::REGEX_SEARCH &&
+		! QRegExp (text).isValid ())
+		Search_Status->setText (tr ("Invalid expression"));
+	else
+		Search_Status->setText (tr ("%n found", "", Search_Hits.size ()));
+	}
+Tree_View->highlight (Search_Hits,
+	text.size () >= METADATA_DIALOG_MIN_REVEAL_LENGTH);
+#if (DEBUG_SECTION & DEBUG_SEARCH)
+clog << "<<< Metadata_Dialog::search: " << Search_Hits.size () << " found"
+		<< endl;
+#endif
+}
+
+
+void
+Metadata_Dialog::next_search_hit ()
+{
+if (Search_Hits.isEmpty ())
+	return;
+if (++Search_Hit >= Search_Hits.size ())
+	Search_Hit = 0;
+Tree_View->current_parameter (Search_Hits[Search_Hit]);
+Search_Status->setText (tr ("%1 of %2")
+	.arg (Search_Hit + 1)
+	.arg (Search_Hits.size ()));
+}
+
+
+void
+Metadata_Dialog::rebuild_search_index ()
+{
+#if (DEBUG_SECTION & DEBUG_SEARCH)
+clog << "<-> Metadata_Dialog::rebuild_search_index" << endl;
+#endif
+Search_Index->build (parameters ());
+//	Until the index is ready.
+search ();
+}
+
+
 bool
 Metadata_Dialog::save_selected_metadata ()
 {
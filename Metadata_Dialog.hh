@@ -25,6 +25,7 @@ Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
 #define Metadata_Dialog_hh
 
 #include	<QDialog>
+#include	<QList>
 
 //	Forward references.
 namespace idaeim {
@@ -41,6 +42,10 @@ class QMenuBar;
 class QString;
 class QFileDialog;
 class QErrorMessage;
+class QLineEdit;
+class QComboBox;
+class QLabel;
+class QTimer;
 
 
 namespace UA
@@ -49,10 +54,18 @@ namespace HiRISE
 {
 //	Forward references.
 class Parameter_Tree_View;
+class Metadata_Search_Index;
 
 /**	A <i>Metadata_Dialog</i> provides a dialog box to display metadata
 	contained in an <i>idaeim::PVL::Aggregate</i> structure.
 
+	A search bar above the tree finds parameters by name, pathname or
+	value. The parameters are indexed by a Metadata_Search_Index on a
+	worker thread whenever they are set, so searches are answered from
+	the index without walking the tree. The parameters found are
+	highlighted and revealed in the tree; pressing Return in the search
+	field steps through them.
+
 	@author		Parker Snell, UA/HiROC
 	@version	$Revision: 1.12 $
 */
@@ -118,6 +131,26 @@ explicit Metadata_Dialog (QWidget* parent = NULL, Qt::WindowFlags flags = 0);
 */
 idaeim::PVL::Aggregate* parameters () const;
 
+/**	Add a parameter to the parameters being displayed.
+
+	The parameter is inserted into the displayed tree without resetting
+	the view, so the expansion and selection state of the tree is
+	retained. The search index is rebuilt shortly after the last
+	parameter is added.
+
+	@param	parameter	A pointer to the Parameter to be added.
+		<b>N.B.</b>: Ownership of the Parameter is transferred to the
+		Aggregate to which it is added.
+	@param	aggregate	A pointer to the Aggregate, within the {@link
+		parameters() parameters} being displayed, to which the parameter
+		is to be added. If NULL the parameter is added to the top level
+		parameters.
+	@see	Parameter_Tree_Model::add(idaeim::PVL::Parameter*,
+		idaeim::PVL::Aggregate*)
+*/
+void add_parameter (idaeim::PVL::Parameter* parameter,
+	idaeim::PVL::Aggregate* aggregate = NULL);
+
 /**	Get the Parameter_Tree_View used to display the Parameter tree.
 
 	@return	A pointer to the Parameter_Tree_View owned by this Metadata_Dialog.
@@ -232,6 +265,9 @@ public slots:
 	of the Aggregate. The Aggregate must not be deleted during the
 	lifespan of the dialog.
 
+	The parameters are indexed for searching on a worker thread; the
+	current search is repeated when the index is ready.
+
 	@param	parameters	A pointer to an Aggregate which contains all the
 		metadata parameters to be shown in the dialog.
 */
@@ -277,6 +313,24 @@ private slots:
 void selection_changed
 	(const QItemSelection& current, const QItemSelection& previous);
 
+/**	Search the parameters for the search field text.
+
+	The parameters found are highlighted in the tree and the number found
+	is reported next to the search field. The tree is only expanded to
+	reveal the parameters found when the search text is at least a few
+	characters long. If the search field is empty the highlighting is
+	removed.
+*/
+void search ();
+
+/**	Make the next parameter found by the last {@link search() search}
+	the current tree item.
+*/
+void next_search_hit ();
+
+//!	Rebuild the search index for the current parameters.
+void rebuild_search_index ();
+
 /*==============================================================================
 	Utilities
 */
@@ -322,6 +376,25 @@ QFileDialog*
 QAction*
 	Save_Selected_Action;
 
+//	Search bar.
+QLineEdit*
+	Search_Field;
+QComboBox*
+	Search_Mode;
+QLabel*
+	Search_Status;
+
+Metadata_Search_Index*
+	Search_Index;
+//!	Delays rebuilding the index while parameters are being added.
+QTimer*
+	Index_Timer;
+
+QList<idaeim::PVL::Parameter*>
+	Search_Hits;
+int
+	Search_Hit;
+
 static QErrorMessage
 	*Error_Message;
 
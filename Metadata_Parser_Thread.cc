@@ -0,0 +1,301 @@
+/*	Metadata_Parser_Thread
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#include	"Metadata_Parser_Thread.hh"
+
+#include	"PVL.hh"
+using idaeim::PVL::Parser;
+using idaeim::PVL::Parameter;
+
+#include	<QMutexLocker>
+#include	<QMetaType>
+
+#include	<istream>
+#include	<streambuf>
+#include	<exception>
+
+
+#if defined (DEBUG_SECTION)
+/*******************************************************************************
+	DEBUG_SECTION controls
+
+	DEBUG_SECTION report selection options.
+	Define any of the following options to obtain the desired debug reports:
+*/
+#define DEBUG_OFF			0
+#define DEBUG_ALL			-1
+#define DEBUG_SOURCE		(1 << 0)
+#define DEBUG_RUN			(1 << 1)
+
+#define DEBUG_DEFAULT		DEBUG_ALL
+
+#if (DEBUG_SECTION+0) == 0
+#undef  DEBUG_SECTION
+#define DEBUG_SECTION DEBUG_OFF
+#else
+#include	"HiView_Utilities.hh"
+#include	<iostream>
+using std::clog;
+using std::endl;
+#endif
+
+#endif	//	DEBUG_SECTION
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/*==============================================================================
+	Constants
+*/
+const char* const
+	Metadata_Parser_Thread::ID =
+		"UA::HiRISE::Metadata_Parser_Thread ($Revision: 1.1 $ $Date: 2026/10/17 00:00:00 $)";
+
+/*==============================================================================
+	Source buffer
+*/
+#ifndef	DOXYGEN_PROCESSING
+/*	A stream buffer that obtains its content from the parser thread
+	source, waiting for content to arrive as needed.
+*/
+class Metadata_Source_Buffer
+:	public std::streambuf
+{
+public:
+
+explicit Metadata_Source_Buffer (Metadata_Parser_Thread* parser_thread)
+	:	Parser_Thread (parser_thread)
+{}
+
+protected:
+
+virtual std::streambuf::int_type
+underflow ()
+{
+if (gptr () < egptr ())
+	return traits_type::to_int_type (*gptr ());
+Content.clear ();
+if (! Parser_Thread->next_content (Content) ||
+	Content.isEmpty ())
+	return traits_type::eof ();
+char
+	*content = Content.data ();
+setg (content, content, content + Content.size ());
+return traits_type::to_int_type (*gptr ());
+}
+
+private:
+
+Metadata_Parser_Thread
+	*Parser_Thread;
+QByteArray
+	Content;
+};
+#endif
+
+/*==============================================================================
+	Constructors
+*/
+Metadata_Parser_Thread::Metadata_Parser_Thread
+	(
+	QObject*	parent
+	)
+	:	QThread (parent),
+		Source_Finished (false),
+		Parsing_Canceled (false)
+{
+setObjectName ("Metadata_Parser_Thread");
+//	Parameters are signaled across threads.
+qRegisterMetaType<idaeim::PVL::Parameter*> ("idaeim::PVL::Parameter*");
+}
+
+
+Metadata_Parser_Thread::~Metadata_Parser_Thread ()
+{
+cancel ();
+wait ();
+}
+
+/*==============================================================================
+	Source
+*/
+void
+Metadata_Parser_Thread::append
+	(
+	const QByteArray&	data
+	)
+{
+if (data.isEmpty ())
+	return;
+#if ((DEBUG_SECTION) & DEBUG_SOURCE)
+LOCKED_LOGGING ((
+clog << "<-> Metadata_Parser_Thread::append: " << data.size () << " bytes"
+		<< endl));
+#endif
+	{
+	QMutexLocker
+		lock (&Source_Lock);
+	if (Source_Finished ||
+		Parsing_Canceled)
+		return;
+	Pending_Content.append (data);
+	Source_Available.wakeAll ();
+	}
+if (! isRunning () &&
+	! isFinished ())
+	start ();
+}
+
+
+void
+Metadata_Parser_Thread::finish ()
+{
+#if ((DEBUG_SECTION) & DEBUG_SOURCE)
+LOCKED_LOGGING ((
+clog << "<-> Metadata_Parser_Thread::finish" << endl));
+#endif
+	{
+	QMutexLocker
+		lock (&Source_Lock);
+	Source_Finished = true;
+	Source_Available.wakeAll ();
+	}
+if (! isRunning () &&
+	! isFinished ())
+	start ();
+}
+
+
+void
+Metadata_Parser_Thread::cancel ()
+{
+QMutexLocker
+	lock (&Source_Lock);
+Parsing_Canceled = true;
+Pending_Content.clear ();
+Source_Available.wakeAll ();
+}
+
+
+bool
+Metadata_Parser_Thread::canceled () const
+{
+QMutexLocker
+	lock (&Source_Lock);
+return Parsing_Canceled;
+}
+
+
+bool
+Metadata_Parser_Thread::next_content
+	(
+	QByteArray&	data
+	)
+{
+QMutexLocker
+	lock (&Source_Lock);
+while (Pending_Content.isEmpty () &&
+		! Source_Finished &&
+		! Parsing_Canceled)
+	Source_Available.wait (&Source_Lock);
+if (Parsing_Canceled)
+	return false;
+data.swap (Pending_Content);
+return ! data.isEmpty ();
+}
+
+/*==============================================================================
+	Thread run
+*/
+void
+Metadata_Parser_Thread::run ()
+{
+#if ((DEBUG_SECTION) & DEBUG_RUN)
+LOCKED_LOGGING ((
+clog << ">>> Metadata_Parser_Thread::run" << endl));
+#endif
+Metadata_Source_Buffer
+	source_buffer (this);
+std::istream
+	source (&source_buffer);
+bool
+	successful = true;
+try
+	{
+	Parser
+		parser (source);
+	Parameter
+		*parameter;
+	while ((parameter = parser.get_parameter ()))
+		{
+		if (canceled ())
+			{
+			delete parameter;
+			break;
+			}
+		//	>>> SIGNAL <<<
+		emit parsed (parameter);
+		}
+	}
+catch (idaeim::Exception& except)
+	{
+	#if ((DEBUG_SECTION) & DEBUG_RUN)
+	LOCKED_LOGGING ((
+	clog << "!!! Failed to parse source -" << endl
+		 << except.message () << endl));
+	#endif
+	successful = false;
+	}
+catch (std::exception& except)
+	{
+	#if ((DEBUG_SECTION) & DEBUG_RUN)
+	LOCKED_LOGGING ((
+	clog << "!!! Failed to parse source -" << endl
+		 << except.what () << endl));
+	#endif
+	successful = false;
+	}
+catch (...)
+	{
+	#if ((DEBUG_SECTION) & DEBUG_RUN)
+	LOCKED_LOGGING ((
+	clog << "!!! Failed to parse source!" << endl));
+	#endif
+	successful = false;
+	}
+if (canceled ())
+	successful = false;
+
+#if ((DEBUG_SECTION) & DEBUG_RUN)
+LOCKED_LOGGING ((
+clog << "<<< Metadata_Parser_Thread::run: " << successful << endl));
+#endif
+//	>>> SIGNAL <<<
+emit completed (successful);
+}
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
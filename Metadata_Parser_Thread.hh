@@ -0,0 +1,201 @@
+/*	Metadata_Parser_Thread
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#ifndef HiView_Metadata_Parser_Thread_hh
+#define HiView_Metadata_Parser_Thread_hh
+
+#include	<QThread>
+#include	<QMutex>
+#include	<QWaitCondition>
+#include	<QByteArray>
+
+//	Forward references.
+namespace idaeim {
+namespace PVL {
+class Parameter;
+}}
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/**	A <i>Metadata_Parser_Thread</i> parses PVL metadata on a worker
+	thread as its source content arrives.
+
+	Source content is {@link append(const QByteArray&) appended} to the
+	parser from the thread that obtains it - e.g. as a network reply
+	delivers data - and the end of the content is marked by {@link
+	finish() finishing} the source. The parser thread waits for content
+	as needed, so parsing proceeds while the source is still being
+	received.
+
+	Each top level Parameter is {@link parsed(idaeim::PVL::Parameter*)
+	signaled} as soon as it has been completely parsed, so a user of the
+	metadata can present it incrementally. The {@link completed(bool)
+	completed} signal is emitted when parsing ends.
+
+	@version	$Revision: 1.1 $
+*/
+class Metadata_Parser_Thread
+:	public QThread
+{
+//	Qt Object declaration.
+Q_OBJECT
+
+public:
+/*==============================================================================
+	Constants
+*/
+//!	Class identification name with source code version and date.
+static const char* const
+	ID;
+
+/*==============================================================================
+	Constructors
+*/
+/**	Constructs a Metadata_Parser_Thread.
+
+	The thread is not started.
+
+	@param	parent	The QObject parent of the thread.
+*/
+explicit Metadata_Parser_Thread (QObject* parent = NULL);
+
+/**	Destroys the Metadata_Parser_Thread.
+
+	Parsing is {@link cancel() canceled} and the thread is waited on
+	to finish.
+*/
+virtual ~Metadata_Parser_Thread ();
+
+/*==============================================================================
+	Source
+*/
+/**	Append source content.
+
+	The thread is started if it has not yet been started. Content
+	appended after the source is {@link finish() finished}, parsing is
+	{@link cancel() canceled}, or the parser has ended is ignored.
+
+	@param	data	A QByteArray with more source content. If empty
+		nothing is done.
+*/
+void append (const QByteArray& data);
+
+/**	Mark the end of the source content.
+
+	The thread is started if it has not yet been started so the
+	{@link completed(bool) completed} signal is always emitted.
+*/
+void finish ();
+
+/**	Cancel parsing.
+
+	The parser stops at the next opportunity. No further Parameters are
+	signaled; the completed signal reports an unsuccessful parse.
+*/
+void cancel ();
+
+/**	Test if parsing has been canceled.
+
+	@return	true if parsing was {@link cancel() canceled}; false otherwise.
+*/
+bool canceled () const;
+
+/*==============================================================================
+	Qt signals
+*/
+public:
+
+signals:
+
+/**	Signals a top level Parameter that has been parsed.
+
+	<b>N.B.</b>: The signal is emitted from the parser thread.
+	Ownership of the Parameter is transferred to the receiver; if there
+	is no receiver the Parameter will not be deleted.
+
+	@param	parameter	A pointer to the Parameter.
+*/
+void parsed (idaeim::PVL::Parameter* parameter);
+
+/**	Signals that parsing has ended.
+
+	<b>N.B.</b>: The signal is emitted from the parser thread after all
+	{@link parsed(idaeim::PVL::Parameter*) parsed} signals.
+
+	@param	successful	true if the source content was parsed without
+		error up to the end of the PVL statements; false if a parsing
+		error occurred or parsing was canceled.
+*/
+void completed (bool successful);
+
+/*==============================================================================
+	Thread run
+*/
+protected:
+
+virtual void run ();
+
+/*==============================================================================
+	Helpers
+*/
+private:
+
+friend class Metadata_Source_Buffer;
+
+/**	Get the next source content.
+
+	The calling thread waits until source content is available or the
+	source is finished or canceled.
+
+	@param	data	A QByteArray that is assigned the next source content.
+	@return	true if source content was obtained; false if there is no more
+		source content.
+*/
+bool next_content (QByteArray& data);
+
+/*==============================================================================
+	Data
+*/
+private:
+
+//!	Source content not yet parsed.
+QByteArray
+	Pending_Content;
+
+bool
+	Source_Finished,
+	Parsing_Canceled;
+
+mutable QMutex
+	Source_Lock;
+QWaitCondition
+	Source_Available;
+};
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
+#endif
@@ -0,0 +1,485 @@
+/*	Metadata_Search_Index
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#include	"Metadata_Search_Index.hh"
+
+#include	"PVL.hh"
+using idaeim::PVL::Aggregate;
+using idaeim::PVL::Parameter;
+using idaeim::PVL::Value;
+using idaeim::PVL::Array;
+
+#include	<QMutexLocker>
+#include	<QRegExp>
+#include	<QStringList>
+
+#include	<string>
+using std::string;
+#include	<algorithm>
+
+
+#if defined (DEBUG_SECTION)
+/*******************************************************************************
+	DEBUG_SECTION controls
+
+	DEBUG_SECTION report selection options.
+	Define any of the following options to obtain the desired debug reports:
+*/
+#define DEBUG_OFF			0
+#define DEBUG_ALL			-1
+#define DEBUG_BUILD			(1 << 0)
+#define DEBUG_SEARCH		(1 << 1)
+
+#define DEBUG_DEFAULT		DEBUG_ALL
+
+#if (DEBUG_SECTION+0) == 0
+#undef  DEBUG_SECTION
+#define DEBUG_SECTION DEBUG_OFF
+#else
+#include	"HiView_Utilities.hh"
+#include	<iostream>
+using std::clog;
+using std::endl;
+#endif
+
+#endif	//	DEBUG_SECTION
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/*==============================================================================
+	Constants
+*/
+const char* const
+	Metadata_Search_Index::ID =
+		"UA::HiRISE::Metadata_Search_Index ($Revision: 1.1 $ $Date: 2026/10/17 00:00:00 $)";
+
+/*==============================================================================
+	Local functions
+*/
+namespace
+{
+//	The text of a Value; Array elements are separated by spaces.
+void
+value_text
+	(
+	const Value&	value,
+	QString&		text
+	)
+{
+if (value.is_Array ())
+	{
+	const Array
+		&values = static_cast<const Array&>(value);
+	for (unsigned int
+			element = 0;
+			element < values.size ();
+			element++)
+		value_text (values[element], text);
+	}
+else
+	{
+	if (! text.isEmpty ())
+		text += ' ';
+	text += QString::fromStdString (static_cast<string>(value));
+	}
+}
+
+
+//	Three characters packed into a trigram key.
+inline quint64
+trigram
+	(
+	const QChar*	characters
+	)
+{
+return
+	((quint64)characters[0].unicode () << 32) |
+	((quint64)characters[1].unicode () << 16) |
+	 (quint64)characters[2].unicode ();
+}
+
+}	//	Local namespace
+
+/*==============================================================================
+	Constructors
+*/
+Metadata_Search_Index::Metadata_Search_Index
+	(
+	QObject*	parent
+	)
+	:	QThread (parent),
+		Parameters (NULL),
+		Ready (false),
+		Canceled (false)
+{
+setObjectName ("Metadata_Search_Index");
+}
+
+
+Metadata_Search_Index::~Metadata_Search_Index ()
+{
+cancel ();
+}
+
+/*==============================================================================
+	Index
+*/
+void
+Metadata_Search_Index::build
+	(
+	Aggregate*	parameters
+	)
+{
+#if ((DEBUG_SECTION) & DEBUG_BUILD)
+LOCKED_LOGGING ((
+clog << ">-< Metadata_Search_Index::build: " << (void*)parameters << endl));
+#endif
+cancel ();
+Parameters = parameters;
+	{
+	QMutexLocker
+		lock (&State_Lock);
+	Canceled = false;
+	}
+if (Parameters)
+	start ();
+}
+
+
+void
+Metadata_Search_Index::cancel ()
+{
+	{
+	QMutexLocker
+		lock (&State_Lock);
+	Canceled = true;
+	Ready = false;
+	}
+wait ();
+clear ();
+Parameters = NULL;
+}
+
+
+bool
+Metadata_Search_Index::ready () const
+{
+QMutexLocker
+	lock (&State_Lock);
+return Ready;
+}
+
+
+bool
+Metadata_Search_Index::canceled () const
+{
+QMutexLocker
+	lock (&State_Lock);
+return Canceled;
+}
+
+
+int
+Metadata_Search_Index::entries () const
+{return ready () ? Entries.size () : 0;}
+
+
+void
+Metadata_Search_Index::clear ()
+{
+Entries.clear ();
+Terms.clear ();
+Trigrams.clear ();
+}
+
+/*==============================================================================
+	Search
+*/
+Metadata_Search_Index::Parameter_List
+Metadata_Search_Index::search
+	(
+	const QString&	text,
+	Search_Mode		mode
+	) const
+{
+#if ((DEBUG_SECTION) & DEBUG_SEARCH)
+LOCKED_LOGGING ((
+clog << ">>> Metadata_Search_Index::search: \"" << qPrintable (text)
+		<< "\" mode " << mode << endl));
+#endif
+Parameter_List
+	found;
+if (text.isEmpty () ||
+	! ready ())
+	return found;
+
+QVector<int>
+	matches;
+QString
+	folded (text.toCaseFolded ());
+switch (mode)
+	{
+	case PREFIX_SEARCH:
+		{
+		Term
+			key;
+		key.Text = folded;
+		key.Entry = 0;
+		for (QVector<Term>::const_iterator
+				term = std::lower_bound (Terms.begin (), Terms.end (), key);
+				term != Terms.end () &&
+				term->Text.startsWith (folded);
+				++term)
+			matches.append (term->Entry);
+		std::sort (matches.begin (), matches.end ());
+		matches.erase
+			(std::unique (matches.begin (), matches.end ()), matches.end ());
+		break;
+		}
+
+	case SUBSTRING_SEARCH:
+		{
+		QVector<int>
+			candidates (substring_candidates (folded));
+		for (int
+				index = 0;
+				index < candidates.size ();
+				index++)
+			if (Entries[candidates[index]].Folded.contains (folded))
+				matches.append (candidates[index]);
+		break;
+		}
+
+	case REGEX_SEARCH:
+		{
+		QRegExp
+			expression (text, Qt::CaseInsensitive);
+		if (! expression.isValid ())
+			break;
+		for (int
+				index = 0;
+				index < Entries.size ();
+				index++)
+			{
+			const Entry
+				&entry = Entries[index];
+			if (expression.indexIn (entry.Name)     >= 0 ||
+				expression.indexIn (entry.Pathname) >= 0 ||
+				expression.indexIn (entry.Value)    >= 0)
+				matches.append (index);
+			}
+		break;
+		}
+	}
+
+for (int
+		index = 0;
+		index < matches.size ();
+		index++)
+	found.append (Entries[matches[index]].Parameter);
+#if ((DEBUG_SECTION) & DEBUG_SEARCH)
+LOCKED_LOGGING ((
+clog << "<<< Metadata_Search_Index::search: " << found.size ()
+		<< " found" << endl));
+#endif
+return found;
+}
+
+
+QVector<int>
+Metadata_Search_Index::substring_candidates
+	(
+	const QString&	folded
+	) const
+{
+QVector<int>
+	candidates;
+if (folded.size () < 3)
+	{
+	//	Too short for a trigram; every entry is a candidate.
+	candidates.reserve (Entries.size ());
+	for (int
+			index = 0;
+			index < Entries.size ();
+			index++)
+		candidates.append (index);
+	return candidates;
+	}
+
+/*	Every trigram of the text must occur in a matching entry, so the
+	shortest entry list of the text trigrams holds all the candidates.
+*/
+const QVector<int>
+	*shortest = NULL;
+const QChar
+	*characters = folded.constData ();
+for (int
+		index = 0;
+		index <= folded.size () - 3;
+		index++)
+	{
+	QHash<quint64, QVector<int> >::const_iterator
+		entries = Trigrams.constFind (trigram (characters + index));
+	if (entries == Trigrams.constEnd ())
+		return candidates;
+	if (! shortest ||
+		entries->size () < shortest->size ())
+		shortest = &(*entries);
+	}
+return *shortest;
+}
+
+/*==============================================================================
+	Thread run
+*/
+void
+Metadata_Search_Index::run ()
+{
+#if ((DEBUG_SECTION) & DEBUG_BUILD)
+LOCKED_LOGGING ((
+clog << ">>> Metadata_Search_Index::run" << endl));
+#endif
+index_aggregate (Parameters, QString ());
+if (canceled ())
+	{
+	#if ((DEBUG_SECTION) & DEBUG_BUILD)
+	LOCKED_LOGGING ((
+	clog << "<<< Metadata_Search_Index::run: canceled" << endl));
+	#endif
+	return;
+	}
+std::sort (Terms.begin (), Terms.end ());
+
+	{
+	QMutexLocker
+		lock (&State_Lock);
+	if (Canceled)
+		return;
+	Ready = true;
+	}
+#if ((DEBUG_SECTION) & DEBUG_BUILD)
+LOCKED_LOGGING ((
+clog << "<<< Metadata_Search_Index::run: " << Entries.size () << " entries, "
+		<< Terms.size () << " terms, "
+		<< Trigrams.size () << " trigrams" << endl));
+#endif
+//	>>> SIGNAL <<<
+emit built ();
+}
+
+/*==============================================================================
+	Helpers
+*/
+void
+Metadata_Search_Index::index_aggregate
+	(
+	Aggregate*		aggregate,
+	const QString&	path
+	)
+{
+int
+	parameters = aggregate->size ();
+for (int
+		index = 0;
+		index < parameters;
+		index++)
+	{
+	//	Cancel promptly; the GUI thread waits for it.
+	if (canceled ())
+		return;
+	Parameter
+		*parameter = &(*aggregate)[index];
+	Entry
+		entry;
+	entry.Parameter = parameter;
+	entry.Name = QString::fromStdString (parameter->name ());
+	entry.Pathname = path + '/' + entry.Name;
+	if (! parameter->is_Aggregate ())
+		value_text (parameter->value (), entry.Value);
+	entry.Folded =
+		(entry.Name + '\n' + entry.Pathname + '\n' + entry.Value)
+		.toCaseFolded ();
+	Entries.append (entry);
+	index_entry (Entries.size () - 1);
+
+	if (parameter->is_Aggregate ())
+		index_aggregate
+			(static_cast<Aggregate*>(parameter), entry.Pathname);
+	}
+}
+
+
+void
+Metadata_Search_Index::index_entry
+	(
+	int		entry
+	)
+{
+QRegExp
+	word_delimiters ("[\\s,()\"{}]+");
+
+const Entry
+	&indexed = Entries[entry];
+Term
+	term;
+term.Entry = entry;
+
+//	Prefix terms.
+term.Text = indexed.Name.toCaseFolded ();
+Terms.append (term);
+term.Text = indexed.Pathname.toCaseFolded ();
+Terms.append (term);
+QStringList
+	words (indexed.Value.toCaseFolded ()
+		.split (word_delimiters, QString::SkipEmptyParts));
+for (int
+		index = 0;
+		index < words.size ();
+		index++)
+	{
+	term.Text = words[index];
+	Terms.append (term);
+	}
+
+//	Substring trigrams.
+const QChar
+	*characters = indexed.Folded.constData ();
+for (int
+		index = 0;
+		index <= indexed.Folded.size () - 3;
+		index++)
+	{
+	QVector<int>
+		&entries = Trigrams[trigram (characters + index)];
+	if (entries.isEmpty () ||
+		entries.last () != entry)
+		entries.append (entry);
+	}
+}
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
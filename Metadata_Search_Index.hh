@@ -0,0 +1,248 @@
+/*	Metadata_Search_Index
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#ifndef HiView_Metadata_Search_Index_hh
+#define HiView_Metadata_Search_Index_hh
+
+#include	<QThread>
+#include	<QMutex>
+#include	<QString>
+#include	<QVector>
+#include	<QList>
+#include	<QHash>
+
+//	Forward references.
+namespace idaeim {
+namespace PVL {
+class Parameter;
+class Aggregate;
+}}
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/**	A <i>Metadata_Search_Index</i> provides fast searches of the names,
+	pathnames and values of the Parameters in an Aggregate tree.
+
+	The index is {@link build(idaeim::PVL::Aggregate*) built} on a
+	worker thread. Every Parameter in the tree is entered with its name,
+	absolute pathname and Value text. Two indexes are built from the
+	case folded entry text: a sorted list of terms - the names, pathnames
+	and individual Value words - for prefix searches, and an inverted
+	index of the character trigrams in each entry for substring searches.
+	A substring search intersects the entry lists of the trigrams in the
+	search text and then only needs to confirm the candidate entries.
+	Regular expression searches are matched against each entry.
+
+	<b>N.B.</b>: The Aggregate must not be changed or deleted while the
+	index is being built; {@link cancel() cancel} the build first. Once
+	built the index refers to the Parameters of the Aggregate, so it must
+	be rebuilt if the Aggregate is changed.
+
+	@version	$Revision: 1.1 $
+*/
+class Metadata_Search_Index
+:	public QThread
+{
+//	Qt Object declaration.
+Q_OBJECT
+
+public:
+/*==============================================================================
+	Constants
+*/
+//!	Class identification name with source code version and date.
+static const char* const
+	ID;
+
+//!	Search modes.
+enum Search_Mode
+	{
+	SUBSTRING_SEARCH,
+	PREFIX_SEARCH,
+	REGEX_SEARCH
+	};
+
+/*==============================================================================
+	Types
+*/
+typedef QList<idaeim::PVL::Parameter*>	Parameter_List;
+
+/*==============================================================================
+	Constructors
+*/
+/**	Constructs an empty Metadata_Search_Index.
+
+	@param	parent	The QObject parent of the index.
+*/
+explicit Metadata_Search_Index (QObject* parent = NULL);
+
+/**	Destroys the Metadata_Search_Index.
+
+	Any build in progress is {@link cancel() canceled}.
+*/
+virtual ~Metadata_Search_Index ();
+
+/*==============================================================================
+	Index
+*/
+/**	Build the index for an Aggregate tree.
+
+	Any build in progress is {@link cancel() canceled} and the current
+	index is cleared. Then the worker thread is started to build the
+	index; the {@link built() built} signal is emitted when it is
+	{@link ready() ready}.
+
+	@param	parameters	A pointer to the Aggregate to be indexed. If NULL
+		the index is left empty.
+*/
+void build (idaeim::PVL::Aggregate* parameters);
+
+/**	Cancel a build in progress.
+
+	The caller waits for the worker thread to stop. The index is left
+	empty.
+*/
+void cancel ();
+
+/**	Test if the index is ready for searching.
+
+	@return	true if an index has been completely built; false otherwise.
+*/
+bool ready () const;
+
+/**	Get the number of Parameters in the index.
+
+	@return	The number of indexed Parameters. This will be zero if the
+		index is not {@link ready() ready}.
+*/
+int entries () const;
+
+/**	Search the index.
+
+	Prefix and substring searches are case insensitive. Prefix searches
+	match the beginning of a Parameter name, its absolute pathname, or
+	any word of its Value. Substring and regular expression searches
+	match anywhere in the name, pathname or Value.
+
+	@param	text	The text to search for. If empty nothing is found.
+	@param	mode	The Search_Mode.
+	@return	A list of the matching Parameters in the order they occur in
+		the tree. This will be empty if the index is not {@link ready()
+		ready}, nothing matched, or the text is not a valid regular
+		expression for a REGEX_SEARCH.
+*/
+Parameter_List search (const QString& text,
+	Search_Mode mode = SUBSTRING_SEARCH) const;
+
+/*==============================================================================
+	Qt signals
+*/
+public:
+
+signals:
+
+/**	Signals that a {@link build(idaeim::PVL::Aggregate*) build} has
+	completed and the index is {@link ready() ready}.
+*/
+void built ();
+
+/*==============================================================================
+	Thread run
+*/
+protected:
+
+virtual void run ();
+
+/*==============================================================================
+	Helpers
+*/
+private:
+
+bool canceled () const;
+
+void clear ();
+
+void index_aggregate (idaeim::PVL::Aggregate* aggregate,
+	const QString& path);
+
+void index_entry (int entry);
+
+QVector<int> substring_candidates (const QString& folded) const;
+
+/*==============================================================================
+	Data
+*/
+private:
+
+struct Entry
+	{
+	idaeim::PVL::Parameter
+		*Parameter;
+	QString
+		Name,
+		Pathname,
+		Value,
+		//	Case folded name, pathname and value.
+		Folded;
+	};
+
+struct Term
+	{
+	QString
+		Text;
+	int
+		Entry;
+
+	bool operator< (const Term& term) const
+		{return Text < term.Text;}
+	};
+
+//!	The Aggregate being indexed.
+idaeim::PVL::Aggregate
+	*Parameters;
+
+QVector<Entry>
+	Entries;
+
+//!	Sorted case folded terms.
+QVector<Term>
+	Terms;
+
+//!	Entries containing each character trigram, in entry order.
+QHash<quint64, QVector<int> >
+	Trigrams;
+
+bool
+	Ready,
+	Canceled;
+mutable QMutex
+	State_Lock;
+};
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
+#endif
@@ -23,6 +23,7 @@ Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
 
 #include	"PDS_Metadata.hh"
 #include "Qstream.hh"
+#include	"Metadata_Parser_Thread.hh"
 
 #include	"PVL.hh"
 using namespace idaeim::PVL;
@@ -191,6 +192,8 @@ PDS_Metadata::PDS_Metadata
 	)
 	:	QObject (parent),
 		//Network_Status (),
+		Network_Reply (NULL),
+		Parser_Thread (NULL),
 		Metadata (NULL)
 {
 setObjectName ("PDS_Metadata");
@@ -240,7 +243,7 @@ return Metadata;
 
 bool
 PDS_Metadata::fetching () const
-{return false;}
+{return Network_Reply || Parser_Thread;}
 //{return isRunning () || request_status () == IN_PROGRESS;}
 
 
@@ -258,10 +261,31 @@ if (was_reset &&
 	Metadata = NULL;
 	}
 return was_reset;*/
+if (Network_Reply)
+	{
+	//	Abandon any network request in progress.
+	Network_Reply->disconnect (this);
+	Network_Reply->abort ();
+	Network_Reply->deleteLater ();
+	Network_Reply = NULL;
+	}
+if (Parser_Thread)
+	{
+	/*	Abandon any parsing in progress.
+
+		Deletion is deferred so any parsed signals already queued from
+		the thread are delivered, and discarded, before it is deleted.
+	*/
+	Parser_Thread->cancel ();
+	Parser_Thread->wait ();
+	Parser_Thread->deleteLater ();
+	Parser_Thread = NULL;
+	}
 if (Metadata)
-{
-    delete Metadata;
-}
+	{
+	delete Metadata;
+	Metadata = NULL;
+	}
 return true;
 }
 
@@ -278,155 +302,84 @@ PDS_Metadata::fetch
 #endif
 	)
 {
-    
 #if ((DEBUG_SECTION) & DEBUG_FETCH)
 clog << ">>> PDS_Metadata::fetch: " << URL.toString () << endl
 	 << "     URL scheme = " << URL.scheme () << endl
 	 << "       URL path = " << URL.path () << endl
 	 << "    synchronous = " << synchronous << endl;
 #endif
-/*int
-	result = IN_PROGRESS;*/
-if (/* isRunning () &&*/  URL.isEmpty ()) return;
+if (URL.isEmpty ())
+	return;
 
-//{
-	//Status_Lock->lock ();
-/*
-	if (Request_Status == IN_PROGRESS)
-		{
-		#if ((DEBUG_SECTION) & DEBUG_FETCH)
-		clog << "    Request_Status IN_PROGRESS!" << endl
-			 << "<<< PDS_Metadata::fetch: false" << endl;
-		#endif
-		//Status_Lock->unlock ();
-		return false;
-		}
-      */
-	//	Reset the fetch state.
-	if (Metadata)
-	{
-		delete Metadata;
-		Metadata = NULL;
-	}
-	
-	Requested_URL = URL;
-   /*
-	Redirected_URL.clear ();
-	Request_Status = result;
-	HTTP_Status = NO_STATUS;
-	HTTP_Status_Description.clear ();
-   */
-	//Status_Lock->unlock ();
-
-	if ((URL.scheme ().compare ("HTTP", Qt::CaseInsensitive) == 0 ||
-        URL.scheme ().compare ("HTTPS", Qt::CaseInsensitive) == 0) &&
-		! URL.host ().isEmpty () &&
-		! URL.path ().isEmpty ())
-	{
-		//	HTTP server fetch.
-		#if ((DEBUG_SECTION) & DEBUG_FETCH)
-		clog << "    PDS_Metadata::fetch: starting network get" << endl;
-		#endif
-		/*
-		start ();
+//	Reset the fetch state.
+reset ();
+Requested_URL = URL;
 
-		if (synchronous)
-		{
-			#if ((DEBUG_SECTION) & DEBUG_CHECK)
-			LOCKED_LOGGING ((
-			clog << "    PDS_Metadata::fetch: waiting for thread to finish"
-					<< endl));
-			#endif
-			wait ();	//	Wait for the thread to finish;
-			result = Request_Status;
-			synchronous = false;	//	No signal from here.
-		}
-		*/
+if ((URL.scheme ().compare ("HTTP", Qt::CaseInsensitive) == 0 ||
+	 URL.scheme ().compare ("HTTPS", Qt::CaseInsensitive) == 0) &&
+	! URL.host ().isEmpty () &&
+	! URL.path ().isEmpty ())
+	{
+	//	HTTP server fetch.
+	#if ((DEBUG_SECTION) & DEBUG_FETCH)
+	clog << "    PDS_Metadata::fetch: starting network get" << endl;
+	#endif
 	/*
 		The QNetworkAccessManager must be constructed on the same thread
 		where it is used with its QNetworkReply.
 	*/
 	QNetworkAccessManager* Network_Access_Manager = new QNetworkAccessManager(this);
-		
-		Network_Reply = Network_Access_Manager->get (QNetworkRequest (Requested_URL));
-		QObject::connect
-		(
-		    Network_Reply,
-		    SIGNAL(finished()),
-		    this,
-		    SLOT(fetched())
-		);
+	new_parser ();
+	Network_Reply = Network_Access_Manager->get (QNetworkRequest (Requested_URL));
+	//	The content is parsed as it is received.
+	connect (Network_Reply,
+		SIGNAL (readyRead ()),
+		SLOT (received ()));
+	connect (Network_Reply,
+		SIGNAL (finished ()),
+		SLOT (fetched ()));
 	}
-	else
-	if ((URL.scheme ().compare ("FILE", Qt::CaseInsensitive) == 0 ||
-		 URL.scheme ().isEmpty ()) &&
-		! URL.path ().isEmpty ())
+else
+if ((URL.scheme ().compare ("FILE", Qt::CaseInsensitive) == 0 ||
+	 URL.scheme ().isEmpty ()) &&
+	! URL.path ().isEmpty ())
 	{
-		//	Local filesystem fetch.
-		//synchronous = true;
-		#if ((DEBUG_SECTION) & DEBUG_FETCH)
-		clog << "    filesystem fetch for " << URL.path () << endl;
-		#endif
-		QFile
-			file (QDir::toNativeSeparators (URL.path ()));
-		if (file.exists ())
+	//	Local filesystem fetch.
+	#if ((DEBUG_SECTION) & DEBUG_FETCH)
+	clog << "    filesystem fetch for " << URL.path () << endl;
+	#endif
+	QFile
+		file (QDir::toNativeSeparators (URL.path ()));
+	if (file.exists () &&
+		file.open (QIODevice::ReadOnly))
 		{
-			if (file.open (QIODevice::ReadOnly))
-				{
-				//result = ACCESSIBLE_URL;
-				Qistream
-					qistream (&file);
-				Parser
-					parser (qistream);
-				try {
-					Metadata = new Aggregate (parser, Parser::CONTAINER_NAME);
-					#if ((DEBUG_SECTION) & DEBUG_FETCH)
-					clog << "    Metadata @ " << (void*)Metadata << " -" << endl
-						 << *Metadata;
-					#endif
-		//Request_Status = NO_STATUS;
-							emit fetched (Metadata);
-
-					}
-				catch (idaeim::Exception except)
-					{
-					#if ((DEBUG_SECTION) & DEBUG_FETCH)
-					clog << "!!! Failed to parse file source -" << endl
-						 << except.message () << endl;
-					#endif
-					}
-				file.close ();
-				}
-			/*else
-				result = URL_ACCESS_DENIED;*/
+		new_parser ();
+		Parser_Thread->append (file.readAll ());
+		Parser_Thread->finish ();
+		file.close ();
 		}
-	/*	else
-			result = URL_NOT_FOUND;*/
-	/*}
-	else
-	{
-		synchronous = true;
-		result = INVALID_URL;
-	}*/
-	/*
-	if (synchronous)
-	{
-		//	Set the request status.
-		request_status (result);
-
-		//	>>> SIGNAL <<<
-		#if ((DEBUG_SECTION) & DEBUG_FETCH)
-		LOCKED_LOGGING ((
-		clog << "    PDS_Metadata::fetch: emit fetched Metadata @ "
-				<< (void*)Metadata << endl));
-		#endif
-		emit fetched (Metadata);
 	}
-	*/
+#if ((DEBUG_SECTION) & DEBUG_FETCH)
+clog << "<<< PDS_Metadata::fetch" << endl;
+#endif
 }
 
+
+void
+PDS_Metadata::new_parser ()
+{
+Parser_Thread = new Metadata_Parser_Thread (this);
+connect (Parser_Thread,
+	SIGNAL (parsed (idaeim::PVL::Parameter*)),
+	SLOT (parsed (idaeim::PVL::Parameter*)),
+	Qt::QueuedConnection);
+connect (Parser_Thread,
+	SIGNAL (completed (bool)),
+	SLOT (parse_completed (bool)),
+	Qt::QueuedConnection);
 }
 
+
 /*
 void
 PDS_Metadata::run ()
@@ -526,93 +479,163 @@ clog << "<<< PDS_Metadata::run" << endl));
 }
 */
 
-void PDS_Metadata::fetched()
+void
+PDS_Metadata::received ()
 {
-    if (! Network_Reply) return;
-    
-    if (Network_Reply->error() != QNetworkReply::NoError)
-    {
-	#if ((DEBUG_SECTION) & DEBUG_FETCH)
-	clog << "!!! PDS_Metadata::fetched got error" <<  Network_Reply->errorString() << endl;
-	#endif 
+if (! Network_Reply ||
+	! Parser_Thread ||
+	sender () != Network_Reply)
 	return;
-    }
-    
-	QUrl predirectUrl =
-	         Network_Reply->attribute(QNetworkRequest::RedirectionTargetAttribute).toUrl();
 
-	
-	if (predirectUrl == Network_Reply->request().url())
+if (! Network_Reply->attribute (QNetworkRequest::RedirectionTargetAttribute)
+		.toUrl ().isEmpty ())
+	//	The content of a redirection reply is not metadata.
+	return;
+
+Parser_Thread->append (Network_Reply->readAll ());
+}
+
+
+void
+PDS_Metadata::fetched ()
+{
+if (! Network_Reply ||
+	sender () != Network_Reply)
+	return;
+
+if (Network_Reply->error () != QNetworkReply::NoError)
 	{
 	#if ((DEBUG_SECTION) & DEBUG_FETCH)
-	clog << "!!! PDS_Metadata::fetched infinite loop detected" <<  endl;
-	#endif  
-		Network_Reply->deleteLater();
-		return;
+	clog << "!!! PDS_Metadata::fetched got error "
+			<< Network_Reply->errorString () << endl;
+	#endif
+	Network_Reply->deleteLater ();
+	Network_Reply = NULL;
+	if (Parser_Thread)
+		{
+		//	Any metadata parsed so far is reported on completion.
+		Parser_Thread->cancel ();
+		Parser_Thread->finish ();
+		}
+	return;
 	}
- 
-	/* If the URL is not empty, we're being redirected. */
-	if ( ! predirectUrl.isEmpty()) {
-	#if ((DEBUG_SECTION) & DEBUG_FETCH)
-	clog << "!!! PDS_Metadata::fetched redirected to " << predirectUrl.toString() << endl;
-	#endif 
-
-		/* We'll do another request to the redirection url. */
-		Network_Reply->deleteLater();
-		//Request_Status = NO_STATUS;
-		fetch(predirectUrl, true);
-		
-		return;
-	}    
-    //QString* qstr = new QString(Network_Reply->readAll());
-	#if ((DEBUG_SECTION) & DEBUG_FETCH)
-	clog << "PDS_Metadata::fetched" << endl;
-	//clog << qstr->toStdString() << endl;
-	#endif        
-/*	
-   QBuffer* buffer = new QBuffer();
-   QByteArray array = Network_Reply->readAll();
-
-	buffer->setBuffer(&array);
-				Qistream
-					qistream (buffer);   
-					Parser parser(qistream);
-*/
 
-    QString* qstr = new QString(Network_Reply->readAll());
-    Parser parser(qstr->toStdString());
-    
-Aggregate
-	*metadata (NULL);
-try {metadata = new Aggregate (parser, Parser::CONTAINER_NAME);}
-catch (idaeim::Exception except)
+QUrl
+	redirected_URL = Network_Reply->attribute
+		(QNetworkRequest::RedirectionTargetAttribute).toUrl ();
+if (! redirected_URL.isEmpty ())
 	{
+	if (redirected_URL == Network_Reply->request ().url ())
+		{
+		#if ((DEBUG_SECTION) & DEBUG_FETCH)
+		clog << "!!! PDS_Metadata::fetched infinite loop detected" << endl;
+		#endif
+		Network_Reply->deleteLater ();
+		Network_Reply = NULL;
+		if (Parser_Thread)
+			{
+			Parser_Thread->cancel ();
+			Parser_Thread->finish ();
+			}
+		return;
+		}
+
+	//	Make another request to the redirection URL.
 	#if ((DEBUG_SECTION) & DEBUG_FETCH)
-	clog << "!!!PDS_Metadata::fetched Failed to parse source -" << endl
-		 << except.message () << endl;
-	#endif
-	} 
-catch (std::exception except)
-{
-	#if ((DEBUG_SECTION) & DEBUG_FETCH)
-	clog << "!!!PDS_Metadata::fetched Failed to parse source -" << endl
-		 << except.what () << endl;
+	clog << "    PDS_Metadata::fetched redirected to "
+			<< redirected_URL.toString () << endl;
 	#endif
+	fetch (redirected_URL, ASYNCHRONOUS);
+	return;
+	}
+
+#if ((DEBUG_SECTION) & DEBUG_FETCH)
+clog << "<-> PDS_Metadata::fetched" << endl;
+#endif
+if (Parser_Thread)
+	{
+	Parser_Thread->append (Network_Reply->readAll ());
+	Parser_Thread->finish ();
+	}
+Network_Reply->deleteLater ();
+Network_Reply = NULL;
 }
-catch (...)
+
+
+void
+PDS_Metadata::parsed
+	(
+	Parameter*	parameter
+	)
 {
-	#if ((DEBUG_SECTION) & DEBUG_FETCH)
-	clog << "!!!PDS_Metadata::fetched Failed to parse source!" << endl;
-	#endif
+if (! parameter)
+	return;
+if (! Parser_Thread ||
+	sender () != Parser_Thread)
+	{
+	//	From an abandoned parser.
+	delete parameter;
+	return;
+	}
+
+if (! Metadata)
+	Metadata = new Aggregate (Parser::CONTAINER_NAME);
+Metadata->add (parameter);
+#if ((DEBUG_SECTION) & DEBUG_FETCH)
+clog << "<-> PDS_Metadata::parsed: " << (*Metadata)[Metadata->size () - 1].name ()
+		<< endl;
+#endif
+//	>>> SIGNAL <<<
+emit fetched_parameter (&(*Metadata)[Metadata->size () - 1]);
 }
 
-   delete qstr;
-	//Request_Status = NO_STATUS;
-	Network_Reply->deleteLater();
-Metadata = metadata;	
-emit fetched (Metadata);	
+
+void
+PDS_Metadata::parse_completed
+	(
+	bool
+#if ((DEBUG_SECTION) & DEBUG_FETCH)
+		successful
+#endif
+	)
+{
+if (! Parser_Thread ||
+	sender () != Parser_Thread)
+	//	From an abandoned parser.
+	return;
+#if ((DEBUG_SECTION) & DEBUG_FETCH)
+clog << ">>> PDS_Metadata::parse_completed: successful = " << successful << endl;
+#endif
+Parser_Thread->deleteLater ();
+Parser_Thread = NULL;
+
+if (Network_Reply)
+	{
+	/*	The PVL content has ended;
+		any additional content of the source is ignored.
+	*/
+	Network_Reply->disconnect (this);
+	Network_Reply->abort ();
+	Network_Reply->deleteLater ();
+	Network_Reply = NULL;
+	}
+
+if (Metadata &&
+	! Metadata->size ())
+	{
+	delete Metadata;
+	Metadata = NULL;
+	}
+#if ((DEBUG_SECTION) & DEBUG_FETCH)
+clog << "    PDS_Metadata::parse_completed: emit fetched Metadata @ "
+		<< (void*)Metadata << endl
+	 << "<<< PDS_Metadata::parse_completed" << endl;
+#endif
+//	>>> SIGNAL <<<
+emit fetched (Metadata);
 }
 
+
 /*==============================================================================
 	Utilities
 */
@@ -44,6 +44,9 @@ namespace UA
 {
 namespace HiRISE
 {
+//	Forward reference.
+class Metadata_Parser_Thread;
+
 /**	A <i>PDS_Metadata</i> fetches PDS metadata from a URL source.
 
 	The PDS_Metadata is a fully thread safe QThread subclass, and a subclass
@@ -51,10 +54,16 @@ namespace HiRISE
 	uses a QNetworkAccessManager to fetch the URL file content. The URL
 	fetch may be done asynchronously or synchrously with a maximum wait
 	time for it to complete, and a fetch in progress may be canceled. A
-	local file URL may also be fetched; this is always done
+	local file URL may also be fetched; the file is always read
 	synchronously. A signal is emitted whenever a fetch has been
 	completed.
 
+	The fetched content is parsed on a Metadata_Parser_Thread as it is
+	received, and each top level parameter is {@link
+	fetched_parameter(idaeim::PVL::Parameter*) signaled} as soon as it
+	has been parsed so the metadata can be used before a large label has
+	been completely received.
+
 	The results of a URL fetch is the PDS metadata parameters in the form
 	of a PVL Aggregate.
 
@@ -275,9 +284,10 @@ bool fetching () const;
 
 /**	Reset this PDS_Metadata.
 
-	The {@link metadata() metadata parameters}, if any, are deleted and the
-	metadata is set to NULL. The network status values are also {@link
-	Network_Status::reset() reset}.
+	Any {@link fetch(const QUrl&, bool) fetch} in progress is abandoned
+	without signaling its completion. The {@link metadata() metadata
+	parameters}, if any, are deleted and the metadata is set to NULL. The
+	network status values are also {@link Network_Status::reset() reset}.
 */
 bool reset ();
 
@@ -1089,6 +1099,12 @@ enum
 	file for the metadata fetch to proceed by parsing the PVL content of the
 	file.
 
+	The source content is parsed on a Metadata_Parser_Thread as it is
+	received. The {@link fetched_parameter(idaeim::PVL::Parameter*)
+	fetched_parameter} signal is emitted for each top level parameter as
+	it is parsed, before the fetched signal. A fetch in progress is
+	abandoned when a new fetch is started.
+
 	The {@link fetched(idaeim::PVL::Aggregate*) fetched} signal is always
 	emitted when the fetch completesregardless of whether the fetch is
 	synchronous or asynchronous, or if a timeout occurs.
@@ -1137,13 +1153,36 @@ signals:
 	@see request_status()
 */
 void fetched (idaeim::PVL::Aggregate* metadata);
+
+/**	Signals a top level parameter obtained during a {@link fetch(const
+	QUrl&, bool) URL fetch}.
+
+	The signal is emitted as soon as the parameter has been parsed,
+	while the remainder of the source content may still be arriving.
+
+	@param	parameter	A pointer to the parameter. <b>N.B.</b>: The
+		parameter is owned by the {@link metadata() metadata} of this
+		PDS_Metadata; it remains valid until another fetch is started
+		or the PDS_Metadata is reset or destroyed.
+*/
+void fetched_parameter (idaeim::PVL::Parameter* parameter);
 /*==============================================================================
 	Qt slots
 */
 
 private slots:
 
+void received ();
 void fetched ();
+void parsed (idaeim::PVL::Parameter* parameter);
+void parse_completed (bool successful);
+
+/*==============================================================================
+	Helpers
+*/
+private:
+
+void new_parser ();
     
 /*==============================================================================
 	Data
@@ -1154,6 +1193,9 @@ private:
 QNetworkReply* Network_Reply;
 QUrl Requested_URL;
 
+Metadata_Parser_Thread
+	*Parser_Thread;
+
 
 idaeim::PVL::Aggregate*
 	Metadata;
@@ -29,6 +29,8 @@ using idaeim::PVL::Parameter;
 using idaeim::PVL::Value;
 
 #include	<QTreeView>
+#include	<QColor>
+#include	<QBrush>
 
 #include	<string>
 using std::string;
@@ -98,10 +100,18 @@ const char* const
 #ifndef DEFAULT_PARAMETER_TREE_ROOT_NAME
 #define DEFAULT_PARAMETER_TREE_ROOT_NAME	Root
 #endif
+
+#ifndef DEFAULT_PARAMETER_TREE_HIGHLIGHT_COLOR
+#define DEFAULT_PARAMETER_TREE_HIGHLIGHT_COLOR	khaki
+#endif
 #define _DEFAULT_ROOT_NAME_	AS_STRING(DEFAULT_PARAMETER_TREE_ROOT_NAME)
 const char* const
 	Parameter_Tree_Model::DEFAULT_ROOT_NAME		= _DEFAULT_ROOT_NAME_;
 
+#define _DEFAULT_HIGHLIGHT_COLOR_	AS_STRING(DEFAULT_PARAMETER_TREE_HIGHLIGHT_COLOR)
+const char* const
+	Parameter_Tree_Model::DEFAULT_HIGHLIGHT_COLOR	= _DEFAULT_HIGHLIGHT_COLOR_;
+
 /*==============================================================================
 	Constructors
 */
@@ -119,6 +129,7 @@ Parameter_Tree_Model::Parameter_Tree_Model
 clog << "<-> Parameter_Tree_Model::Parameter_Tree_Model @ " << (void*)this
 		<< ": root @ " << (void*)root << endl;
 #endif
+index_parameters ();
 #if (DEBUG_SECTION != 0)
 clog << boolalpha;
 QHash<int, QByteArray>
@@ -149,7 +160,10 @@ Parameter_Tree_Model::Parameter_Tree_Model
 	:	QAbstractItemModel (),
 		Root (model.Root),
 		Root_Visible (model.Root_Visible),
-		Root_Name (model.Root_Name)
+		Root_Name (model.Root_Name),
+		Parameter_Rows (model.Parameter_Rows),
+		Value_Strings (model.Value_Strings),
+		Highlighted (model.Highlighted)
 {
 #if (DEBUG_SECTION & DEBUG_CONSTRUCTORS)
 clog << "<-> Parameter_Tree_Model::Parameter_Tree_Model: copy @ "
@@ -186,6 +200,9 @@ if (this != &model)
 	Root = model.Root;
 	Root_Visible = model.Root_Visible;
 	Root_Name = model.Root_Name;
+	Parameter_Rows = model.Parameter_Rows;
+	Value_Strings = model.Value_Strings;
+	Highlighted = model.Highlighted;
 	}
 return *this;
 }
@@ -279,6 +296,14 @@ if (role == Qt::TextAlignmentRole)
 	datum = static_cast<int>(Qt::AlignTop | Qt::AlignLeft);
 	}
 else
+if (role == Qt::BackgroundRole &&
+	index.isValid ())
+	{
+	if (Highlighted.contains
+			(static_cast<const Parameter*>(index.internalPointer ())))
+		datum = QBrush (QColor (DEFAULT_HIGHLIGHT_COLOR));
+	}
+else
 if (role == Qt::DisplayRole &&
 	index.isValid ())
 	{
@@ -331,7 +356,12 @@ if (role == Qt::DisplayRole &&
 				#if (DEBUG_SECTION & DEBUG_DATA)
 				clog << "    Value = " << *value << endl;
 				#endif
-				datum = QString::fromStdString (static_cast<string>(*value));
+				QHash<const Parameter*, QString>::const_iterator
+					cached = Value_Strings.constFind (parameter);
+				if (cached == Value_Strings.constEnd ())
+					cached = Value_Strings.insert (parameter,
+						QString::fromStdString (static_cast<string>(*value)));
+				datum = *cached;
 				}
 			}
 		}
@@ -515,9 +545,142 @@ if (parameter)
 return comments;
 }
 
+QModelIndex
+Parameter_Tree_Model::parameter_index
+	(
+	Parameter*	parameter
+	) const
+{
+QModelIndex
+	index;
+if (parameter &&
+	(parameter != Root ||
+	 Root_Visible))
+	index = createIndex (parameter_row (parameter), 0, parameter);
+return index;
+}
+
+/*==============================================================================
+	Manipulators
+*/
+QModelIndex
+Parameter_Tree_Model::add
+	(
+	Parameter*	parameter,
+	Aggregate*	aggregate
+	)
+{
+#if (DEBUG_SECTION & DEBUG_MODEL)
+clog << ">>> Parameter_Tree_Model::add: parameter @ " << (void*)parameter
+		<< " to aggregate @ " << (void*)aggregate << endl;
+#endif
+QModelIndex
+	index;
+if (! aggregate)
+	aggregate = Root;
+if (parameter &&
+	aggregate)
+	{
+	int
+		row = aggregate->size ();
+	beginInsertRows (parameter_index (aggregate), row, row);
+	aggregate->add (parameter);
+	parameter = &(*aggregate)[row];
+	Parameter_Rows.insert (parameter, row);
+	if (parameter->is_Aggregate ())
+		index_parameters (static_cast<Aggregate*>(parameter));
+	endInsertRows ();
+	index = createIndex (row, 0, parameter);
+	}
+#if (DEBUG_SECTION & DEBUG_MODEL)
+clog << "<<< Parameter_Tree_Model::add: " << index << endl;
+#endif
+return index;
+}
+
+
+void
+Parameter_Tree_Model::highlight
+	(
+	const QList<Parameter*>&	parameters
+	)
+{
+#if (DEBUG_SECTION & DEBUG_MODEL)
+clog << ">>> Parameter_Tree_Model::highlight: "
+		<< parameters.size () << " parameters" << endl;
+#endif
+QSet<const Parameter*>
+	highlighted;
+for (int
+		entry = 0;
+		entry < parameters.size ();
+		entry++)
+	highlighted.insert (parameters[entry]);
+
+//	Only the rows that change highlighting need to be redrawn.
+QSet<const Parameter*>
+	changed (Highlighted),
+	added (highlighted);
+changed.subtract (highlighted);
+added.subtract (Highlighted);
+changed.unite (added);
+Highlighted = highlighted;
+
+for (QSet<const Parameter*>::const_iterator
+		parameter = changed.constBegin ();
+		parameter != changed.constEnd ();
+		++parameter)
+	{
+	QModelIndex
+		index = parameter_index (const_cast<Parameter*>(*parameter));
+	if (index.isValid ())
+		emit dataChanged (index, index.sibling (index.row (), 1));
+	}
+#if (DEBUG_SECTION & DEBUG_MODEL)
+clog << "<<< Parameter_Tree_Model::highlight: "
+		<< changed.size () << " rows changed" << endl;
+#endif
+}
+
 /*==============================================================================
 	Helpers
 */
+void
+Parameter_Tree_Model::index_parameters ()
+{
+Parameter_Rows.clear ();
+Value_Strings.clear ();
+if (Root)
+	index_parameters (Root);
+#if (DEBUG_SECTION & DEBUG_MODEL)
+clog << "<-> Parameter_Tree_Model::index_parameters: "
+		<< Parameter_Rows.size () << " parameters" << endl;
+#endif
+}
+
+
+void
+Parameter_Tree_Model::index_parameters
+	(
+	Aggregate*	aggregate
+	)
+{
+int
+	rows = aggregate->size ();
+for (int
+		row = 0;
+		row < rows;
+		row++)
+	{
+	Parameter
+		*parameter = &(*aggregate)[row];
+	Parameter_Rows.insert (parameter, row);
+	if (parameter->is_Aggregate ())
+		index_parameters (static_cast<Aggregate*>(parameter));
+	}
+}
+
+
 int
 Parameter_Tree_Model::parameter_row
 	(
@@ -532,6 +695,11 @@ if (parameter)
 		parent = parameter->parent ();
 	if (parent)
 		{
+		QHash<const Parameter*, int>::const_iterator
+			indexed = Parameter_Rows.constFind (parameter);
+		if (indexed != Parameter_Rows.constEnd ())
+			return *indexed;
+
 		row = parent->size ();
 		while (row--)
 			if (&(*parent)[row] == parameter)
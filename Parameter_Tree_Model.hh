@@ -25,6 +25,10 @@ Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
 #define Parameter_Tree_Model_hh
 
 #include	<QAbstractItemModel>
+#include	<QHash>
+#include	<QSet>
+#include	<QList>
+#include	<QString>
 
 #include	<iosfwd>
 
@@ -51,6 +55,12 @@ namespace HiRISE
 	<b>N.B.</b>: The model is implemented as read-only; no editing
 	operations are supported.
 
+	Large Aggregates - such as merged product labels - may have many
+	thousands of parameters. When the Aggregate is bound to the model the
+	row of each Parameter within its parent is indexed so the parent of
+	an item is found without searching the parent Aggregate. The display
+	strings of Parameter Values are cached as they are first used.
+
 	@author		Parker Snell, UA/HiROC
 	@version	$Revision: 1.19 $
 */
@@ -73,6 +83,11 @@ static const char* const
 static const char* const
 	DEFAULT_ROOT_NAME;
 
+//!	Default {@link highlight(const QList<idaeim::PVL::Parameter*>&)
+//!	highlight} background color name.
+static const char* const
+	DEFAULT_HIGHLIGHT_COLOR;
+
 /*==============================================================================
 	Constructors
 */
@@ -283,13 +298,87 @@ void root_name (const QString& name);
 */
 QString comments (const QModelIndex& index) const;
 
+/**	Get the model index of a Parameter.
+
+	@param	parameter	A pointer to a Parameter in the {@link parameters()
+		parameters} tree.
+	@return	A QModelIndex for the name column of the Parameter. This will
+		be invalid if the parameter is NULL, or is the root Aggregate when
+		the {@link root_visible() root is not visible}.
+*/
+QModelIndex parameter_index (idaeim::PVL::Parameter* parameter) const;
+
+/**	Test if a Parameter is highlighted.
+
+	@param	parameter	A pointer to a Parameter.
+	@return	true if the parameter is {@link
+		highlight(const QList<idaeim::PVL::Parameter*>&) highlighted};
+		false otherwise.
+*/
+bool highlighted (const idaeim::PVL::Parameter* parameter) const
+	{return Highlighted.contains (parameter);}
+
+/*==============================================================================
+	Manipulators
+*/
+/**	Add a Parameter to an Aggregate of the model.
+
+	The Parameter is appended to the Aggregate with the appropriate
+	beginInsertRows and endInsertRows signals so attached views are
+	updated incrementally without resetting the model. The Parameter,
+	and any Parameters it contains, are indexed.
+
+	This allows a model to be populated as Parameters become available;
+	e.g. while a PVL label is being parsed.
+
+	@param	parameter	A pointer to the Parameter to be added. <b>N.B.</b>:
+		Ownership of the Parameter is transferred to the Aggregate.
+	@param	aggregate	A pointer to the Aggregate, in the {@link
+		parameters() parameters} tree, to which the parameter is to be
+		added. If NULL the root Aggregate is used.
+	@return	A QModelIndex for the added Parameter. This will be invalid
+		if the parameter is NULL or there is no Aggregate to which it can
+		be added; in this case the parameter is not owned by the model.
+*/
+QModelIndex add (idaeim::PVL::Parameter* parameter,
+	idaeim::PVL::Aggregate* aggregate = NULL);
+
+/**	Highlight Parameters of the model.
+
+	The rows of highlighted Parameters are given the {@link
+	#DEFAULT_HIGHLIGHT_COLOR} background; e.g. to mark the Parameters
+	found by a search. The previously highlighted Parameters are no
+	longer highlighted. A dataChanged signal is emitted for each row
+	whose highlighting changes.
+
+	@param	parameters	A list of pointers to Parameters in the {@link
+		parameters() parameters} tree. If empty no Parameters will be
+		highlighted.
+*/
+void highlight (const QList<idaeim::PVL::Parameter*>& parameters);
+
 /*==============================================================================
 	Helpers
 */
 private:
 
+/**	Index the rows of all Parameters in the Root Aggregate tree.
+
+	Any cached Value display strings are cleared.
+*/
+void index_parameters ();
+
+/**	Index the rows of the Parameters in an Aggregate tree.
+
+	@param	aggregate	A pointer to the Aggregate to be indexed.
+*/
+void index_parameters (idaeim::PVL::Aggregate* aggregate);
+
 /**	Get the row of a Parameter in its parent.
 
+	The row is obtained from the Parameter index. A Parameter that has
+	not been indexed is searched for in its parent.
+
 	@param	parameter	A pointer to a Parameter.
 	@return	The Aggregate entry index of the parameter in its parent.
 		This will be -1 if the parameter is NULL. If the parameter has no
@@ -312,6 +401,18 @@ bool
 
 QString
 	Root_Name;
+
+//!	Row of each Parameter in its parent Aggregate.
+QHash<const idaeim::PVL::Parameter*, int>
+	Parameter_Rows;
+
+//!	Display strings of Parameter Values, filled as they are used.
+mutable QHash<const idaeim::PVL::Parameter*, QString>
+	Value_Strings;
+
+//!	Highlighted Parameters.
+QSet<const idaeim::PVL::Parameter*>
+	Highlighted;
 };
 
 /*==============================================================================
@@ -33,6 +33,7 @@ using idaeim::PVL::Array;
 
 #include	<QTreeView>
 #include	<QList>
+#include	<QSet>
 
 #include	<string>
 using std::string;
@@ -94,6 +95,12 @@ const char* const
 const bool
 	Parameter_Tree_View::DEFAULT_ANIMATION	= PARAMETER_VIEW_DEFAULT_ANIMATION;
 
+#ifndef PARAMETER_VIEW_MAX_REVEALED
+#define PARAMETER_VIEW_MAX_REVEALED			32
+#endif
+const int
+	Parameter_Tree_View::MAX_REVEALED		= PARAMETER_VIEW_MAX_REVEALED;
+
 /*==============================================================================
 	Constructors
 */
@@ -288,6 +295,87 @@ return parameter_list;
 }
 
 
+void
+Parameter_Tree_View::highlight
+	(
+	const Parameter_List&	parameters,
+	bool					reveal
+	)
+{
+Parameter_Tree_Model*
+	tree_model = static_cast<Parameter_Tree_Model*>(model ());
+if (! tree_model)
+	return;
+tree_model->highlight (parameters);
+if (! reveal)
+	return;
+
+QSet<Aggregate*>
+	expanded;
+for (int
+		index = 0;
+		index < parameters.size () &&
+		index < MAX_REVEALED;
+		index++)
+	{
+	for (Aggregate*
+			aggregate = parameters[index]->parent ();
+			aggregate &&
+			! expanded.contains (aggregate);
+			aggregate = aggregate->parent ())
+		{
+		expanded.insert (aggregate);
+		QModelIndex
+			aggregate_index (tree_model->parameter_index (aggregate));
+		if (aggregate_index.isValid ())
+			expand (aggregate_index);
+		}
+	}
+if (! parameters.isEmpty ())
+	scrollTo (tree_model->parameter_index (parameters.first ()));
+}
+
+
+void
+Parameter_Tree_View::current_parameter
+	(
+	Parameter*	parameter
+	)
+{
+Parameter_Tree_Model*
+	tree_model = static_cast<Parameter_Tree_Model*>(model ());
+if (! tree_model ||
+	! parameter)
+	return;
+QModelIndex
+	index (tree_model->parameter_index (parameter));
+if (index.isValid ())
+	{
+	for (QModelIndex
+			parent_index = index.parent ();
+			parent_index.isValid ();
+			parent_index = parent_index.parent ())
+		expand (parent_index);
+	setCurrentIndex (index);
+	scrollTo (index);
+	}
+}
+
+
+void
+Parameter_Tree_View::rowsInserted
+	(
+	const QModelIndex&	parent,
+	int					start,
+	int					end
+	)
+{
+QTreeView::rowsInserted (parent, start, end);
+if (subtrees (parent, start, end))
+	setUniformRowHeights (false);
+}
+
+
 void
 Parameter_Tree_View::setAnimated
 	(
@@ -359,20 +447,18 @@ string
 #endif
 Parameter_Tree_Model*
 	parameter_model = static_cast<Parameter_Tree_Model*>(model ());
-QTreeView*
-	subtree = NULL;
-Value_Tree_Model*
-	array_model;
+bool
+	created = false;
 QModelIndex
 	index,
 	parent;
+#if (DEBUG_SECTION & DEBUG_ARRAY_SUBTREES)
 Parameter*
 	parameter;
+#endif
 int
 	row = 0,
-	row_count = 1,
-	//	Height of Array subtree.
-	subtree_height = (fontMetrics ().height () + 1) * 5;
+	row_count = 1;
 
 //	Walk through the tree heirarchy looking for Parameters with Arrays.
 while (true)
@@ -434,43 +520,93 @@ while (true)
 		continue;
 		}
 
-	parameter = static_cast<Parameter*>(index.internalPointer ());
-	if (parameter &&
-		parameter->is_Assignment () &&
-		parameter->value ().is_Array ())
+	if (array_subtree (index))
+		created = true;
+	++row;
+	}
+#if (DEBUG_SECTION & DEBUG_ARRAY_SUBTREES)
+clog << "<<< Parameter_Tree_View::subtrees: " << created << endl;
+#endif
+return created;
+}
+
+
+bool
+Parameter_Tree_View::subtrees
+	(
+	const QModelIndex&	parent,
+	int					start,
+	int					end
+	)
+{
+Parameter_Tree_Model*
+	parameter_model = static_cast<Parameter_Tree_Model*>(model ());
+bool
+	created = false;
+QModelIndex
+	index;
+for (int
+		row = start;
+		row <= end;
+		row++)
+	{
+	index = parameter_model->index (row, 0, parent);
+	if (parameter_model->hasChildren (index))
 		{
-		#if (DEBUG_SECTION & DEBUG_ARRAY_SUBTREES)
-		clog << "      Array" << endl;
-		#endif
-		subtree = new QTreeView (this);	//	subtree parent is this view.
-		subtree->setHeaderHidden (true);
-		subtree->setMaximumHeight (subtree_height);
-		subtree->setUniformRowHeights (true);	//	Optimization.
-		subtree->setAnimated (isAnimated ());
-		subtree->setSortingEnabled (false);
-
-		array_model = new Value_Tree_Model
-			(static_cast<Array*>(&parameter->value ()));
-		//	Ownership of the array_model is passed to the subtree.
-		array_model->setParent (subtree);
-		subtree->setModel (array_model);
-
-		//	Set subtree as widget for node.
-		index = parameter_model->index (row, 1, parent);
-		#if (DEBUG_SECTION & DEBUG_ARRAY_SUBTREES)
-		clog << "      subtree @ " << (void*)subtree << endl
-			 << "      array_model @ " << (void*)array_model << endl
-			 << "      setIndexWidget " << index << endl;
-		#endif
-		//	Ownership of the subtree is passed to the view.
-		setIndexWidget (index, subtree);
+		if (subtrees (index, 0, parameter_model->rowCount (index) - 1))
+			created = true;
 		}
-	++row;
+	else
+	if (array_subtree (index))
+		created = true;
 	}
+return created;
+}
+
+
+bool
+Parameter_Tree_View::array_subtree
+	(
+	const QModelIndex&	index
+	)
+{
+Parameter*
+	parameter = static_cast<Parameter*>(index.internalPointer ());
+if (! parameter ||
+	! parameter->is_Assignment () ||
+	! parameter->value ().is_Array ())
+	return false;
+
+#if (DEBUG_SECTION & DEBUG_ARRAY_SUBTREES)
+clog << "      Array" << endl;
+#endif
+QTreeView
+	*subtree = new QTreeView (this);	//	subtree parent is this view.
+subtree->setHeaderHidden (true);
+//	Height of Array subtree.
+subtree->setMaximumHeight ((fontMetrics ().height () + 1) * 5);
+subtree->setUniformRowHeights (true);	//	Optimization.
+subtree->setAnimated (isAnimated ());
+subtree->setSortingEnabled (false);
+
+Value_Tree_Model
+	*array_model = new Value_Tree_Model
+		(static_cast<Array*>(&parameter->value ()));
+//	Ownership of the array_model is passed to the subtree.
+array_model->setParent (subtree);
+subtree->setModel (array_model);
+
+//	Set subtree as widget for node.
+QModelIndex
+	value_index = index.sibling (index.row (), 1);
 #if (DEBUG_SECTION & DEBUG_ARRAY_SUBTREES)
-clog << "<<< Parameter_Tree_View::subtrees: " << (subtree != NULL) << endl;
+clog << "      subtree @ " << (void*)subtree << endl
+	 << "      array_model @ " << (void*)array_model << endl
+	 << "      setIndexWidget " << value_index << endl;
 #endif
-return subtree;
+//	Ownership of the subtree is passed to the view.
+setIndexWidget (value_index, subtree);
+return true;
 }
 
 
@@ -75,6 +75,10 @@ static const char* const
 static const bool
 	DEFAULT_ANIMATION;
 
+//!	Maximum number of highlighted parameters that are revealed.
+static const int
+	MAX_REVEALED;
+
 /*==============================================================================
 	Constructors
 */
@@ -185,6 +189,30 @@ QString comments (const QModelIndex& index) const;
 */
 Parameter_List selected_parameters () const;
 
+/**	Highlight and reveal {@link parameters() parameters}.
+
+	The Parameters are {@link Parameter_Tree_Model::highlight(const
+	QList<idaeim::PVL::Parameter*>&) highlighted} in the model. When
+	revealed, the Aggregates that contain the first MAX_REVEALED
+	Parameters are expanded and the view is scrolled to the first
+	Parameter. The selection is not changed.
+
+	@param	parameters	A list of Parameters to be highlighted. If empty
+		any highlighting is removed.
+	@param	reveal	If true the highlighted Parameters are revealed;
+		otherwise the expansion of the tree is not changed.
+*/
+void highlight (const Parameter_List& parameters, bool reveal = true);
+
+/**	Make a Parameter the current item.
+
+	The Parameter is revealed, scrolled to and selected.
+
+	@param	parameter	A pointer to a Parameter in the {@link
+		parameters() parameters}. If NULL nothing is done.
+*/
+void current_parameter (idaeim::PVL::Parameter* parameter);
+
 /*------------------------------------------------------------------------------
 	Reimplemented methods
 */
@@ -210,6 +238,18 @@ virtual void setModel (QAbstractItemModel* model);
 */
 void setAnimated (bool enable);
 
+protected:
+
+/**	Handles rows inserted into the model.
+
+	Array subtrees are provided for the Parameters that were inserted.
+
+	@param	parent	The QModelIndex of the parent of the inserted rows.
+	@param	start	The first row inserted.
+	@param	end		The last row inserted.
+*/
+virtual void rowsInserted (const QModelIndex& parent, int start, int end);
+
 /*==============================================================================
 	Helpers
 */
@@ -229,6 +269,28 @@ void initialize ();
 */
 bool subtrees ();
 
+/**	Provide Array subtrees for rows of the model.
+
+	The rows, and all their descendants, are searched for Assignment
+	Parameters with Array Values for which an Array subtree is provided.
+
+	@param	parent	The QModelIndex of the parent of the rows.
+	@param	start	The first row.
+	@param	end		The last row.
+	@return	true if at least one array subtree was created; false
+		otherwise.
+	@see	subtrees()
+*/
+bool subtrees (const QModelIndex& parent, int start, int end);
+
+/**	Provide an Array subtree for a Parameter.
+
+	@param	index	The QModelIndex of the Parameter in the name column.
+	@return	true if the Parameter has an Array Value for which a subtree
+		was created; false otherwise.
+*/
+bool array_subtree (const QModelIndex& index);
+
 /*==============================================================================
 	Data
 */
@@ -0,0 +1,671 @@
+/*	Planar_Image
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#include	"Planar_Image.hh"
+
+#include	<QImage>
+#include	<QImageReader>
+#include	<QMutexLocker>
+#include	<QtGlobal>
+
+#include	<string>
+using std::string;
+#include	<sstream>
+using std::ostringstream;
+#include	<iomanip>
+using std::endl;
+#include	<stdexcept>
+using std::invalid_argument;
+using std::runtime_error;
+
+
+#if defined (DEBUG_SECTION)
+/*	DEBUG_SECTION controls
+
+	DEBUG_SECTION report selection options.
+	Define any of the following options to obtain the desired debug reports:
+*/
+#define DEBUG_OFF			0
+#define DEBUG_ALL			-1
+#define DEBUG_CONSTRUCTORS	(1 << 0)
+#define DEBUG_LOAD			(1 << 1)
+#define DEBUG_HISTOGRAMS	(1 << 2)
+#define DEBUG_PIXEL_DATA	(1 << 6)
+
+#define DEBUG_DEFAULT		(DEBUG_ALL & ~DEBUG_PIXEL_DATA)
+
+#if (DEBUG_SECTION +0) == 0
+#undef  DEBUG_SECTION
+#define DEBUG_SECTION DEBUG_OFF
+#endif
+
+#include	<iostream>
+using std::clog;
+#endif	//	DEBUG_SECTION
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/*==============================================================================
+	Constants
+*/
+const char* const
+	Planar_Image::ID =
+		"UA::HiRISE::Planar_Image ($Revision: 1.1 $ $Date: 2026/10/17 00:00:00 $)";
+
+#ifndef PLANAR_IMAGE_ALIGNMENT
+#define PLANAR_IMAGE_ALIGNMENT		64
+#endif
+const int
+	Planar_Image::PLANE_ALIGNMENT	= PLANAR_IMAGE_ALIGNMENT;
+
+namespace
+{
+/*	The number of image bands for a high precision image format.
+
+	Zero is returned for any other image format.
+*/
+unsigned int
+high_precision_bands
+	(
+	QImage::Format	format
+	)
+{
+switch (format)
+	{
+	#if QT_VERSION >= 0x50C00
+	case QImage::Format_RGBX64:
+	case QImage::Format_RGBA64:
+	case QImage::Format_RGBA64_Premultiplied:
+		return 3;
+	#endif
+	#if QT_VERSION >= 0x50D00
+	case QImage::Format_Grayscale16:
+		return 1;
+	#endif
+	#if QT_VERSION >= 0x60200
+	case QImage::Format_RGBX16FPx4:
+	case QImage::Format_RGBA16FPx4:
+	case QImage::Format_RGBA16FPx4_Premultiplied:
+	case QImage::Format_RGBX32FPx4:
+	case QImage::Format_RGBA32FPx4:
+	case QImage::Format_RGBA32FPx4_Premultiplied:
+		return 3;
+	#endif
+	default:
+		return 0;
+	}
+}
+
+/*	Rescale a floating point component to the 16-bit range.
+
+	NaN and -Inf map to 0, +Inf maps to 65535; finite values outside
+	the minimum to maximum range of the finite values are clamped.
+*/
+inline quint16
+rescaled
+	(
+	float	value,
+	float	minimum,
+	float	scale
+	)
+{
+if (! qIsFinite (value))
+	return (value > 0.0f) ? 65535 : 0;
+value = (value - minimum) * scale + 0.5f;
+if (value <= 0.0f)
+	return 0;
+if (value >= 65535.0f)
+	return 65535;
+return static_cast<quint16>(value);
+}
+
+}	//	local namespace
+
+/*==============================================================================
+	Band_Planes
+*/
+Planar_Image::Band_Planes::Band_Planes
+	(
+	const QSize&	size,
+	unsigned int	bands
+	)
+	:	Size (size),
+		Bands (bands),
+		Line_Stride (0)
+{
+Planes[0] =
+Planes[1] =
+Planes[2] = NULL;
+
+//	Line stride rounded up to a whole number of alignment units.
+const int
+	alignment_samples = PLANE_ALIGNMENT / sizeof (quint16);
+Line_Stride = ((Size.width () + alignment_samples - 1) / alignment_samples)
+	* alignment_samples;
+size_t
+	plane_bytes = (size_t)Line_Stride * Size.height () * sizeof (quint16);
+for (unsigned int
+		band = 0;
+		band < Bands;
+		band++)
+	{
+	if (! (Planes[band] = static_cast<quint16*>
+			(qMallocAligned (plane_bytes, PLANE_ALIGNMENT))))
+		{
+		while (band--)
+			qFreeAligned (Planes[band]);
+		Planes[0] = NULL;
+		ostringstream
+			message;
+		message
+			<< Planar_Image::ID << endl
+			<< "Unable to allocate " << Bands << " band planes of "
+				<< plane_bytes << " bytes.";
+		throw runtime_error (message.str ());
+		}
+	}
+}
+
+
+Planar_Image::Band_Planes::~Band_Planes ()
+{
+for (unsigned int
+		band = 0;
+		band < Bands;
+		band++)
+	qFreeAligned (Planes[band]);
+}
+
+
+Planar_Image::Band_Planes*
+Planar_Image::Band_Planes::load
+	(
+	const QString&	pathname
+	)
+{
+#if ((DEBUG_SECTION) & DEBUG_LOAD)
+clog << ">>> Planar_Image::Band_Planes::load: "
+		<< pathname.toStdString () << endl;
+#endif
+QImageReader
+	reader (pathname);
+QImage
+	image (reader.read ());
+if (image.isNull ())
+	{
+	ostringstream
+		message;
+	message
+		<< Planar_Image::ID << endl
+		<< "Unable to read the image file " << pathname.toStdString () << endl
+		<< reader.errorString ().toStdString ();
+	throw runtime_error (message.str ());
+	}
+unsigned int
+	bands = high_precision_bands (image.format ());
+if (! bands)
+	{
+	ostringstream
+		message;
+	message
+		<< Planar_Image::ID << endl
+		<< "The image of " << pathname.toStdString ()
+			<< " does not have more than 8 bits per component.";
+	throw invalid_argument (message.str ());
+	}
+#if ((DEBUG_SECTION) & DEBUG_LOAD)
+clog << "    " << image.width () << "w, " << image.height () << "h, "
+		<< bands << "b, format " << image.format () << endl;
+#endif
+
+Band_Planes
+	*planes = new Band_Planes (image.size (), bands);
+const int
+	width  = image.width (),
+	height = image.height ();
+int
+	line,
+	sample;
+quint16
+	*red,
+	*green,
+	*blue;
+
+#if QT_VERSION >= 0x60200
+if (bands == 3 &&
+	image.format () != QImage::Format_RGBX64 &&
+	image.format () != QImage::Format_RGBA64 &&
+	image.format () != QImage::Format_RGBA64_Premultiplied)
+	{
+	//	Floating point components are rescaled to the 16-bit range.
+	if (image.format () != QImage::Format_RGBA32FPx4)
+		image = image.convertToFormat (QImage::Format_RGBA32FPx4);
+	const float
+		*pixels;
+	float
+		minimum = 0.0,
+		maximum = 0.0;
+	bool
+		first = true;
+	for (line = 0;
+		 line < height;
+		 line++)
+		{
+		pixels = reinterpret_cast<const float*>(image.constScanLine (line));
+		for (sample = 0;
+			 sample < width * 4;
+			 sample++)
+			{
+			if ((sample & 3) == 3 ||
+				! qIsFinite (pixels[sample]))	//	NaN or Inf.
+				continue;
+			if (first)
+				{
+				minimum = maximum = pixels[sample];
+				first = false;
+				}
+			else
+			if (pixels[sample] < minimum)
+				minimum = pixels[sample];
+			else
+			if (pixels[sample] > maximum)
+				maximum = pixels[sample];
+			}
+		}
+	const float
+		scale = (maximum > minimum) ? (65535.0f / (maximum - minimum)) : 0.0f;
+	#if ((DEBUG_SECTION) & DEBUG_LOAD)
+	clog << "    rescaled " << minimum << " - " << maximum << endl;
+	#endif
+	for (line = 0;
+		 line < height;
+		 line++)
+		{
+		pixels = reinterpret_cast<const float*>(image.constScanLine (line));
+		red   = planes->plane_line (line, 0);
+		green = planes->plane_line (line, 1);
+		blue  = planes->plane_line (line, 2);
+		for (sample = 0;
+			 sample < width;
+			 sample++,
+			 pixels += 4)
+			{
+			red[sample]   = rescaled (pixels[0], minimum, scale);
+			green[sample] = rescaled (pixels[1], minimum, scale);
+			blue[sample]  = rescaled (pixels[2], minimum, scale);
+			}
+		}
+	}
+else
+#endif
+#if QT_VERSION >= 0x50D00
+if (bands == 1)
+	{
+	const quint16
+		*pixels;
+	for (line = 0;
+		 line < height;
+		 line++)
+		{
+		pixels = reinterpret_cast<const quint16*>(image.constScanLine (line));
+		red = planes->plane_line (line, 0);
+		for (sample = 0;
+			 sample < width;
+			 sample++)
+			red[sample] = pixels[sample];
+		}
+	}
+else
+#endif
+	{
+	#if QT_VERSION >= 0x50C00
+	if (image.format () == QImage::Format_RGBA64_Premultiplied)
+		image = image.convertToFormat (QImage::Format_RGBA64);
+	const QRgba64
+		*pixels;
+	for (line = 0;
+		 line < height;
+		 line++)
+		{
+		pixels = reinterpret_cast<const QRgba64*>(image.constScanLine (line));
+		red   = planes->plane_line (line, 0);
+		green = planes->plane_line (line, 1);
+		blue  = planes->plane_line (line, 2);
+		for (sample = 0;
+			 sample < width;
+			 sample++)
+			{
+			red[sample]   = pixels[sample].red ();
+			green[sample] = pixels[sample].green ();
+			blue[sample]  = pixels[sample].blue ();
+			}
+		}
+	#endif
+	}
+#if ((DEBUG_SECTION) & DEBUG_LOAD)
+clog << "<<< Planar_Image::Band_Planes::load: line stride "
+		<< planes->Line_Stride << endl;
+#endif
+return planes;
+}
+
+/*==============================================================================
+	Constructors
+*/
+Planar_Image::Planar_Image
+	(
+	Band_Planes*		source,
+	const QSize&		size,
+	const unsigned int*	band_map,
+	const QTransform**	transforms,
+	const Data_Map**	data_maps
+	)
+	:
+	Plastic_Image (! size.isEmpty () ? size
+		: (source ? source->size () : size),
+		band_map, transforms, data_maps),
+	Source (source)
+{
+#if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
+clog << ">>> Planar_Image @ " << (void*)this
+		<< ": From Band_Planes @ " << (void*)source << endl;
+#endif
+initialize ();
+#if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
+clog << "<<< Planar_Image" << endl;
+#endif
+}
+
+
+Planar_Image::Planar_Image
+	(
+	const Planar_Image&	image,
+	const QSize&		size,
+	Mapping_Type		shared_mappings
+	)
+	:
+	Plastic_Image (size.isValid () ? size : image.size (),
+		(shared_mappings & BAND_MAP)   ?
+			image.source_band_map () : NULL,
+		(shared_mappings & TRANSFORMS) ?
+			const_cast<const QTransform**>(image.source_transforms ()) : NULL,
+		(shared_mappings & DATA_MAPS)  ?
+			const_cast<const Data_Map**>(image.source_data_maps ()) : NULL),
+	Source (image.Source)
+{
+#if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
+clog << ">>> Planar_Image @ " << (void*)this
+		<< ": Copy @ " << (void*)(&image) << endl
+	 << "    shared Band_Planes @ " << (void*)Source.data () << endl;
+#endif
+Auto_Update = image.Auto_Update;
+bool
+	do_update = auto_update (false);
+
+initialize ();
+
+source_name (image.source_name ());
+
+if (! (shared_mappings & BAND_MAP))
+	source_band_map (image.source_band_map ());
+if (! (shared_mappings & TRANSFORMS))
+	source_transforms
+		(const_cast<const QTransform**>(image.source_transforms ()));
+if (! (shared_mappings & DATA_MAPS))
+	source_data_maps
+		(const_cast<const Data_Map**>(image.source_data_maps ()));
+
+background_color (image.background_color ());
+
+if ((Auto_Update = do_update))
+	update ();
+else
+	fill (background_color ());
+#if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
+clog << "<<< Planar_Image" << endl;
+#endif
+}
+
+
+Planar_Image::~Planar_Image ()
+{
+#if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
+clog << ">-< ~Planar_Image @ " << (void*)this << endl;
+#endif
+}
+
+/*==============================================================================
+	Accessors
+*/
+Planar_Image*
+Planar_Image::clone
+	(
+	const QSize&	size,
+	Mapping_Type	shared_mappings
+	) const
+{return new Planar_Image (*this, size, shared_mappings);}
+
+
+const void*
+Planar_Image::source () const
+{return Source.data ();}
+
+
+QSize
+Planar_Image::source_size () const
+{return Source ? Source->size () : QSize (0, 0);}
+
+
+unsigned int
+Planar_Image::source_bands () const
+{return Source ? Source->bands () : 0;}
+
+
+unsigned int
+Planar_Image::source_precision_bits () const
+{return Source ? 16 : 0;}
+
+
+Plastic_Image::Pixel_Datum
+Planar_Image::source_pixel_value
+	(
+	unsigned int	x,
+	unsigned int	y,
+	unsigned int	band
+	)
+	const
+{
+Pixel_Datum
+	value;
+if (Source &&
+	x < static_cast<unsigned int>(Source->size ().width ()) &&
+	y < static_cast<unsigned int>(Source->size ().height ()) &&
+	band < Source->bands ())
+	value = Source->line_data (y, band)[x];
+else
+	value = UNDEFINED_PIXEL_VALUE;
+#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
+clog << ">-< Planar_Image::source_pixel_value: "
+		<< x << "x, " << y << "y, " << band << "b = " << value << endl;
+#endif
+return value;
+}
+
+
+void
+Planar_Image::source_line_values
+	(
+	Pixel_Datum*	values,
+	const int*		samples,
+	unsigned int	count,
+	int				line,
+	unsigned int	band
+	)
+	const
+{
+#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
+clog << ">-< Planar_Image::source_line_values: "
+		<< count << " samples, " << line << "y, " << band << 'b' << endl;
+#endif
+unsigned int
+	index,
+	sample;
+if (! Source ||
+	line < 0 ||
+	line >= Source->size ().height () ||
+	band >= Source->bands ())
+	{
+	for (index = 0;
+		 index < count;
+		 index++)
+		values[index] = UNDEFINED_PIXEL_VALUE;
+	return;
+	}
+
+const unsigned int
+	source_width = static_cast<unsigned int>(Source->size ().width ());
+const quint16
+	*source_data = Source->line_data (line, band);
+for (index = 0;
+	 index < count;
+	 index++)
+	{
+	sample = static_cast<unsigned int>(samples[index]);
+	values[index] = (sample < source_width) ?
+		source_data[sample] : UNDEFINED_PIXEL_VALUE;
+	}
+}
+
+
+unsigned long long
+Planar_Image::source_histograms
+	(
+	QVector<Histogram*>	histograms,
+	const QRect&		source_region
+	) const
+{
+if (! Source)
+	return Plastic_Image::source_histograms (histograms, source_region);
+
+#if ((DEBUG_SECTION) & DEBUG_HISTOGRAMS)
+clog << ">>> Planar_Image::source_histograms:" << endl
+	 << "    source_region = " << source_region << endl;
+#endif
+if (histograms.size () < 3)
+	histograms.resize (3);
+
+QMutexLocker
+	object_lock (&Object_Lock);
+QRect
+	selected_region (image_region () & source_region);
+if (source_region.isEmpty () ||
+	selected_region.isEmpty ())
+	{
+	#if ((DEBUG_SECTION) & DEBUG_HISTOGRAMS)
+	clog << "<<< Planar_Image::source_histograms: 0" << endl;
+	#endif
+	return 0;
+	}
+selected_region &= QRect (QPoint (0, 0), Source->size ());
+
+const unsigned int
+	*band_map = source_band_map ();
+quint64
+	*counts;
+const quint16
+	*source_data,
+	*end_data;
+int
+	band,
+	bands = 0,
+	line,
+	end_line = selected_region.top () + selected_region.height ();
+bool
+	duplicate[3];
+for (band = 0;
+	 band < 3;
+	 band++)
+	{
+	//	Display bands with the same source band are refreshed after the scan.
+	int
+		other_band = band;
+	while (other_band--)
+		if (band_map[band] == band_map[other_band])
+			break;
+	if ((duplicate[band] = (other_band >= 0)) ||
+		! refresh_source_histogram (histograms, band) ||
+		band_map[band] >= Source->bands ())
+		continue;
+	++bands;
+
+	//	Sequential scan of the band plane lines.
+	counts = histograms[band]->data ();
+	for (line = selected_region.top ();
+		 line < end_line;
+		 line++)
+		{
+		source_data = Source->line_data (line, band_map[band])
+			+ selected_region.left ();
+		end_data = source_data + selected_region.width ();
+		while (source_data < end_data)
+			counts[*source_data++]++;
+		}
+	}
+
+for (band = 1;
+	 band < 3;
+	 band++)
+	if (duplicate[band])
+		refresh_source_histogram (histograms, band);
+
+unsigned long long
+	max_count = bands ?
+		(unsigned long long)selected_region.width ()
+			* selected_region.height () : 0;
+#if ((DEBUG_SECTION) & DEBUG_HISTOGRAMS)
+clog << "<<< Planar_Image::source_histograms: " << max_count << endl;
+#endif
+return max_count;
+}
+
+/*==============================================================================
+	Utilities
+*/
+bool
+Planar_Image::is_planar_image_file
+	(
+	const QString&	pathname
+	)
+{
+QImageReader
+	reader (pathname);
+return reader.canRead () &&
+	high_precision_bands (reader.imageFormat ()) != 0;
+}
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
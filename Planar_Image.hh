@@ -0,0 +1,294 @@
+/*	Planar_Image
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#ifndef HiView_Planar_Image_hh
+#define HiView_Planar_Image_hh
+
+#include	"Plastic_Image.hh"
+
+#include	<QString>
+#include	<QSize>
+#include	<QSharedPointer>
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/**	A <i>Planar_Image</i> is a Plastic_Image with a source image of
+	16-bit pixel samples held in separate band planes.
+
+	The source image is any image file that Qt decodes to a high
+	precision format: 16-bit grayscale, 16-bit per component RGB(A) or -
+	with Qt 6 - floating point RGB(A). Unlike a Plastic_QImage, the pixel
+	data is not reduced to 8 bits: each band is held as a plane of 16-bit
+	samples so the full source precision is available to the image data
+	maps and histograms. Floating point components are linearly rescaled
+	from the range of component values in the image to the full 16-bit
+	range. Alpha components are dropped.
+
+	Each band plane is a single buffer aligned to a cache line boundary,
+	with each line padded to a whole number of cache lines. The decoded
+	interleaved image is released as soon as the band planes have been
+	filled. The band planes are shared by all clones of a Planar_Image.
+
+	@version	$Revision: 1.1 $
+*/
+class Planar_Image
+:	public Plastic_Image
+{
+public:
+/*==============================================================================
+	Constants
+*/
+//!	Class identification name with source code version and date.
+static const char* const
+	ID;
+
+//!	Band plane buffer and line alignment in bytes.
+static const int
+	PLANE_ALIGNMENT;
+
+/*==============================================================================
+	Types
+*/
+/**	<i>Band_Planes</i> hold the 16-bit pixel samples of an image.
+*/
+class Band_Planes
+{
+public:
+/**	Load an image file into Band_Planes.
+
+	@param	pathname	The pathname to the image file.
+	@return	A pointer to Band_Planes. Ownership is transferred to the
+		caller.
+	@throws	std::invalid_argument	If the image is not decoded to a high
+		precision format.
+	@throws	std::runtime_error	If the image can not be read or the
+		band planes can not be allocated.
+*/
+static Band_Planes* load (const QString& pathname);
+
+~Band_Planes ();
+
+//!	Image size in pixels.
+inline QSize size () const
+	{return Size;}
+
+//!	Number of image bands; 1 or 3.
+inline unsigned int bands () const
+	{return Bands;}
+
+/**	Get the number of samples from the beginning of one plane line to
+	the next.
+
+	@return	The plane line stride in samples.
+*/
+inline int line_stride () const
+	{return Line_Stride;}
+
+/**	Get a pointer to the first sample of a band plane line.
+
+	@param	line	The image line number.
+	@param	band	The image band number.
+	@return	A pointer to the line samples. The line and band must be
+		within the image bounds.
+*/
+inline const quint16* line_data (int line, unsigned int band) const
+	{return Planes[band] + (qint64)line * Line_Stride;}
+
+private:
+
+Band_Planes (const QSize& size, unsigned int bands);
+
+//	Not copyable.
+Band_Planes (const Band_Planes&);
+Band_Planes& operator= (const Band_Planes&);
+
+inline quint16* plane_line (int line, unsigned int band)
+	{return Planes[band] + (qint64)line * Line_Stride;}
+
+QSize
+	Size;
+unsigned int
+	Bands;
+int
+	Line_Stride;
+quint16
+	*Planes[3];
+};
+
+typedef QSharedPointer<Band_Planes>	Shared_Band_Planes;
+
+/*==============================================================================
+	Constructors
+*/
+/**	Construct a Planar_Image on Band_Planes.
+
+	<b>N.B.</b>: Ownership of the Band_Planes is transferred to the
+	Planar_Image; i.e. the Band_Planes must have been constructed on the
+	heap.
+
+	@param	source	A pointer to Band_Planes that will provide the
+		source image for this Plastic_Image.
+	@param	size	The size of the new Planar_Image. If the size is not
+		valid the size of the source image will be used.
+	@param	band_map	A pointer to unsigned int array of three values
+		that will be used as the shared band map for this
+		Plastic_Image. If NULL band map sharing is not enabled and a
+		default band map will be provided.
+	@param	transforms	An array of QTransform pointers, one for each
+		band of the image, that will be used as the shared geometric
+		transforms for this Plastic_Image. If NULL geometric transforms
+		sharing is not enabled and default identity transforms will be
+		provided.
+	@param	data_maps	An array of data map arrays, one for each band
+		of the image, that will be used as the shared data maps for this
+		Plastic_Image. If NULL data map sharing is not enabled and
+		default identity data maps will be provided.
+*/
+explicit Planar_Image (Band_Planes* source,
+	const QSize&		size = QSize (),
+	const unsigned int*	band_map = NULL,
+	const QTransform**	transforms = NULL,
+	const Data_Map**	data_maps = NULL);
+
+/**	Copy a Planar_Image.
+
+	The source {@link source() band planes} are shared, not copied. The
+	image {@link source_transforms() geometric transforms}, {@link
+	source_band_map() band map} and {@link source_data_maps() data maps}
+	are copied unless the corresponding shared mappings flag inidicates
+	they are to be shared with the image being copied. The {@link
+	background_color() background color} is also copied.
+
+	@param	image	The Planar_Image to be copied.
+	@param	size	The size of the new Planar_Image. If the size is not
+		valid the size of the Planar_Image being copied (not its source
+		image) will be used.
+	@param	shared_mappings	A Mapping_Type that specifies any combination
+		of {@link #BAND_MAP}, {@link #TRANSFORMS} or {@link #DATA_MAPS} -
+		or {@link #NO_MAPPINGS} - data mappings that are to be shared with
+		the Planar_Image being copied.
+*/
+explicit Planar_Image (const Planar_Image& image,
+	const QSize&	size = QSize (),
+	Mapping_Type	shared_mappings = NO_MAPPINGS);
+
+virtual ~Planar_Image ();
+
+/*==============================================================================
+	Accessors
+*/
+/**	Clone this Planar_Image.
+
+	@param	size	The size of the new Planar_Image. If the size is not
+		valid the size of this Planar_Image (not its source image) will
+		be used.
+	@param	shared_mappings	A Mapping_Type that specifies any combination
+		of {@link #BAND_MAP}, {@link #TRANSFORMS} or {@link #DATA_MAPS} -
+		or {@link #NO_MAPPINGS} - data mappings that are to be shared with
+		this Planar_Image.
+	@return	A pointer to a Planar_Image.
+	@see	Planar_Image(const Planar_Image&, const QSize&, Mapping_Type)
+*/
+virtual Planar_Image* clone (const QSize& size = QSize (),
+	Mapping_Type shared_mappings = NO_MAPPINGS) const;
+
+/**	Get the image source.
+
+	@return	A pointer to the Band_Planes.
+*/
+virtual const void* source () const;
+
+virtual QSize source_size () const;
+
+virtual unsigned int source_bands () const;
+
+virtual unsigned int source_precision_bits () const;
+
+virtual Pixel_Datum source_pixel_value
+	(unsigned int x, unsigned int y, unsigned int band) const;
+
+/**	Get source image pixel data values from a single source image line.
+
+	The pixel values are obtained directly from the source band plane
+	line data.
+
+	@param	values	A pointer to a Pixel_Datum array that will receive
+		the source data values.
+	@param	samples	A pointer to an array of count source image sample
+		locations.
+	@param	count	The number of sample locations.
+	@param	line	The source image line location.
+	@param	band	The source image band.
+	@see	Plastic_Image::source_line_values(Pixel_Datum*, const int*,
+		unsigned int, int, unsigned int)
+*/
+virtual void source_line_values (Pixel_Datum* values,
+	const int* samples, unsigned int count, int line, unsigned int band) const;
+
+/**	Produce histograms of source image data.
+
+	Each distinct source band is accumulated from a sequential scan of
+	its band plane lines.
+
+	@param	histograms	A vector of three Histogram data vector pointers.
+	@param	source_region	A QRect specifying the region of the source
+		image to be scanned.
+	@return	The maximum number of pixels sampled for each histogram.
+		This will be zero if no histogramming was done.
+	@see	Plastic_Image::source_histograms(QVector<Histogram*>,
+		const QRect&)
+*/
+virtual unsigned long long source_histograms (QVector<Histogram*> histograms,
+	const QRect& source_region) const;
+
+/*==============================================================================
+	Utilities
+*/
+/**	Test if a file contains an image that Qt decodes to a high precision
+	format.
+
+	Only the image header is examined; the image is not decoded.
+
+	@param	pathname	The pathname to a file.
+	@return	true if the file image format has more than 8 bits per
+		component; false otherwise.
+*/
+static bool is_planar_image_file (const QString& pathname);
+
+/*==============================================================================
+	Data
+*/
+protected:
+
+Shared_Band_Planes
+	Source;
+
+};	//	Class Planar_Image
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
+#endif
@@ -24,6 +24,10 @@ Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
 #include	"Plastic_Image.hh"
 
 #include	"HiView_Utilities.hh"
+#include	"Data_Map_Kernels.hh"
+#include	"Box_Filter.hh"
+#include	"Index_Table_Cache.hh"
+#include	"Tile_Memory_Arena.hh"
 
 #include	<QString>
 #include	<QSize>
@@ -52,6 +56,7 @@ using idaeim::PVL::Integer;
 using idaeim::PVL::String;
 
 #include	<cmath>
+#include	<cstring>
 #include	<iostream>
 using std::clog;
 #include	<sstream>
@@ -271,6 +276,66 @@ unsigned int
 	Plastic_Image::Default_Rendering_Increment_Lines
 		= DEFAULT_RENDERING_INCREMENT_LINES;
 
+#ifndef DEFAULT_BOX_FILTER_RENDERING
+#define DEFAULT_BOX_FILTER_RENDERING	true
+#endif
+bool
+	Plastic_Image::Box_Filter_Rendering	= DEFAULT_BOX_FILTER_RENDERING;
+
+/*==============================================================================
+	Local
+*/
+namespace
+{
+/*	Provide the pixel storage for a new image.
+
+	Tile sized images are served by the Tile_Memory_Arena and use its
+	storage, which is returned to the arena when the last QImage sharing
+	it is destroyed. Other images use the usual QImage storage.
+*/
+QImage
+image_storage
+	(
+	const QSize&	size
+	)
+{
+QSize
+	image_size (size.isValid () ? size : QSize (0, 0));
+#if QT_VERSION >= 0x50000
+if (! image_size.isEmpty ())
+	{
+	//	The IMAGE_FORMAT is 32-bit, so lines are always aligned.
+	int
+		bytes_per_line = image_size.width () * (int)sizeof (QRgb);
+	std::size_t
+		bytes = (std::size_t)bytes_per_line * image_size.height ();
+	if (Tile_Memory_Arena::serves (bytes))
+		{
+		uchar
+			*storage = static_cast<uchar*>(Tile_Memory_Arena::allocate (bytes));
+		if (! storage)
+			{
+			ostringstream
+				message;
+			message
+				<< Plastic_Image::ID << endl
+				<< "Unable to obtain a " << image_size.width () << 'x'
+					<< image_size.height () << " pixel data buffer" << endl
+				<< "within the " << Tile_Memory_Arena::max_bytes ()
+					<< " byte tile memory limit.";
+			throw runtime_error (message.str ());
+			}
+		return QImage (storage,
+			image_size.width (), image_size.height (), bytes_per_line,
+			Plastic_Image::IMAGE_FORMAT,
+			Tile_Memory_Arena::release, storage);
+		}
+	}
+#endif
+return QImage (image_size, Plastic_Image::IMAGE_FORMAT);
+}
+}
+
 /*==============================================================================
 	Constructors
 */
@@ -281,8 +346,7 @@ Plastic_Image::Plastic_Image
 	const QTransform**	transforms,
 	const Data_Map**	data_maps
 	)
-	:	QImage ((image_size.isValid () ?
-			image_size : QSize (0, 0)), IMAGE_FORMAT),
+	:	QImage (image_storage (image_size)),
 		Object_Lock (QMutex::Recursive),
 		Metadata (NULL),
 		Image_Metadata (NULL),
@@ -668,6 +732,47 @@ return Triplet
 	 source_pixel_value (x, y, 2));
 }
 
+
+void
+Plastic_Image::source_line_values
+	(
+	Pixel_Datum*	values,
+	const int*		samples,
+	unsigned int	count,
+	int				line,
+	unsigned int	band
+	) const
+{
+for (unsigned int
+		index = 0;
+		index < count;
+	  ++index)
+	values[index] = source_pixel_value
+		(static_cast<unsigned int>(samples[index]),
+		 static_cast<unsigned int>(line), band);
+}
+
+
+unsigned int
+Plastic_Image::source_resolution_level
+	(
+	double
+	) const
+{return 1;}
+
+
+void
+Plastic_Image::source_level_line_values
+	(
+	Pixel_Datum*	values,
+	const int*		samples,
+	unsigned int	count,
+	int				line,
+	unsigned int	band,
+	unsigned int
+	) const
+{source_line_values (values, samples, count, line, band);}
+
 /*------------------------------------------------------------------------------
 	Source band by display band mapping
 */
@@ -2202,10 +2307,11 @@ selected_region &= source_region;
 clog << "    selected image region = " << selected_region << endl;
 #endif
 
-Histogram
-	*histogram;
+quint64
+	*counts;
 Pixel_Datum
-	pixel_value;
+	pixel_value,
+	max_value;
 unsigned long long
 	count,
 	max_count = 0;
@@ -2213,16 +2319,27 @@ int
 	start_line = selected_region.top () - 1,
 	line = 0,
 	end_line = start_line + selected_region.height () + 1,
-	start_sample = selected_region.left () - 1,
-	sample = 0,
-	end_sample = start_sample + selected_region.width () + 1,
+	samples = selected_region.width (),
+	sample,
 	source_band;
 #if ((DEBUG_SECTION) & (DEBUG_HISTOGRAMS | DEBUG_PRINT_HISTOGRAMS))
 clog << "      first = "
-		<< (start_line + 1) << "x, " << (start_sample + 1) << 'y' << endl
+		<< (start_line + 1) << "x, " << selected_region.left () << 'y' << endl
 	 << "       last = "
-	 	<< (end_sample - 1) << "x, " << (end_line - 1) << 'y' << endl;
+	 	<< selected_region.right () << "x, " << (end_line - 1) << 'y' << endl;
 #endif
+/*	The source data is obtained a line at a time so an implementation
+	with direct access to its source data is not called for each pixel.
+*/
+QVector<int>
+	sample_locations (samples);
+for (sample = 0;
+	 sample < samples;
+	 sample++)
+	sample_locations[sample] = selected_region.left () + sample;
+QVector<Pixel_Datum>
+	line_values (samples);
+
 for (int
 		band = 0;
 		band < 3;
@@ -2230,20 +2347,23 @@ for (int
 	{
 	if (refresh_source_histogram (histograms, band))
 		{
-		histogram = histograms[band];
+		counts = histograms[band]->data ();
+		max_value = histograms[band]->size ();
 		count = 0;
 		source_band = Band_Map[band];
 		line = start_line;
 
 		while (++line < end_line)
 			{
-			sample = start_sample;
-			while (++sample < end_sample)
+			source_line_values (line_values.data (),
+				sample_locations.constData (), samples, line, source_band);
+			for (sample = 0;
+				 sample < samples;
+				 sample++)
 				{
-				pixel_value = source_pixel_value (sample, line, source_band);
-				if (pixel_value != UNDEFINED_PIXEL_VALUE)
+				if ((pixel_value = line_values[sample]) < max_value)
 					{
-					(*histogram)[pixel_value]++;
+					counts[pixel_value]++;
 					++count;
 					}
 				}
@@ -2253,7 +2373,7 @@ for (int
 			max_count = count;
 		#if ((DEBUG_SECTION) & DEBUG_PRINT_HISTOGRAMS)
 		clog << "    band " << band << " -" << endl;
-		clog << histogram;
+		clog << histograms[band];
 		#endif
 		}
 	}
@@ -2636,6 +2756,51 @@ return Needs_Update | Needs_Update_Shadow;
 }
 
 
+namespace
+{
+/*	Display to source transform mappings, in order of rendering cost.
+
+	The rendering loop for each display band is selected by its
+	mapping when rendering starts.
+*/
+enum Transform_Mapping
+	{
+	//	Source location is the display location.
+	IDENTITY_MAPPING,
+	//	Source location is offset from the display location by whole pixels.
+	OFFSET_MAPPING,
+	//	Source sample is independent of the display line, and source line
+	//	is independent of the display sample.
+	SCALE_MAPPING,
+	//	Source location is a linear function of the display location.
+	AFFINE_MAPPING,
+	//	Anything else.
+	PROJECTIVE_MAPPING
+	};
+
+Transform_Mapping
+transform_mapping
+	(
+	const QTransform&	transform
+	)
+{
+if (transform.isIdentity ())
+	return IDENTITY_MAPPING;
+if (! transform.isAffine ())
+	return PROJECTIVE_MAPPING;
+if (transform.m12 () != 0.0 ||
+	transform.m21 () != 0.0)
+	return AFFINE_MAPPING;
+if (transform.m11 () == 1.0 &&
+	transform.m22 () == 1.0 &&
+	transform.dx () == std::floor (transform.dx ()) &&
+	transform.dy () == std::floor (transform.dy ()))
+	return OFFSET_MAPPING;
+return SCALE_MAPPING;
+}
+}
+
+
 bool
 Plastic_Image::render_image ()
 	throw (Render_Exception, std::bad_exception)
@@ -2712,21 +2877,25 @@ Update.end (Update.SEQUENCE_END);
 
 QTransform
 	transform,
-	*transforms[3] = {NULL, NULL, NULL};
+	transforms[3];
+Transform_Mapping
+	mappings[3];
 QRgb
-	pixel_value,
 	/*
 		N.B.: The image_data method returns a pointer to writable
 		(non-const) image display data. This avoids having the
 		implicitly shared image data detatched if it is currently
 		being used elsewhere.
 	*/
-	*display_data = image_data (),
-	background_value[3];
+	*display_data = image_data ();
 unsigned int
-	band_map[3];
+	band_map[3],
+	data_map_size[3],
+	resolution_levels[3];
 Data_Map
 	*data_maps[3];
+quint8
+	background_datum[3];
 int
 	band = -1;
 while (++band < 3)
@@ -2750,11 +2919,33 @@ while (++band < 3)
 		 << "    transform -" << *source_transform (band);
 	clog << "    inverted -" << transform;
 	#endif
-	if (! transform.isIdentity ())
-		transforms[band] = new QTransform (transform);
+	/*	Scaled down, unrotated bands may be rendered from a reduced
+		resolution level of the source; the source locations are
+		reduced to the level by scaling the inverse transform.
+	*/
+	resolution_levels[band] = 1;
+	if (transform.isAffine () &&
+		transform.m12 () == 0.0 &&
+		transform.m21 () == 0.0 &&
+		qAbs (transform.m11 ()) > 1.0 &&
+		qAbs (transform.m22 ()) > 1.0)
+		{
+		resolution_levels[band] = source_resolution_level
+			(1.0 / qMin (qAbs (transform.m11 ()), qAbs (transform.m22 ())));
+		if (resolution_levels[band] > 1)
+			{
+			double
+				level_scale = 1.0 / (1 << (resolution_levels[band] - 1));
+			transform *= QTransform::fromScale (level_scale, level_scale);
+			}
+		#if ((DEBUG_SECTION) & (DEBUG_MANIPULATORS | DEBUG_RENDER))
+		clog << "    resolution level " << resolution_levels[band] << endl;
+		#endif
+		}
+	transforms[band] = transform;
+	mappings[band] = transform_mapping (transform);
 	#if ((DEBUG_SECTION) & (DEBUG_MANIPULATORS | DEBUG_RENDER))
-	else
-		clog << "    set to NULL" << endl;
+	clog << "    mapping " << mappings[band] << endl;
 	#endif
 
 	//	Display-to-Source band map.
@@ -2777,16 +2968,24 @@ while (++band < 3)
 	data_maps[band] = Rendering->Data_Maps[band];
 
 	//	Background (no image) value.
-	background_value[band] =
-		Rendering->Background_Color & (0xFF << (16 - (band << 3)));
+	background_datum[band] = static_cast<quint8>
+		(Rendering->Background_Color >> (16 - (band << 3)));
 	}
 
-Pixel_Datum
-	datum,
+/*	Source values beyond the source data precision, or the data map
+	size, are rendered as background.
+*/
+unsigned int
 	max_value = source_data_map_size () - 1;
+for (band = 0;
+	 band < 3;
+	 band++)
+	{
+	data_map_size[band] = static_cast<unsigned int>(data_maps[band]->size ());
+	if (data_map_size[band] > max_value + 1)
+		data_map_size[band] = max_value + 1;
+	}
 int
-	source_line,
-	source_sample,
 	display_line = -1,
 	display_lines = height (),
 	display_sample,
@@ -2801,6 +3000,212 @@ if (rendering_increment &&
 		>= (unsigned int)display_lines))
 	rendering_increment = (unsigned int)display_lines;
 
+/*	Line rendering buffers.
+
+	Each display line is rendered band by band: The source sample
+	location for each display sample is found by a loop specialized for
+	the band's transform mapping - precomputed columns for the identity,
+	offset and scale mappings, or stepping the inverse transform along
+	the display line for other affine mappings - the source data values
+	at these locations are obtained for the entire line in a single
+	source_line_values call, and then the line of values is mapped
+	through the band's Data_Map into a line of display band values. The
+	three lines of display band values are then packed into the display
+	image line. The data map kernels use the best SIMD instruction set
+	available on the host.
+*/
+int
+	*source_samples = new int[display_samples],
+	source_lines[3];
+Pixel_Datum
+	*source_values[3];
+source_values[0] = new Pixel_Datum[display_samples * 3];
+source_values[1] = source_values[0] + display_samples;
+source_values[2] = source_values[1] + display_samples;
+quint8
+	*band_values[3];
+band_values[0] = new quint8[display_samples * 3];
+band_values[1] = band_values[0] + display_samples;
+band_values[2] = band_values[1] + display_samples;
+
+/*	Display bands that can share source values.
+
+	When a display band is mapped from the same source band, with the
+	same transform, as a previous display band the source line values
+	obtained for the previous band are reused.
+*/
+int
+	same_values_band[3];
+for (band = 0;
+	 band < 3;
+	 band++)
+	{
+	same_values_band[band] = band;
+	for (int
+			other_band = 0;
+			other_band < band;
+			other_band++)
+		{
+		if (band_map[band] == band_map[other_band] &&
+			transforms[band] == transforms[other_band])
+			{
+			same_values_band[band] = other_band;
+			break;
+			}
+		}
+	}
+
+/*	Source sample columns and lines.
+
+	For the identity, offset and scale mappings the source sample
+	location of each display sample is the same on every display line.
+	These locations are found once, for all display lines, and shared by
+	all bands with the same transform. The scaled locations are offsets
+	from the whole part of the transform origin obtained from shared
+	index tables; the same tables are used by all images rendered with
+	the same scaling, origin phase and size - the tiles of a tiled
+	display - so the scaled location mapping is only done once.
+*/
+int
+	*column_samples[3] = {NULL, NULL, NULL},
+	*column_storage = new int[display_samples * 3],
+	row_origin[3];
+Index_Table_Cache::Shared_Index_Table
+	row_table[3];
+for (band = 0;
+	 band < 3;
+	 band++)
+	{
+	if (mappings[band] > SCALE_MAPPING)
+		continue;
+	for (int
+			other_band = 0;
+			other_band < band;
+			other_band++)
+		{
+		if (column_samples[other_band] &&
+			transforms[band] == transforms[other_band])
+			{
+			column_samples[band] = column_samples[other_band];
+			break;
+			}
+		}
+	if (column_samples[band])
+		continue;
+
+	column_samples[band] = column_storage + (display_samples * band);
+	if (mappings[band] == SCALE_MAPPING)
+		{
+		double
+			origin = std::floor (transforms[band].dx ());
+		Index_Table_Cache::Shared_Index_Table
+			column_table (Index_Table_Cache::index_table
+				(transforms[band].m11 (), transforms[band].dx () - origin,
+				display_samples));
+		const int
+			*columns = column_table->constData ();
+		int
+			offset = static_cast<int>(origin);
+		for (display_sample = 0;
+			 display_sample < display_samples;
+			 display_sample++)
+			column_samples[band][display_sample] =
+				offset + columns[display_sample];
+		}
+	else
+		{
+		int
+			offset = qRound (transforms[band].dx ());
+		for (display_sample = 0;
+			 display_sample < display_samples;
+			 display_sample++)
+			column_samples[band][display_sample] = display_sample + offset;
+		}
+	}
+
+for (band = 0;
+	 band < 3;
+	 band++)
+	{
+	if (mappings[band] == OFFSET_MAPPING)
+		row_origin[band] = qRound (transforms[band].dy ());
+	if (mappings[band] != SCALE_MAPPING)
+		continue;
+	double
+		origin = std::floor (transforms[band].dy ());
+	row_origin[band] = static_cast<int>(origin);
+	row_table[band] = Index_Table_Cache::index_table
+		(transforms[band].m22 (), transforms[band].dy () - origin,
+		display_lines);
+	}
+
+/*	Box filtered bands.
+
+	A scaled down band - usually the residual scaling remaining after
+	selecting a source resolution level - is rendered with each display
+	pixel the average of the source values it covers. The horizontal
+	source sample bins are the same for every display line, so the
+	contiguous source samples covered by the line are set once. For
+	each display line the source lines it covers are obtained in
+	sequence and accumulated, then averaged into the line of values.
+*/
+Box_Filter
+	*box_filters[3] = {NULL, NULL, NULL};
+int
+	*filter_samples[3] = {NULL, NULL, NULL},
+	filter_samples_max = 0,
+	level_width[3],
+	level_height[3],
+	filter_line,
+	filter_line_end;
+Pixel_Datum
+	*filter_values = NULL;
+for (band = 0;
+	 band < 3;
+	 band++)
+	{
+	if (! Box_Filter_Rendering ||
+		same_values_band[band] != band ||
+		mappings[band] != SCALE_MAPPING ||
+		band_map[band] >= source_bands () ||
+		! Box_Filter::applicable (transforms[band]))
+		continue;
+
+	level_width[band]  = source_size ().width ();
+	level_height[band] = source_size ().height ();
+	if (resolution_levels[band] > 1)
+		{
+		int
+			level_divisor = 1 << (resolution_levels[band] - 1);
+		level_width[band]  =
+			(level_width[band]  + level_divisor - 1) / level_divisor;
+		level_height[band] =
+			(level_height[band] + level_divisor - 1) / level_divisor;
+		}
+
+	//	Source pixel centers are at the rounded source locations.
+	box_filters[band] = new Box_Filter;
+	box_filters[band]->samples (display_samples,
+		transforms[band].dx () - (transforms[band].m11 () / 2.0),
+		transforms[band].m11 (), level_width[band]);
+	filter_samples[band] = new int[box_filters[band]->width () + 1];
+	for (display_sample = 0;
+		 display_sample < box_filters[band]->width ();
+		 display_sample++)
+		filter_samples[band][display_sample] =
+			box_filters[band]->first () + display_sample;
+	if (filter_samples_max < box_filters[band]->width ())
+		filter_samples_max = box_filters[band]->width ();
+	#if ((DEBUG_SECTION) & (DEBUG_MANIPULATORS | DEBUG_RENDER))
+	clog << "    band " << band << " box filtered from source samples "
+			<< box_filters[band]->first () << '-'
+			<< (box_filters[band]->first () + box_filters[band]->width ())
+			<< " of " << level_width[band] << endl;
+	#endif
+	}
+if (filter_samples_max)
+	filter_values = new Pixel_Datum[filter_samples_max];
+
 #if ((DEBUG_SECTION) & (DEBUG_MANIPULATORS | DEBUG_RENDER | DEBUG_LOCATION))
 clog << "    display_samples = " << display_samples << endl
 	 << "      display_lines = " << display_lines << endl
@@ -2808,97 +3213,193 @@ clog << "    display_samples = " << display_samples << endl
 	 << "       display_data @ " << (void*)display_data << endl
 	 << "     source samples = " << source_size ().width () << endl
 	 << "       source lines = " << source_size ().height () << endl
-	 << "          max_value = " << hex << max_value << dec << endl;
+	 << "          max_value = " << hex << max_value << dec << endl
+	 << "     SIMD kernels = "
+	 	<< SIMD_level_name (data_map_kernels_level ()) << endl
+	 << "   same_values_band = "
+	 	<< same_values_band[0] << ", "
+	 	<< same_values_band[1] << ", "
+	 	<< same_values_band[2] << endl;
 #endif
 
 Rendering_Monitor::Status
 	status = Rendering_Monitor::TOP_QUALITY_DATA;
 QRect
 	rendered_region (0, 0, display_samples, 0);
+Pixel_Datum
+	*values;
+double
+	source_y = 0.0,
+	line_x,
+	line_y,
+	step_x,
+	step_y;
 
 while (++display_line < display_lines)
 	{
-	display_sample = -1;
-	while (++display_sample < display_samples)
+	#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
+	#if ((DEBUG_SECTION) & DEBUG_ONE_LINE)
+	if (! display_line)
+	#endif
+		clog << "    line " << display_line << " -" << endl;
+	#endif
+	band = -1;
+	while (++band < 3)
 		{
-		pixel_value = 0xFF000000;
-		band = -1;
-		#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
-		if (! display_sample)
+		values = source_values[band];
+		if (same_values_band[band] != band)
 			{
-			#if ((DEBUG_SECTION) & DEBUG_ONE_LINE)
-			if (! display_line)
-			#endif
-				clog << "    line " << display_line << " -" << endl;
+			//	Reuse the source values of an equivalent band.
+			memcpy (values, source_values[same_values_band[band]],
+				display_samples * sizeof (Pixel_Datum));
+			continue;
 			}
-		#endif
-		while (++band < 3)
+
+		if (mappings[band] <= SCALE_MAPPING)
 			{
-			if (transforms[band])
-				transforms[band]->map
-					(display_sample, display_line,
-					&source_sample, &source_line);
+			/*	The source line is constant along the display line,
+				and the source sample columns are the same for all lines.
+			*/
+			if (mappings[band] == IDENTITY_MAPPING)
+				source_lines[band] = display_line;
+			else
+			if (mappings[band] == OFFSET_MAPPING)
+				source_lines[band] = display_line + row_origin[band];
 			else
+				source_lines[band] = row_origin[band]
+					+ row_table[band]->at (display_line);
+			if (box_filters[band])
 				{
-				source_sample = display_sample;
-				source_line = display_line;
+				source_y = transforms[band].m22 () * display_line
+							+ transforms[band].dy ();
+				Box_Filter::span
+					(source_y - (transforms[band].m22 () / 2.0),
+					transforms[band].m22 (), level_height[band],
+					&filter_line, &filter_line_end);
+				box_filters[band]->clear ();
+				for (;
+					 filter_line < filter_line_end;
+					 filter_line++)
+					{
+					if (resolution_levels[band] > 1)
+						source_level_line_values (filter_values,
+							filter_samples[band], box_filters[band]->width (),
+							filter_line, band_map[band],
+							resolution_levels[band]);
+					else
+						source_line_values (filter_values,
+							filter_samples[band], box_filters[band]->width (),
+							filter_line, band_map[band]);
+					box_filters[band]->accumulate (filter_values);
+					}
+				box_filters[band]->average (values, UNDEFINED_PIXEL_VALUE);
 				}
-			datum =
-				source_pixel_value
-					(source_sample, source_line, band_map[band]);
-			#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
-			#if ((DEBUG_SECTION) & DEBUG_ONE_LINE)
-			if (! display_line)
-			#endif
-				clog << "      " << band << "->" << band_map[band]
-						<< ": image "
-						<< setw (3) << display_sample << "x, "
-						<< setw (3) << display_line << "y <- source "
-						<< setw (3) << source_sample << "x, "
-						<< setw (3) << source_line << "y = "
-						<< setfill ('0') << hex << setw (2)
-						<< datum << " -> ";
-			#endif
-			if (datum == UNDEFINED_PIXEL_VALUE ||
-				datum > max_value)
+			else
+			if (resolution_levels[band] > 1)
+				source_level_line_values (values, column_samples[band],
+					display_samples, source_lines[band], band_map[band],
+					resolution_levels[band]);
+			else
+				source_line_values (values, column_samples[band],
+					display_samples, source_lines[band], band_map[band]);
+			}
+		else
+		if (mappings[band] == AFFINE_MAPPING)
+			{
+			/*	The display line terms of the inverse transform are
+				only evaluated once per line. Each source location is
+				computed from its display sample, in the same order of
+				operations as QTransform::map, rather than accumulated
+				across the line; accumulated rounding error would select
+				different source pixels on wide lines.
+			*/
+			line_x = transforms[band].m21 () * display_line;
+			line_y = transforms[band].m22 () * display_line;
+			step_x = transforms[band].m11 ();
+			if (transforms[band].m12 () == 0.0)
 				{
-				#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
-				#if ((DEBUG_SECTION) & DEBUG_ONE_LINE)
-				if (! display_line)
-				#endif
-					clog << "BG" << dec << setfill (' ') << endl;
-				#endif
-				pixel_value |= background_value[band];
+				//	Sheared: the source line is constant along the display line.
+				for (display_sample = 0;
+					 display_sample < display_samples;
+					 display_sample++)
+					source_samples[display_sample] =
+						qRound (step_x * display_sample + line_x
+							+ transforms[band].dx ());
+				source_lines[band] =
+					qRound (line_y + transforms[band].dy ());
+				source_line_values (values, source_samples, display_samples,
+					source_lines[band], band_map[band]);
 				}
 			else
 				{
-				#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
-				#if ((DEBUG_SECTION) & DEBUG_ONE_LINE)
-				if (! display_line)
-				#endif
-					clog
-						<< setw (2)
-						<< static_cast<Pixel_Datum>(data_maps[band]->at (datum))
-						<< dec << setfill (' ') << endl;
-				#endif
-				//	Merge the mapped pixel datum into the image pixel value.
-				pixel_value |=
-					static_cast<QRgb>(data_maps[band]->at (datum))
-					<< (16 - (band << 3));
+				//	Rotated: step both source coordinates.
+				step_y = transforms[band].m12 ();
+				for (display_sample = 0;
+					 display_sample < display_samples;
+					 display_sample++)
+					values[display_sample] =
+						source_pixel_value
+							(qRound (step_x * display_sample + line_x
+								+ transforms[band].dx ()),
+							 qRound (step_y * display_sample + line_y
+								+ transforms[band].dy ()),
+							band_map[band]);
+				source_lines[band] = -1;
+				}
+			}
+		else
+			{
+			//	Projective mapping: transform each sample.
+			source_lines[band] = -1;
+			for (display_sample = 0;
+				 display_sample < display_samples;
+				 display_sample++)
+				{
+				transforms[band].map
+					(display_sample, display_line,
+					&source_samples[display_sample], &source_lines[band]);
+				values[display_sample] =
+					source_pixel_value
+						(source_samples[display_sample], source_lines[band],
+						band_map[band]);
 				}
 			}
 		#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
 		#if ((DEBUG_SECTION) & DEBUG_ONE_LINE)
 		if (! display_line)
 		#endif
-			clog << "      display_data @ "
-					<< setfill ('0') << hex << setw (sizeof (display_data) << 1)
-					<< (void*)display_data
-					<< " = " << setw (8) << pixel_value
-					<< dec << setfill (' ') << endl;
+			{
+			clog << "      " << band << "->" << band_map[band]
+					<< ": image line " << display_line
+					<< " <- source line " << source_lines[band] << endl
+				 << "       " << hex << setfill ('0');
+			for (display_sample = 0;
+				 display_sample < display_samples;
+				 display_sample++)
+				clog << ' ' << setw (2) << values[display_sample];
+			clog << dec << setfill (' ') << endl;
+			}
 		#endif
-		*display_data++ = pixel_value;
 		}
+
+	//	Map the line of source values into the display line.
+	for (band = 0;
+		 band < 3;
+		 band++)
+		map_data_values (source_values[band], band_values[band],
+			display_samples,
+			data_maps[band]->constData (), data_map_size[band],
+			background_datum[band]);
+	pack_display_pixels (display_data,
+		band_values[0], band_values[1], band_values[2], display_samples);
+	#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
+	#if ((DEBUG_SECTION) & DEBUG_ONE_LINE)
+	if (! display_line)
+	#endif
+		display_line_data (*this, display_line);
+	#endif
+	display_data += display_samples;
+
 	if (rendering_increment &&
 		++rendered_lines == rendering_increment)
 		{
@@ -2924,6 +3425,18 @@ while (++display_line < display_lines)
 		rendered_lines = 0;
 		}
 	}
+delete[] band_values[0];
+delete[] source_values[0];
+delete[] source_samples;
+delete[] column_storage;
+delete[] filter_values;
+for (band = 0;
+	 band < 3;
+	 band++)
+	{
+	delete box_filters[band];
+	delete[] filter_samples[band];
+	}
 
 /*	Check for canceled rendering.
 	This is done as a test-and-reset operation to avoid a possible race.
@@ -2951,13 +3464,6 @@ if (rendered_lines)
 		(status, Rendering_Monitor::Status_Message[status], rendered_region);
 	}
 
-//	Cleanup.
-for (band = 0;
-	 band < 3;
-	 band++)
-	if (transforms[band])
-		delete transforms[band];
-
 #if ((DEBUG_SECTION) & DEBUG_TILE_MARKINGS)
 //	Tile markings.
 QString
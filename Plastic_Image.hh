@@ -382,6 +382,10 @@ static bool
 static unsigned int
 	Default_Rendering_Increment_Lines;
 
+//!	Scaled down images are rendered with a box filter.
+static bool
+	Box_Filter_Rendering;
+
 /*==============================================================================
 	Constructors
 */
@@ -588,6 +592,83 @@ virtual Pixel_Datum source_pixel_value
 */
 virtual Triplet source_pixel (const QPoint& point) const;
 
+/**	Get source image pixel data values from a single source image line.
+
+	This is the line oriented equivalent of the {@link
+	source_pixel_value(unsigned int, unsigned int, unsigned int) source
+	pixel value} method that is used by the base class {@link
+	render_image() rendering} procedure: The source data values for a
+	set of sample locations along one source image line are obtained
+	in a single call so the cost of locating the source line data
+	need only be incurred once per line rather than once per pixel.
+
+	The base class implementation simply obtains each value from the
+	source_pixel_value method. An implementing subclass that has direct
+	access to its source image lines should override this method.
+
+	@param	values	A pointer to a Pixel_Datum array that will receive
+		the source data values. The array must have room for at least
+		count values.
+	@param	samples	A pointer to an array of count source image sample
+		(horizontal) locations. The locations may be in any order, may be
+		repeated, and may fall outside the source image.
+	@param	count	The number of sample locations, and values, to be
+		provided.
+	@param	line	The source image line (vertical) location.
+	@param	band	The image band from which to obtain the pixel data.
+		This has the same meaning as for the source_pixel_value method.
+	@see	source_pixel_value(unsigned int, unsigned int, unsigned int)
+*/
+virtual void source_line_values (Pixel_Datum* values,
+	const int* samples, unsigned int count, int line, unsigned int band) const;
+
+/**	Get the source resolution level to be used for rendering at an
+	image scale.
+
+	Resolution level 1 is the full resolution source image; each
+	successive resolution level is half the size of the previous level.
+	The {@link render_image() rendering} procedure obtains source values
+	for scaled down (but not rotated) bands from the resolution level
+	provided here using the {@link source_level_line_values(Pixel_Datum*,
+	const int*, unsigned int, int, unsigned int, unsigned int) const
+	source level line values} method, with the source sample and line
+	locations reduced accordingly.
+
+	The base class implementation always provides resolution level 1.
+	An implementing subclass that is able to provide reduced resolution
+	source data should override this method to select the resolution
+	level at or above the level that produces the image scale, as for
+	JP2_Image::nearest_resolution_level(double), and ensure the level is
+	ready for use before returning.
+
+	@param	scale	A positive image scaling factor.
+	@return	The resolution level to be used to render the image.
+*/
+virtual unsigned int source_resolution_level (double scale) const;
+
+/**	Get source image pixel data values from a single line of a source
+	resolution level.
+
+	The base class implementation ignores the resolution level and
+	obtains the values from the {@link source_line_values(Pixel_Datum*,
+	const int*, unsigned int, int, unsigned int) const full resolution
+	source line values}.
+
+	@param	values	A pointer to a Pixel_Datum array that will receive
+		the source data values.
+	@param	samples	A pointer to an array of count resolution level
+		sample locations.
+	@param	count	The number of sample locations.
+	@param	line	The resolution level line location.
+	@param	band	The source image band.
+	@param	resolution_level	A resolution level provided by the {@link
+		source_resolution_level(double) const source resolution level}
+		method.
+*/
+virtual void source_level_line_values (Pixel_Datum* values,
+	const int* samples, unsigned int count, int line, unsigned int band,
+	unsigned int resolution_level) const;
+
 /**	Close the source image.
 
 	The source image will no longer be accessible. The display image
@@ -1288,6 +1369,16 @@ virtual unsigned long long display_histograms (QVector<Histogram*> histograms,
 	its destination image display pixel value. This is done independently
 	for each band of the destination image.
 
+	The rendering is done a display image line at a time: The inverse
+	transform is stepped along the display line to find the source
+	sample locations, which - when the transform does not rotate or
+	shear the image - all fall on a single source line. The source values
+	for the entire line are then obtained with one {@link
+	source_line_values(Pixel_Datum*, const int*, unsigned int, int,
+	unsigned int) source line values} call and mapped through the band's
+	Data_Map into the display line. Display bands mapped from the same
+	source band with the same transform share the source line values.
+
 	When rendering begins a copy is made of the image configuration
 	variables that affect rendering; this includes the needs update
 	state. While the image {@link is_rendering() is rendering} the
@@ -1559,6 +1650,34 @@ inline static void default_rendering_increment_lines
 inline static unsigned int default_rendering_increment_lines ()
 	{return Default_Rendering_Increment_Lines;}
 
+/**	Enable or disable box filter rendering of scaled down images.
+
+	When enabled, a display band that is scaled down by a factor that
+	is {@link Box_Filter::applicable(const QTransform&) applicable} -
+	usually the residual scaling between source resolution levels -
+	is rendered with each display pixel the average of the source values
+	it covers, rather than a single point sampled source value. This
+	avoids the aliasing artifacts of point sampling at scales that are
+	not a power of two. Other transforms are always point sampled.
+
+	The default is enabled unless DEFAULT_BOX_FILTER_RENDERING is
+	defined false at compile time.
+
+	@param	enabled	true if scaled down images are to be box filtered;
+		false if they are to be point sampled.
+*/
+inline static void box_filter_rendering (bool enabled)
+	{Box_Filter_Rendering = enabled;}
+
+/**	Test if box filter rendering of scaled down images is enabled.
+
+	@return	true if scaled down images are box filtered; false if they
+		are point sampled.
+	@see	box_filter_rendering(bool)
+*/
+inline static bool box_filter_rendering ()
+	{return Box_Filter_Rendering;}
+
 /**	Set the suggested rendering increment.
 
 	The specified number of rendering increment lines is a suggestion to
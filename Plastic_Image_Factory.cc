@@ -26,6 +26,8 @@ Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
 #include	"Plastic_Image.hh"
 #include	"Plastic_QImage.hh"
 #include	"JP2_Image.hh"
+#include	"Mapped_Image.hh"
+#include	"Planar_Image.hh"
 #include	"HiView_Utilities.hh"
 
 //	UA::HiRISE::JP2_Reader.
@@ -110,6 +112,18 @@ if (! source_name.isEmpty ())
 		Type = "JP2";
 		image = create_JP2_Image (source_name, size);
 		}
+	else
+	if (Mapped_Image::is_mapped_image_file (source_name))
+		{
+		Type = "Mapped";
+		image = create_Mapped_Image (source_name, size);
+		}
+	else
+	if (Planar_Image::is_planar_image_file (source_name))
+		{
+		Type = "Planar";
+		image = create_Planar_Image (source_name, size);
+		}
 	else
 		{
 		Type = "QImage";
@@ -241,6 +255,86 @@ clog << "<<< Plastic_Image_Factory::create_JP2_Image" << endl;
 return image;
 }	
 
+Mapped_Image*
+Plastic_Image_Factory::create_Mapped_Image
+	(
+	const QString&	source_name,
+	const QSize&	size
+	)
+{
+#if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
+clog << ">>> Plastic_Image_Factory::create_Mapped_Image" << endl;
+#endif
+Mapped_Image::Source_File
+	*source = NULL;
+Mapped_Image
+	*image = NULL;
+if (is_file (source_name))
+	{
+	try {source = Mapped_Image::Source_File::open (source_name);}
+	catch (std::exception& except)
+		{Error_Message += except.what ();}
+	catch (...)
+		{Error_Message += QObject::tr ("Unknown exception!");}
+	if (source)
+		{
+		#if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
+		clog << "    mapped Source_File @ " << (void*)source << endl;
+		#endif
+		//	N.B.: Ownership of the Source_File is transferred.
+		try {image = new Mapped_Image (source, size);}
+		catch (std::exception& except)
+			{Error_Message += except.what ();}
+		catch (...)
+			{Error_Message += QObject::tr ("Unknown exception!");}
+		}
+	}
+#if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
+clog << "<<< Plastic_Image_Factory::create_Mapped_Image" << endl;
+#endif
+return image;
+}	
+
+Planar_Image*
+Plastic_Image_Factory::create_Planar_Image
+	(
+	const QString&	source_name,
+	const QSize&	size
+	)
+{
+#if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
+clog << ">>> Plastic_Image_Factory::create_Planar_Image" << endl;
+#endif
+Planar_Image::Band_Planes
+	*source = NULL;
+Planar_Image
+	*image = NULL;
+if (is_file (source_name))
+	{
+	try {source = Planar_Image::Band_Planes::load (source_name);}
+	catch (std::exception& except)
+		{Error_Message += except.what ();}
+	catch (...)
+		{Error_Message += QObject::tr ("Unknown exception!");}
+	if (source)
+		{
+		#if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
+		clog << "    loaded Band_Planes @ " << (void*)source << endl;
+		#endif
+		//	N.B.: Ownership of the Band_Planes is transferred.
+		try {image = new Planar_Image (source, size);}
+		catch (std::exception& except)
+			{Error_Message += except.what ();}
+		catch (...)
+			{Error_Message += QObject::tr ("Unknown exception!");}
+		}
+	}
+#if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
+clog << "<<< Plastic_Image_Factory::create_Planar_Image" << endl;
+#endif
+return image;
+}	
+
 /*==============================================================================
 	Utilities
 */
@@ -36,6 +36,8 @@ namespace HiRISE
 class Plastic_Image;
 class Plastic_QImage;
 class JP2_Image;
+class Mapped_Image;
+class Planar_Image;
 
 /**	A <i>Plastic_Image_Factory</i> provides a factory method for
 	creating Plastic_Image objects.
@@ -72,6 +74,12 @@ static Plastic_QImage* create_Plastic_QImage (const QString& source_name,
 static JP2_Image* create_JP2_Image (const QString& source_name,
 	const QSize& size);
 
+static Mapped_Image* create_Mapped_Image (const QString& source_name,
+	const QSize& size);
+
+static Planar_Image* create_Planar_Image (const QString& source_name,
+	const QSize& size);
+
 /*==============================================================================
 	Accessors
 */
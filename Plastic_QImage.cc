@@ -71,6 +71,12 @@ const char* const
 	Plastic_QImage::ID =
 		"UA::HiRISE::Plastic_QImage ($Revision: 1.30 $ $Date: 2012/06/15 01:16:07 $)";
 
+#ifndef DEFAULT_RESOLUTION_PYRAMID
+#define DEFAULT_RESOLUTION_PYRAMID	true
+#endif
+bool
+	Plastic_QImage::Resolution_Pyramid	= DEFAULT_RESOLUTION_PYRAMID;
+
 /*==============================================================================
 	Constructors
 */
@@ -86,7 +92,8 @@ Plastic_QImage::Plastic_QImage
 	Plastic_Image (! size.isEmpty () ? size
 		: (image ? image->size () : size),
 		band_map, transforms, data_maps),
-	Source (image ? image : new QImage (0, 0, IMAGE_FORMAT))
+	Source (image ? image : new QImage (0, 0, IMAGE_FORMAT)),
+	Pyramid (new Image_Pyramid (*Source))
 {
 #if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
 clog << ">>> Plastic_QImage @ " << (void*)this
@@ -118,7 +125,8 @@ Plastic_QImage::Plastic_QImage
 	Plastic_Image (! size.isEmpty () ? size : image.size (),
 		band_map, transforms, data_maps),
 	Source (image.isNull () ?
-		new QImage (0, 0, IMAGE_FORMAT) : new QImage (image))
+		new QImage (0, 0, IMAGE_FORMAT) : new QImage (image)),
+	Pyramid (new Image_Pyramid (*Source))
 {
 #if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
 clog << ">>> Plastic_QImage @ " << (void*)this
@@ -170,6 +178,8 @@ if (image.Source)
 		 << "      image source @ " << (void*)image.Source<< endl;
 	#endif
 	Source = new QImage (*image.Source);
+	//	The resolution levels are shared with the copied image.
+	Pyramid = image.Pyramid;
 	}
 else
 	{
@@ -178,6 +188,8 @@ else
 	#endif
 	Source = new QImage (0, 0, IMAGE_FORMAT);
 	}
+if (! Pyramid)
+	Pyramid = Shared_Image_Pyramid (new Image_Pyramid (*Source));
 #if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
 clog << "    Source @ " << (void*)Source << endl;
 #endif
@@ -315,6 +327,281 @@ return precision;
 }
 
 
+namespace
+{
+/*	Direct access to QImage pixel data.
+
+	QImage::pixel checks the coordinates and dispatches on the image
+	format for every call. For the common image formats the pixel data
+	is read here directly from the image scan lines instead. The values
+	obtained are the same as those provided by QImage::pixel.
+*/
+enum Pixel_Access
+	{
+	PIXEL_ACCESS,	//	QImage::pixel.
+	RGB32_ACCESS,
+	RGB888_ACCESS,
+	INDEXED8_ACCESS,
+	GRAYSCALE8_ACCESS,
+	GRAYSCALE16_ACCESS
+	};
+
+inline Pixel_Access
+pixel_access
+	(
+	const QImage&	image
+	)
+{
+switch (image.format ())
+	{
+	case QImage::Format_RGB32:
+	case QImage::Format_ARGB32:
+		return RGB32_ACCESS;
+	case QImage::Format_RGB888:
+		return RGB888_ACCESS;
+	case QImage::Format_Indexed8:
+		return INDEXED8_ACCESS;
+	#if QT_VERSION >= 0x50500
+	case QImage::Format_Grayscale8:
+		return GRAYSCALE8_ACCESS;
+	#endif
+	#if QT_VERSION >= 0x50D00
+	case QImage::Format_Grayscale16:
+		return GRAYSCALE16_ACCESS;
+	#endif
+	default:
+		return PIXEL_ACCESS;
+	}
+}
+
+/*	Reduce a 16-bit gray value to 8 bits.
+
+	The value is divided by 257 with rounding, as QImage::pixel does.
+*/
+inline unsigned int
+gray16_to_8
+	(
+	unsigned int	value
+	)
+{return (value + 128 - (value >> 8)) >> 8;}
+
+/*	Get a QImage pixel value.
+
+	The coordinate must be within the image.
+*/
+inline QRgb
+image_pixel
+	(
+	const QImage&	image,
+	Pixel_Access	access,
+	int				x,
+	int				y
+	)
+{
+const uchar
+	*data;
+switch (access)
+	{
+	case RGB32_ACCESS:
+		return reinterpret_cast<const QRgb*>(image.constScanLine (y))[x];
+	case RGB888_ACCESS:
+		data = image.constScanLine (y) + (x * 3);
+		return qRgb (data[0], data[1], data[2]);
+	case INDEXED8_ACCESS:
+		x = image.constScanLine (y)[x];
+		return (x < image.colorCount ()) ? image.color (x) : 0;
+	case GRAYSCALE8_ACCESS:
+		x = image.constScanLine (y)[x];
+		return qRgb (x, x, x);
+	case GRAYSCALE16_ACCESS:
+		x = gray16_to_8
+			(reinterpret_cast<const quint16*>(image.constScanLine (y))[x]);
+		return qRgb (x, x, x);
+	default:
+		return image.pixel (x, y);
+	}
+}
+
+/*	Get QImage pixel values from a single image line.
+*/
+void
+image_line_values
+	(
+	const QImage&					image,
+	Plastic_Image::Pixel_Datum*		values,
+	const int*						samples,
+	unsigned int					count,
+	int								line,
+	unsigned int					band
+	)
+{
+const unsigned int
+	image_width = static_cast<unsigned int>(image.width ());
+unsigned int
+	index,
+	sample;
+if (line < 0 ||
+	line >= image.height () ||
+	band > 2)
+	{
+	for (index = 0;
+		 index < count;
+		 index++)
+		values[index] = Plastic_Image::UNDEFINED_PIXEL_VALUE;
+	return;
+	}
+
+const uchar
+	*image_data = image.constScanLine (line);
+Pixel_Access
+	access = pixel_access (image);
+switch (access)
+	{
+	case RGB32_ACCESS:
+		{
+		band = 16 - (band << 3);
+		const QRgb
+			*pixels = reinterpret_cast<const QRgb*>(image_data);
+		for (index = 0;
+			 index < count;
+			 index++)
+			{
+			sample = static_cast<unsigned int>(samples[index]);
+			values[index] = (sample < image_width) ?
+				((pixels[sample] >> band) & 0xFF) :
+				Plastic_Image::UNDEFINED_PIXEL_VALUE;
+			}
+		break;
+		}
+	case RGB888_ACCESS:
+		image_data += band;
+		for (index = 0;
+			 index < count;
+			 index++)
+			{
+			sample = static_cast<unsigned int>(samples[index]);
+			values[index] = (sample < image_width) ?
+				image_data[sample * 3] :
+				Plastic_Image::UNDEFINED_PIXEL_VALUE;
+			}
+		break;
+	case GRAYSCALE8_ACCESS:
+		for (index = 0;
+			 index < count;
+			 index++)
+			{
+			sample = static_cast<unsigned int>(samples[index]);
+			values[index] = (sample < image_width) ?
+				image_data[sample] :
+				Plastic_Image::UNDEFINED_PIXEL_VALUE;
+			}
+		break;
+	case GRAYSCALE16_ACCESS:
+		{
+		const quint16
+			*pixels = reinterpret_cast<const quint16*>(image_data);
+		for (index = 0;
+			 index < count;
+			 index++)
+			{
+			sample = static_cast<unsigned int>(samples[index]);
+			values[index] = (sample < image_width) ?
+				gray16_to_8 (pixels[sample]) :
+				Plastic_Image::UNDEFINED_PIXEL_VALUE;
+			}
+		break;
+		}
+	case INDEXED8_ACCESS:
+		{
+		band = 16 - (band << 3);
+		const QVector<QRgb>
+			color_table (image.colorTable ());
+		const unsigned int
+			colors = static_cast<unsigned int>(color_table.size ());
+		unsigned int
+			color;
+		for (index = 0;
+			 index < count;
+			 index++)
+			{
+			sample = static_cast<unsigned int>(samples[index]);
+			if (sample < image_width)
+				{
+				color = image_data[sample];
+				values[index] = (color < colors) ?
+					((color_table[color] >> band) & 0xFF) : 0;
+				}
+			else
+				values[index] = Plastic_Image::UNDEFINED_PIXEL_VALUE;
+			}
+		break;
+		}
+	default:
+		band = 16 - (band << 3);
+		for (index = 0;
+			 index < count;
+			 index++)
+			{
+			sample = static_cast<unsigned int>(samples[index]);
+			values[index] = (sample < image_width) ?
+				((image.pixel (sample, line) >> band) & 0xFF) :
+				Plastic_Image::UNDEFINED_PIXEL_VALUE;
+			}
+	}
+}
+
+/*	Get a segment of a QImage line as QRgb values.
+
+	The segment must be within the image. The line data is returned
+	directly, without copying, for 32-bit RGB images; otherwise the
+	pixel values are written to the storage provided.
+*/
+const QRgb*
+image_line_rgb
+	(
+	const QImage&	image,
+	Pixel_Access	access,
+	int				line,
+	int				left,
+	int				width,
+	QRgb*			storage
+	)
+{
+const uchar
+	*image_data = image.constScanLine (line);
+QRgb
+	*rgb = storage;
+int
+	sample = left,
+	end = left + width;
+switch (access)
+	{
+	case RGB32_ACCESS:
+		return reinterpret_cast<const QRgb*>(image_data) + left;
+	case RGB888_ACCESS:
+		for (image_data += left * 3;
+			 sample < end;
+			 sample++,
+			 image_data += 3)
+			*rgb++ = qRgb (image_data[0], image_data[1], image_data[2]);
+		break;
+	case GRAYSCALE8_ACCESS:
+		for (image_data += left;
+			 sample < end;
+			 sample++,
+			 image_data++)
+			*rgb++ = qRgb (*image_data, *image_data, *image_data);
+		break;
+	default:
+		while (sample < end)
+			*rgb++ = image_pixel (image, access, sample++, line);
+	}
+return storage;
+}
+
+}	//	local namespace
+
+
 Plastic_Image::Pixel_Datum
 Plastic_QImage::source_pixel_value
 	(
@@ -335,11 +622,13 @@ if (Source &&
 	y < static_cast<unsigned int>(Source->height ()) &&
 	band < 3)
 	{
+	QRgb
+		datum = image_pixel (*Source, pixel_access (*Source), x, y);
 	#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
-	clog << hex << Source->pixel (x, y) << dec << " -> ";
+	clog << hex << datum << dec << " -> ";
 	#endif
 	band = 16 - (band << 3);
-	value = (Source->pixel (x, y) & (0xFF << band)) >> band;
+	value = (datum & (0xFF << band)) >> band;
 	}
 else
 	value = UNDEFINED_PIXEL_VALUE;
@@ -350,6 +639,199 @@ return value;
 }
 
 
+
+
+void
+Plastic_QImage::source_line_values
+	(
+	Pixel_Datum*	values,
+	const int*		samples,
+	unsigned int	count,
+	int				line,
+	unsigned int	band
+	)
+	const
+{
+#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
+clog << ">-< Plastic_QImage::source_line_values: "
+		<< count << " samples, " << line << "y, " << band << 'b' << endl;
+#endif
+if (Source)
+	image_line_values (*Source, values, samples, count, line, band);
+else
+	while (count--)
+		*values++ = UNDEFINED_PIXEL_VALUE;
+}
+
+
+unsigned int
+Plastic_QImage::source_resolution_level
+	(
+	double	scale
+	) const
+{
+unsigned int
+	resolution_level = 1;
+if (Resolution_Pyramid &&
+	Pyramid &&
+	(resolution_level = Pyramid->nearest_resolution_level (scale)) > 1)
+	{
+	/*	Produce the level now, before rendering, and hold its image so
+		the source lines are read without locking the Pyramid.
+	*/
+	if (Level_Images.size () <= (int)resolution_level)
+		Level_Images.resize (resolution_level + 1);
+	Level_Images[resolution_level] = Pyramid->level (resolution_level);
+	}
+else
+	resolution_level = 1;
+#if ((DEBUG_SECTION) & DEBUG_RENDER)
+clog << ">-< Plastic_QImage::source_resolution_level: " << scale
+		<< " -> " << resolution_level << endl;
+#endif
+return resolution_level;
+}
+
+
+void
+Plastic_QImage::source_level_line_values
+	(
+	Pixel_Datum*	values,
+	const int*		samples,
+	unsigned int	count,
+	int				line,
+	unsigned int	band,
+	unsigned int	resolution_level
+	)
+	const
+{
+#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
+clog << ">-< Plastic_QImage::source_level_line_values: "
+		<< count << " samples, " << line << "y, " << band << "b, level "
+		<< resolution_level << endl;
+#endif
+//	The level image was resolved by source_resolution_level.
+const QImage
+	*image = (resolution_level < (unsigned int)Level_Images.size ()) ?
+		Level_Images[resolution_level] : NULL;
+if (! image)
+	image = Pyramid ? Pyramid->level (resolution_level) : Source;
+if (image)
+	image_line_values (*image, values, samples, count, line, band);
+else
+	while (count--)
+		*values++ = UNDEFINED_PIXEL_VALUE;
+}
+
+
+unsigned long long
+Plastic_QImage::source_histograms
+	(
+	QVector<Histogram*>	histograms,
+	const QRect&		source_region
+	) const
+{
+Pixel_Access
+	access = Source ? pixel_access (*Source) : PIXEL_ACCESS;
+if (access == PIXEL_ACCESS)
+	return Plastic_Image::source_histograms (histograms, source_region);
+
+#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
+clog << ">>> Plastic_QImage::source_histograms:" << endl
+	 << "    source_region = " << source_region << endl;
+#endif
+if (histograms.size () < 3)
+	histograms.resize (3);
+
+QMutexLocker
+	object_lock (&Object_Lock);
+QRect
+	selected_region (image_region () & source_region);
+if (source_region.isEmpty () ||
+	selected_region.isEmpty ())
+	{
+	#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
+	clog << "<<< Plastic_QImage::source_histograms: 0" << endl;
+	#endif
+	return 0;
+	}
+selected_region &= Source->rect ();
+
+/*	Refresh the histograms of the display bands that are not mapped
+	from the same source band as a lower numbered display band. The
+	others are refreshed, from the histograms they duplicate, after the
+	scan.
+*/
+const unsigned int
+	*band_map = source_band_map ();
+quint64
+	*counts[3];
+int
+	shifts[3],
+	bands = 0,
+	band,
+	other_band;
+bool
+	duplicate[3];
+for (band = 0;
+	 band < 3;
+	 band++)
+	{
+	other_band = band;
+	while (other_band--)
+		if (band_map[band] == band_map[other_band])
+			break;
+	if (! (duplicate[band] = (other_band >= 0)) &&
+		refresh_source_histogram (histograms, band) &&
+		band_map[band] < 3)
+		{
+		counts[bands] = histograms[band]->data ();
+		shifts[bands] = 16 - (band_map[band] << 3);
+		++bands;
+		}
+	}
+
+QVector<QRgb>
+	line_storage ((access == RGB32_ACCESS) ? 0 : selected_region.width ());
+const QRgb
+	*source_data,
+	*end_data;
+int
+	line = selected_region.top (),
+	end_line = line + selected_region.height ();
+while (line < end_line)
+	{
+	source_data = image_line_rgb (*Source, access, line++,
+		selected_region.left (), selected_region.width (),
+		line_storage.data ());
+	end_data = source_data + selected_region.width ();
+	while (source_data < end_data)
+		{
+		for (band = 0;
+			 band < bands;
+			 band++)
+			counts[band][(*source_data >> shifts[band]) & 0xFF]++;
+		++source_data;
+		}
+	}
+
+for (band = 1;
+	 band < 3;
+	 band++)
+	if (duplicate[band])
+		refresh_source_histogram (histograms, band);
+
+unsigned long long
+	max_count = bands ?
+		(unsigned long long)selected_region.width ()
+			* selected_region.height () : 0;
+#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
+clog << "<<< Plastic_QImage::source_histograms: " << max_count << endl;
+#endif
+return max_count;
+}
+
+
 Plastic_Image::Triplet
 Plastic_QImage::source_pixel
 	(
@@ -362,11 +844,11 @@ clog << ">-< Plastic_QImage::source_pixel: " << point << " = ";
 Triplet
 	triplet;
 if (Source &&
-	point.x () < Source->width () &&
-	point.y () < Source->height ())
+	Source->rect ().contains (point))
 	{
 	QRgb
-		datum = Source->pixel (point);
+		datum = image_pixel (*Source, pixel_access (*Source),
+			point.x (), point.y ());
 	#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
 	clog << hex << datum << dec << " -> ";
 	#endif
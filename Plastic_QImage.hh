@@ -25,6 +25,10 @@ Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
 #define HiView_Plastic_QImage_hh
 
 #include	"Plastic_Image.hh"
+#include	"Image_Pyramid.hh"
+
+#include	<QSharedPointer>
+#include	<QVector>
 
 
 namespace UA
@@ -42,6 +46,11 @@ public:
 static const char* const
 	ID;
 
+/*==============================================================================
+	Types
+*/
+typedef QSharedPointer<Image_Pyramid>	Shared_Image_Pyramid;
+
 /*==============================================================================
 	Constructors
 */
@@ -180,10 +189,120 @@ virtual unsigned int source_bands () const;
 
 virtual unsigned int source_precision_bits () const;
 
+/**	Get a source image pixel datum.
+
+	The pixel values of 32-bit RGB, 24-bit RGB, 8-bit indexed and 8-bit
+	or 16-bit grayscale source images are obtained directly from the
+	source image line data; other source image formats are accessed
+	with QImage::pixel. The values are the same in either case.
+
+	@param	x	The source image sample location.
+	@param	y	The source image line location.
+	@param	band	The source image band.
+	@return	The pixel datum value. This will be UNDEFINED_PIXEL_VALUE if
+		the location or band is outside the source image.
+*/
 virtual Pixel_Datum source_pixel_value
 	(unsigned int x, unsigned int y, unsigned int band) const;
 virtual Plastic_Image::Triplet source_pixel (const QPoint& point) const;
 
+/**	Get source image pixel data values from a single source image line.
+
+	The pixel values are obtained directly from the source image line
+	data for the same source image formats as {@link
+	source_pixel_value(unsigned int, unsigned int, unsigned int)}; other
+	source image formats are accessed by pixel.
+
+	@param	values	A pointer to a Pixel_Datum array that will receive
+		the source data values.
+	@param	samples	A pointer to an array of count source image sample
+		locations.
+	@param	count	The number of sample locations.
+	@param	line	The source image line location.
+	@param	band	The source image band.
+	@see	Plastic_Image::source_line_values(Pixel_Datum*, const int*,
+		unsigned int, int, unsigned int)
+*/
+virtual void source_line_values (Pixel_Datum* values,
+	const int* samples, unsigned int count, int line, unsigned int band) const;
+
+/**	Get the source resolution level to be used for rendering at an
+	image scale.
+
+	If the {@link resolution_pyramid() resolution pyramid} is enabled
+	the {@link Image_Pyramid::nearest_resolution_level(double) const
+	nearest resolution level} of the source image pyramid for the scale
+	is selected, and produced if it has not already been. The resolution
+	pyramid is shared by all clones of a Plastic_QImage, so each level is
+	produced only once.
+
+	@param	scale	A positive image scaling factor.
+	@return	The resolution level to be used to render the image. This
+		will be 1 if the resolution pyramid is not enabled.
+	@see	Plastic_Image::source_resolution_level(double) const
+*/
+virtual unsigned int source_resolution_level (double scale) const;
+
+/**	Get source image pixel data values from a single line of a source
+	resolution level.
+
+	@param	values	A pointer to a Pixel_Datum array that will receive
+		the source data values.
+	@param	samples	A pointer to an array of count resolution level
+		sample locations.
+	@param	count	The number of sample locations.
+	@param	line	The resolution level line location.
+	@param	band	The source image band.
+	@param	resolution_level	The resolution level.
+	@see	Plastic_Image::source_level_line_values(Pixel_Datum*,
+		const int*, unsigned int, int, unsigned int, unsigned int) const
+*/
+virtual void source_level_line_values (Pixel_Datum* values,
+	const int* samples, unsigned int count, int line, unsigned int band,
+	unsigned int resolution_level) const;
+
+/**	Enable or disable rendering from the source image resolution
+	pyramid.
+
+	The default is enabled unless DEFAULT_RESOLUTION_PYRAMID is defined
+	false at compile time.
+
+	@param	enabled	true if scaled down images are to be rendered from
+		reduced resolution levels of the source image; false if they are
+		always rendered from the full resolution source image.
+*/
+inline static void resolution_pyramid (bool enabled)
+	{Resolution_Pyramid = enabled;}
+
+/**	Test if rendering from the source image resolution pyramid is
+	enabled.
+
+	@return	true if scaled down images are rendered from reduced
+		resolution levels of the source image; false otherwise.
+*/
+inline static bool resolution_pyramid ()
+	{return Resolution_Pyramid;}
+
+/**	Produce histograms of source image data.
+
+	The histograms are accumulated for all display bands in a single
+	scan of the source image line data for the same source image formats
+	as {@link source_pixel_value(unsigned int, unsigned int, unsigned
+	int)}; other source image formats are scanned by the {@link
+	Plastic_Image::source_histograms(QVector<Histogram*>, const QRect&)
+	base implementation}.
+
+	@param	histograms	A vector of three Histogram data vector pointers.
+	@param	source_region	A QRect specifying the region of the source
+		image to be scanned.
+	@return	The maximum number of pixels sampled for each histogram.
+		This will be zero if no histogramming was done.
+	@see	Plastic_Image::source_histograms(QVector<Histogram*>,
+		const QRect&)
+*/
+virtual unsigned long long source_histograms (QVector<Histogram*> histograms,
+	const QRect& source_region) const;
+
 /*==============================================================================
 	Data
 */
@@ -192,6 +311,24 @@ protected:
 QImage
 	*Source;
 
+//!	Reduced resolution levels of the Source.
+Shared_Image_Pyramid
+	Pyramid;
+
+/**	Pyramid level images, by resolution level, obtained by
+	source_resolution_level for rendering.
+
+	Pyramid level images never change once produced, so they may be
+	read without locking the Pyramid.
+*/
+mutable QVector<const QImage*>
+	Level_Images;
+
+private:
+
+static bool
+	Resolution_Pyramid;
+
 };	//	Class Plastic_QImage
 
 
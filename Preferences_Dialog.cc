@@ -285,6 +285,10 @@ connect (Rendering, SIGNAL (tile_size_changed (int)),
 	SIGNAL (tile_size_changed (int)));
 connect (Rendering, SIGNAL (rendering_increment_lines_changed (int)),
 	SIGNAL (rendering_increment_lines_changed (int)));
+connect (Rendering, SIGNAL (rendering_threads_changed (int)),
+	SIGNAL (rendering_threads_changed (int)));
+connect (Rendering, SIGNAL (decoded_data_cache_size_changed (int)),
+	SIGNAL (decoded_data_cache_size_changed (int)));
 
 //connect (JPIP, SIGNAL (HTTP_to_JPIP_hostname_changed (const QString&)),
 //	SIGNAL (HTTP_to_JPIP_hostname_changed (const QString&)));
@@ -2216,6 +2220,39 @@ int
 	Rendering_Section::Default_Rendering_Increment_Lines
 		= DEFAULT_RENDERING_INCREMENT_LINES;
 
+const char
+	*Rendering_Section::RENDERING_THREADS_KEY
+		= "Rendering_Threads";
+
+#ifndef DEFAULT_RENDERING_THREADS
+#define DEFAULT_RENDERING_THREADS			0
+#endif
+int
+	Rendering_Section::Default_Rendering_Threads
+		= DEFAULT_RENDERING_THREADS;
+#ifndef MAX_RENDERING_THREADS
+#define MAX_RENDERING_THREADS				64
+#endif
+
+const char
+	*Rendering_Section::DECODED_DATA_CACHE_SIZE_KEY
+		= "Decoded_Data_Cache_Size";
+
+//	Decoded data cache size in MiB.
+#ifndef DEFAULT_DECODED_DATA_CACHE_SIZE
+#define DEFAULT_DECODED_DATA_CACHE_SIZE		256
+#endif
+int
+	Rendering_Section::Default_Decoded_Data_Cache_Size
+		= DEFAULT_DECODED_DATA_CACHE_SIZE;
+#ifndef MAX_DECODED_DATA_CACHE_SIZE
+#define MAX_DECODED_DATA_CACHE_SIZE			65536
+#endif
+
+const char
+	*Rendering_Section::DECODED_DATA_SPILL_DIRECTORY_KEY
+		= "Decoded_Data_Spill_Directory";
+
 
 Rendering_Section::Rendering_Section
 	(
@@ -2535,6 +2572,72 @@ if (! settings.contains (RENDERING_INCREMENT_LINES_KEY))
 	settings.setValue (RENDERING_INCREMENT_LINES_KEY,
 		Default_Rendering_Increment_Lines);
 
+int
+	threads =
+	Rendering_Threads = settings.value (RENDERING_THREADS_KEY,
+		Default_Rendering_Threads).toInt (&OK);
+#if ((DEBUG_SECTION) & (DEBUG_CONSTRUCTORS | DEBUG_RENDERING))
+clog << "    " << RENDERING_THREADS_KEY << " = "
+		<< Rendering_Threads << endl;
+#endif
+if (! OK ||
+	Rendering_Threads < 0 ||
+	Rendering_Threads > MAX_RENDERING_THREADS)
+	{
+	QMessageBox::warning ((isVisible () ? this : NULL), Title,
+		tr ("The ") + RENDERING_THREADS_KEY + " \""
+		+ settings.value (RENDERING_THREADS_KEY).toString ()
+		+ tr ("\" value is invalid;\n")
+		+ tr ("A value in the range 0 - ")
+		+ QString::number (MAX_RENDERING_THREADS)
+		+ tr (" is required.\n\n")
+		+ tr ("The default value of ")
+		+ QString::number (Default_Rendering_Threads)
+		+ tr (" is being used."));
+	threads = Default_Rendering_Threads;
+	}
+else
+if (! settings.contains (RENDERING_THREADS_KEY))
+	settings.setValue (RENDERING_THREADS_KEY,
+		Default_Rendering_Threads);
+
+int
+	cache_size =
+	Decoded_Data_Cache_Size = settings.value (DECODED_DATA_CACHE_SIZE_KEY,
+		Default_Decoded_Data_Cache_Size).toInt (&OK);
+#if ((DEBUG_SECTION) & (DEBUG_CONSTRUCTORS | DEBUG_RENDERING))
+clog << "    " << DECODED_DATA_CACHE_SIZE_KEY << " = "
+		<< Decoded_Data_Cache_Size << endl;
+#endif
+if (! OK ||
+	Decoded_Data_Cache_Size < 0 ||
+	Decoded_Data_Cache_Size > MAX_DECODED_DATA_CACHE_SIZE)
+	{
+	QMessageBox::warning ((isVisible () ? this : NULL), Title,
+		tr ("The ") + DECODED_DATA_CACHE_SIZE_KEY + " \""
+		+ settings.value (DECODED_DATA_CACHE_SIZE_KEY).toString ()
+		+ tr ("\" value is invalid;\n")
+		+ tr ("A value in the range 0 - ")
+		+ QString::number (MAX_DECODED_DATA_CACHE_SIZE)
+		+ tr (" is required.\n\n")
+		+ tr ("The default value of ")
+		+ QString::number (Default_Decoded_Data_Cache_Size)
+		+ tr (" is being used."));
+	cache_size = Default_Decoded_Data_Cache_Size;
+	}
+else
+if (! settings.contains (DECODED_DATA_CACHE_SIZE_KEY))
+	settings.setValue (DECODED_DATA_CACHE_SIZE_KEY,
+		Default_Decoded_Data_Cache_Size);
+
+//	The spill directory is only set in the settings file.
+Decoded_Data_Spill_Directory =
+	settings.value (DECODED_DATA_SPILL_DIRECTORY_KEY).toString ();
+#if ((DEBUG_SECTION) & (DEBUG_CONSTRUCTORS | DEBUG_RENDERING))
+clog << "    " << DECODED_DATA_SPILL_DIRECTORY_KEY << " = "
+		<< Decoded_Data_Spill_Directory.toStdString () << endl;
+#endif
+
 /*==============================================================================
 	Layout controls
 */
@@ -3179,6 +3282,106 @@ clog << "    " << row << ',' << col
 		<< ": Rendering_Increment_Lines_Reset_Button" << endl;
 #endif
 
+//		Rendering Threads.
+++row;
+//			Label.
+col = 0;
+grid_layout->addWidget (label = new QLabel (tr ("Rendering &Threads:"), this),
+	row, col, Qt::AlignRight | Qt::AlignVCenter);
+#if ((DEBUG_SECTION) & (DEBUG_CONSTRUCTORS | DEBUG_RENDERING))
+clog << "    " << row << ',' << col << ": Rendering Threads label" << endl;
+#endif
+//			Value.
+++col;
+Rendering_Threads_spinBox = new QSpinBox (this);
+Rendering_Threads_spinBox->setAlignment (Qt::AlignRight);
+Rendering_Threads_spinBox->setMinimum (0);
+Rendering_Threads_spinBox->setSpecialValueText ("auto");
+Rendering_Threads_spinBox->setMaximum (MAX_RENDERING_THREADS);
+Rendering_Threads_spinBox->setValue (Rendering_Threads);
+Rendering_Threads_spinBox->setKeyboardTracking (true);
+Rendering_Threads_spinBox->setToolTip
+	(tr ("Number of threads used to render image tiles concurrently.\n"
+		 "JPEG2000 decoding of the tiles of one image is done by one\n"
+		 "thread at a time; mapping the decoded data to the display,\n"
+		 "and the tiles of other images, use the other threads."));
+#ifndef QT_NO_SHORTCUT
+label->setBuddy (Rendering_Threads_spinBox);
+#endif
+connect (Rendering_Threads_spinBox, SIGNAL (valueChanged (int)),
+	SLOT (changing ()));
+connect (Rendering_Threads_spinBox, SIGNAL (editingFinished ()),
+	SLOT (rendering_threads_change ()));
+grid_layout->addWidget (Rendering_Threads_spinBox, row, col);
+#if ((DEBUG_SECTION) & (DEBUG_CONSTRUCTORS | DEBUG_RENDERING))
+clog << "    " << row << ',' << col
+		<< ": Rendering_Threads_spinBox" << endl;
+#endif
+//			Reset button.
+++col;
+Rendering_Threads_Reset_Button =
+	new Icon_Button (*Reset_Button_Icon, this);
+Rendering_Threads_Reset_Button->setVisible (false);
+Rendering_Threads_Reset_Button->setFocusPolicy (Qt::NoFocus);
+connect (Rendering_Threads_Reset_Button, SIGNAL (clicked ()),
+	SLOT (rendering_threads_reset ()));
+grid_layout->addWidget (Rendering_Threads_Reset_Button,
+	row, col, Qt::AlignLeft);
+#if ((DEBUG_SECTION) & (DEBUG_CONSTRUCTORS | DEBUG_RENDERING))
+clog << "    " << row << ',' << col
+		<< ": Rendering_Threads_Reset_Button" << endl;
+#endif
+
+//		Decoded Data Cache Size.
+++row;
+//			Label.
+col = 0;
+grid_layout->addWidget (label = new QLabel (tr ("Decoded &Data Cache:"), this),
+	row, col, Qt::AlignRight | Qt::AlignVCenter);
+#if ((DEBUG_SECTION) & (DEBUG_CONSTRUCTORS | DEBUG_RENDERING))
+clog << "    " << row << ',' << col << ": Decoded Data Cache label" << endl;
+#endif
+//			Value.
+++col;
+Decoded_Data_Cache_Size_spinBox = new QSpinBox (this);
+Decoded_Data_Cache_Size_spinBox->setAlignment (Qt::AlignRight);
+Decoded_Data_Cache_Size_spinBox->setMinimum (0);
+Decoded_Data_Cache_Size_spinBox->setSpecialValueText ("off");
+Decoded_Data_Cache_Size_spinBox->setMaximum (MAX_DECODED_DATA_CACHE_SIZE);
+Decoded_Data_Cache_Size_spinBox->setSingleStep (64);
+Decoded_Data_Cache_Size_spinBox->setSuffix (" MB");
+Decoded_Data_Cache_Size_spinBox->setValue (Decoded_Data_Cache_Size);
+Decoded_Data_Cache_Size_spinBox->setKeyboardTracking (true);
+Decoded_Data_Cache_Size_spinBox->setToolTip
+	(tr ("Memory used to hold decoded JPEG2000 source data for reuse;\n"
+		"off also stops spilling decoded data to disk"));
+#ifndef QT_NO_SHORTCUT
+label->setBuddy (Decoded_Data_Cache_Size_spinBox);
+#endif
+connect (Decoded_Data_Cache_Size_spinBox, SIGNAL (valueChanged (int)),
+	SLOT (changing ()));
+connect (Decoded_Data_Cache_Size_spinBox, SIGNAL (editingFinished ()),
+	SLOT (decoded_data_cache_size_change ()));
+grid_layout->addWidget (Decoded_Data_Cache_Size_spinBox, row, col);
+#if ((DEBUG_SECTION) & (DEBUG_CONSTRUCTORS | DEBUG_RENDERING))
+clog << "    " << row << ',' << col
+		<< ": Decoded_Data_Cache_Size_spinBox" << endl;
+#endif
+//			Reset button.
+++col;
+Decoded_Data_Cache_Size_Reset_Button =
+	new Icon_Button (*Reset_Button_Icon, this);
+Decoded_Data_Cache_Size_Reset_Button->setVisible (false);
+Decoded_Data_Cache_Size_Reset_Button->setFocusPolicy (Qt::NoFocus);
+connect (Decoded_Data_Cache_Size_Reset_Button, SIGNAL (clicked ()),
+	SLOT (decoded_data_cache_size_reset ()));
+grid_layout->addWidget (Decoded_Data_Cache_Size_Reset_Button,
+	row, col, Qt::AlignLeft);
+#if ((DEBUG_SECTION) & (DEBUG_CONSTRUCTORS | DEBUG_RENDERING))
+clog << "    " << row << ',' << col
+		<< ": Decoded_Data_Cache_Size_Reset_Button" << endl;
+#endif
+
 //		Spacing.
 ++row;
 grid_layout->setRowMinimumHeight (row, 10);
@@ -3229,6 +3432,8 @@ scaling_minor_increment (minor_increment);
 scaling_major_increment (major_increment);
 tile_size (tile_extent);
 rendering_increment_lines (increment_lines);
+rendering_threads (threads);
+decoded_data_cache_size (cache_size);
 Background_Color_Text_Pending = Default_Background_Color_Text;
 if (! (OK = background_color_is_valid (color)) &&
 	color != Default_Background_Color_Text)
@@ -3747,6 +3952,92 @@ Rendering_Section::rendering_increment_lines_reset ()
 {rendering_increment_lines (Rendering_Increment_Lines);}
 
 
+void
+Rendering_Section::rendering_threads
+	(
+	int		threads
+	)
+{
+if (threads < 0 ||
+	threads > MAX_RENDERING_THREADS)
+	{
+	QMessageBox::information ((isVisible () ? this : NULL), Title,
+		tr ("The number of rendering threads of ")
+		+ QString::number (threads)
+		+ tr (" was clipped to the 0 - ")
+		+ QString::number (MAX_RENDERING_THREADS)
+		+ tr (" limits."));
+	threads = qBound (0, threads, MAX_RENDERING_THREADS);
+	}
+
+if (Rendering_Threads_spinBox->value () != threads)
+	Rendering_Threads_spinBox->setValue (threads);
+
+Rendering_Threads_Reset_Button->setVisible
+	(threads != Rendering_Threads);
+
+reset_modifier_buttons ();
+}
+
+
+void
+Rendering_Section::rendering_threads_change ()
+{
+#if ((DEBUG_SECTION) & DEBUG_RENDERING)
+clog << ">-< Rendering_Section::rendering_threads_change" << endl;
+#endif
+rendering_threads (Rendering_Threads_spinBox->value ());
+}
+
+
+void
+Rendering_Section::rendering_threads_reset ()
+{rendering_threads (Rendering_Threads);}
+
+
+void
+Rendering_Section::decoded_data_cache_size
+	(
+	int		size
+	)
+{
+if (size < 0 ||
+	size > MAX_DECODED_DATA_CACHE_SIZE)
+	{
+	QMessageBox::information ((isVisible () ? this : NULL), Title,
+		tr ("The decoded data cache size of ")
+		+ QString::number (size)
+		+ tr (" was clipped to the 0 - ")
+		+ QString::number (MAX_DECODED_DATA_CACHE_SIZE)
+		+ tr (" limits."));
+	size = qBound (0, size, MAX_DECODED_DATA_CACHE_SIZE);
+	}
+
+if (Decoded_Data_Cache_Size_spinBox->value () != size)
+	Decoded_Data_Cache_Size_spinBox->setValue (size);
+
+Decoded_Data_Cache_Size_Reset_Button->setVisible
+	(size != Decoded_Data_Cache_Size);
+
+reset_modifier_buttons ();
+}
+
+
+void
+Rendering_Section::decoded_data_cache_size_change ()
+{
+#if ((DEBUG_SECTION) & DEBUG_RENDERING)
+clog << ">-< Rendering_Section::decoded_data_cache_size_change" << endl;
+#endif
+decoded_data_cache_size (Decoded_Data_Cache_Size_spinBox->value ());
+}
+
+
+void
+Rendering_Section::decoded_data_cache_size_reset ()
+{decoded_data_cache_size (Decoded_Data_Cache_Size);}
+
+
 void
 Rendering_Section::background_color
 	(
@@ -3925,6 +4216,8 @@ contrast_stretch_reset ();
 
 tile_size_reset ();
 rendering_increment_lines_reset ();
+rendering_threads_reset ();
+decoded_data_cache_size_reset ();
 background_color_reset ();
 }
 
@@ -3949,6 +4242,8 @@ for (int
 
 tile_size (Default_Tile_Size);
 rendering_increment_lines (Default_Rendering_Increment_Lines);
+rendering_threads (Default_Rendering_Threads);
+decoded_data_cache_size (Default_Decoded_Data_Cache_Size);
 background_color (Default_Background_Color_Text);
 line_color(Default_Line_Color_Text);
 }
@@ -4003,6 +4298,10 @@ Defaults_Button->setEnabled
 		!= Default_Scaling_Major_Increment		||
 	Rendering_Increment_Lines_spinBox->value ()
 		!= Default_Rendering_Increment_Lines	||
+	Rendering_Threads_spinBox->value ()
+		!= Default_Rendering_Threads			||
+	Decoded_Data_Cache_Size_spinBox->value ()
+		!= Default_Decoded_Data_Cache_Size		||
 	Tile_Size_spinBox->value ()
 		!= Default_Tile_Size					||
 	Background_Color_lineEdit->text ()
@@ -4092,6 +4391,14 @@ Rendering_Increment_Lines_Reset_Button->setVisible (change =
 	(Rendering_Increment_Lines_spinBox->value ()
 		!= Rendering_Increment_Lines));
 changed |= change;
+Rendering_Threads_Reset_Button->setVisible (change =
+	(Rendering_Threads_spinBox->value ()
+		!= Rendering_Threads));
+changed |= change;
+Decoded_Data_Cache_Size_Reset_Button->setVisible (change =
+	(Decoded_Data_Cache_Size_spinBox->value ()
+		!= Decoded_Data_Cache_Size));
+changed |= change;
 //	Text fields manage their Reset_Buttons.
 changed |= (Background_Color_lineEdit->text ()
 		!= Background_Color_Text);
@@ -4145,6 +4452,10 @@ return
 		!= Scaling_Major_Increment		||
 	Rendering_Increment_Lines_spinBox->value ()
 		!= Rendering_Increment_Lines	||
+	Rendering_Threads_spinBox->value ()
+		!= Rendering_Threads			||
+	Decoded_Data_Cache_Size_spinBox->value ()
+		!= Decoded_Data_Cache_Size		||
 	Tile_Size_spinBox->value ()
 		!= Tile_Size					||
 	Background_Color_lineEdit->text ()
@@ -4286,6 +4597,24 @@ if (Rendering_Increment_Lines != Rendering_Increment_Lines_spinBox->value ())
 	//	>>> SIGNAL <<<
 	emit rendering_increment_lines_changed (Rendering_Increment_Lines);
 	}
+if (Rendering_Threads != Rendering_Threads_spinBox->value ())
+	{
+	Rendering_Threads = Rendering_Threads_spinBox->value ();
+	Rendering_Threads_Reset_Button->setVisible (false);
+	settings.setValue
+		(RENDERING_THREADS_KEY, Rendering_Threads);
+	//	>>> SIGNAL <<<
+	emit rendering_threads_changed (Rendering_Threads);
+	}
+if (Decoded_Data_Cache_Size != Decoded_Data_Cache_Size_spinBox->value ())
+	{
+	Decoded_Data_Cache_Size = Decoded_Data_Cache_Size_spinBox->value ();
+	Decoded_Data_Cache_Size_Reset_Button->setVisible (false);
+	settings.setValue
+		(DECODED_DATA_CACHE_SIZE_KEY, Decoded_Data_Cache_Size);
+	//	>>> SIGNAL <<<
+	emit decoded_data_cache_size_changed (Decoded_Data_Cache_Size);
+	}
 
 reset_modifier_buttons ();
 #if ((DEBUG_SECTION) & DEBUG_RENDERING)
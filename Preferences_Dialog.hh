@@ -414,6 +414,12 @@ static const char
 	*TILE_SIZE_KEY;
 static const char
 	*RENDERING_INCREMENT_LINES_KEY;
+static const char
+	*RENDERING_THREADS_KEY;
+static const char
+	*DECODED_DATA_CACHE_SIZE_KEY;
+static const char
+	*DECODED_DATA_SPILL_DIRECTORY_KEY;
 static const char
 	*BACKGROUND_COLOR_KEY;
 	
@@ -443,6 +449,10 @@ static int
 	Default_Tile_Size;
 static int
 	Default_Rendering_Increment_Lines;
+static int
+	Default_Rendering_Threads;
+static int
+	Default_Decoded_Data_Cache_Size;
 static QRgb
 	Default_Background_Color;
 
@@ -480,6 +490,23 @@ inline int tile_size () const
 inline int rendering_increment_lines () const
 	{return Rendering_Increment_Lines;}
 
+inline int rendering_threads () const
+	{return Rendering_Threads;}
+
+inline int decoded_data_cache_size () const
+	{return Decoded_Data_Cache_Size;}
+
+/**	Get the decoded data spill directory.
+
+	There is no dialog control for this value; it is only set in the
+	preferences settings file.
+
+	@return	The pathname of the directory where decoded source data is
+		spilled. This will be empty if no spill directory is to be used.
+*/
+inline QString decoded_data_spill_directory () const
+	{return Decoded_Data_Spill_Directory;}
+
 inline QRgb background_color () const
 	{return Background_Color;}
 
@@ -502,6 +529,8 @@ void background_color_changed (QRgb color);
 void line_color_changed (const QColor & color);
 void tile_size_changed (int size);
 void rendering_increment_lines_changed (int lines);
+void rendering_threads_changed (int threads);
+void decoded_data_cache_size_changed (int size);
 
 /*==============================================================================
 	Slots:
@@ -540,6 +569,10 @@ void tile_size_change ();
 void tile_size_reset ();
 void rendering_increment_lines_change ();
 void rendering_increment_lines_reset ();
+void rendering_threads_change ();
+void rendering_threads_reset ();
+void decoded_data_cache_size_change ();
+void decoded_data_cache_size_reset ();
 
 void changing ();
 
@@ -563,6 +596,8 @@ static QString color_text (QRgb color);
 static QRgb color_value (const QString& text);
 void tile_size (int size);
 void rendering_increment_lines (int lines);
+void rendering_threads (int threads);
+void decoded_data_cache_size (int size);
 
 void reset_modifier_buttons ();
 void reset_defaults_button ();
@@ -615,6 +650,22 @@ QSpinBox
 Icon_Button
 	*Rendering_Increment_Lines_Reset_Button;
 
+int
+	Rendering_Threads;
+QSpinBox
+	*Rendering_Threads_spinBox;
+Icon_Button
+	*Rendering_Threads_Reset_Button;
+
+int
+	Decoded_Data_Cache_Size;
+QSpinBox
+	*Decoded_Data_Cache_Size_spinBox;
+Icon_Button
+	*Decoded_Data_Cache_Size_Reset_Button;
+QString
+	Decoded_Data_Spill_Directory;
+
 QRgb
 	Background_Color;
 QString
@@ -1135,6 +1186,15 @@ inline int tile_size () const
 inline int rendering_increment_lines () const
 	{return Rendering->rendering_increment_lines ();}
 
+inline int rendering_threads () const
+	{return Rendering->rendering_threads ();}
+
+inline int decoded_data_cache_size () const
+	{return Rendering->decoded_data_cache_size ();}
+
+inline QString decoded_data_spill_directory () const
+	{return Rendering->decoded_data_spill_directory ();}
+
 //	JPIP:
 
 //inline QString HTTP_to_JPIP_hostname () const
@@ -1195,6 +1255,8 @@ void background_color_changed (QRgb color);
 void line_color_changed (const QColor & color);
 void tile_size_changed (int size);
 void rendering_increment_lines_changed (int lines);
+void rendering_threads_changed (int threads);
+void decoded_data_cache_size_changed (int size);
 
 //void HTTP_to_JPIP_hostname_changed (const QString& proxy);
 void JPIP_server_port_changed (int port);
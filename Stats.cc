@@ -25,6 +25,7 @@ Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
 
 #include	<QtAlgorithms>
 
+#include	<algorithm>
 #include	<cmath>
 #include	<sstream>
 using std::ostringstream;
@@ -116,6 +117,7 @@ if (this != &stats)
 		Mean_Value[index]        = stats.Mean_Value[index];
 		Median_Value[index]      = stats.Median_Value[index];
 		Std_Dev_of_Values[index] = stats.Std_Dev_of_Values[index];
+		Cumulative_Counts[index] = stats.Cumulative_Counts[index];
 		}
 	Histograms = stats.Histograms;
 	}
@@ -223,15 +225,10 @@ if (Histograms[index] &&
 	Valid_Area[index] &&
 	value < Highest_Value[index])
 	{
-	Histogram
-		*histogram = Histograms[index];
+	const unsigned long long
+		*cumulative = Cumulative_Counts[index].constData ();
 	unsigned long long
-		count = 0;
-	for (int
-			bin = Highest_Value[index];
-			bin > value;
-		  --bin)
-		count += histogram->at (bin);
+		count = cumulative[Highest_Value[index]] - cumulative[value];
 
 	#if ((DEBUG_SECTION) & DEBUG_VALUE_AT)
 	clog << "    accumulated histogram count = " << count << endl;
@@ -262,15 +259,14 @@ if (Histograms[index] &&
 	Valid_Area[index] &&
 	value > Lowest_Value[index])
 	{
-	Histogram
-		*histogram = Histograms[index];
+	const QVector<unsigned long long>
+		&cumulative = Cumulative_Counts[index];
+	if (value > cumulative.size ())
+		value = cumulative.size ();
 	unsigned long long
-		count = 0;
-	for (int
-			bin = Lowest_Value[index];
-			bin < value;
-		  ++bin)
-		count += histogram->at (bin);
+		count = cumulative[value - 1];
+	if (Lowest_Value[index] > 0)
+		count -= cumulative[Lowest_Value[index] - 1];
 	percent = ((double)count / Valid_Area[index]) * 100.0;
 	}
 return percent;
@@ -296,14 +292,19 @@ if (Histograms[index] &&
 	if (Valid_Area[index] &&
 		percent > 0.0)
 		{
-		Histogram
-			*histogram = Histograms[index];
+		/*	The value is the lowest for which the area from the value
+			to the highest value is at least the percentage area;
+			i.e. the first value with a cumulative count, below it,
+			greater than the cumulative count at the highest value
+			less the percentage area.
+		*/
+		const unsigned long long
+			*cumulative = Cumulative_Counts[index].constData ();
 		unsigned long long
-			count = histogram->at (value),
 			area = static_cast<unsigned long long>
 				((percent / 100.0) * Valid_Area[index]);
-		while (count < area)
-			count += histogram->at (--value);
+		value = std::upper_bound (cumulative, cumulative + value,
+			cumulative[value] - area) - cumulative;
 		}
 	}
 else
@@ -331,14 +332,18 @@ if (Histograms[index] &&
 	if (Valid_Area[index] &&
 		percent > 0.0)
 		{
-		Histogram
-			*histogram = Histograms[index];
+		/*	The value is the lowest for which the area from the lowest
+			value to the value is at least the percentage area.
+		*/
+		const QVector<unsigned long long>
+			&cumulative = Cumulative_Counts[index];
 		unsigned long long
-			count = histogram->at (value),
 			area = static_cast<unsigned long long>
 				((percent / 100.0) * Valid_Area[index]);
-		while (count < area)
-			count += histogram->at (++value);
+		if (value > 0)
+			area += cumulative[value - 1];
+		value = std::lower_bound (cumulative.constBegin () + value,
+			cumulative.constEnd (), area) - cumulative.constBegin ();
 		}
 	}
 else
@@ -407,6 +412,7 @@ while (++index < last_index)
 	Mean_Value[index]        = 0;
 	Median_Value[index]      = 0;
 	Std_Dev_of_Values[index] = 0;
+	Cumulative_Counts[index].resize (0);
 
 	if (Histograms[index])
 		{
@@ -534,6 +540,16 @@ while (++index < last_index)
 			Std_Dev_of_Values[index] =
 				sqrt (accumulator / counted_values);
 			}
+
+		//	Cumulative counts for the percentage queries.
+		QVector<unsigned long long>
+			&cumulative = Cumulative_Counts[index];
+		cumulative.resize (histogram->size ());
+		area_count = 0;
+		for (value = 0;
+			 value < histogram->size ();
+			 value++)
+			cumulative[value] = (area_count += histogram->at (value));
 		}
 	#if ((DEBUG_SECTION) & (DEBUG_CALCULATE | DEBUG_VALUES))
 	clog << "             Lower_Area = " << Lower_Area[index] << endl
@@ -574,6 +590,7 @@ while (index--)
 	Mean_Value[index]        = 0;
 	Median_Value[index]      = 0;
 	Std_Dev_of_Values[index] = 0;
+	Cumulative_Counts[index].resize (0);
 
 	if (Histograms[index])
 		Histograms[index]->fill (0);
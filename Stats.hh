@@ -579,6 +579,15 @@ double
 QVector<Histogram*>
 	Histograms;
 
+/*	Cumulative histogram counts for each statistics set.
+
+	Each entry is the sum of the histogram counts at and below the
+	entry's value. The percentage queries are answered by differences
+	and binary searches of these tables.
+*/
+QVector<unsigned long long>
+	Cumulative_Counts[3];
+
 };
 
 
@@ -0,0 +1,545 @@
+/*	Tile_Memory_Arena
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#include	"Tile_Memory_Arena.hh"
+
+#include	<QList>
+#include	<QMap>
+#include	<QMutex>
+#include	<QMutexLocker>
+#include	<QtGlobal>
+
+#ifdef _WIN32
+#include	<windows.h>
+#else
+#include	<sys/mman.h>
+#include	<unistd.h>
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS	MAP_ANON
+#endif
+#endif
+
+
+#if defined (DEBUG_SECTION)
+/*******************************************************************************
+	DEBUG_SECTION controls
+
+	DEBUG_SECTION report selection options.
+	Define any of the following options to obtain the desired debug reports:
+*/
+#define DEBUG_OFF			0
+#define DEBUG_ALL			-1
+#define DEBUG_BLOCKS		(1 << 0)
+
+#define DEBUG_DEFAULT		DEBUG_ALL
+
+#if (DEBUG_SECTION+0) == 0
+#undef  DEBUG_SECTION
+#define DEBUG_SECTION DEBUG_OFF
+#else
+#include	<iostream>
+using std::clog;
+using std::endl;
+#endif
+
+#endif	//	DEBUG_SECTION
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/*==============================================================================
+	Constants
+*/
+const char* const
+	Tile_Memory_Arena::ID =
+		"UA::HiRISE::Tile_Memory_Arena ($Revision: 1.1 $ $Date: 2026/10/17 00:00:00 $)";
+
+#ifndef DEFAULT_TILE_MEMORY_BLOCK_SIZE
+#define DEFAULT_TILE_MEMORY_BLOCK_SIZE		(16 * 1024 * 1024)
+#endif
+const std::size_t
+	Tile_Memory_Arena::DEFAULT_BLOCK_SIZE	= DEFAULT_TILE_MEMORY_BLOCK_SIZE;
+
+#ifndef DEFAULT_TILE_MEMORY_MAX_BYTES
+#define DEFAULT_TILE_MEMORY_MAX_BYTES		((std::size_t)1024 * 1024 * 1024)
+#endif
+const std::size_t
+	Tile_Memory_Arena::DEFAULT_MAX_BYTES	= DEFAULT_TILE_MEMORY_MAX_BYTES;
+
+#ifndef DEFAULT_TILE_MEMORY_ARENA
+#define DEFAULT_TILE_MEMORY_ARENA			true
+#endif
+
+#ifndef DEFAULT_TILE_MEMORY_HUGE_PAGES
+#define DEFAULT_TILE_MEMORY_HUGE_PAGES		true
+#endif
+
+namespace
+{
+struct Memory_Block
+{
+char
+	*Base;
+std::size_t
+	Size,
+	Slot_Size;
+int
+	Live_Slots;
+};
+
+struct Memory_Arena
+{
+//	Blocks by base address.
+QMap<quintptr, Memory_Block*>
+	Blocks;
+//	Free slots by slot size.
+QMap<std::size_t, QList<char*> >
+	Free_Slots;
+//	Users of each served tile storage size.
+QMap<std::size_t, int>
+	Tile_Sizes;
+std::size_t
+	Page_Size,
+	Reserved_Bytes,
+	Live_Bytes,
+	Max_Bytes;
+bool
+	Enabled,
+	Huge_Pages;
+QMutex
+	Lock;
+
+Memory_Arena ()
+	:	Page_Size (4096),
+		Reserved_Bytes (0),
+		Live_Bytes (0),
+		Max_Bytes (Tile_Memory_Arena::DEFAULT_MAX_BYTES),
+		Enabled (DEFAULT_TILE_MEMORY_ARENA),
+		Huge_Pages (DEFAULT_TILE_MEMORY_HUGE_PAGES)
+{
+#ifdef _WIN32
+SYSTEM_INFO
+	system_info;
+GetSystemInfo (&system_info);
+Page_Size = system_info.dwPageSize;
+#else
+long
+	page_size = sysconf (_SC_PAGESIZE);
+if (page_size > 0)
+	Page_Size = page_size;
+#endif
+}
+
+char*
+map_memory
+	(
+	std::size_t	size
+	)
+{
+#ifdef _WIN32
+return static_cast<char*>(VirtualAlloc
+	(NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+#else
+void
+	*memory = mmap (NULL, size, PROT_READ | PROT_WRITE,
+		MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+if (memory == MAP_FAILED)
+	return NULL;
+#ifdef MADV_HUGEPAGE
+if (Huge_Pages)
+	madvise (memory, size, MADV_HUGEPAGE);
+#endif
+return static_cast<char*>(memory);
+#endif
+}
+
+void
+unmap_memory
+	(
+	Memory_Block*	block
+	)
+{
+#ifdef _WIN32
+VirtualFree (block->Base, 0, MEM_RELEASE);
+#else
+munmap (block->Base, block->Size);
+#endif
+}
+
+//	Release the unused blocks, other than of a slot size, until the size fits.
+void
+release_blocks
+	(
+	std::size_t	size,
+	std::size_t	keep_slot_size = 0
+	)
+{
+QMap<quintptr, Memory_Block*>::iterator
+	entry = Blocks.begin ();
+while (entry != Blocks.end () &&
+		Reserved_Bytes + size > Max_Bytes)
+	{
+	Memory_Block
+		*block = entry.value ();
+	if (block->Live_Slots ||
+		block->Slot_Size == keep_slot_size)
+		{
+		++entry;
+		continue;
+		}
+	QList<char*>
+		&free_list = Free_Slots[block->Slot_Size];
+	for (int
+			index = 0;
+			index < free_list.size ();
+			)
+		{
+		if (free_list[index] >= block->Base &&
+			free_list[index] <  block->Base + block->Size)
+			free_list.removeAt (index);
+		else
+			++index;
+		}
+	if (free_list.isEmpty ())
+		Free_Slots.remove (block->Slot_Size);
+	#if ((DEBUG_SECTION) & DEBUG_BLOCKS)
+	clog << ">-< Tile_Memory_Arena: release block @ " << (void*)block->Base
+			<< ", " << block->Size << " bytes of "
+			<< block->Slot_Size << " byte slots" << endl;
+	#endif
+	Reserved_Bytes -= block->Size;
+	unmap_memory (block);
+	delete block;
+	entry = Blocks.erase (entry);
+	}
+}
+};
+
+/*	The arena is never destroyed.
+
+	Images using arena storage may be deleted during program exit
+	after static objects have been destroyed.
+*/
+Memory_Arena&
+arena ()
+{
+static Memory_Arena
+	*memory_arena = new Memory_Arena;
+return *memory_arena;
+}
+}
+
+/*==============================================================================
+	Storage
+*/
+bool
+Tile_Memory_Arena::serves
+	(
+	std::size_t	bytes
+	)
+{
+Memory_Arena
+	&memory = arena ();
+QMutexLocker
+	lock (&memory.Lock);
+return
+	memory.Enabled &&
+	memory.Tile_Sizes.contains (bytes);
+}
+
+
+void*
+Tile_Memory_Arena::allocate
+	(
+	std::size_t	bytes
+	)
+{
+Memory_Arena
+	&memory = arena ();
+QMutexLocker
+	lock (&memory.Lock);
+if (! memory.Enabled ||
+	! memory.Tile_Sizes.contains (bytes))
+	return NULL;
+
+std::size_t
+	slot_size =
+		((bytes + memory.Page_Size - 1) / memory.Page_Size) * memory.Page_Size;
+QList<char*>
+	*free_list = NULL;
+QMap<std::size_t, QList<char*> >::iterator
+	free_slots = memory.Free_Slots.find (slot_size);
+if (free_slots == memory.Free_Slots.end () ||
+	free_slots->isEmpty ())
+	{
+	//	New block.
+	std::size_t
+		block_slots = qMax<std::size_t> (1, DEFAULT_BLOCK_SIZE / slot_size),
+		block_size;
+	if (memory.Reserved_Bytes + (block_slots * slot_size) > memory.Max_Bytes)
+		memory.release_blocks (block_slots * slot_size, slot_size);
+	if (memory.Reserved_Bytes + (block_slots * slot_size) > memory.Max_Bytes)
+		{
+		//	Fit what is available.
+		block_slots = (memory.Reserved_Bytes < memory.Max_Bytes) ?
+			(memory.Max_Bytes - memory.Reserved_Bytes) / slot_size : 0;
+		if (! block_slots)
+			{
+			#if ((DEBUG_SECTION) & DEBUG_BLOCKS)
+			clog << ">-< Tile_Memory_Arena::allocate: " << bytes
+					<< " bytes exceeds the " << memory.Max_Bytes
+					<< " byte limit" << endl;
+			#endif
+			return NULL;
+			}
+		}
+	block_size = block_slots * slot_size;
+
+	Memory_Block
+		*block = new Memory_Block;
+	if (! (block->Base = memory.map_memory (block_size)))
+		{
+		delete block;
+		return NULL;
+		}
+	block->Size = block_size;
+	block->Slot_Size = slot_size;
+	block->Live_Slots = 0;
+	memory.Blocks.insert (reinterpret_cast<quintptr>(block->Base), block);
+	memory.Reserved_Bytes += block_size;
+	#if ((DEBUG_SECTION) & DEBUG_BLOCKS)
+	clog << ">-< Tile_Memory_Arena::allocate: new block @ "
+			<< (void*)block->Base << ", " << block_slots << " slots of "
+			<< slot_size << " bytes" << endl;
+	#endif
+
+	free_list = &memory.Free_Slots[slot_size];
+	//	Lowest addresses first.
+	while (block_slots--)
+		free_list->append (block->Base + (block_slots * slot_size));
+	}
+else
+	free_list = &free_slots.value ();
+
+char
+	*storage = free_list->takeLast ();
+QMap<quintptr, Memory_Block*>::iterator
+	entry = memory.Blocks.upperBound (reinterpret_cast<quintptr>(storage));
+(--entry).value ()->Live_Slots++;
+memory.Live_Bytes += slot_size;
+return storage;
+}
+
+
+void
+Tile_Memory_Arena::release
+	(
+	void*	storage
+	)
+{
+if (! storage)
+	return;
+Memory_Arena
+	&memory = arena ();
+QMutexLocker
+	lock (&memory.Lock);
+QMap<quintptr, Memory_Block*>::iterator
+	entry = memory.Blocks.upperBound (reinterpret_cast<quintptr>(storage));
+if (entry == memory.Blocks.begin ())
+	return;
+Memory_Block
+	*block = (--entry).value ();
+if (static_cast<char*>(storage) >= block->Base + block->Size)
+	return;
+block->Live_Slots--;
+memory.Live_Bytes -= block->Slot_Size;
+memory.Free_Slots[block->Slot_Size].append (static_cast<char*>(storage));
+}
+
+
+void
+Tile_Memory_Arena::trim ()
+{
+Memory_Arena
+	&memory = arena ();
+QMutexLocker
+	lock (&memory.Lock);
+std::size_t
+	max_bytes = memory.Max_Bytes;
+memory.Max_Bytes = 0;
+memory.release_blocks (0);
+memory.Max_Bytes = max_bytes;
+}
+
+/*==============================================================================
+	Accessors
+*/
+void
+Tile_Memory_Arena::enabled
+	(
+	bool	enabled
+	)
+{
+Memory_Arena
+	&memory = arena ();
+QMutexLocker
+	lock (&memory.Lock);
+memory.Enabled = enabled;
+}
+
+
+bool
+Tile_Memory_Arena::enabled ()
+{
+Memory_Arena
+	&memory = arena ();
+QMutexLocker
+	lock (&memory.Lock);
+return memory.Enabled;
+}
+
+
+void
+Tile_Memory_Arena::max_bytes
+	(
+	std::size_t	bytes
+	)
+{
+Memory_Arena
+	&memory = arena ();
+QMutexLocker
+	lock (&memory.Lock);
+memory.Max_Bytes = bytes;
+memory.release_blocks (0);
+}
+
+
+std::size_t
+Tile_Memory_Arena::max_bytes ()
+{
+Memory_Arena
+	&memory = arena ();
+QMutexLocker
+	lock (&memory.Lock);
+return memory.Max_Bytes;
+}
+
+
+void
+Tile_Memory_Arena::add_tile_size
+	(
+	std::size_t	bytes
+	)
+{
+if (! bytes)
+	return;
+Memory_Arena
+	&memory = arena ();
+QMutexLocker
+	lock (&memory.Lock);
+++memory.Tile_Sizes[bytes];
+}
+
+
+void
+Tile_Memory_Arena::remove_tile_size
+	(
+	std::size_t	bytes
+	)
+{
+Memory_Arena
+	&memory = arena ();
+QMutexLocker
+	lock (&memory.Lock);
+QMap<std::size_t, int>::iterator
+	entry = memory.Tile_Sizes.find (bytes);
+if (entry != memory.Tile_Sizes.end () &&
+	--entry.value () <= 0)
+	memory.Tile_Sizes.erase (entry);
+}
+
+
+void
+Tile_Memory_Arena::huge_pages
+	(
+	bool	enabled
+	)
+{
+Memory_Arena
+	&memory = arena ();
+QMutexLocker
+	lock (&memory.Lock);
+memory.Huge_Pages = enabled;
+}
+
+
+bool
+Tile_Memory_Arena::huge_pages ()
+{
+Memory_Arena
+	&memory = arena ();
+QMutexLocker
+	lock (&memory.Lock);
+return memory.Huge_Pages;
+}
+
+/*==============================================================================
+	Usage
+*/
+std::size_t
+Tile_Memory_Arena::reserved_bytes ()
+{
+Memory_Arena
+	&memory = arena ();
+QMutexLocker
+	lock (&memory.Lock);
+return memory.Reserved_Bytes;
+}
+
+
+std::size_t
+Tile_Memory_Arena::live_bytes ()
+{
+Memory_Arena
+	&memory = arena ();
+QMutexLocker
+	lock (&memory.Lock);
+return memory.Live_Bytes;
+}
+
+
+std::size_t
+Tile_Memory_Arena::free_bytes ()
+{
+Memory_Arena
+	&memory = arena ();
+QMutexLocker
+	lock (&memory.Lock);
+return memory.Reserved_Bytes - memory.Live_Bytes;
+}
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
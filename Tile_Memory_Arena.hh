@@ -0,0 +1,225 @@
+/*	Tile_Memory_Arena
+
+HiROC CVS ID: $Id$
+
+Copyright (C) 2026  Arizona Board of Regents on behalf of the
+Planetary Image Research Laboratory, Lunar and Planetary Laboratory at
+the University of Arizona.
+
+This library is free software; you can redistribute it and/or modify it
+under the terms of the GNU Lesser General Public License, version 2.1,
+as published by the Free Software Foundation.
+
+This library is distributed in the hope that it will be useful, but
+WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this library; if not, write to the Free Software Foundation,
+Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+*******************************************************************************/
+
+#ifndef HiView_Tile_Memory_Arena_hh
+#define HiView_Tile_Memory_Arena_hh
+
+#include	<cstddef>
+
+
+namespace UA
+{
+namespace HiRISE
+{
+/**	The <i>Tile_Memory_Arena</i> provides pixel storage for image tiles
+	from a few large memory blocks.
+
+	A tiled image display creates, recycles and deletes many images of
+	the same size. Rather than allocating each image's pixel storage
+	separately from the heap, the storage is taken from slabs: large,
+	page aligned blocks of memory that are divided into equal sized
+	slots. Each block serves a single slot size, which is the requested
+	storage size rounded up to a whole number of memory pages. Released
+	slots are reused for later allocations of the same size; blocks are
+	only returned to the system when they are entirely unused and
+	either memory is needed for another slot size or the arena is
+	{@link trim() trimmed}.
+
+	The total memory reserved by the arena is limited to a {@link
+	max_bytes(std::size_t) maximum}: when the limit is reached no more
+	storage is allocated. Only allocations of the {@link
+	add_tile_size(std::size_t) tile storage sizes} in use are served by
+	the arena; storage for other images, which are few and of varied
+	sizes, is better left to the heap. On systems that support them the blocks may be
+	advised to use {@link huge_pages(bool) huge pages}.
+
+	The current {@link live_bytes() live} and {@link free_bytes() free}
+	storage usage is available for reporting.
+
+	The Tile_Memory_Arena is thread safe.
+
+	@version	$Revision: 1.1 $
+*/
+class Tile_Memory_Arena
+{
+public:
+/*==============================================================================
+	Constants
+*/
+//!	Class identification name with source code version and date.
+static const char* const
+	ID;
+
+//!	Default size of a memory block.
+static const std::size_t
+	DEFAULT_BLOCK_SIZE;
+
+//!	Default maximum memory reserved by the arena.
+static const std::size_t
+	DEFAULT_MAX_BYTES;
+
+/*==============================================================================
+	Storage
+*/
+/**	Test if the arena serves a storage allocation.
+
+	@param	bytes	The size of the storage.
+	@return	true if the arena is {@link enabled() enabled} and the
+		allocation is one of the {@link add_tile_size(std::size_t)
+		tile storage sizes} in use; false otherwise.
+*/
+static bool serves (std::size_t bytes);
+
+/**	Allocate storage.
+
+	@param	bytes	The size of the storage.
+	@return	A pointer to page aligned storage of at least the specified
+		size. This will be NULL if the arena does not {@link
+		serves(std::size_t) serve} the allocation or the storage would
+		exceed the {@link max_bytes() maximum reserved memory}.
+*/
+static void* allocate (std::size_t bytes);
+
+/**	Release storage.
+
+	The signature of this function is compatible with a QImage
+	cleanup function.
+
+	@param	storage	A pointer to storage obtained from {@link
+		allocate(std::size_t) allocate}. If NULL nothing is done.
+*/
+static void release (void* storage);
+
+/**	Return all entirely unused memory blocks to the system.
+*/
+static void trim ();
+
+/*==============================================================================
+	Accessors
+*/
+/**	Enable or disable the arena.
+
+	When disabled the arena does not {@link serves(std::size_t) serve}
+	new allocations. Storage already allocated remains valid.
+
+	The default is enabled unless DEFAULT_TILE_MEMORY_ARENA is defined
+	false at compile time.
+
+	@param	enabled	true if the arena is to serve allocations; false
+		otherwise.
+*/
+static void enabled (bool enabled);
+
+/**	Test if the arena is enabled.
+
+	@return	true if the arena serves allocations; false otherwise.
+*/
+static bool enabled ();
+
+/**	Set the maximum memory reserved by the arena.
+
+	Unused memory blocks are returned to the system until the limit is
+	met, but storage in use is never released.
+
+	@param	bytes	The maximum number of bytes of memory to be reserved.
+*/
+static void max_bytes (std::size_t bytes);
+
+/**	Get the maximum memory reserved by the arena.
+
+	@return	The maximum number of bytes of memory that may be reserved.
+*/
+static std::size_t max_bytes ();
+
+/**	Add a tile storage size to be served by the arena.
+
+	Each user of tiles - e.g. a tiled image display - adds the storage
+	size of its tiles, and {@link remove_tile_size(std::size_t) removes}
+	it when its tile size changes or it no longer uses tiles. The same
+	size may be added by more than one user; it is served until every
+	user has removed it.
+
+	@param	bytes	The number of bytes of pixel storage for a tile. If
+		zero nothing is done.
+*/
+static void add_tile_size (std::size_t bytes);
+
+/**	Remove a tile storage size previously {@link
+	add_tile_size(std::size_t) added}.
+
+	Storage already allocated for the tile size remains valid; its
+	blocks are returned to the system when they become unused.
+
+	@param	bytes	The number of bytes of pixel storage for a tile.
+*/
+static void remove_tile_size (std::size_t bytes);
+
+/**	Enable or disable huge pages for new memory blocks.
+
+	Huge pages are only advised where the system supports them.
+
+	The default is enabled unless DEFAULT_TILE_MEMORY_HUGE_PAGES is
+	defined false at compile time.
+
+	@param	enabled	true if huge pages are to be advised; false otherwise.
+*/
+static void huge_pages (bool enabled);
+
+/**	Test if huge pages are enabled for new memory blocks.
+
+	@return	true if huge pages are advised; false otherwise.
+*/
+static bool huge_pages ();
+
+/*==============================================================================
+	Usage
+*/
+/**	Get the memory reserved by the arena.
+
+	@return	The number of bytes in all memory blocks.
+*/
+static std::size_t reserved_bytes ();
+
+/**	Get the storage in use.
+
+	@return	The number of bytes in allocated storage slots.
+*/
+static std::size_t live_bytes ();
+
+/**	Get the storage not in use.
+
+	@return	The number of bytes in free storage slots; i.e. the
+		{@link reserved_bytes() reserved bytes} less the {@link
+		live_bytes() live bytes}.
+*/
+static std::size_t free_bytes ();
+
+private:
+//	Not instantiable.
+Tile_Memory_Arena ();
+};
+
+
+}	//	namespace HiRISE
+}	//	namespace UA
+#endif
@@ -35,20 +35,30 @@ Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
 #include	"Image_Tile.hh"
 #include	"Plastic_Image.hh"
 #include	"Plastic_QImage.hh"
+#include	"Tile_Memory_Arena.hh"
 #include	"HiView_Utilities.hh"
 
 #include	<QPainter>
 #include	<QPaintEvent>
+#include	<QRegion>
 #include	<QMouseEvent>
 #include	<QPoint>
 #include	<QPointF>
 #include	<QErrorMessage>
 #include	<QApplication>
+#include	<QThread>
+#include	<QThreadPool>
+#include	<QRunnable>
+#include	<QAtomicInt>
+#include	<QSemaphore>
+#include	<QMap>
+#include	<QTimer>
 #include        <QDebug>
 
 #include	<algorithm>
 using std::min;
 using std::max;
+#include	<cmath>
 #include	<sstream>
 using std::ostringstream;
 #include	<stdexcept>
@@ -194,6 +204,41 @@ bool
 	Tiled_Image_Display::Default_Source_Image_Rendering =
 		DEFAULT_SOURCE_IMAGE_RENDERING;
 
+#ifndef DEFAULT_HISTOGRAM_INDEX
+#define DEFAULT_HISTOGRAM_INDEX			true
+#endif
+bool
+	Tiled_Image_Display::Histogram_Index_Enabled =
+		DEFAULT_HISTOGRAM_INDEX;
+
+#ifndef DEFAULT_SCROLL_REUSE
+#define DEFAULT_SCROLL_REUSE			true
+#endif
+bool
+	Tiled_Image_Display::Scroll_Reuse_Enabled =
+		DEFAULT_SCROLL_REUSE;
+
+#ifndef DEFAULT_PROGRESSIVE_RENDERING
+#define DEFAULT_PROGRESSIVE_RENDERING	true
+#endif
+bool
+	Tiled_Image_Display::Progressive_Rendering_Enabled =
+		DEFAULT_PROGRESSIVE_RENDERING;
+
+#ifndef DEFAULT_TILE_PREFETCH_BUDGET
+#define DEFAULT_TILE_PREFETCH_BUDGET	(16 * 1024 * 1024)
+#endif
+unsigned long
+	Tiled_Image_Display::Tile_Prefetch_Budget =
+		DEFAULT_TILE_PREFETCH_BUDGET;
+
+#ifndef DEFAULT_REPAINT_INTERVAL
+#define DEFAULT_REPAINT_INTERVAL		20
+#endif
+int
+	Tiled_Image_Display::Repaint_Interval =
+		DEFAULT_REPAINT_INTERVAL;
+
 /*------------------------------------------------------------------------------
 	Local
 */
@@ -206,6 +251,18 @@ enum
 	NO_TILES_RESET			= 0,
 	VISIBLE_TILES_RESET		= 1
 	};
+
+//	Maximum milliseconds between image moves in the same motion.
+const int
+	PREFETCH_MOTION_INTERVAL		= 750;
+
+//	Number of average motion steps to look ahead for prefetching.
+const double
+	PREFETCH_LOOKAHEAD_STEPS		= 8.0;
+
+//	Tolerance, in image pixels, for matching prefetched tile locations.
+const double
+	PREFETCH_LOCATION_TOLERANCE		= 0.01;
 }
 #endif
 
@@ -233,7 +290,8 @@ Tiled_Image_Display::Tiled_Image_Display
 		Tile_Image_Pool_Max (0),
 		Tile_Grid_Size (0, 0),
 		Tile_Display_Size (Default_Tile_Display_Size),
-		Tile_Image_Size (Tile_Display_Size)
+		Tile_Image_Size (Tile_Display_Size),
+		Tile_Memory_Bytes (0)
 {
 setObjectName ("Tiled_Image_Display");
 #if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
@@ -285,6 +343,13 @@ connect (Renderer,
 			SIGNAL (error (const QString&)),
 			SLOT (rendering_error (const QString&)));
 
+//	Incremental rendering repaints.
+Repaint_Timer = new QTimer (this);
+Repaint_Timer->setSingleShot (true);
+connect (Repaint_Timer,
+			SIGNAL (timeout ()),
+			SLOT (repaint_pending ()));
+
 //	Enable mouseMoveEvent tracking.
 setMouseTracking (true);
 
@@ -309,6 +374,7 @@ Renderer->finish
 	 Image_Renderer::WAIT_UNTIL_DONE);
 //	Delete all of the tiles.
 clear_tiles ();
+tile_memory_size (0);
 
 #if ((DEBUG_SECTION) & DEBUG_CONSTRUCTORS)
 LOCKED_LOGGING ((
@@ -509,6 +575,8 @@ if (successful)
 		>>> WARNING <<< The tile images must be deleted before the source image.
 	*/
 	clear_tiles ();
+	Placeholder_Image = QImage ();
+	cancel_pending_repaints ();
 
 	//	Switch over to the new Source and Reference images.
 	#if ((DEBUG_SECTION) & (DEBUG_SLOTS | DEBUG_LOAD_IMAGE | DEBUG_OVERVIEW))
@@ -689,7 +757,14 @@ if (successful)
 	if (! dynamic_cast<Plastic_QImage*>(Reference_Image) &&
 		(Tile_Display_Size.rwidth ()  > Default_Tile_Display_Size.rwidth () ||
 		 Tile_Display_Size.rheight () > Default_Tile_Display_Size.rheight ()))
-		 Tile_Display_Size = Default_Tile_Display_Size;	//	Multi-tile display.
+		{
+		Tile_Display_Size = Default_Tile_Display_Size;	//	Multi-tile display.
+		tile_memory_size ((std::size_t)Tile_Display_Size.width ()
+			* Tile_Display_Size.height () * sizeof (QRgb));
+		}
+	else
+		//	Only multi-tile displays use tile memory.
+		tile_memory_size (0);
 	reset_tile_image_size ();
 
 	//	Reset the origin, in image space, of the entire tile grid region.
@@ -869,6 +944,31 @@ if ((unsigned int)rendering_increment
 }
 
 
+void
+Tiled_Image_Display::rendering_threads
+	(
+	int		threads
+	)
+{
+#if (SYNCHRONOUS_RENDERING +0) != 1
+Image_Renderer_Thread::default_rendering_threads (threads);
+#else
+Q_UNUSED (threads);
+#endif
+}
+
+
+int
+Tiled_Image_Display::rendering_threads ()
+{
+#if (SYNCHRONOUS_RENDERING +0) != 1
+return Image_Renderer_Thread::default_rendering_threads ();
+#else
+return 1;
+#endif
+}
+
+
 void
 Tiled_Image_Display::background_color
 	(
@@ -1030,6 +1130,225 @@ emit image_metadata_changed (image.metadata ());
 /*------------------------------------------------------------------------------
 	Histograms
 */
+#ifndef DOXYGEN_PROCESSING
+namespace
+{
+/*	Source histograms scan.
+
+	A region of the image to be scanned and the tile images that
+	intersect it. A scan of a histogram index block produces its own
+	Block histograms for the index.
+*/
+struct Source_Histograms_Scan
+{
+QRect
+	Image_Region;
+QList<Plastic_Image*>
+	Tiles;
+QPoint
+	Block;
+bool
+	Indexed;
+Histogram_Index::Block
+	*Block_Histograms;
+};
+
+/*	Source histograms scanner.
+
+	Each scanner takes the next scan from a shared list. The tile images
+	of an edge region scan are accumulated into the scanner's own
+	histograms; the tile images of an index block scan are counted into
+	separate histograms from which the scan's Block histograms are
+	produced. The next scan in the list is taken by whichever scanner is
+	free, so the scanners balance the load of scans with different costs
+	among themselves. When all scanners are done their histograms are
+	merged.
+*/
+class Source_Histograms_Scanner
+:	public QRunnable
+{
+public:
+
+typedef Plastic_Image::Histogram	Histogram;
+
+Source_Histograms_Scanner
+	(
+	QVector<Source_Histograms_Scan>&	scans,
+	QAtomicInt&							next_scan,
+	const QVector<Histogram*>&			histograms,
+	QSemaphore&							done
+	)
+	:	Scans (scans.data ()),
+		Total_Scans (scans.size ()),
+		Next_Scan (next_scan),
+		Done (done),
+		Histograms (3),
+		Block_Histograms (3),
+		Counted (0),
+		Failed (false)
+{
+setAutoDelete (false);
+mirror (histograms, Histograms);
+mirror (histograms, Block_Histograms);
+}
+
+~Source_Histograms_Scanner ()
+{
+release (Histograms);
+release (Block_Histograms);
+}
+
+//	Scan on a pool thread; the scanner is done when it is released.
+void run ()
+{
+scan ();
+Done.release ();
+}
+
+void scan ()
+{
+unsigned long long
+	counted;
+int
+	index,
+	band;
+while ((index = Next_Scan.fetchAndAddOrdered (1)) < Total_Scans)
+	{
+	Source_Histograms_Scan
+		&scan = Scans[index];
+	QVector<Histogram*>
+		&histograms = scan.Indexed ? Block_Histograms : Histograms;
+	if (scan.Indexed)
+		for (band = 0;
+			 band < 3;
+			 band++)
+			histograms[band]->fill (0);
+
+	for (int
+			tile = 0;
+			tile < scan.Tiles.size ();
+			tile++)
+		{
+		if ((counted = scan.Tiles[tile]->source_histograms
+				(histograms, scan.Image_Region)))
+			Counted += counted;
+		else
+			{
+			Failed = true;
+			//	Stop all scanners.
+			Next_Scan.fetchAndStoreOrdered (Total_Scans);
+			break;
+			}
+		}
+	if (scan.Indexed &&
+		! Failed)
+		scan.Block_Histograms = new Histogram_Index::Block (histograms);
+	}
+}
+
+/*	Merge the scanned histograms into a histograms set.
+
+	Histograms that are shared by bands are only merged once.
+*/
+void merge
+	(
+	QVector<Histogram*>&	histograms
+	) const
+{
+int
+	band,
+	other_band,
+	entry;
+for (band = 0;
+	 band < 3;
+	 band++)
+	{
+	if (! histograms[band])
+		continue;
+	other_band = band;
+	while (other_band--)
+		if (histograms[band] == histograms[other_band])
+			break;
+	if (other_band >= 0)
+		continue;
+
+	const Histogram
+		&source = *Histograms[band];
+	if (histograms[band]->size () < source.size ())
+		histograms[band]->resize (source.size ());
+	quint64
+		*counts = histograms[band]->data ();
+	for (entry = 0;
+		 entry < source.size ();
+		 entry++)
+		counts[entry] += source[entry];
+	}
+}
+
+//	Mirror a histograms set, including any histograms shared by bands.
+static void mirror
+	(
+	const QVector<Histogram*>&	histograms,
+	QVector<Histogram*>&		mirrored
+	)
+{
+int
+	band,
+	other_band;
+for (band = 0;
+	 band < 3;
+	 band++)
+	{
+	other_band = band;
+	if (histograms[band])
+		while (other_band--)
+			if (histograms[band] == histograms[other_band])
+				break;
+	if (other_band >= 0 &&
+		other_band != band)
+		mirrored[band] = mirrored[other_band];
+	else
+		mirrored[band] = new Histogram
+			(histograms[band] ? histograms[band]->size () : 0);
+	}
+}
+
+static void release
+	(
+	QVector<Histogram*>&	histograms
+	)
+{
+for (int
+		band = 0;
+		band < 3;
+		band++)
+	if (band == 0 ||
+		(histograms[band] != histograms[band - 1] &&
+		 (band == 1 ||
+		  histograms[band] != histograms[0])))
+		delete histograms[band];
+}
+
+Source_Histograms_Scan
+	*Scans;
+int
+	Total_Scans;
+QAtomicInt
+	&Next_Scan;
+QSemaphore
+	&Done;
+QVector<Histogram*>
+	Histograms,
+	Block_Histograms;
+unsigned long long
+	Counted;
+bool
+	Failed;
+};
+}
+#endif
+
+
 bool
 Tiled_Image_Display::source_data_histograms
 	(
@@ -1093,14 +1412,17 @@ if (image_region.isEmpty ())
 	#endif
 	return true;
 	}
-unsigned long long
-	area = image_region.width () * image_region.height (),
-	counted,
-	count = 0;
 #if ((DEBUG_SECTION) & DEBUG_HISTOGRAMS)
-clog << "    image_region area = " << area << endl;
+clog << "    image_region area = "
+		<< ((unsigned long long)image_region.width () * image_region.height ())
+		<< endl;
 #endif
+if (histograms.size () < 3)
+	histograms.resize (3);
+
+//	Collect the tile images that intersect the image region.
 QList<Plastic_Image*>
+	selected_tiles,
 	*tiles;
 Plastic_Image
 	*tile_image;
@@ -1117,33 +1439,187 @@ while (tile_row--)
 			{
 			if ((tile_image = tiles->at (tile_col)) &&
 				image_region.intersects (tile_image->image_region ()))
+				selected_tiles.append (tile_image);
+			}
+		}
+	}
+
+/*	Assemble the scans of the image region.
+
+	When the histogram index is enabled the histograms of the index
+	blocks entirely within the image region that have already been
+	counted are taken from the index; the remaining blocks are scanned
+	for the index. Only the edge regions outside the blocks are scanned
+	directly.
+*/
+QVector<Source_Histograms_Scan>
+	scans;
+Source_Histograms_Scan
+	scan;
+scan.Indexed = false;
+scan.Block_Histograms = NULL;
+QRect
+	blocks_region;
+QList<QRect>
+	edge_regions;
+int
+	indexed_blocks = 0;
+if (Histogram_Index_Enabled)
+	{
+	/*	The index block size is scaled by powers of two as the image
+		scale is reduced so a block covers about the same amount of
+		tile image data at any scale.
+	*/
+	QSizeF
+		scaling (image_scaling ());
+	double
+		scale = qMin (scaling.width (), scaling.height ());
+	int
+		block_size = Histogram_Index::DEFAULT_BLOCK_SIZE;
+	while (scale > 0.0 &&
+			scale < 1.0 &&
+			block_size < (Histogram_Index::DEFAULT_BLOCK_SIZE << 8))
+		{
+		scale *= 2.0;
+		block_size <<= 1;
+		}
+	Source_Histogram_Index.reset
+		(block_size, Reference_Image->source_band_map ());
+	blocks_region = Source_Histogram_Index.blocks_region (image_region);
+	}
+if (blocks_region.isEmpty ())
+	edge_regions.append (image_region);
+else
+	{
+	edge_regions = Source_Histogram_Index.edge_regions (image_region);
+
+	int
+		block_size = Source_Histogram_Index.block_size (),
+		first_column = blocks_region.left () / block_size,
+		last_row = blocks_region.bottom () / block_size,
+		last_column = blocks_region.right () / block_size;
+	scan.Indexed = true;
+	for (scan.Block.ry () = blocks_region.top () / block_size;
+		 scan.Block.y () <= last_row;
+		 scan.Block.ry ()++)
+		{
+		for (scan.Block.rx () = first_column;
+			 scan.Block.x () <= last_column;
+			 scan.Block.rx ()++)
+			{
+			if (Source_Histogram_Index.add (histograms, scan.Block))
+				++indexed_blocks;
+			else
 				{
-				counted =
-					tile_image->source_histograms (histograms, image_region);
-				#if ((DEBUG_SECTION) & DEBUG_HISTOGRAMS)
-				clog << "    tile " << tile_col << ',' << tile_row << " - "
-						<< tile_image->image_region () << ": "
-						<< counted << " counted" << endl;
-				#endif
-				if (counted == 0)
-					{
-					#if ((DEBUG_SECTION) & DEBUG_HISTOGRAMS)
-					clog << "    no histogram" << endl;
-					#endif
-					goto Done;
-					}
-				if ((count += counted) >= area)
-					goto Completed;
+				scan.Image_Region =
+					Source_Histogram_Index.block_region (scan.Block);
+				scan.Tiles.clear ();
+				for (tile_col = 0;
+					 tile_col < selected_tiles.size ();
+					 tile_col++)
+					if (scan.Image_Region.intersects
+							(selected_tiles[tile_col]->image_region ()))
+						scan.Tiles.append (selected_tiles[tile_col]);
+				scans.append (scan);
 				}
 			}
 		}
+	scan.Indexed = false;
+	}
+//	Each edge region tile is a separate scan.
+while (! edge_regions.isEmpty ())
+	{
+	scan.Image_Region = edge_regions.takeFirst ();
+	for (tile_col = 0;
+		 tile_col < selected_tiles.size ();
+		 tile_col++)
+		{
+		if (scan.Image_Region.intersects
+				(selected_tiles[tile_col]->image_region ()))
+			{
+			scan.Tiles.clear ();
+			scan.Tiles.append (selected_tiles[tile_col]);
+			scans.append (scan);
+			}
+		}
 	}
 
-Completed:
+/*	Scan concurrently.
+
+	The calling thread is one of the scanners.
+*/
+QAtomicInt
+	next_scan (0);
+QSemaphore
+	scanners_done;
+int
+	scanners = qBound (1, QThread::idealThreadCount (), scans.size ());
+QList<Source_Histograms_Scanner*>
+	scanner_list;
+for (int
+		scanner = 0;
+		scanner < scanners;
+		scanner++)
+	scanner_list.append (new Source_Histograms_Scanner
+		(scans, next_scan, histograms, scanners_done));
+/*	The shared global pool is used; only the scanners for which a pool
+	thread is available now are started. Scans are taken from the shared
+	list, so the calling thread scans whatever the others do not.
+*/
+int
+	started = 0;
+for (int
+		scanner = 1;
+		scanner < scanners;
+		scanner++)
+	if (QThreadPool::globalInstance ()->tryStart (scanner_list[scanner]))
+		++started;
+scanner_list[0]->scan ();
+scanners_done.acquire (started);
+
+#if ((DEBUG_SECTION) & DEBUG_HISTOGRAMS)
+unsigned long long
+	count = 0;
+#endif
 completed = true;
+while (! scanner_list.isEmpty ())
+	{
+	Source_Histograms_Scanner
+		*scanner = scanner_list.takeFirst ();
+	if (scanner->Failed)
+		completed = false;
+	#if ((DEBUG_SECTION) & DEBUG_HISTOGRAMS)
+	count += scanner->Counted;
+	#endif
+	scanner->merge (histograms);
+	delete scanner;
+	}
 
-Done:
+//	Add the scanned blocks to the histograms and the index.
+for (int
+		index = 0;
+		index < scans.size ();
+		index++)
+	{
+	if (! scans[index].Block_Histograms)
+		continue;
+	if (completed)
+		{
+		scans[index].Block_Histograms->add_to (histograms);
+		Source_Histogram_Index.insert
+			(scans[index].Block, scans[index].Block_Histograms);
+		}
+	else
+		delete scans[index].Block_Histograms;
+	}
 #if ((DEBUG_SECTION) & DEBUG_HISTOGRAMS)
+clog << "    " << indexed_blocks << " indexed blocks of size "
+		<< Source_Histogram_Index.block_size () << " used" << endl
+	 << "    " << scans.size () << " scans of "
+		<< selected_tiles.size () << " tiles by "
+		<< scanners << " scanners: " << count << " counted" << endl;
+if (! completed)
+	clog << "    no histogram" << endl;
 clog << "<<< Tiled_Image_Display::source_data_histograms: "
 		<< boolalpha << completed << endl;
 #endif
@@ -1151,6 +1627,19 @@ return completed;
 }
 
 
+void
+Tiled_Image_Display::histogram_index
+	(
+	bool	enabled
+	)
+{Histogram_Index_Enabled = enabled;}
+
+
+bool
+Tiled_Image_Display::histogram_index ()
+{return Histogram_Index_Enabled;}
+
+
 bool
 Tiled_Image_Display::display_data_histograms
 	(
@@ -2054,6 +2543,132 @@ return region;
 }
 
 
+void
+Tiled_Image_Display::capture_placeholder ()
+{
+if (! Progressive_Rendering_Enabled ||
+	! Tile_Grid_Images ||
+	rect ().isEmpty ())
+	{
+	Placeholder_Image = QImage ();
+	return;
+	}
+
+QImage
+	placeholder (size (), QImage::Format_ARGB32_Premultiplied);
+placeholder.fill (Qt::transparent);
+bool
+	painted = false;
+QPainter
+	painter (&placeholder);
+
+//	Carry forward the previous placeholder where nothing new was rendered.
+if (! Placeholder_Image.isNull ())
+	{
+	paint_placeholder (painter, rect ());
+	painted = true;
+	}
+
+//	Snapshot the completed tiles in the viewport.
+QList<Plastic_Image*>
+	*tiles;
+Plastic_Image
+	*tile_image;
+QRect
+	tile_region;
+for (int
+		row = 0;
+		row < Tile_Grid_Images->size ();
+		row++)
+	{
+	if (! (tiles = Tile_Grid_Images->at (row)))
+		continue;
+	for (int
+			col = 0;
+			col < tiles->size ();
+			col++)
+		{
+		if (! (tile_image = tiles->at (col)) ||
+			tile_image->needs_update ())
+			continue;
+		tile_region = tile_display_region (QPoint (col, row));
+		if (! tile_region.intersects (rect ()))
+			continue;
+		painter.drawImage (tile_region, *tile_image);
+		painted = true;
+		}
+	}
+painter.end ();
+
+if (painted)
+	{
+	Placeholder_Image = placeholder;
+	Placeholder_Region = QRectF
+		(map_display_to_image (QPoint (0, 0)),
+		 map_display_to_image (QPoint (width (), height ())));
+	}
+else
+	Placeholder_Image = QImage ();
+#if ((DEBUG_SECTION) & DEBUG_PAINT)
+LOCKED_LOGGING ((
+clog << ">-< Tiled_Image_Display::capture_placeholder: image region "
+		<< Placeholder_Region << (painted ? "" : " (none)") << endl));
+#endif
+}
+
+
+void
+Tiled_Image_Display::paint_placeholder
+	(
+	QPainter&		painter,
+	const QRect&	tile_region
+	) const
+{
+if (Placeholder_Image.isNull () ||
+	tile_region.isEmpty ())
+	return;
+
+//	The image region of the tile at the current scaling.
+QRectF
+	image_region
+		(map_display_to_image (tile_region.topLeft ()),
+		 map_display_to_image (tile_region.bottomRight () + QPoint (1, 1))),
+	covered (image_region & Placeholder_Region);
+if (covered.isEmpty ())
+	return;
+
+//	Map the covered image region to the tile and to the placeholder.
+double
+	display_scale_x = tile_region.width ()  / image_region.width (),
+	display_scale_y = tile_region.height () / image_region.height (),
+	placeholder_scale_x =
+		Placeholder_Image.width ()  / Placeholder_Region.width (),
+	placeholder_scale_y =
+		Placeholder_Image.height () / Placeholder_Region.height ();
+QRectF
+	target
+		(tile_region.x () + (covered.x () - image_region.x ()) * display_scale_x,
+		 tile_region.y () + (covered.y () - image_region.y ()) * display_scale_y,
+		 covered.width ()  * display_scale_x,
+		 covered.height () * display_scale_y),
+	source
+		((covered.x () - Placeholder_Region.x ()) * placeholder_scale_x,
+		 (covered.y () - Placeholder_Region.y ()) * placeholder_scale_y,
+		 covered.width ()  * placeholder_scale_x,
+		 covered.height () * placeholder_scale_y);
+painter.drawImage (target, Placeholder_Image, source);
+}
+
+
+void
+Tiled_Image_Display::cancel_pending_repaints ()
+{
+Repaint_Timer->stop ();
+Pending_Repaint_Tiles.clear ();
+Pending_Repaint_Regions.clear ();
+}
+
+
 void
 Tiled_Image_Display::viewport_relative_region
 	(
@@ -2083,6 +2698,20 @@ return calculate_tile_image_size (band);
 }
 
 
+void
+Tiled_Image_Display::tile_memory_size
+	(
+	std::size_t	bytes
+	)
+{
+if (bytes != Tile_Memory_Bytes)
+	{
+	Tile_Memory_Arena::remove_tile_size (Tile_Memory_Bytes);
+	Tile_Memory_Arena::add_tile_size (Tile_Memory_Bytes = bytes);
+	}
+}
+
+
 bool
 Tiled_Image_Display::reset_tile_image_size ()
 {
@@ -2136,6 +2765,7 @@ if (tile_size.rheight () < MINIMUM_TILE_DIMENSION)
 if (tile_size != Tile_Display_Size)
 	{
 	Pending_State_Change_Enabled = false;
+	cancel_pending_repaints ();
 
 	//	Cancel all rendering.
 	Renderer->reset (Image_Renderer::WAIT_UNTIL_DONE);
@@ -2143,6 +2773,8 @@ if (tile_size != Tile_Display_Size)
 	//	Reset the tile grid.
 	clear_tiles ();
 	Tile_Display_Size = tile_size;
+	tile_memory_size ((std::size_t)Tile_Display_Size.width ()
+		* Tile_Display_Size.height () * sizeof (QRgb));
 	reset_tile_image_size ();
 	resize_tile_grid ();
 
@@ -2679,6 +3311,7 @@ if (clipped_origin != current_origin)
 	{
 	Pending_State_Change_Enabled = false;
 	change = UPDATE_DISPLAY;
+	cancel_pending_repaints ();
 
 	QPointF
 		location (clipped_origin);
@@ -2707,8 +3340,34 @@ if (clipped_origin != current_origin)
 		LOCKED_LOGGING ((
 		clog << "    map_image_to_tile = " << offset << endl));
 		#endif
-		if (offset.rx () < 0 ||
-			offset.ry () < 0)
+		bool
+			reset_grid = (offset.rx () < 0 || offset.ry () < 0);
+		if (reset_grid &&
+			Scroll_Reuse_Enabled)
+			{
+			/*	The new origin is outside the tile grid.
+
+				If the new display region still overlaps the tile grid
+				the grid is shifted, as for a move within the grid
+				margins, so the tiles that remain in view are not
+				rendered again.
+			*/
+			QPointF
+				grid_offset (location - Tiled_Image_Region.topLeft ());
+			offset.rx () = static_cast<int>
+				(std::floor (grid_offset.rx () / Tile_Image_Size.rwidth ()));
+			offset.ry () = static_cast<int>
+				(std::floor (grid_offset.ry () / Tile_Image_Size.rheight ()));
+			reset_grid =
+				qAbs (offset.rx () - 1) >= Tile_Grid_Size.rwidth () ||
+				qAbs (offset.ry () - 1) >= Tile_Grid_Size.rheight ();
+			#if ((DEBUG_SECTION) & (DEBUG_SLOTS | DEBUG_MOVE | DEBUG_ORIGIN))
+			LOCKED_LOGGING ((
+			clog << "    scroll reuse tile offset = " << offset
+					<< (reset_grid ? " - no overlap" : "") << endl));
+			#endif
+			}
+		if (reset_grid)
 			{
 			//	Now for someplace completely different.
 			change = RENDER_TILES;
@@ -2929,6 +3588,10 @@ if (clipped_origin != current_origin)
 		#endif
 		if ((tiles_reset = reset_tiles ()) != VISIBLE_TILES_RESET)
 			change = UPDATE_DISPLAY;
+		else
+		if (Progressive_Rendering_Enabled)
+			//	Show placeholders while the visible tiles are rendered.
+			update ();
 		#if ((DEBUG_SECTION) & (DEBUG_SLOTS | DEBUG_MOVE | DEBUG_ORIGIN))
 		if (tiles_reset)
 			{
@@ -2942,6 +3605,10 @@ if (clipped_origin != current_origin)
 		#endif
 		}
 
+	if (band <= 0)
+		//	Render ahead of the image motion.
+		prefetch_tiles (clipped_origin);
+
 	//	Restart rendering.
 	#if ((DEBUG_SECTION) & (DEBUG_SLOTS | DEBUG_MOVE | DEBUG_ORIGIN))
 	LOCKED_LOGGING ((
@@ -3288,7 +3955,15 @@ while (true)
 
 				origin_changed =
 				scaling_changed = false;
-				band = 3;
+				if (! Prefetch_Tiles.isEmpty () &&
+					adopt_prefetched_tile (tiles, tile_grid.rx (), tile_locations))
+					{
+					//	The prefetched tile is already at the tile locations.
+					tile_image = tiles->at (tile_grid.rx ());
+					band = 0;
+					}
+				else
+					band = 3;
 				while (band--)
 					{
 					#if ((DEBUG_SECTION) & (DEBUG_RESET_TILES | DEBUG_IMAGE_GEOMETRY))
@@ -3446,6 +4121,10 @@ UNLOCK_LOG;
 #endif
 //	Cancel all rendering.
 Renderer->reset (Image_Renderer::WAIT_UNTIL_DONE);
+Source_Histogram_Index.clear ();
+while (! Prefetch_Tiles.isEmpty ())
+	Renderer->delete_image (Prefetch_Tiles.takeLast ());
+Motion_Time = QTime ();
 QList<Plastic_Image*>
 	*tiles;
 QPoint
@@ -3499,6 +4178,8 @@ Tile_Image_Pool_Max = 0;
 
 //	Force the images queued for deletion to be deleted.
 Renderer->clean_up ();
+//	Return the unused tile memory.
+Tile_Memory_Arena::trim ();
 
 #if ((DEBUG_SECTION) & (DEBUG_TILE_GRID | DEBUG_CONSTRUCTORS))
 LOCK_LOG;
@@ -3516,6 +4197,316 @@ UNLOCK_LOG;
 #endif
 }
 
+
+void
+Tiled_Image_Display::prefetch_tiles
+	(
+	const QPointF&	origin
+	)
+{
+#if ((DEBUG_SECTION) & (DEBUG_MOVE | DEBUG_RESET_TILES))
+LOCKED_LOGGING ((
+clog << ">>> Tiled_Image_Display::prefetch_tiles: " << origin << endl));
+#endif
+//	Track the image motion.
+QPointF
+	step (origin - Motion_Origin);
+if (! Motion_Time.isValid () ||
+	Motion_Time.elapsed () > PREFETCH_MOTION_INTERVAL)
+	//	A new motion; the direction is not yet known.
+	Motion_Step = QPointF ();
+else
+if ((step.x () * Motion_Step.x () + step.y () * Motion_Step.y ()) <= 0.0)
+	//	Change of direction.
+	Motion_Step = step;
+else
+	Motion_Step = (Motion_Step + step) * 0.5;
+Motion_Origin = origin;
+Motion_Time.start ();
+
+unsigned long
+	tile_bytes = (unsigned long)Tile_Display_Size.width ()
+		* Tile_Display_Size.height () * sizeof (QRgb);
+int
+	max_tiles = tile_bytes ? (int)(Tile_Prefetch_Budget / tile_bytes) : 0,
+	tile_cols = Tile_Grid_Size.width (),
+	tile_rows = Tile_Grid_Size.height ();
+if (! max_tiles ||
+	! tile_cols ||
+	! tile_rows ||
+	Image_Loading ||
+	Tile_Image_Size.isEmpty ())
+	{
+	release_prefetched_tiles ();
+	#if ((DEBUG_SECTION) & (DEBUG_MOVE | DEBUG_RESET_TILES))
+	LOCKED_LOGGING ((
+	clog << "<<< Tiled_Image_Display::prefetch_tiles: disabled" << endl));
+	#endif
+	return;
+	}
+if (Motion_Step.isNull ())
+	{
+	#if ((DEBUG_SECTION) & (DEBUG_MOVE | DEBUG_RESET_TILES))
+	LOCKED_LOGGING ((
+	clog << "<<< Tiled_Image_Display::prefetch_tiles: no motion" << endl));
+	#endif
+	return;
+	}
+
+//	The image region ahead of the motion, limited to one viewport.
+QPointF
+	ahead (Motion_Step * PREFETCH_LOOKAHEAD_STEPS);
+double
+	limit = Displayed_Image_Region.width ();
+ahead.rx () = qBound (-limit, ahead.rx (), limit);
+limit = Displayed_Image_Region.height ();
+ahead.ry () = qBound (-limit, ahead.ry (), limit);
+QRectF
+	region (Displayed_Image_Region | Displayed_Image_Region.translated (ahead));
+QSizeF
+	size_of_image (image_size ());
+region &= QRectF (QPointF (0, 0), size_of_image);
+
+//	Tile grid locations covering the region, by distance from the grid.
+QPointF
+	grid_origin (Tiled_Image_Region.topLeft ());
+int
+	first_col = (int)std::floor
+		((region.left ()   - grid_origin.x ()) / Tile_Image_Size.width ()),
+	end_col   = (int)std::ceil
+		((region.right ()  - grid_origin.x ()) / Tile_Image_Size.width ()),
+	first_row = (int)std::floor
+		((region.top ()    - grid_origin.y ()) / Tile_Image_Size.height ()),
+	end_row   = (int)std::ceil
+		((region.bottom () - grid_origin.y ()) / Tile_Image_Size.height ()),
+	col,
+	row,
+	col_distance,
+	row_distance;
+QMap<int, QList<QPoint> >
+	cells;
+for (row = first_row;
+	 row < end_row;
+	 row++)
+	{
+	if (grid_origin.y () + (row * Tile_Image_Size.height ()) < 0 ||
+		grid_origin.y () + (row * Tile_Image_Size.height ())
+			>= size_of_image.height ())
+		continue;
+	row_distance = (row < 0) ? -row :
+		((row >= tile_rows) ? row - tile_rows + 1 : 0);
+	for (col = first_col;
+		 col < end_col;
+		 col++)
+		{
+		if (grid_origin.x () + (col * Tile_Image_Size.width ()) < 0 ||
+			grid_origin.x () + (col * Tile_Image_Size.width ())
+				>= size_of_image.width ())
+			continue;
+		col_distance = (col < 0) ? -col :
+			((col >= tile_cols) ? col - tile_cols + 1 : 0);
+		if (col_distance ||
+			row_distance)
+			cells[qMax (col_distance, row_distance)].append (QPoint (col, row));
+		}
+	}
+
+//	Tile image locations, for each band, of the tile grid origin.
+QPointF
+	locations[3],
+	grid_origins[3];
+QSizeF
+	tile_sizes[3],
+	scalings[3];
+int
+	band = 3;
+while (band--)
+	{
+	tile_sizes[band] = tile_image_size (band);
+	scalings[band] = image_scaling (band);
+	grid_origins[band] = displayed_tile_grid_origin (band);
+	grid_origins[band].rx () -= tile_sizes[band].rwidth ();
+	grid_origins[band].ry () -= tile_sizes[band].rheight ();
+	}
+
+QList<Plastic_Image*>
+	prefetched;
+Plastic_Image
+	*tile_image;
+int
+	index;
+for (QMap<int, QList<QPoint> >::const_iterator
+		distance = cells.constBegin ();
+		distance != cells.constEnd () &&
+		prefetched.size () < max_tiles;
+	  ++distance)
+	{
+	for (int
+			cell = 0;
+			cell < distance->size () &&
+			prefetched.size () < max_tiles;
+			cell++)
+		{
+		band = 3;
+		while (band--)
+			{
+			locations[band] = grid_origins[band];
+			locations[band].rx () +=
+				distance->at (cell).x () * tile_sizes[band].width ();
+			locations[band].ry () +=
+				distance->at (cell).y () * tile_sizes[band].height ();
+			}
+
+		//	Keep a tile already prefetched at the location.
+		for (index = 0,
+				tile_image = NULL;
+			 index < Prefetch_Tiles.size ();
+			 index++)
+			{
+			QPointF
+				offset (Prefetch_Tiles[index]->source_origin () - locations[0]);
+			if (qAbs (offset.x ()) < PREFETCH_LOCATION_TOLERANCE &&
+				qAbs (offset.y ()) < PREFETCH_LOCATION_TOLERANCE)
+				{
+				tile_image = Prefetch_Tiles.takeAt (index);
+				break;
+				}
+			}
+		if (! tile_image)
+			{
+			if (Tile_Image_Pool.isEmpty ())
+				{
+				if (! (tile_image = Renderer->image_clone
+						(Tile_Display_Size,
+						//	Mappings shared with the Reference_Image.
+						Plastic_Image::BAND_MAP |
+						Plastic_Image::DATA_MAPS)))
+					goto Done;
+				}
+			else
+				tile_image = Tile_Image_Pool.takeLast ();
+
+			band = 3;
+			while (band--)
+				{
+				tile_image->source_scaling (scalings[band], band);
+				tile_image->source_origin (locations[band], band);
+				}
+			}
+		prefetched.append (tile_image);
+
+		if (tile_image->needs_update () &&
+			! Renderer->is_queued (tile_image) &&
+			! Renderer->is_rendering (tile_image))
+			{
+			#if ((DEBUG_SECTION) & (DEBUG_MOVE | DEBUG_RESET_TILES))
+			LOCKED_LOGGING ((
+			clog << "    prefetch tile " << distance->at (cell)
+					<< " @ " << locations[0] << endl));
+			#endif
+			Renderer->queue (tile_image,
+				Image_Renderer::LOW_PRIORITY_RENDERING);
+			}
+		}
+	}
+
+Done:
+//	Release the tiles no longer ahead of the motion.
+release_prefetched_tiles ();
+Prefetch_Tiles = prefetched;
+#if ((DEBUG_SECTION) & (DEBUG_MOVE | DEBUG_RESET_TILES))
+LOCKED_LOGGING ((
+clog << "<<< Tiled_Image_Display::prefetch_tiles: "
+		<< Prefetch_Tiles.size () << " tiles, motion step "
+		<< Motion_Step << endl));
+#endif
+}
+
+
+bool
+Tiled_Image_Display::adopt_prefetched_tile
+	(
+	QList<Plastic_Image*>*	tiles,
+	int						column,
+	const QPointF*			locations
+	)
+{
+Plastic_Image
+	*tile_image = tiles->at (column),
+	*prefetched;
+QPointF
+	offset;
+int
+	band;
+if (tile_image)
+	{
+	offset = tile_image->source_origin () - locations[0];
+	if (qAbs (offset.x ()) < PREFETCH_LOCATION_TOLERANCE &&
+		qAbs (offset.y ()) < PREFETCH_LOCATION_TOLERANCE &&
+		tile_image->source_scaling () == image_scaling ())
+		//	The tile is already in place.
+		return false;
+	}
+
+for (int
+		index = 0;
+		index < Prefetch_Tiles.size ();
+		index++)
+	{
+	prefetched = Prefetch_Tiles[index];
+	if (prefetched->size () != Tile_Display_Size ||
+		prefetched->needs_update () ||
+		Renderer->is_queued (prefetched) ||
+		Renderer->is_rendering (prefetched))
+		continue;
+	for (band = 0;
+		 band < 3;
+		 band++)
+		{
+		offset = prefetched->source_origin (band) - locations[band];
+		if (qAbs (offset.x ()) >= PREFETCH_LOCATION_TOLERANCE ||
+			qAbs (offset.y ()) >= PREFETCH_LOCATION_TOLERANCE ||
+			prefetched->source_scaling (band) != image_scaling (band))
+			break;
+		}
+	if (band < 3)
+		continue;
+
+	#if ((DEBUG_SECTION) & (DEBUG_MOVE | DEBUG_RESET_TILES))
+	LOCKED_LOGGING ((
+	clog << ">-< Tiled_Image_Display::adopt_prefetched_tile: "
+			<< *prefetched << endl));
+	#endif
+	Prefetch_Tiles.removeAt (index);
+	if (tile_image)
+		{
+		//	The displaced tile is released when prefetching is reset.
+		Renderer->cancel (tile_image, Image_Renderer::DO_NOT_WAIT);
+		Prefetch_Tiles.append (tile_image);
+		}
+	tiles->replace (column, prefetched);
+	return true;
+	}
+return false;
+}
+
+
+void
+Tiled_Image_Display::release_prefetched_tiles ()
+{
+Plastic_Image
+	*tile_image;
+while (! Prefetch_Tiles.isEmpty ())
+	{
+	tile_image = Prefetch_Tiles.takeLast ();
+	Renderer->cancel (tile_image, Image_Renderer::DO_NOT_WAIT);
+	if (Tile_Image_Pool.size () < Tile_Image_Pool_Max)
+		Tile_Image_Pool.append (tile_image);
+	else
+		Renderer->delete_image (tile_image);
+	}
+}
+
 /*==============================================================================
 	Scaling
 */
@@ -3570,10 +4561,19 @@ clog << "    current scaling = " << current_scaling << endl
 if ((changed = (scaling != current_scaling)))
 	{
 	Pending_State_Change_Enabled = false;
+	cancel_pending_repaints ();
 
 	//	Cancel all rendering.
 	Renderer->reset (Image_Renderer::DO_NOT_WAIT);
 
+	//	Keep the current rendering as a placeholder at the new scaling.
+	if (band <= 0)
+		capture_placeholder ();
+
+	//	Prefetched tiles are for the current scaling.
+	release_prefetched_tiles ();
+	Motion_Time = QTime ();
+
 	//	Current image origin.
 	QPointF
 		old_origin (displayed_image_origin (band)),
@@ -3753,6 +4753,9 @@ if ((changed = (scaling != current_scaling)))
 		#endif
 		}
 
+	//	The indexed source data histograms are for the previous scale.
+	Source_Histogram_Index.clear ();
+
 	//	Reset the tile geometries.
 	reset_tiles ();
 	#if ((DEBUG_SECTION) & DEBUG_SCALING)
@@ -4166,6 +5169,9 @@ clog << ">>> Tiled_Image_Display::image_update_needed: " << update_type
 		<< " - " << Plastic_Image::mapping_type_names (update_type) << endl
 	 << "    in " << object_pathname (this) << endl));
 #endif
+//	Prefetched tiles would have to be rendered again.
+release_prefetched_tiles ();
+
 int
 	tile_rows = Tile_Grid_Size.rheight (),
 	tile_cols = Tile_Grid_Size.rwidth ();
@@ -4680,6 +5686,25 @@ clog << ">>> Tiled_Image_Display::rendered:" << endl
 	 << "    tile_coordinate = " << tile_coordinate << endl
 	 << "        tile_region = " << tile_region << endl));
 #endif
+/*	The tile image data has changed.
+
+	N.B.: The null tile coordinate that signals visible tile rendering
+	completion is also the coordinate of the upper left margin tile.
+*/
+if (tile_coordinate.x () >= 0 &&
+	tile_coordinate.x () < Tile_Grid_Size.width () &&
+	tile_coordinate.y () >= 0 &&
+	tile_coordinate.y () < Tile_Grid_Size.height ())
+	{
+	QList<Plastic_Image*>
+		*tiles = Tile_Grid_Images->at (tile_coordinate.y ());
+	Plastic_Image
+		*tile_image;
+	if (tiles &&
+		(tile_image = tiles->at (tile_coordinate.x ())))
+		Source_Histogram_Index.invalidate (tile_image->image_region ());
+	}
+
 if (tile_coordinate.isNull ())
 	{
 	//	Visible tile image rendering completed. Update the entire viewport.
@@ -4689,6 +5714,8 @@ if (tile_coordinate.isNull ())
 	LOCKED_LOGGING ((
 	clog << "    update ..." << endl));
 	#endif
+	Placeholder_Image = QImage ();
+	cancel_pending_repaints ();
 	update ();
 
 	if (Pending_State_Change)
@@ -4753,7 +5780,23 @@ else
 						DEBUG_LOCATION))
 		clog << "    repaint single tile ..." << endl;
 		#endif
-		repaint (display_region);
+		if (Repaint_Interval <= 0)
+			repaint (display_region);
+		else
+			{
+			//	Coalesce with the pending repaint of the tile.
+			int
+				index = Pending_Repaint_Tiles.indexOf (tile_coordinate);
+			if (index < 0)
+				{
+				Pending_Repaint_Tiles.append (tile_coordinate);
+				Pending_Repaint_Regions.append (display_region);
+				}
+			else
+				Pending_Repaint_Regions[index] |= display_region;
+			if (! Repaint_Timer->isActive ())
+				Repaint_Timer->start (Repaint_Interval);
+			}
 		//qApp->sendPostedEvents ();
 		#if ((DEBUG_SECTION) & DEBUG_PROMPT)
 		char
@@ -4775,6 +5818,32 @@ clog << "<<< Tiled_Image_Display::rendered" << endl));
 }
 
 
+void
+Tiled_Image_Display::repaint_pending ()
+{
+#if ((DEBUG_SECTION) & (DEBUG_SLOTS | \
+				DEBUG_RENDERED | \
+				DEBUG_PAINT))
+LOCKED_LOGGING ((
+clog << ">-< Tiled_Image_Display::repaint_pending: "
+		<< Pending_Repaint_Regions.size () << " tile regions" << endl));
+#endif
+//	All the pending tile regions are repainted in a single paint event.
+QRegion
+	region;
+for (int
+		index = 0;
+		index < Pending_Repaint_Regions.size ();
+		index++)
+	region |= Pending_Repaint_Regions[index];
+Pending_Repaint_Tiles.clear ();
+Pending_Repaint_Regions.clear ();
+region &= rect ();
+if (! region.isEmpty ())
+	repaint (region);
+}
+
+
 void
 Tiled_Image_Display::paintEvent
 	(
@@ -4872,7 +5941,9 @@ if (tile_grid == tile_grid_limit &&		//	Only one tile.
 			 << "         tile region = " << tile_region << endl));
 		#endif
 		//	Extant tile image containing the display region.
-		painter.drawImage (tile_region, *tile_image);
+		displayed_tile_region = paint_region & tile_region;
+		painter.drawImage (displayed_tile_region, *tile_image,
+			displayed_tile_region.translated (-tile_region.topLeft ()));
 
 		#if ((DEBUG_SECTION) & (DEBUG_EVENTS | DEBUG_PAINT | DEBUG_PAINT_ONE))
 		#if ((DEBUG_SECTION) & DEBUG_PIXEL_DATA)
@@ -5069,6 +6140,8 @@ while (true)
 						label = QString (" source fill: ");
 						#endif
 						}
+					//	Refine with the previous rendering, if any.
+					paint_placeholder (painter, tile_region);
 					}
 				else
 					{
@@ -25,16 +25,22 @@ Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
 #define HiView_Tiled_Image_Display_hh
 
 #include	"Plastic_Image.hh"
+#include	"Histogram_Index.hh"
 
 //	PIRL++
 #include	"Reference_Counted_Pointer.hh"
 
 #include	<QWidget>
+#include	<QTime>
+
+#include	<cstddef>
 
 //	Forward references.
 template<typename T> class QVector;
 template<typename T> class QList;
 class QPaintEvent;
+class QPainter;
+class QTimer;
 class QMouseEvent;
 class QErrorMessage;
 
@@ -261,6 +267,26 @@ static double
 static bool
 	Default_Source_Image_Rendering;
 
+//!	Source data histogram index enabled.
+static bool
+	Histogram_Index_Enabled;
+
+//!	Tiles still in view are reused when the image is moved.
+static bool
+	Scroll_Reuse_Enabled;
+
+//!	Unrendered tiles are painted with coarse placeholders.
+static bool
+	Progressive_Rendering_Enabled;
+
+//!	Maximum bytes of tile images rendered ahead of image moves.
+static unsigned long
+	Tile_Prefetch_Budget;
+
+//!	Minimum milliseconds between incremental rendering repaints.
+static int
+	Repaint_Interval;
+
 /*==============================================================================
 	Constructors
 */
@@ -420,6 +446,19 @@ void rendering_increment_lines (int rendering_increment);
 inline static int rendering_increment_lines ()
 	{return (int)Plastic_Image::default_rendering_increment_lines ();}
 
+/**	Set the number of threads used to render image tiles.
+
+	<b>N.B.</b>: The renderer's rendering pool is resized before the
+	next tile is rendered. JPEG2000 source decoding for the tiles of the
+	same image is still done one tile at a time; see Image_Renderer_Thread.
+
+	@param	threads	The number of image tiles that may be rendered
+		concurrently. If zero the number of processor cores is used.
+	@see	Image_Renderer_Thread::default_rendering_threads(int)
+*/
+void rendering_threads (int threads);
+static int rendering_threads ();
+
 void background_color (QRgb color);
 inline static QRgb background_color ()
 	{return Plastic_Image::default_background_color ();}
@@ -812,6 +851,19 @@ inline int pending_state_change () const
 	mapped to the three display bands. <b>N.B.</b>: Original source image
 	data values - before any data mapping - are counted.
 
+	The tile images that intersect the image region are scanned
+	concurrently, each scanning thread taking the next unscanned tile
+	when it is free and counting into its own histograms; these are
+	merged when all the tiles have been scanned.
+
+	When the {@link histogram_index(bool) histogram index} is enabled
+	the histograms of each block of the image that is entirely within the
+	image region are counted once and then kept in a Histogram_Index;
+	only the edges of the region outside of these blocks are scanned
+	again when the region changes. The index is cleared when the image,
+	the image scale or the band mapping changes, and the blocks of a tile
+	image that is rendered are invalidated.
+
 	@param	histograms	A QVector of {@link #Histogram} pointers. Three
 		Histograms will be produced. If any of the three pointers are
 		NULL a new Histogram will be created (its ownership is
@@ -830,6 +882,21 @@ bool source_data_histograms (QVector<Histogram*> histograms,
 bool display_data_histograms (QVector<Histogram*> histograms,
 	const QRect& display_region) const;
 
+/**	Enable or disable use of the source data histogram index.
+
+	@param	enabled	true if the histogram index is to be used when
+		{@link source_data_histograms(QVector<Histogram*>, const QRect&)
+		const producing source data histograms}; false otherwise.
+*/
+static void histogram_index (bool enabled);
+
+/**	Test if the source data histogram index is enabled.
+
+	@return	true if the histogram index is enabled; false otherwise.
+	@see	histogram_index(bool)
+*/
+static bool histogram_index ();
+
 /*------------------------------------------------------------------------------
 	Display tiling
 */
@@ -886,6 +953,123 @@ inline QSize tile_display_size () const
 inline static int minimum_tile_dimension ()
 	{return MINIMUM_TILE_DIMENSION;}
 
+/**	Enable or disable scroll reuse of the tile grid.
+
+	When the image is {@link move_image(const QPoint&, int) moved} by
+	less than the tile grid margin the tile grid is always shifted: the
+	tiles that remain in view keep their rendered images and only the
+	tiles rotated into the newly exposed rows and columns are rendered.
+	With scroll reuse enabled the tile grid is also shifted when the
+	image is moved further, as long as the new display region overlaps
+	the tile grid; otherwise all the tiles are reset and rendered.
+
+	The default is enabled unless DEFAULT_SCROLL_REUSE is defined false
+	at compile time.
+
+	@param	enabled	true if tiles still in view are to be reused when the
+		image is moved; false if all tiles are to be rendered when the
+		image is moved beyond the tile grid margin.
+*/
+inline static void scroll_reuse (bool enabled)
+	{Scroll_Reuse_Enabled = enabled;}
+
+/**	Test if scroll reuse of the tile grid is enabled.
+
+	@return	true if tiles still in view are reused when the image is
+		moved; false otherwise.
+	@see	scroll_reuse(bool)
+*/
+inline static bool scroll_reuse ()
+	{return Scroll_Reuse_Enabled;}
+
+/**	Enable or disable progressive tile rendering.
+
+	While a visible tile is waiting to be rendered its display region is
+	painted with a coarse placeholder. The placeholder is always taken
+	from the low resolution overview of the entire image - the source
+	image - if it has been rendered. With progressive rendering enabled
+	the display is also repainted as soon as new tiles are queued for
+	rendering, not when they are rendered. And when the image is scaled
+	the rendering at the previous scale is kept, and scaled, as a finer
+	placeholder over the overview until all the visible tiles have been
+	rendered at the new scale.
+
+	The default is enabled unless DEFAULT_PROGRESSIVE_RENDERING is
+	defined false at compile time.
+
+	@param	enabled	true if unrendered tiles are to be progressively
+		painted with coarse placeholders; false otherwise.
+*/
+inline static void progressive_rendering (bool enabled)
+	{Progressive_Rendering_Enabled = enabled;}
+
+/**	Test if progressive tile rendering is enabled.
+
+	@return	true if unrendered tiles are progressively painted with
+		coarse placeholders; false otherwise.
+	@see	progressive_rendering(bool)
+*/
+inline static bool progressive_rendering ()
+	{return Progressive_Rendering_Enabled;}
+
+/**	Set the memory budget for tiles rendered ahead of image moves.
+
+	The direction and speed of recent image moves - from display
+	viewport panning or the Navigator_Tool - is tracked. When the
+	image is moving consistently in one direction the tiles beyond
+	the tile grid margins in the direction of motion are queued for low
+	priority rendering, which also requests their source data from a
+	JPIP server for a remote image. When the image moves onto these
+	tiles they are swapped into the tile grid without being rendered
+	again. The number of prefetched tiles is limited by the memory
+	budget.
+
+	The default budget is 16 MB unless DEFAULT_TILE_PREFETCH_BUDGET is
+	defined otherwise at compile time.
+
+	@param	bytes	The maximum number of bytes of tile image storage
+		to be used for prefetched tiles. If zero tile prefetching is
+		disabled.
+*/
+inline static void tile_prefetch_budget (unsigned long bytes)
+	{Tile_Prefetch_Budget = bytes;}
+
+/**	Get the memory budget for tiles rendered ahead of image moves.
+
+	@return	The maximum number of bytes of tile image storage used for
+		prefetched tiles.
+	@see	tile_prefetch_budget(unsigned long)
+*/
+inline static unsigned long tile_prefetch_budget ()
+	{return Tile_Prefetch_Budget;}
+
+/**	Set the interval for incremental rendering repaints.
+
+	As a tile is rendered its progress is reported for each part of
+	the tile that is completed. The display regions for these reports
+	are accumulated, for each tile, and repainted together no more
+	often than the repaint interval. Only the accumulated regions are
+	drawn from the tile images.
+
+	The default interval is 20 milliseconds unless
+	DEFAULT_REPAINT_INTERVAL is defined otherwise at compile time.
+
+	@param	milliseconds	The minimum time between incremental
+		rendering repaints. If zero or less each rendering report is
+		immediately repainted.
+*/
+inline static void repaint_interval (int milliseconds)
+	{Repaint_Interval = milliseconds;}
+
+/**	Get the interval for incremental rendering repaints.
+
+	@return	The minimum milliseconds between incremental rendering
+		repaints.
+	@see	repaint_interval(int)
+*/
+inline static int repaint_interval ()
+	{return Repaint_Interval;}
+
 
 protected:
 
@@ -1164,6 +1348,38 @@ int reset_tiles ();
 */
 void clear_tiles ();
 
+/**	Prefetch the tiles ahead of the image motion.
+
+	The image motion is updated from the new image origin. If the image
+	is moving consistently in one direction the tiles outside the tile
+	grid that cover the image region ahead of the displayed image
+	region, nearest first, are queued for low priority rendering within
+	the {@link tile_prefetch_budget() tile prefetch budget}. Prefetched
+	tiles that are no longer ahead of the motion are released.
+
+	@param	origin	The new image origin of the reference band.
+*/
+void prefetch_tiles (const QPointF& origin);
+
+/**	Swap a prefetched tile into the tile grid.
+
+	@param	tiles	The tile grid row.
+	@param	column	The tile grid column of the tile to be replaced.
+	@param	locations	The tile image origins for each band.
+	@return	true if a rendered prefetched tile at the locations, with the
+		current image scaling, replaced the tile grid image; false if the
+		tile grid image was left unchanged.
+*/
+bool adopt_prefetched_tile (QList<Plastic_Image*>* tiles, int column,
+	const QPointF* locations);
+
+/**	Release all prefetched tiles.
+
+	The tile images are canceled from the rendering queue and moved to
+	the Tile_Image_Pool or deleted.
+*/
+void release_prefetched_tiles ();
+
 /*==============================================================================
 	Utilities
 */
@@ -1800,8 +2016,9 @@ void renderer_status (int status);
 	isEmpty the entire {@link tile_display_region(const QPoint&)} for the
 	tile_coordinate has completed rendering. If any portion of the
 	viewport-relative region overlaps the display viewport that portion
-	of the display is immediately repainted. This incremental rendering
-	does not result in a state change signal.
+	of the display is {@link repaint_interval(int) repainted} together
+	with any other incremental rendering of the same tile. This
+	incremental rendering does not result in a state change signal.
 
 	@param	tile_coordinate	A QPoint specifying the tile that was rendered.
 		If the value is not valid the entire viewport is ready for an update.
@@ -1812,6 +2029,15 @@ void renderer_status (int status);
 void rendered
 	(const QPoint& tile_coordinate, const QRect& tile_region = QRect ());
 
+/**	Repaint the display regions of incremental tile rendering.
+
+	The union of the accumulated display regions is repainted in a
+	single paint event and the regions are cleared.
+
+	@see	rendered(const QPoint&, const QRect&)
+*/
+void repaint_pending ();
+
 void rendering_error (const QString& message);
 
 /*==============================================================================
@@ -1928,6 +2154,16 @@ QSizeF calculate_tile_image_size (int band = 0) const;
 */
 bool reset_tile_image_size ();
 
+/**	Set the storage size of the tile images served by the
+	Tile_Memory_Arena for this display.
+
+	The previous size is removed from the arena and the new size added.
+
+	@param	bytes	The number of bytes of pixel storage for a tile
+		image. Zero if the display does not use tile memory.
+*/
+void tile_memory_size (std::size_t bytes);
+
 /**	Calculate the effective tile grid region in image space.
 
 	<b>N.B.</b>: The effective tile grid may extend beyond the bounaries
@@ -1988,6 +2224,32 @@ bool reset_tiled_image_region ();
 static QRect tile_relative_region
 	(const QRect& tile_region, QPoint tile_origin);
 
+/**	Capture the rendered tiles in the display viewport as a placeholder.
+
+	The display regions of the visible tiles that do not need to be
+	rendered are drawn into the Placeholder_Image; other regions are
+	left transparent. The image region covered by the viewport is
+	recorded in the Placeholder_Region. Any previous placeholder is
+	painted first so repeated scaling keeps the best rendering available.
+	If there is nothing to capture the Placeholder_Image is null.
+
+	This must be done before the display geometry is changed.
+*/
+void capture_placeholder ();
+
+/**	Paint the placeholder for an unrendered tile.
+
+	@param	painter	The QPainter for the display.
+	@param	tile_region	The display region of the tile.
+*/
+void paint_placeholder (QPainter& painter, const QRect& tile_region) const;
+
+/**	Discard the pending incremental rendering repaints.
+
+	This is used when the display viewport is to be entirely updated.
+*/
+void cancel_pending_repaints ();
+
 /**	Convert a tile-relative region to a viewport-relative region.
 
 	The specified tile region is assumed to have an origin relative to
@@ -2136,6 +2398,11 @@ bool
 	Pending_State_Change_Enabled;
 
 
+//!	Index of source data histograms for image blocks.
+mutable Histogram_Index
+	Source_Histogram_Index;
+
+
 //	The tile grid:
 
 //!	The grid of image rendering tiles covering the Tiled_Image_Region.
@@ -2171,6 +2438,10 @@ QSize
 mutable QSizeF
 	Tile_Image_Size;
 
+//!	Tile image storage size registered with the Tile_Memory_Arena.
+std::size_t
+	Tile_Memory_Bytes;
+
 //!	Tiled region, including margin tiles, in image space.
 mutable QRectF
 	Tiled_Image_Region;
@@ -2189,6 +2460,51 @@ QPoint
 QPoint
 	Tile_Display_Offset;
 
+/*------------------------------------------------------------------------------
+	Progressive rendering.
+*/
+//!	Previously rendered display viewport used as a placeholder.
+QImage
+	Placeholder_Image;
+
+//!	Image region, in image space, of the Placeholder_Image.
+QRectF
+	Placeholder_Region;
+
+/*------------------------------------------------------------------------------
+	Tile prefetching.
+*/
+//!	Tiles rendered ahead of image moves, outside the tile grid.
+QList<Plastic_Image*>
+	Prefetch_Tiles;
+
+//!	Image origin of the last move.
+QPointF
+	Motion_Origin;
+
+//!	Average image origin step for recent moves.
+QPointF
+	Motion_Step;
+
+//!	Time of the last move.
+QTime
+	Motion_Time;
+
+/*------------------------------------------------------------------------------
+	Incremental repaint.
+*/
+//!	Single shot timer for the next incremental rendering repaint.
+QTimer
+	*Repaint_Timer;
+
+//!	Tile grid coordinates of tiles with regions pending repaint.
+QList<QPoint>
+	Pending_Repaint_Tiles;
+
+//!	Display regions pending repaint for each Pending_Repaint_Tiles entry.
+QList<QRect>
+	Pending_Repaint_Regions;
+
 /*------------------------------------------------------------------------------
 */
 //!	Shared error message dialog.